@@ -12,6 +12,8 @@ import (
 	"sync"
 	"time"
 
+	"github.com/deepteams/webp/internal/dsp"
+	"github.com/deepteams/webp/internal/lossless"
 	"github.com/deepteams/webp/mux"
 )
 
@@ -47,10 +49,29 @@ type Animation struct {
 // It will be set by the codec package once available.
 var FrameDecoderFunc func(bitstreamData, alphaData []byte) (*image.NRGBA, error)
 
+// FrameDecoderRawFunc decodes a raw bitstream frame into the codec's native
+// output format: *image.YCbCr (4:2:0) for opaque lossy frames, *image.NRGBA
+// otherwise. It lets StreamDecoder.NextFrameRaw hand opaque full-canvas
+// frames to the consumer without a colour-space conversion.
+// It will be set by the codec package once available.
+var FrameDecoderRawFunc func(bitstreamData, alphaData []byte) (image.Image, error)
+
+// YCbCrToNRGBAFunc converts a decoded YCbCr frame to NRGBA. It is used to
+// materialize the NRGBA canvas when a frame that was handed out raw turns out
+// to be needed as compositing context for a later frame. It will be set by
+// the codec package to its SIMD upsampling path; when nil, a scalar
+// per-pixel conversion is used.
+var YCbCrToNRGBAFunc func(img *image.YCbCr) *image.NRGBA
+
 // FrameEncoderFunc encodes an image to a raw VP8/VP8L bitstream.
 // lossless controls whether VP8L (true) or VP8 (false) is used.
 // quality controls encoding quality (0-100).
 // It will be set by the codec package once available.
+//
+// The function may be invoked from multiple goroutines concurrently: the
+// optimized frame path encodes its dispose-method candidates (and, with
+// AllowMixed, the lossy/lossless pair) in parallel when more than one CPU
+// is available. Implementations must be safe for concurrent use.
 var FrameEncoderFunc func(img image.Image, lossless bool, quality int) ([]byte, error)
 
 // SimpleEncodeFunc encodes an image as a complete simple (non-animated) WebP
@@ -144,6 +165,8 @@ func DecodeBytes(data []byte) (*Animation, error) {
 			HasAlpha:      fi.HasAlpha,
 			BitstreamData: fi.Data,
 			AlphaData:     fi.AlphaData,
+			Width:         fi.Width,
+			Height:        fi.Height,
 		}
 	}
 
@@ -321,15 +344,21 @@ func (d *AnimDecoder) HasNext() bool {
 // This matches the C libwebp IsKeyFrame() logic, using the bitstream's
 // has_alpha flag instead of scanning pixel data.
 func (d *AnimDecoder) isKeyFrame(idx int) bool {
-	f := &d.anim.Frames[idx]
+	return isKeyFrameAt(d.anim, idx, d.prevFrameWasKeyframe, d.prevDispose, d.prevBounds)
+}
+
+// isKeyFrameAt is the keyframe test shared by AnimDecoder and StreamDecoder.
+// The prev* parameters describe the frame at idx-1 (ignored for idx 0).
+func isKeyFrameAt(anim *Animation, idx int, prevWasKeyframe bool, prevDispose DisposeMethod, prevBounds image.Rectangle) bool {
+	f := &anim.Frames[idx]
 
 	// First frame is always a keyframe.
 	if idx == 0 {
 		return true
 	}
 
-	canvasW := d.anim.CanvasWidth
-	canvasH := d.anim.CanvasHeight
+	canvasW := anim.CanvasWidth
+	canvasH := anim.CanvasHeight
 
 	// A full-canvas frame that has no alpha (per bitstream flag) or uses
 	// no-blend is a keyframe. This uses the bitstream-level alpha flag
@@ -349,10 +378,10 @@ func (d *AnimDecoder) isKeyFrame(idx int) bool {
 	// - previous frame covered the full canvas, or
 	// - previous frame was itself a keyframe
 	// then this frame is a keyframe (canvas is fully transparent).
-	if d.prevDispose == DisposeBackground {
-		prevFull := d.prevBounds.Min.X == 0 && d.prevBounds.Min.Y == 0 &&
-			d.prevBounds.Dx() == canvasW && d.prevBounds.Dy() == canvasH
-		if prevFull || d.prevFrameWasKeyframe {
+	if prevDispose == DisposeBackground {
+		prevFull := prevBounds.Min.X == 0 && prevBounds.Min.Y == 0 &&
+			prevBounds.Dx() == canvasW && prevBounds.Dy() == canvasH
+		if prevFull || prevWasKeyframe {
 			return true
 		}
 	}
@@ -422,37 +451,74 @@ func (d *AnimDecoder) Canvas() *image.NRGBA {
 // compositeFrame blends the frame onto the current canvas.
 // Frame bounds are clamped to the canvas dimensions to prevent out-of-bounds access.
 func (d *AnimDecoder) compositeFrame(f *Frame) {
-	src := toNRGBA(f.Image)
+	compositeOnto(d.currFrame, f, toNRGBA(f.Image))
+}
+
+// minPixelsForParallelComposite is the minimum composited area before the
+// canvas is split into horizontal bands blended on separate goroutines.
+// Below this the goroutine overhead outweighs the row work.
+const minPixelsForParallelComposite = 1 << 16
+
+// compositeOnto blends src (the frame's decoded pixels) onto canvas at the
+// frame's offset using the frame's blend mode. It is shared by AnimDecoder
+// and StreamDecoder; the latter decodes src lazily without retaining it on
+// the Frame.
+//
+// Rows are processed as contiguous pixel slices: BlendNone is a straight
+// row copy and BlendAlpha goes through the dsp row-blend kernel. Large
+// rectangles are split into horizontal bands composited in parallel.
+func compositeOnto(canvas *image.NRGBA, f *Frame, src *image.NRGBA) {
 	rect := f.Bounds()
 	srcBounds := src.Bounds()
 
-	// Clamp frame bounds to canvas dimensions to prevent out-of-bounds writes.
-	canvasBounds := d.currFrame.Bounds()
+	// Clamp frame bounds to canvas dimensions to prevent out-of-bounds
+	// writes, and to the pixels actually present in src (its size can
+	// disagree with the container-reported frame rectangle).
+	canvasBounds := canvas.Bounds()
 	rect = rect.Intersect(canvasBounds)
+	rect = rect.Intersect(image.Rect(f.OffsetX, f.OffsetY,
+		f.OffsetX+srcBounds.Dx(), f.OffsetY+srcBounds.Dy()))
 	if rect.Empty() {
 		return
 	}
 
-	for y := rect.Min.Y; y < rect.Max.Y; y++ {
-		sy := y - f.OffsetY
-		if sy < 0 || sy >= srcBounds.Dy() {
-			continue
-		}
-		for x := rect.Min.X; x < rect.Max.X; x++ {
-			sx := x - f.OffsetX
-			if sx < 0 || sx >= srcBounds.Dx() {
-				continue
-			}
-			srcPx := src.NRGBAAt(sx, sy)
+	width := rect.Dx()
+	rows := rect.Dy()
+	srcX := srcBounds.Min.X + (rect.Min.X - f.OffsetX)
 
+	compositeRows := func(y0, y1 int) {
+		for y := y0; y < y1; y++ {
+			so := src.PixOffset(srcX, srcBounds.Min.Y+(y-f.OffsetY))
+			do := canvas.PixOffset(rect.Min.X, y)
+			srcRow := src.Pix[so : so+width*4]
+			dstRow := canvas.Pix[do : do+width*4]
 			if f.Blend == BlendNone {
-				d.currFrame.SetNRGBA(x, y, srcPx)
+				copy(dstRow, srcRow)
 			} else {
-				dstPx := d.currFrame.NRGBAAt(x, y)
-				d.currFrame.SetNRGBA(x, y, alphaBlendNRGBA(srcPx, dstPx))
+				dsp.BlendRowNRGBA(dstRow, srcRow)
 			}
 		}
 	}
+
+	numWorkers := runtime.GOMAXPROCS(0)
+	if rows*width < minPixelsForParallelComposite || numWorkers < 2 {
+		compositeRows(rect.Min.Y, rect.Max.Y)
+		return
+	}
+	if numWorkers > rows {
+		numWorkers = rows
+	}
+	var wg sync.WaitGroup
+	for w := 0; w < numWorkers; w++ {
+		y0 := rect.Min.Y + rows*w/numWorkers
+		y1 := rect.Min.Y + rows*(w+1)/numWorkers
+		wg.Add(1)
+		go func(y0, y1 int) {
+			defer wg.Done()
+			compositeRows(y0, y1)
+		}(y0, y1)
+	}
+	wg.Wait()
 }
 
 // clearCanvas fills the entire canvas with transparent (0,0,0,0).
@@ -462,18 +528,20 @@ func clearCanvas(canvas *image.NRGBA) {
 	}
 }
 
-// frameWidth returns the width of the frame's image, or 0 if nil.
+// frameWidth returns the width of the frame's image, falling back to the
+// container-reported width when the frame has not been decoded.
 func frameWidth(f *Frame) int {
 	if f.Image == nil {
-		return 0
+		return f.Width
 	}
 	return f.Image.Bounds().Dx()
 }
 
-// frameHeight returns the height of the frame's image, or 0 if nil.
+// frameHeight returns the height of the frame's image, falling back to the
+// container-reported height when the frame has not been decoded.
 func frameHeight(f *Frame) int {
 	if f.Image == nil {
-		return 0
+		return f.Height
 	}
 	return f.Image.Bounds().Dy()
 }
@@ -487,9 +555,12 @@ type EncodeOptions struct {
 	Quality         int  // 0-100 for lossy encoding.
 	Lossless        bool
 
-	// AllowMixed enables mixed codec mode. When true, each frame is encoded
-	// as both lossy (VP8) and lossless (VP8L), and the smaller result is used.
-	// This means different frames in the same animation may use different codecs.
+	// AllowMixed enables mixed codec mode. When true, each frame may use
+	// either codec — lossy (VP8) or lossless (VP8L) — whichever produces
+	// the smaller result. A color-statistics classifier predicts the
+	// winner first (palette-sized frames go lossless, high-diversity
+	// photographic frames go lossy) so most frames pay for a single
+	// encode; only ambiguous frames are encoded with both codecs.
 	// This matches the C libwebp allow_mixed option in WebPAnimEncoderOptions.
 	AllowMixed bool
 
@@ -631,18 +702,104 @@ func (e *AnimEncoder) AddFrame(img image.Image, duration time.Duration) error {
 	return errors.New("animation: no frame encoder available; use AddRawFrame or register FrameEncoderFunc")
 }
 
-// encodeFrame encodes an image using the configured codec. When AllowMixed is
-// true, the image is encoded as both lossy and lossless, and the smaller result
-// is returned. This matches the C libwebp behavior where allow_mixed causes
-// each frame to be tried with both codecs independently.
+// codecPrediction is the outcome of classifyFrameCodec.
+type codecPrediction int
+
+const (
+	predictAmbiguous codecPrediction = iota
+	predictLossless
+	predictLossy
+)
+
+// mixedColorCap is the distinct-color count above which a mixed-mode frame
+// is classified as photographic (lossy wins). Between the VP8L palette
+// limit and this cap the content is ambiguous and only a dual encode can
+// decide.
+const mixedColorCap = 1024
+
+// classifyFrameCodec predicts which codec wins a mixed-mode frame using
+// the same palette statistic the VP8L analyze() stage computes: frames
+// whose colors fit a palette (<= lossless.MaxPaletteSize distinct values)
+// compress best with VP8L, while high color diversity indicates
+// photographic content where VP8 wins at typical qualities. The scan
+// early-exits once mixedColorCap distinct colors are seen, so
+// photographic frames classify after a few thousand pixels.
+func classifyFrameCodec(img image.Image) codecPrediction {
+	nrgba, ok := img.(*image.NRGBA)
+	if !ok {
+		return predictAmbiguous
+	}
+	b := nrgba.Bounds()
+	w, h := b.Dx(), b.Dy()
+	colorSet := make(map[uint32]struct{}, lossless.MaxPaletteSize+1)
+	for y := 0; y < h; y++ {
+		rowOff := (y+b.Min.Y-nrgba.Rect.Min.Y)*nrgba.Stride + (b.Min.X-nrgba.Rect.Min.X)*4
+		for x := 0; x < w; x++ {
+			off := rowOff + x*4
+			c := uint32(nrgba.Pix[off])<<24 | uint32(nrgba.Pix[off+1])<<16 |
+				uint32(nrgba.Pix[off+2])<<8 | uint32(nrgba.Pix[off+3])
+			colorSet[c] = struct{}{}
+			if len(colorSet) > mixedColorCap {
+				return predictLossy
+			}
+		}
+	}
+	if len(colorSet) <= lossless.MaxPaletteSize {
+		return predictLossless
+	}
+	return predictAmbiguous
+}
+
+// encodeFrame encodes an image using the configured codec. When AllowMixed
+// is true, a color-statistics classifier first predicts the winning codec
+// and the frame is encoded once with it (falling back to the other codec
+// if that encode fails); only ambiguous frames are encoded as both lossy
+// and lossless with the smaller result kept, as C libwebp's allow_mixed
+// does unconditionally.
 func (e *AnimEncoder) encodeFrame(img image.Image, lossless bool, quality int) ([]byte, error) {
+	if !e.opts.AllowMixed {
+		return FrameEncoderFunc(img, lossless, quality)
+	}
+	switch classifyFrameCodec(img) {
+	case predictLossless:
+		bs, err := FrameEncoderFunc(img, true, quality)
+		if err != nil {
+			return FrameEncoderFunc(img, false, quality)
+		}
+		return bs, nil
+	case predictLossy:
+		bs, err := FrameEncoderFunc(img, false, quality)
+		if err != nil {
+			return FrameEncoderFunc(img, true, quality)
+		}
+		return bs, nil
+	}
+	if runtime.GOMAXPROCS(0) > 1 {
+		// The two codec attempts are independent; run the alternate codec on
+		// its own goroutine while this one handles the configured codec.
+		var (
+			bsAlt  []byte
+			errAlt error
+			done   = make(chan struct{})
+		)
+		go func() {
+			defer close(done)
+			bsAlt, errAlt = FrameEncoderFunc(img, !lossless, quality)
+		}()
+		bs, err := FrameEncoderFunc(img, lossless, quality)
+		<-done
+		if err != nil {
+			return nil, err
+		}
+		if errAlt == nil && len(bsAlt) < len(bs) {
+			return bsAlt, nil
+		}
+		return bs, nil
+	}
 	bs, err := FrameEncoderFunc(img, lossless, quality)
 	if err != nil {
 		return nil, err
 	}
-	if !e.opts.AllowMixed {
-		return bs, nil
-	}
 	// Try the reversed codec (lossy if configured lossless, and vice versa).
 	bsAlt, errAlt := FrameEncoderFunc(img, !lossless, quality)
 	if errAlt != nil {
@@ -692,10 +849,14 @@ func (e *AnimEncoder) addOptimizedFrame(img image.Image, duration time.Duration)
 		return nil
 	}
 
-	// Check if this frame is pixel-identical to the previous canvas. If so,
-	// merge it by extending the previous frame's duration instead of encoding
-	// a new frame. This matches the C libwebp frame_skipped / empty-rect logic.
-	if isCanvasIdentical(e.prevCanvas, currCanvas) {
+	// Diff against the previous canvas once. An empty rectangle means the
+	// frame is pixel-identical: merge it by extending the previous frame's
+	// duration instead of encoding a new frame, matching the C libwebp
+	// frame_skipped / empty-rect logic. A non-empty rectangle is reused by
+	// the DISPOSE_NONE candidate below, so static-frame detection and
+	// dirty-rect detection cost a single canvas scan.
+	changed := findChangedRect(e.prevCanvas, currCanvas)
+	if changed.Empty() {
 		return e.increasePreviousDuration(durMS)
 	}
 
@@ -711,7 +872,7 @@ func (e *AnimEncoder) addOptimizedFrame(img image.Image, duration time.Duration)
 	}
 
 	// Try sub-frame encoding with both dispose methods and pick the best.
-	return e.encodeSubFrame(currCanvas, durMS)
+	return e.encodeSubFrame(currCanvas, changed, durMS)
 }
 
 // encodeKeyframe encodes the current canvas as a full-canvas keyframe.
@@ -843,65 +1004,95 @@ func isLossyBlendingPossible(src, dst *image.NRGBA, rect image.Rectangle, qualit
 // unknown). In the Go encoder, frames are committed immediately so
 // prevFrameRect is always valid, and both candidates can always be evaluated.
 // See AnimEncoder type comment for the full DIFF-AN3 rationale.
-func (e *AnimEncoder) encodeSubFrame(currCanvas *image.NRGBA, durMS int) error {
+func (e *AnimEncoder) encodeSubFrame(currCanvas *image.NRGBA, changed image.Rectangle, durMS int) error {
 	// --- Candidate 1: DISPOSE_NONE on previous frame ---
-	// The previous canvas is unchanged; diff against it directly.
-	rectNone := findChangedRect(e.prevCanvas, currCanvas)
-	if rectNone.Empty() {
-		// No pixel changed -- encode a minimal 1x1 frame.
-		rectNone = image.Rect(0, 0, 1, 1)
-	}
-	rectNone = snapToEven(rectNone)
-	rectNone = rectNone.Intersect(image.Rect(0, 0, e.width, e.height))
-
-	// Check if blending is possible for the DISPOSE_NONE candidate.
-	// Matching C libwebp: blend mode is BLEND if validation passes, NO_BLEND otherwise.
-	blendNone := BlendNone
-	if e.opts.Lossless {
-		if isLosslessBlendingPossible(e.prevCanvas, currCanvas, rectNone) {
-			blendNone = BlendAlpha
+	// The previous canvas is unchanged; the caller already diffed against
+	// it, so reuse its rectangle.
+	runNone := func() ([]byte, image.Rectangle, BlendMethod, error) {
+		rectNone := changed
+		if rectNone.Empty() {
+			// No pixel changed -- encode a minimal 1x1 frame.
+			rectNone = image.Rect(0, 0, 1, 1)
 		}
-	} else {
-		if isLossyBlendingPossible(e.prevCanvas, currCanvas, rectNone, e.opts.Quality) {
-			blendNone = BlendAlpha
+		rectNone = snapToEven(rectNone)
+		rectNone = rectNone.Intersect(image.Rect(0, 0, e.width, e.height))
+
+		// Check if blending is possible for the DISPOSE_NONE candidate.
+		// Matching C libwebp: blend mode is BLEND if validation passes, NO_BLEND otherwise.
+		blendNone := BlendNone
+		if e.opts.Lossless {
+			if isLosslessBlendingPossible(e.prevCanvas, currCanvas, rectNone) {
+				blendNone = BlendAlpha
+			}
+		} else {
+			if isLossyBlendingPossible(e.prevCanvas, currCanvas, rectNone, e.opts.Quality) {
+				blendNone = BlendAlpha
+			}
 		}
-	}
 
-	subImgNone := extractSubImage(currCanvas, rectNone)
-	bsNone, err := e.encodeFrame(subImgNone, e.opts.Lossless, e.opts.Quality)
-	if err != nil {
-		return fmt.Errorf("animation: encoding sub-frame (dispose-none): %w", err)
+		subImgNone := extractSubImage(currCanvas, rectNone)
+		bsNone, err := e.encodeFrame(subImgNone, e.opts.Lossless, e.opts.Quality)
+		return bsNone, rectNone, blendNone, err
 	}
 
 	// --- Candidate 2: DISPOSE_BACKGROUND on previous frame ---
 	// Simulate what the canvas would look like if the previous frame's
 	// rectangle were cleared to transparent after display.
-	var bsBG []byte
-	var rectBG image.Rectangle
-	blendBG := BlendNone
-	prevDisposedCanvas := cloneNRGBA(e.prevCanvas)
-	fillRect(prevDisposedCanvas, e.prevFrameRect, color.NRGBA{})
-	rectBG = findChangedRect(prevDisposedCanvas, currCanvas)
-	if rectBG.Empty() {
-		rectBG = image.Rect(0, 0, 1, 1)
-	}
-	rectBG = snapToEven(rectBG)
-	rectBG = rectBG.Intersect(image.Rect(0, 0, e.width, e.height))
-
-	// Check if blending is possible for the DISPOSE_BG candidate.
-	if e.opts.Lossless {
-		if isLosslessBlendingPossible(prevDisposedCanvas, currCanvas, rectBG) {
-			blendBG = BlendAlpha
+	runBG := func() ([]byte, image.Rectangle, BlendMethod, error) {
+		prevDisposedCanvas := cloneNRGBA(e.prevCanvas)
+		fillRect(prevDisposedCanvas, e.prevFrameRect, color.NRGBA{})
+		rectBG := findChangedRect(prevDisposedCanvas, currCanvas)
+		if rectBG.Empty() {
+			rectBG = image.Rect(0, 0, 1, 1)
+		}
+		rectBG = snapToEven(rectBG)
+		rectBG = rectBG.Intersect(image.Rect(0, 0, e.width, e.height))
+
+		// Check if blending is possible for the DISPOSE_BG candidate.
+		blendBG := BlendNone
+		if e.opts.Lossless {
+			if isLosslessBlendingPossible(prevDisposedCanvas, currCanvas, rectBG) {
+				blendBG = BlendAlpha
+			}
+		} else {
+			if isLossyBlendingPossible(prevDisposedCanvas, currCanvas, rectBG, e.opts.Quality) {
+				blendBG = BlendAlpha
+			}
 		}
+
+		subImgBG := extractSubImage(currCanvas, rectBG)
+		bsBG, err := e.encodeFrame(subImgBG, e.opts.Lossless, e.opts.Quality)
+		return bsBG, rectBG, blendBG, err
+	}
+
+	// The two candidates only read the previous canvas, the current canvas and
+	// the encoder options, so their analysis and sub-encodes are independent.
+	// Run them concurrently when more than one CPU is available; the selection
+	// below is identical either way.
+	var (
+		bsNone, bsBG       []byte
+		rectNone, rectBG   image.Rectangle
+		blendNone, blendBG BlendMethod
+		err, errBG         error
+	)
+	if runtime.GOMAXPROCS(0) > 1 {
+		done := make(chan struct{})
+		go func() {
+			defer close(done)
+			bsBG, rectBG, blendBG, errBG = runBG()
+		}()
+		bsNone, rectNone, blendNone, err = runNone()
+		<-done
 	} else {
-		if isLossyBlendingPossible(prevDisposedCanvas, currCanvas, rectBG, e.opts.Quality) {
-			blendBG = BlendAlpha
+		bsNone, rectNone, blendNone, err = runNone()
+		if err == nil {
+			bsBG, rectBG, blendBG, errBG = runBG()
 		}
 	}
-
-	subImgBG := extractSubImage(currCanvas, rectBG)
-	bsBG, err = e.encodeFrame(subImgBG, e.opts.Lossless, e.opts.Quality)
 	if err != nil {
+		return fmt.Errorf("animation: encoding sub-frame (dispose-none): %w", err)
+	}
+	if errBG != nil {
 		// If encoding the BG candidate fails, fall through with DISPOSE_NONE.
 		bsBG = nil
 	}
@@ -954,15 +1145,6 @@ func (e *AnimEncoder) encodeSubFrame(currCanvas *image.NRGBA, durMS int) error {
 	return nil
 }
 
-// isCanvasIdentical returns true if every pixel in a and b is identical.
-// Both images must have the same dimensions.
-func isCanvasIdentical(a, b *image.NRGBA) bool {
-	if a == nil || b == nil {
-		return false
-	}
-	return bytes.Equal(a.Pix, b.Pix)
-}
-
 // increasePreviousDuration extends the previous frame's duration by durMS
 // milliseconds, merging the current (identical) frame into the previous one.
 //
@@ -1010,12 +1192,23 @@ func (e *AnimEncoder) increasePreviousDuration(durMS int) error {
 	return nil
 }
 
+// dirtyBlockPx is the block width (in pixels) used when narrowing the X
+// boundaries of the changed rectangle: 16 pixels = 64 bytes per compare,
+// so the runtime's vectorized memequal does the bulk of the work and the
+// scalar per-pixel refinement only runs inside one boundary block per side.
+const dirtyBlockPx = 16
+
 // findChangedRect computes the bounding rectangle of pixels that differ
 // between prev and curr. Both images must have the same dimensions.
-// Returns an empty rectangle if all pixels are identical.
+// Returns an empty rectangle if all pixels are identical, which doubles as
+// the static-frame early-out (the first row scan bails at the first
+// difference, so an identical canvas costs one pass of row compares).
 //
 // Uses bytes.Equal per row for SIMD-accelerated skip of identical rows,
-// then narrows X boundaries progressively within changed rows.
+// then narrows X boundaries in dirtyBlockPx-wide blocks within changed
+// rows, refining to the exact pixel only inside the boundary blocks. The
+// result is the exact per-pixel bounding box — never wider than any
+// block-merged approximation.
 func findChangedRect(prev, curr *image.NRGBA) image.Rectangle {
 	w := prev.Bounds().Dx()
 	h := prev.Bounds().Dy()
@@ -1053,8 +1246,22 @@ func findChangedRect(prev, curr *image.NRGBA) image.Rectangle {
 	maxX := 0
 	for y := minY; y < maxY; y++ {
 		rowOff := y * stride
-		// Scan left, only up to current minX.
-		for x := 0; x < minX; x++ {
+
+		// Scan left: skip equal blocks, then refine within the first
+		// unequal block, only up to current minX.
+		x := 0
+		for x+dirtyBlockPx <= minX {
+			off := rowOff + x*4
+			if !bytes.Equal(prev.Pix[off:off+dirtyBlockPx*4], curr.Pix[off:off+dirtyBlockPx*4]) {
+				break
+			}
+			x += dirtyBlockPx
+		}
+		limit := x + dirtyBlockPx
+		if limit > minX {
+			limit = minX
+		}
+		for ; x < limit; x++ {
 			off := rowOff + x*4
 			if prev.Pix[off] != curr.Pix[off] ||
 				prev.Pix[off+1] != curr.Pix[off+1] ||
@@ -1064,8 +1271,22 @@ func findChangedRect(prev, curr *image.NRGBA) image.Rectangle {
 				break
 			}
 		}
-		// Scan right, only beyond current maxX.
-		for x := w - 1; x >= maxX; x-- {
+
+		// Scan right: same block skip inward from the right edge, only
+		// beyond current maxX.
+		xe := w
+		for xe-dirtyBlockPx >= maxX {
+			off := rowOff + (xe-dirtyBlockPx)*4
+			if !bytes.Equal(prev.Pix[off:off+dirtyBlockPx*4], curr.Pix[off:off+dirtyBlockPx*4]) {
+				break
+			}
+			xe -= dirtyBlockPx
+		}
+		lo := xe - dirtyBlockPx
+		if lo < maxX {
+			lo = maxX
+		}
+		for x := xe - 1; x >= lo; x-- {
 			off := rowOff + x*4
 			if prev.Pix[off] != curr.Pix[off] ||
 				prev.Pix[off+1] != curr.Pix[off+1] ||
@@ -1075,6 +1296,7 @@ func findChangedRect(prev, curr *image.NRGBA) image.Rectangle {
 				break
 			}
 		}
+
 		// Early exit: we've found the widest possible range.
 		if minX == 0 && maxX == w {
 			break
@@ -1288,11 +1510,24 @@ func applyDispose(canvas *image.NRGBA, f *Frame) {
 }
 
 // fillRect fills a rectangle on the canvas with a solid color.
+// The first row is written once and replicated to the remaining rows with
+// copy, so dispose-to-background runs at memmove speed.
 func fillRect(canvas *image.NRGBA, rect image.Rectangle, c color.NRGBA) {
 	rect = rect.Intersect(canvas.Bounds())
-	for y := rect.Min.Y; y < rect.Max.Y; y++ {
-		for x := rect.Min.X; x < rect.Max.X; x++ {
-			canvas.SetNRGBA(x, y, c)
-		}
+	if rect.Empty() {
+		return
+	}
+	rowLen := rect.Dx() * 4
+	first := canvas.PixOffset(rect.Min.X, rect.Min.Y)
+	firstRow := canvas.Pix[first : first+rowLen]
+	for i := 0; i < rowLen; i += 4 {
+		firstRow[i] = c.R
+		firstRow[i+1] = c.G
+		firstRow[i+2] = c.B
+		firstRow[i+3] = c.A
+	}
+	for y := rect.Min.Y + 1; y < rect.Max.Y; y++ {
+		o := canvas.PixOffset(rect.Min.X, y)
+		copy(canvas.Pix[o:o+rowLen], firstRow)
 	}
 }
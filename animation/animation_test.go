@@ -6,6 +6,9 @@ import (
 	"errors"
 	"image"
 	"image/color"
+	"math/rand"
+	"runtime"
+	"sync"
 	"testing"
 	"time"
 
@@ -1128,6 +1131,61 @@ func TestFindChangedRect_Region(t *testing.T) {
 	}
 }
 
+func TestFindChangedRect_DistantRegions(t *testing.T) {
+	// Two small regions far apart (cursor + clock): the rect must be the
+	// exact bounding box of both.
+	red := color.NRGBA{R: 255, A: 255}
+	blue := color.NRGBA{B: 255, A: 255}
+	a := solidNRGBA(200, 120, red)
+	b := solidNRGBA(200, 120, red)
+	b.SetNRGBA(7, 9, blue)
+	b.SetNRGBA(181, 101, blue)
+	r := findChangedRect(a, b)
+	want := image.Rect(7, 9, 182, 102)
+	if r != want {
+		t.Errorf("findChangedRect distant regions = %v, want %v", r, want)
+	}
+}
+
+func TestFindChangedRect_MatchesBruteForce(t *testing.T) {
+	// Cross-check the block-narrowing fast path against a per-pixel
+	// reference across widths that straddle the 16-pixel block size.
+	bruteForce := func(a, b *image.NRGBA) image.Rectangle {
+		w, h := a.Rect.Dx(), a.Rect.Dy()
+		rect := image.Rectangle{}
+		for y := 0; y < h; y++ {
+			for x := 0; x < w; x++ {
+				if a.NRGBAAt(x, y) != b.NRGBAAt(x, y) {
+					px := image.Rect(x, y, x+1, y+1)
+					if rect.Empty() {
+						rect = px
+					} else {
+						rect = rect.Union(px)
+					}
+				}
+			}
+		}
+		return rect
+	}
+
+	rng := rand.New(rand.NewSource(33))
+	for _, w := range []int{5, 16, 17, 31, 32, 100} {
+		h := 24
+		for trial := 0; trial < 20; trial++ {
+			a := solidNRGBA(w, h, color.NRGBA{R: 200, A: 255})
+			b := solidNRGBA(w, h, color.NRGBA{R: 200, A: 255})
+			for n := rng.Intn(5); n >= 0; n-- {
+				b.SetNRGBA(rng.Intn(w), rng.Intn(h), color.NRGBA{G: uint8(1 + rng.Intn(255)), A: 255})
+			}
+			got := findChangedRect(a, b)
+			want := bruteForce(a, b)
+			if got != want {
+				t.Fatalf("w=%d trial=%d: findChangedRect = %v, brute force = %v", w, trial, got, want)
+			}
+		}
+	}
+}
+
 func TestSnapToEven(t *testing.T) {
 	tests := []struct {
 		name string
@@ -1187,16 +1245,124 @@ func TestCloneNRGBA(t *testing.T) {
 	}
 }
 
+// compositeOntoReference is the per-pixel blend loop compositeOnto used
+// before row kernels and band parallelism; tests check parity against it.
+func compositeOntoReference(canvas *image.NRGBA, f *Frame, src *image.NRGBA) {
+	rect := f.Bounds().Intersect(canvas.Bounds())
+	srcBounds := src.Bounds()
+	for y := rect.Min.Y; y < rect.Max.Y; y++ {
+		sy := y - f.OffsetY
+		if sy < 0 || sy >= srcBounds.Dy() {
+			continue
+		}
+		for x := rect.Min.X; x < rect.Max.X; x++ {
+			sx := x - f.OffsetX
+			if sx < 0 || sx >= srcBounds.Dx() {
+				continue
+			}
+			srcPx := src.NRGBAAt(sx, sy)
+			if f.Blend == BlendNone {
+				canvas.SetNRGBA(x, y, srcPx)
+			} else {
+				canvas.SetNRGBA(x, y, alphaBlendNRGBA(srcPx, canvas.NRGBAAt(x, y)))
+			}
+		}
+	}
+}
+
+// patternNRGBA fills an image with a deterministic mix of opaque,
+// transparent, and partially transparent pixels.
+func patternNRGBA(w, h int, seed uint32) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	s := seed
+	for i := 0; i < len(img.Pix); i++ {
+		s = s*1664525 + 1013904223
+		img.Pix[i] = byte(s >> 24)
+	}
+	// Carve alpha into runs of extreme and arbitrary values.
+	for i := 3; i < len(img.Pix); i += 4 {
+		switch (i / 64) % 3 {
+		case 0:
+			img.Pix[i] = 255
+		case 1:
+			img.Pix[i] = 0
+		}
+	}
+	return img
+}
+
+func TestCompositeOntoParity(t *testing.T) {
+	// The row-kernel + parallel-band compositing must match the per-pixel
+	// reference. 512x512 exceeds minPixelsForParallelComposite, so the band
+	// path is exercised when GOMAXPROCS > 1.
+	prev := runtime.GOMAXPROCS(4)
+	defer runtime.GOMAXPROCS(prev)
+
+	for _, blend := range []BlendMethod{BlendAlpha, BlendNone} {
+		canvas := patternNRGBA(512, 512, 1)
+		want := cloneNRGBA(canvas)
+
+		src := patternNRGBA(500, 300, 2)
+		f := &Frame{OffsetX: 6, OffsetY: 100, Blend: blend, Width: 500, Height: 300}
+
+		compositeOnto(canvas, f, src)
+		compositeOntoReference(want, f, src)
+
+		if !bytes.Equal(canvas.Pix, want.Pix) {
+			t.Errorf("blend=%d: composited canvas differs from reference", blend)
+		}
+	}
+}
+
+func TestCompositeOntoClampsToSource(t *testing.T) {
+	// A frame whose container-reported rectangle is larger than the decoded
+	// pixels must only touch the pixels that exist.
+	canvas := solidNRGBA(16, 16, color.NRGBA{R: 255, A: 255})
+	want := cloneNRGBA(canvas)
+
+	src := solidNRGBA(4, 4, color.NRGBA{B: 255, A: 255})
+	f := &Frame{OffsetX: 2, OffsetY: 2, Blend: BlendNone, Width: 10, Height: 10}
+
+	compositeOnto(canvas, f, src)
+	compositeOntoReference(want, f, src)
+
+	if !bytes.Equal(canvas.Pix, want.Pix) {
+		t.Error("clamped composite differs from reference")
+	}
+}
+
+func TestFillRectRowFill(t *testing.T) {
+	c := color.NRGBA{R: 10, G: 20, B: 30, A: 40}
+	canvas := patternNRGBA(33, 17, 3)
+	want := cloneNRGBA(canvas)
+
+	rect := image.Rect(3, 2, 30, 15)
+	fillRect(canvas, rect, c)
+	for y := rect.Min.Y; y < rect.Max.Y; y++ {
+		for x := rect.Min.X; x < rect.Max.X; x++ {
+			want.SetNRGBA(x, y, c)
+		}
+	}
+	if !bytes.Equal(canvas.Pix, want.Pix) {
+		t.Error("fillRect differs from per-pixel fill")
+	}
+}
+
 // --- Optimized encoder tests with mock FrameEncoderFunc ---
 
 // mockFrameEncoder tracks calls to FrameEncoderFunc, recording sub-image sizes.
+// The mutex is required because the encoder invokes FrameEncoderFunc from
+// multiple goroutines when encoding dispose-method candidates in parallel.
 type mockFrameEncoder struct {
+	mu    sync.Mutex
 	calls []image.Rectangle // Bounds of each sub-image encoded.
 }
 
 func (m *mockFrameEncoder) encode(img image.Image, lossless bool, quality int) ([]byte, error) {
 	b := img.Bounds()
+	m.mu.Lock()
 	m.calls = append(m.calls, b)
+	m.mu.Unlock()
 	// Return a valid VP8 keyframe header for the sub-image dimensions.
 	return makeVP8Keyframe(b.Dx(), b.Dy()), nil
 }
@@ -1247,8 +1413,15 @@ func TestOptimizedEncoder_SubFrameDetection(t *testing.T) {
 		t.Errorf("frame 0 encoded as %dx%d, want 100x100", f0.Dx(), f0.Dy())
 	}
 
-	// Frame 1 should be significantly smaller than full canvas.
+	// Frame 1's dispose candidates may be encoded in either order (they run
+	// concurrently), so check that the smallest sub-image encoded for frame 1
+	// matches the changed patch rather than relying on call order.
 	f1 := mock.calls[1]
+	for _, c := range mock.calls[2:] {
+		if c.Dx()*c.Dy() < f1.Dx()*f1.Dy() {
+			f1 = c
+		}
+	}
 	if f1.Dx() > 20 || f1.Dy() > 20 {
 		t.Errorf("frame 1 encoded as %dx%d, expected sub-frame <=20x20", f1.Dx(), f1.Dy())
 	}
@@ -1551,6 +1724,7 @@ func splitAlphAndBitstream(data []byte) ([]byte, []byte) {
 // sub-image area, allowing the test to verify that the encoder picks the
 // smaller candidate. The returned bitstream is a valid VP8 keyframe header.
 type sizeAwareMockEncoder struct {
+	mu    sync.Mutex
 	calls []struct {
 		bounds image.Rectangle
 	}
@@ -1558,7 +1732,9 @@ type sizeAwareMockEncoder struct {
 
 func (m *sizeAwareMockEncoder) encode(img image.Image, lossless bool, quality int) ([]byte, error) {
 	b := img.Bounds()
+	m.mu.Lock()
 	m.calls = append(m.calls, struct{ bounds image.Rectangle }{b})
+	m.mu.Unlock()
 	// Return a VP8 keyframe header padded to be proportional to the pixel area.
 	// The minimum is the 10-byte header; we add area/10 bytes of padding.
 	hdr := makeVP8Keyframe(b.Dx(), b.Dy())
@@ -1732,6 +1908,76 @@ func TestOptimizedEncoder_DisposeBGThreeFrames(t *testing.T) {
 	}
 }
 
+func TestOptimizedEncoder_ParallelCandidatesMatchSerial(t *testing.T) {
+	// The dispose-method candidates (and, with AllowMixed, the lossy/lossless
+	// pair) are encoded on separate goroutines when GOMAXPROCS > 1. Candidate
+	// selection must not depend on that scheduling: with a deterministic
+	// encoder function the emitted file must be byte-identical at any
+	// GOMAXPROCS setting.
+	oldFunc := FrameEncoderFunc
+	defer func() { FrameEncoderFunc = oldFunc }()
+
+	FrameEncoderFunc = func(img image.Image, lossless bool, quality int) ([]byte, error) {
+		b := img.Bounds()
+		hdr := makeVP8Keyframe(b.Dx(), b.Dy())
+		// Size proportional to area so candidate selection is exercised;
+		// lossy slightly larger so the AllowMixed alternate codec wins.
+		padding := (b.Dx() * b.Dy()) / 10
+		if !lossless {
+			padding += 4
+		}
+		result := make([]byte, len(hdr)+padding)
+		copy(result, hdr)
+		return result, nil
+	}
+
+	red := color.NRGBA{R: 255, A: 255}
+	blue := color.NRGBA{B: 255, A: 255}
+	transparent := color.NRGBA{}
+
+	encodeAll := func() []byte {
+		var buf bytes.Buffer
+		enc := NewEncoder(&buf, 100, 100, &EncodeOptions{Quality: 75, AllowMixed: true})
+
+		// Frame 0: full red keyframe.
+		enc.AddFrame(solidNRGBA(100, 100, red), 50*time.Millisecond)
+
+		// Frame 1: small patch change -- DISPOSE_NONE should win.
+		frame1 := solidNRGBA(100, 100, red)
+		for y := 50; y < 60; y++ {
+			for x := 50; x < 60; x++ {
+				frame1.SetNRGBA(x, y, blue)
+			}
+		}
+		enc.AddFrame(frame1, 50*time.Millisecond)
+
+		// Frame 2: mostly transparent -- DISPOSE_BACKGROUND should win.
+		frame2 := solidNRGBA(100, 100, transparent)
+		for y := 0; y < 10; y++ {
+			for x := 0; x < 10; x++ {
+				frame2.SetNRGBA(x, y, blue)
+			}
+		}
+		enc.AddFrame(frame2, 50*time.Millisecond)
+
+		if err := enc.Close(); err != nil {
+			t.Fatalf("Close: %v", err)
+		}
+		return buf.Bytes()
+	}
+
+	prev := runtime.GOMAXPROCS(1)
+	serial := encodeAll()
+	runtime.GOMAXPROCS(4)
+	parallel := encodeAll()
+	runtime.GOMAXPROCS(prev)
+
+	if !bytes.Equal(serial, parallel) {
+		t.Errorf("parallel output differs from serial: %d vs %d bytes",
+			len(parallel), len(serial))
+	}
+}
+
 func TestSanitizeKeyframeOptions(t *testing.T) {
 	tests := []struct {
 		name     string
@@ -2065,25 +2311,56 @@ func (m *mixedMockEncoder) encode(img image.Image, lossless bool, quality int) (
 	return padded, nil
 }
 
+// multiColorNRGBA returns an opaque image cycling through the given number
+// of distinct colors, for steering classifyFrameCodec.
+func multiColorNRGBA(w, h, colors int) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			idx := (y*w + x) % colors
+			img.SetNRGBA(x, y, color.NRGBA{R: uint8(idx), G: uint8(idx >> 8), B: 100, A: 255})
+		}
+	}
+	return img
+}
+
+func TestClassifyFrameCodec(t *testing.T) {
+	// Few distinct colors: palette mode, lossless wins.
+	if got := classifyFrameCodec(solidNRGBA(10, 10, color.NRGBA{R: 255, A: 255})); got != predictLossless {
+		t.Errorf("solid frame classified %d, want predictLossless", got)
+	}
+	// Between the palette limit and the photographic cap: ambiguous.
+	if got := classifyFrameCodec(multiColorNRGBA(30, 30, 500)); got != predictAmbiguous {
+		t.Errorf("500-color frame classified %d, want predictAmbiguous", got)
+	}
+	// High color diversity: photographic, lossy wins.
+	if got := classifyFrameCodec(multiColorNRGBA(64, 64, 2000)); got != predictLossy {
+		t.Errorf("2000-color frame classified %d, want predictLossy", got)
+	}
+	// Non-NRGBA inputs cannot be classified cheaply.
+	if got := classifyFrameCodec(image.NewRGBA(image.Rect(0, 0, 8, 8))); got != predictAmbiguous {
+		t.Errorf("RGBA frame classified %d, want predictAmbiguous", got)
+	}
+}
+
 func TestAllowMixed_PicksSmallerCodec(t *testing.T) {
 	oldFunc := FrameEncoderFunc
 	defer func() { FrameEncoderFunc = oldFunc }()
 
-	// Lossy produces 100 bytes, lossless produces 50 bytes.
-	// With AllowMixed=true and Lossless=false (primary is lossy),
-	// the encoder should try both and pick the smaller (lossless) result.
+	// Lossy produces 100 bytes, lossless produces 50 bytes. The frame's
+	// color count sits in the ambiguous band, so with AllowMixed=true the
+	// encoder must try both codecs and pick the smaller (lossless) result.
 	mock := &mixedMockEncoder{lossySize: 100, losslessSize: 50}
 	FrameEncoderFunc = mock.encode
 
-	red := color.NRGBA{R: 255, A: 255}
 	var buf bytes.Buffer
-	enc := NewEncoder(&buf, 10, 10, &EncodeOptions{
+	enc := NewEncoder(&buf, 30, 30, &EncodeOptions{
 		Quality:    75,
 		Lossless:   false,
 		AllowMixed: true,
 	})
 
-	frame := solidNRGBA(10, 10, red)
+	frame := multiColorNRGBA(30, 30, 500)
 	if err := enc.AddFrame(frame, 50*time.Millisecond); err != nil {
 		t.Fatalf("AddFrame: %v", err)
 	}
@@ -2091,7 +2368,7 @@ func TestAllowMixed_PicksSmallerCodec(t *testing.T) {
 		t.Fatalf("Close: %v", err)
 	}
 
-	// With AllowMixed, the encoder should call FrameEncoderFunc twice per encode
+	// An ambiguous frame should call FrameEncoderFunc twice per encode
 	// operation: once with the primary codec and once with the alternate.
 	if len(mock.calls) < 2 {
 		t.Fatalf("expected at least 2 encoder calls (both codecs), got %d", len(mock.calls))
@@ -2112,6 +2389,48 @@ func TestAllowMixed_PicksSmallerCodec(t *testing.T) {
 	}
 }
 
+func TestAllowMixed_PredictedCodecSkipsDualEncode(t *testing.T) {
+	oldFunc := FrameEncoderFunc
+	defer func() { FrameEncoderFunc = oldFunc }()
+
+	// Make lossless the LARGER result: if the palette prediction is
+	// trusted, the solid frame is still encoded lossless — and only once,
+	// proving no dual encode ran.
+	mock := &mixedMockEncoder{lossySize: 50, losslessSize: 100}
+	FrameEncoderFunc = mock.encode
+
+	var buf bytes.Buffer
+	enc := NewEncoder(&buf, 10, 10, &EncodeOptions{Quality: 75, AllowMixed: true})
+	if err := enc.AddFrame(solidNRGBA(10, 10, color.NRGBA{R: 255, A: 255}), 50*time.Millisecond); err != nil {
+		t.Fatalf("AddFrame: %v", err)
+	}
+	if err := enc.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	for _, c := range mock.calls {
+		if !c.lossless {
+			t.Error("palette frame triggered a lossy encode; prediction should skip it")
+		}
+	}
+
+	// A high-diversity frame must conversely use only the lossy codec.
+	mock2 := &mixedMockEncoder{lossySize: 100, losslessSize: 50}
+	FrameEncoderFunc = mock2.encode
+	buf.Reset()
+	enc = NewEncoder(&buf, 64, 64, &EncodeOptions{Quality: 75, AllowMixed: true})
+	if err := enc.AddFrame(multiColorNRGBA(64, 64, 2000), 50*time.Millisecond); err != nil {
+		t.Fatalf("AddFrame: %v", err)
+	}
+	if err := enc.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	for _, c := range mock2.calls {
+		if c.lossless {
+			t.Error("photographic frame triggered a lossless encode; prediction should skip it")
+		}
+	}
+}
+
 func TestAllowMixed_DisabledUsesSingleCodec(t *testing.T) {
 	oldFunc := FrameEncoderFunc
 	defer func() { FrameEncoderFunc = oldFunc }()
@@ -2152,26 +2471,29 @@ func TestAllowMixed_SubFrameTriesBothCodecs(t *testing.T) {
 	FrameEncoderFunc = mock.encode
 
 	red := color.NRGBA{R: 255, A: 255}
-	blue := color.NRGBA{B: 255, A: 255}
 
 	var buf bytes.Buffer
-	enc := NewEncoder(&buf, 20, 20, &EncodeOptions{
+	enc := NewEncoder(&buf, 40, 40, &EncodeOptions{
 		Quality:    75,
 		Lossless:   false,
 		AllowMixed: true,
 	})
 
 	// Frame 0: full red canvas (keyframe).
-	frame0 := solidNRGBA(20, 20, red)
+	frame0 := solidNRGBA(40, 40, red)
 	if err := enc.AddFrame(frame0, 50*time.Millisecond); err != nil {
 		t.Fatalf("AddFrame 0: %v", err)
 	}
 
-	// Frame 1: red with a small blue patch (triggers sub-frame encoding).
-	frame1 := solidNRGBA(20, 20, red)
-	for y := 5; y < 15; y++ {
-		for x := 5; x < 15; x++ {
-			frame1.SetNRGBA(x, y, blue)
+	// Frame 1: red with a 20x20 patch whose color count sits in the
+	// ambiguous classifier band, so sub-frame encoding must try both
+	// codecs rather than trusting a prediction.
+	frame1 := solidNRGBA(40, 40, red)
+	idx := 0
+	for y := 10; y < 30; y++ {
+		for x := 10; x < 30; x++ {
+			frame1.SetNRGBA(x, y, color.NRGBA{R: uint8(idx), G: uint8(idx >> 8), B: 100, A: 255})
+			idx++
 		}
 	}
 	mock.calls = nil // Reset to track sub-frame calls.
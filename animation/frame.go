@@ -70,11 +70,19 @@ type Frame struct {
 
 	// AlphaData holds the raw ALPH chunk data, if separate from the bitstream.
 	AlphaData []byte
+
+	// Width and Height are the frame dimensions as reported by the container
+	// (ANMF chunk / bitstream header). They are available before the frame's
+	// pixel data has been decoded, which lets streaming decoders perform
+	// keyframe detection and canvas layout without decoding every frame.
+	Width  int
+	Height int
 }
 
-// Bounds returns the frame's rectangle on the canvas.
+// Bounds returns the frame's rectangle on the canvas. When the frame has not
+// been decoded yet, the container-reported Width/Height are used.
 func (f *Frame) Bounds() image.Rectangle {
-	var w, h int
+	w, h := f.Width, f.Height
 	if f.Image != nil {
 		b := f.Image.Bounds()
 		w = b.Dx()
@@ -0,0 +1,365 @@
+package animation
+
+import (
+	"fmt"
+	"image"
+	"time"
+)
+
+// StreamOptions configures a StreamDecoder.
+type StreamOptions struct {
+	// KeyframeCacheSize is the maximum number of composited keyframe
+	// canvases retained for fast backward seeking. Each cached canvas costs
+	// width*height*4 bytes. 0 disables the cache; seeks then always decode
+	// forward from the nearest keyframe.
+	KeyframeCacheSize int
+}
+
+// StreamDecoder decodes an animation frame-by-frame with bounded memory.
+//
+// Unlike AnimDecoder, which requires every frame to be pre-decoded (via
+// DecodeFrames) and therefore holds all frames as full NRGBA images at once,
+// StreamDecoder decodes each frame's bitstream on demand using
+// FrameDecoderFunc and discards the decoded pixels after compositing. At any
+// point it holds only the two canvas buffers plus the optional keyframe
+// cache, regardless of the number of frames.
+//
+// A keyframe index is built at construction time using the same keyframe
+// detection as AnimDecoder, so SeekToFrame only re-decodes frames from the
+// nearest preceding keyframe rather than from the start of the animation.
+type StreamDecoder struct {
+	anim              *Animation
+	currFrame         *image.NRGBA
+	prevFrameDisposed *image.NRGBA
+	pos               int
+
+	// isKey[i] reports whether frame i is a keyframe. Precomputed from
+	// container metadata (frame rectangles and alpha flags) in one pass at
+	// construction, so no pixel data is needed.
+	isKey []bool
+	// keyframes holds the indices i with isKey[i] == true, in order.
+	keyframes []int
+
+	// LRU cache of composited keyframe canvases: canvas state immediately
+	// after rendering the keyframe (before its dispose method is applied).
+	cacheSize int
+	cache     map[int]*image.NRGBA
+	cacheLRU  []int // keyframe indices, least recently used first
+
+	// pendingRaw is the YCbCr frame most recently handed out by NextFrameRaw
+	// without conversion. While set, the canvas buffers are stale;
+	// materializeCanvas converts it on demand when a later frame needs the
+	// canvas as compositing context.
+	pendingRaw      *image.YCbCr
+	pendingRawFrame int
+}
+
+// NewStreamDecoder creates a StreamDecoder from a parsed Animation.
+// The animation's frames do not need to be decoded; BitstreamData is
+// decoded lazily as frames are requested. opts may be nil for defaults
+// (no keyframe cache).
+func NewStreamDecoder(anim *Animation, opts *StreamOptions) (*StreamDecoder, error) {
+	if anim.CanvasWidth <= 0 || anim.CanvasHeight <= 0 {
+		return nil, fmt.Errorf("animation: invalid canvas %dx%d", anim.CanvasWidth, anim.CanvasHeight)
+	}
+	area := uint64(anim.CanvasWidth) * uint64(anim.CanvasHeight)
+	if area > maxCanvasArea {
+		return nil, fmt.Errorf("animation: canvas too large (%dx%d = %d pixels, max %d)", anim.CanvasWidth, anim.CanvasHeight, area, maxCanvasArea)
+	}
+	bounds := image.Rect(0, 0, anim.CanvasWidth, anim.CanvasHeight)
+	d := &StreamDecoder{
+		anim:              anim,
+		currFrame:         image.NewNRGBA(bounds),
+		prevFrameDisposed: image.NewNRGBA(bounds),
+	}
+	if opts != nil && opts.KeyframeCacheSize > 0 {
+		d.cacheSize = opts.KeyframeCacheSize
+		d.cache = make(map[int]*image.NRGBA, d.cacheSize)
+	}
+	d.buildKeyframeIndex()
+	return d, nil
+}
+
+// buildKeyframeIndex precomputes the keyframe flag for every frame in a
+// single metadata pass, threading the same previous-frame state that
+// AnimDecoder tracks during sequential playback.
+func (d *StreamDecoder) buildKeyframeIndex() {
+	n := len(d.anim.Frames)
+	d.isKey = make([]bool, n)
+	prevWasKeyframe := false
+	prevDispose := DisposeNone
+	prevBounds := image.Rectangle{}
+	for i := 0; i < n; i++ {
+		key := isKeyFrameAt(d.anim, i, prevWasKeyframe, prevDispose, prevBounds)
+		d.isKey[i] = key
+		if key {
+			d.keyframes = append(d.keyframes, i)
+		}
+		f := &d.anim.Frames[i]
+		prevWasKeyframe = key
+		prevDispose = f.Dispose
+		prevBounds = f.Bounds()
+	}
+}
+
+// NumFrames returns the total number of frames in the animation.
+func (d *StreamDecoder) NumFrames() int {
+	return len(d.anim.Frames)
+}
+
+// Position returns the index of the frame the next NextFrame call will return.
+func (d *StreamDecoder) Position() int {
+	return d.pos
+}
+
+// KeyframeIndex returns the indices of all keyframes, in order.
+// The returned slice must not be modified.
+func (d *StreamDecoder) KeyframeIndex() []int {
+	return d.keyframes
+}
+
+// HasNext reports whether more frames are available.
+func (d *StreamDecoder) HasNext() bool {
+	return d.pos < len(d.anim.Frames)
+}
+
+// NextFrame decodes and applies the next frame to the canvas and returns a
+// snapshot. The caller receives a copy; subsequent calls do not mutate it.
+func (d *StreamDecoder) NextFrame() (*image.NRGBA, time.Duration, error) {
+	if !d.HasNext() {
+		return nil, 0, ErrNoFrames
+	}
+	f := &d.anim.Frames[d.pos]
+	if err := d.step(); err != nil {
+		return nil, 0, err
+	}
+	snap := cloneNRGBA(d.currFrame)
+	return snap, f.Duration, nil
+}
+
+// NextFrameRaw is like NextFrame but returns opaque full-canvas lossy frames
+// as *image.YCbCr in the codec's native 4:2:0 format, skipping the NRGBA
+// conversion entirely. For animations made of full-canvas opaque frames (the
+// common case for transcoded video) no colour-space conversion happens at
+// all; the canvas is materialized lazily only if a later frame needs it as
+// compositing context. Frames that require compositing are returned as
+// *image.NRGBA canvas snapshots, exactly as NextFrame would.
+//
+// Requires FrameDecoderRawFunc; when it is unset, NextFrameRaw behaves like
+// NextFrame.
+func (d *StreamDecoder) NextFrameRaw() (image.Image, time.Duration, error) {
+	if !d.HasNext() {
+		return nil, 0, ErrNoFrames
+	}
+	f := &d.anim.Frames[d.pos]
+	if d.rawEligible(d.pos) {
+		img, err := FrameDecoderRawFunc(f.BitstreamData, f.AlphaData)
+		if err != nil {
+			return nil, 0, fmt.Errorf("animation: decoding frame %d: %w", d.pos, err)
+		}
+		if ycbcr, ok := img.(*image.YCbCr); ok {
+			d.pendingRaw = ycbcr
+			d.pendingRawFrame = d.pos
+			d.pos++
+			return ycbcr, f.Duration, nil
+		}
+		// The codec produced NRGBA (e.g. the frame has alpha after all);
+		// composite it normally without decoding a second time.
+		d.applyFrame(toNRGBA(img))
+		return cloneNRGBA(d.currFrame), f.Duration, nil
+	}
+	if err := d.step(); err != nil {
+		return nil, 0, err
+	}
+	return cloneNRGBA(d.currFrame), f.Duration, nil
+}
+
+// rawEligible reports whether frame idx can be handed out in the codec's
+// native format: it must be an undecoded full-canvas keyframe, so the frame
+// pixels alone define the whole canvas and no blending context is needed.
+func (d *StreamDecoder) rawEligible(idx int) bool {
+	if FrameDecoderRawFunc == nil {
+		return false
+	}
+	f := &d.anim.Frames[idx]
+	return f.Image == nil && f.BitstreamData != nil && d.isKey[idx] &&
+		f.OffsetX == 0 && f.OffsetY == 0 &&
+		frameWidth(f) == d.anim.CanvasWidth && frameHeight(f) == d.anim.CanvasHeight
+}
+
+// materializeCanvas converts the pending raw frame to NRGBA and rebuilds the
+// canvas buffers from it. The pending frame is always a full-canvas keyframe,
+// so the canvas state after it is fully determined by its pixels.
+func (d *StreamDecoder) materializeCanvas() {
+	if d.pendingRaw == nil {
+		return
+	}
+	var src *image.NRGBA
+	if YCbCrToNRGBAFunc != nil {
+		src = YCbCrToNRGBAFunc(d.pendingRaw)
+	} else {
+		src = toNRGBA(d.pendingRaw)
+	}
+	f := &d.anim.Frames[d.pendingRawFrame]
+	clearCanvas(d.currFrame)
+	compositeOnto(d.currFrame, f, src)
+	copy(d.prevFrameDisposed.Pix, d.currFrame.Pix)
+	applyDispose(d.prevFrameDisposed, f)
+	d.pendingRaw = nil
+}
+
+// SeekToFrame positions the decoder so that the next NextFrame call returns
+// frame n. Frames between the nearest preceding keyframe and n are decoded
+// and composited without producing snapshots; if the keyframe's composited
+// canvas is in the cache, decoding starts after the keyframe instead.
+func (d *StreamDecoder) SeekToFrame(n int) error {
+	if n < 0 || n >= len(d.anim.Frames) {
+		return fmt.Errorf("animation: seek to frame %d out of range [0,%d)", n, len(d.anim.Frames))
+	}
+	// Already positioned at n with valid canvas state.
+	if d.pos == n {
+		return nil
+	}
+
+	// Nearest keyframe at or before n.
+	key := 0
+	for _, k := range d.keyframes {
+		if k > n {
+			break
+		}
+		key = k
+	}
+
+	// Forward seek within the current keyframe interval: keep the canvas
+	// and just decode forward.
+	if d.pos <= n && d.pos > key {
+		return d.advanceTo(n)
+	}
+
+	// Restore from the keyframe cache when possible: the cached canvas is
+	// the state right after the keyframe rendered, so resume at key+1.
+	if cached, ok := d.cacheGet(key); ok && key < n {
+		d.pendingRaw = nil
+		copy(d.currFrame.Pix, cached.Pix)
+		copy(d.prevFrameDisposed.Pix, cached.Pix)
+		applyDispose(d.prevFrameDisposed, &d.anim.Frames[key])
+		d.pos = key + 1
+		return d.advanceTo(n)
+	}
+
+	// Decode forward from the keyframe itself. The keyframe starts from a
+	// cleared canvas, so no earlier state is needed.
+	d.pendingRaw = nil
+	clearCanvas(d.currFrame)
+	clearCanvas(d.prevFrameDisposed)
+	d.pos = key
+	return d.advanceTo(n)
+}
+
+// Reset rewinds the decoder to the first frame and clears the canvas.
+// The keyframe cache is retained.
+func (d *StreamDecoder) Reset() {
+	d.pos = 0
+	d.pendingRaw = nil
+	clearCanvas(d.currFrame)
+	clearCanvas(d.prevFrameDisposed)
+}
+
+// advanceTo composites frames until the decoder is positioned at frame n.
+func (d *StreamDecoder) advanceTo(n int) error {
+	for d.pos < n {
+		if err := d.step(); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// step decodes frame d.pos, composites it onto the canvas, updates the
+// dispose buffer and advances the position. The decoded pixels are not
+// retained on the Frame.
+func (d *StreamDecoder) step() error {
+	f := &d.anim.Frames[d.pos]
+
+	var src *image.NRGBA
+	if f.Image != nil {
+		src = toNRGBA(f.Image)
+	} else {
+		if f.BitstreamData == nil {
+			return ErrNilImage
+		}
+		if FrameDecoderFunc == nil {
+			return ErrNoDecoder
+		}
+		img, err := FrameDecoderFunc(f.BitstreamData, f.AlphaData)
+		if err != nil {
+			return fmt.Errorf("animation: decoding frame %d: %w", d.pos, err)
+		}
+		src = img
+	}
+
+	d.applyFrame(src)
+	return nil
+}
+
+// applyFrame composites the decoded pixels of frame d.pos onto the canvas,
+// updates the dispose buffer and advances the position.
+func (d *StreamDecoder) applyFrame(src *image.NRGBA) {
+	f := &d.anim.Frames[d.pos]
+
+	if d.isKey[d.pos] {
+		// A keyframe replaces the canvas, so any raw frame handed out
+		// earlier no longer matters as context.
+		d.pendingRaw = nil
+		clearCanvas(d.currFrame)
+	} else {
+		d.materializeCanvas()
+		copy(d.currFrame.Pix, d.prevFrameDisposed.Pix)
+	}
+	compositeOnto(d.currFrame, f, src)
+
+	if d.isKey[d.pos] {
+		d.cachePut(d.pos, d.currFrame)
+	}
+
+	copy(d.prevFrameDisposed.Pix, d.currFrame.Pix)
+	applyDispose(d.prevFrameDisposed, f)
+
+	d.pos++
+}
+
+// cacheGet looks up the composited canvas for keyframe idx, marking it
+// most recently used.
+func (d *StreamDecoder) cacheGet(idx int) (*image.NRGBA, bool) {
+	canvas, ok := d.cache[idx]
+	if !ok {
+		return nil, false
+	}
+	for i, k := range d.cacheLRU {
+		if k == idx {
+			d.cacheLRU = append(append(d.cacheLRU[:i], d.cacheLRU[i+1:]...), idx)
+			break
+		}
+	}
+	return canvas, true
+}
+
+// cachePut stores a copy of canvas as the composited state of keyframe idx,
+// evicting the least recently used entry when the cache is full.
+func (d *StreamDecoder) cachePut(idx int, canvas *image.NRGBA) {
+	if d.cacheSize <= 0 {
+		return
+	}
+	if cached, ok := d.cache[idx]; ok {
+		copy(cached.Pix, canvas.Pix)
+		d.cacheGet(idx) // refresh LRU position
+		return
+	}
+	if len(d.cache) >= d.cacheSize {
+		oldest := d.cacheLRU[0]
+		d.cacheLRU = d.cacheLRU[1:]
+		delete(d.cache, oldest)
+	}
+	d.cache[idx] = cloneNRGBA(canvas)
+	d.cacheLRU = append(d.cacheLRU, idx)
+}
@@ -0,0 +1,421 @@
+package animation
+
+import (
+	"bytes"
+	"image"
+	"image/color"
+	"testing"
+	"time"
+)
+
+// streamTestAnimation builds a multi-keyframe animation exercising sub-frames,
+// alpha blending, and dispose-to-background. Frames have pre-decoded Images so
+// the same animation can be played through both AnimDecoder and StreamDecoder.
+func streamTestAnimation() *Animation {
+	red := color.NRGBA{R: 255, A: 255}
+	green := color.NRGBA{G: 255, A: 255}
+	blue := color.NRGBA{B: 255, A: 255}
+	halfRed := color.NRGBA{R: 255, A: 128}
+
+	return &Animation{
+		CanvasWidth:  8,
+		CanvasHeight: 8,
+		Frames: []Frame{
+			// 0: full-canvas keyframe.
+			{Image: solidNRGBA(8, 8, red), Duration: 50 * time.Millisecond, Blend: BlendNone},
+			// 1: sub-frame patch.
+			{Image: solidNRGBA(2, 2, blue), OffsetX: 2, OffsetY: 2, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			// 2: alpha-blended sub-frame, disposed to background.
+			{Image: solidNRGBA(4, 4, halfRed), OffsetX: 4, OffsetY: 4, Duration: 50 * time.Millisecond, Blend: BlendAlpha, HasAlpha: true, Dispose: DisposeBackground},
+			// 3: full-canvas no-alpha frame -- a keyframe per isKeyFrameAt.
+			{Image: solidNRGBA(8, 8, green), Duration: 50 * time.Millisecond, Blend: BlendNone},
+			// 4: final sub-frame patch.
+			{Image: solidNRGBA(2, 2, red), OffsetX: 6, OffsetY: 0, Duration: 50 * time.Millisecond, Blend: BlendNone},
+		},
+	}
+}
+
+func TestStreamDecoderMatchesAnimDecoder(t *testing.T) {
+	anim := streamTestAnimation()
+
+	ad, err := NewAnimDecoder(anim)
+	if err != nil {
+		t.Fatalf("NewAnimDecoder: %v", err)
+	}
+	sd, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+
+	for i := 0; ad.HasNext(); i++ {
+		want, wantDur, err := ad.NextFrame()
+		if err != nil {
+			t.Fatalf("AnimDecoder.NextFrame %d: %v", i, err)
+		}
+		got, gotDur, err := sd.NextFrame()
+		if err != nil {
+			t.Fatalf("StreamDecoder.NextFrame %d: %v", i, err)
+		}
+		if gotDur != wantDur {
+			t.Errorf("frame %d duration = %v, want %v", i, gotDur, wantDur)
+		}
+		if !bytes.Equal(got.Pix, want.Pix) {
+			t.Errorf("frame %d canvas differs from AnimDecoder", i)
+		}
+	}
+	if sd.HasNext() {
+		t.Error("StreamDecoder has frames left after AnimDecoder finished")
+	}
+}
+
+func TestStreamDecoderKeyframeIndex(t *testing.T) {
+	anim := streamTestAnimation()
+	sd, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+	// Frame 0 is always a keyframe; frame 3 is full-canvas without alpha.
+	want := []int{0, 3}
+	got := sd.KeyframeIndex()
+	if len(got) != len(want) {
+		t.Fatalf("keyframes = %v, want %v", got, want)
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("keyframes = %v, want %v", got, want)
+		}
+	}
+}
+
+// streamLazyAnimation builds an animation whose frames carry only fake
+// bitstream data ([w, h, r, g, b, a]) decoded by a counting stub
+// FrameDecoderFunc, so tests can observe exactly which frames get decoded.
+func streamLazyAnimation() *Animation {
+	bs := func(w, h int, c color.NRGBA) []byte {
+		return []byte{byte(w), byte(h), c.R, c.G, c.B, c.A}
+	}
+	red := color.NRGBA{R: 255, A: 255}
+	green := color.NRGBA{G: 255, A: 255}
+	blue := color.NRGBA{B: 255, A: 255}
+
+	return &Animation{
+		CanvasWidth:  8,
+		CanvasHeight: 8,
+		Frames: []Frame{
+			{BitstreamData: bs(8, 8, red), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			{BitstreamData: bs(2, 2, blue), Width: 2, Height: 2, OffsetX: 2, OffsetY: 2, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			{BitstreamData: bs(2, 2, red), Width: 2, Height: 2, OffsetX: 4, OffsetY: 4, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			{BitstreamData: bs(8, 8, green), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			{BitstreamData: bs(2, 2, blue), Width: 2, Height: 2, OffsetX: 6, OffsetY: 6, Duration: 50 * time.Millisecond, Blend: BlendNone},
+		},
+	}
+}
+
+// installStubFrameDecoder registers a FrameDecoderFunc that decodes the fake
+// bitstream format from streamLazyAnimation and counts invocations.
+func installStubFrameDecoder(t *testing.T, count *int) {
+	t.Helper()
+	oldFunc := FrameDecoderFunc
+	t.Cleanup(func() { FrameDecoderFunc = oldFunc })
+	FrameDecoderFunc = func(bitstreamData, alphaData []byte) (*image.NRGBA, error) {
+		*count++
+		w, h := int(bitstreamData[0]), int(bitstreamData[1])
+		c := color.NRGBA{R: bitstreamData[2], G: bitstreamData[3], B: bitstreamData[4], A: bitstreamData[5]}
+		return solidNRGBA(w, h, c), nil
+	}
+}
+
+func TestStreamDecoderLazyDecode(t *testing.T) {
+	anim := streamLazyAnimation()
+	var decodes int
+	installStubFrameDecoder(t, &decodes)
+
+	sd, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+	if decodes != 0 {
+		t.Errorf("construction decoded %d frames, want 0 (index uses metadata only)", decodes)
+	}
+
+	for sd.HasNext() {
+		if _, _, err := sd.NextFrame(); err != nil {
+			t.Fatalf("NextFrame: %v", err)
+		}
+	}
+	if decodes != len(anim.Frames) {
+		t.Errorf("decoded %d frames, want %d", decodes, len(anim.Frames))
+	}
+
+	// Decoded pixels must not be retained on the frames.
+	for i := range anim.Frames {
+		if anim.Frames[i].Image != nil {
+			t.Errorf("frame %d retains decoded Image after streaming playback", i)
+		}
+	}
+}
+
+func TestStreamDecoderSeek(t *testing.T) {
+	anim := streamLazyAnimation()
+	var decodes int
+	installStubFrameDecoder(t, &decodes)
+
+	// Reference canvases from sequential playback.
+	ref, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+	var want []*image.NRGBA
+	for ref.HasNext() {
+		snap, _, err := ref.NextFrame()
+		if err != nil {
+			t.Fatalf("NextFrame: %v", err)
+		}
+		want = append(want, snap)
+	}
+
+	sd, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+
+	// Seek forward into the second keyframe interval: only frames from
+	// keyframe 3 onward should be decoded.
+	decodes = 0
+	if err := sd.SeekToFrame(4); err != nil {
+		t.Fatalf("SeekToFrame(4): %v", err)
+	}
+	snap, _, err := sd.NextFrame()
+	if err != nil {
+		t.Fatalf("NextFrame after seek: %v", err)
+	}
+	if !bytes.Equal(snap.Pix, want[4].Pix) {
+		t.Error("canvas after seek to frame 4 differs from sequential playback")
+	}
+	if decodes != 2 { // frames 3 and 4
+		t.Errorf("seek to frame 4 decoded %d frames, want 2 (from keyframe 3)", decodes)
+	}
+
+	// Seek backward into the first keyframe interval.
+	decodes = 0
+	if err := sd.SeekToFrame(2); err != nil {
+		t.Fatalf("SeekToFrame(2): %v", err)
+	}
+	snap, _, err = sd.NextFrame()
+	if err != nil {
+		t.Fatalf("NextFrame after backward seek: %v", err)
+	}
+	if !bytes.Equal(snap.Pix, want[2].Pix) {
+		t.Error("canvas after backward seek to frame 2 differs from sequential playback")
+	}
+	if decodes != 3 { // frames 0, 1 and 2
+		t.Errorf("backward seek to frame 2 decoded %d frames, want 3 (from keyframe 0)", decodes)
+	}
+
+	// Out-of-range seeks are rejected.
+	if err := sd.SeekToFrame(-1); err == nil {
+		t.Error("SeekToFrame(-1) succeeded, want error")
+	}
+	if err := sd.SeekToFrame(len(anim.Frames)); err == nil {
+		t.Error("SeekToFrame(NumFrames) succeeded, want error")
+	}
+}
+
+// grayYCbCr builds a 4:2:0 YCbCr image with constant luma and neutral chroma,
+// so its exact RGB equivalent is (luma, luma, luma).
+func grayYCbCr(w, h int, luma byte) *image.YCbCr {
+	img := image.NewYCbCr(image.Rect(0, 0, w, h), image.YCbCrSubsampleRatio420)
+	for i := range img.Y {
+		img.Y[i] = luma
+	}
+	for i := range img.Cb {
+		img.Cb[i] = 128
+		img.Cr[i] = 128
+	}
+	return img
+}
+
+// installStubRawDecoder registers FrameDecoderRawFunc and YCbCrToNRGBAFunc
+// stubs for the fake bitstream format from streamLazyAnimation. Full-canvas
+// frames decode to gray YCbCr (luma = the R byte); sub-frames decode to
+// NRGBA. conversions counts YCbCr materializations.
+func installStubRawDecoder(t *testing.T, canvasW int, conversions *int) {
+	t.Helper()
+	oldRaw := FrameDecoderRawFunc
+	oldConv := YCbCrToNRGBAFunc
+	t.Cleanup(func() {
+		FrameDecoderRawFunc = oldRaw
+		YCbCrToNRGBAFunc = oldConv
+	})
+	FrameDecoderRawFunc = func(bitstreamData, alphaData []byte) (image.Image, error) {
+		w, h := int(bitstreamData[0]), int(bitstreamData[1])
+		if w == canvasW {
+			return grayYCbCr(w, h, bitstreamData[2]), nil
+		}
+		c := color.NRGBA{R: bitstreamData[2], G: bitstreamData[3], B: bitstreamData[4], A: bitstreamData[5]}
+		return solidNRGBA(w, h, c), nil
+	}
+	YCbCrToNRGBAFunc = func(img *image.YCbCr) *image.NRGBA {
+		*conversions++
+		// Neutral chroma: RGB == luma exactly.
+		return solidNRGBA(img.Rect.Dx(), img.Rect.Dy(), color.NRGBA{R: img.Y[0], G: img.Y[0], B: img.Y[0], A: 255})
+	}
+}
+
+func TestStreamDecoderNextFrameRaw(t *testing.T) {
+	bs := func(w, h int, c color.NRGBA) []byte {
+		return []byte{byte(w), byte(h), c.R, c.G, c.B, c.A}
+	}
+	blue := color.NRGBA{B: 255, A: 255}
+	anim := &Animation{
+		CanvasWidth:  8,
+		CanvasHeight: 8,
+		Frames: []Frame{
+			// 0: full-canvas opaque frame -- raw YCbCr passthrough.
+			{BitstreamData: bs(8, 8, color.NRGBA{R: 100}), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			// 1: sub-frame patch -- needs the materialized canvas.
+			{BitstreamData: bs(2, 2, blue), Width: 2, Height: 2, OffsetX: 2, OffsetY: 2, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			// 2: full-canvas opaque frame again -- raw passthrough resumes.
+			{BitstreamData: bs(8, 8, color.NRGBA{R: 200}), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+		},
+	}
+	var decodes, conversions int
+	installStubFrameDecoder(t, &decodes)
+	installStubRawDecoder(t, 8, &conversions)
+
+	sd, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+
+	// Frame 0: handed out as YCbCr, no conversion.
+	img, _, err := sd.NextFrameRaw()
+	if err != nil {
+		t.Fatalf("NextFrameRaw 0: %v", err)
+	}
+	ycbcr, ok := img.(*image.YCbCr)
+	if !ok {
+		t.Fatalf("frame 0 = %T, want *image.YCbCr", img)
+	}
+	if ycbcr.Y[0] != 100 {
+		t.Errorf("frame 0 luma = %d, want 100", ycbcr.Y[0])
+	}
+	if conversions != 0 {
+		t.Errorf("conversions after frame 0 = %d, want 0 (passthrough)", conversions)
+	}
+
+	// Frame 1: sub-frame forces exactly one canvas materialization.
+	img, _, err = sd.NextFrameRaw()
+	if err != nil {
+		t.Fatalf("NextFrameRaw 1: %v", err)
+	}
+	canvas, ok := img.(*image.NRGBA)
+	if !ok {
+		t.Fatalf("frame 1 = %T, want *image.NRGBA", img)
+	}
+	if conversions != 1 {
+		t.Errorf("conversions after frame 1 = %d, want 1", conversions)
+	}
+	gray := color.NRGBA{R: 100, G: 100, B: 100, A: 255}
+	if got := canvas.NRGBAAt(0, 0); got != gray {
+		t.Errorf("frame 1 background = %v, want %v", got, gray)
+	}
+	if got := canvas.NRGBAAt(3, 3); got != blue {
+		t.Errorf("frame 1 patch = %v, want %v", got, blue)
+	}
+
+	// Frame 2: full-canvas keyframe, passthrough again without conversion.
+	img, _, err = sd.NextFrameRaw()
+	if err != nil {
+		t.Fatalf("NextFrameRaw 2: %v", err)
+	}
+	if _, ok := img.(*image.YCbCr); !ok {
+		t.Fatalf("frame 2 = %T, want *image.YCbCr", img)
+	}
+	if conversions != 1 {
+		t.Errorf("conversions after frame 2 = %d, want 1", conversions)
+	}
+}
+
+func TestStreamDecoderNextFrameRawAllPassthrough(t *testing.T) {
+	// An animation made only of full-canvas opaque frames never converts.
+	bs := func(luma byte) []byte { return []byte{8, 8, luma, 0, 0, 255} }
+	anim := &Animation{
+		CanvasWidth:  8,
+		CanvasHeight: 8,
+		Frames: []Frame{
+			{BitstreamData: bs(10), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			{BitstreamData: bs(20), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+			{BitstreamData: bs(30), Width: 8, Height: 8, Duration: 50 * time.Millisecond, Blend: BlendNone},
+		},
+	}
+	var decodes, conversions int
+	installStubFrameDecoder(t, &decodes)
+	installStubRawDecoder(t, 8, &conversions)
+
+	sd, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+	for i := 0; sd.HasNext(); i++ {
+		img, _, err := sd.NextFrameRaw()
+		if err != nil {
+			t.Fatalf("NextFrameRaw %d: %v", i, err)
+		}
+		if _, ok := img.(*image.YCbCr); !ok {
+			t.Errorf("frame %d = %T, want *image.YCbCr", i, img)
+		}
+	}
+	if conversions != 0 {
+		t.Errorf("conversions = %d, want 0", conversions)
+	}
+	if decodes != 0 {
+		t.Errorf("NRGBA decodes = %d, want 0", decodes)
+	}
+}
+
+func TestStreamDecoderKeyframeCache(t *testing.T) {
+	anim := streamLazyAnimation()
+	var decodes int
+	installStubFrameDecoder(t, &decodes)
+
+	sd, err := NewStreamDecoder(anim, &StreamOptions{KeyframeCacheSize: 2})
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+
+	// Play through once so both keyframe canvases are cached.
+	for sd.HasNext() {
+		if _, _, err := sd.NextFrame(); err != nil {
+			t.Fatalf("NextFrame: %v", err)
+		}
+	}
+
+	// Backward scrub to frame 1: the cached keyframe-0 canvas means only
+	// frame 1 itself needs decoding.
+	decodes = 0
+	if err := sd.SeekToFrame(1); err != nil {
+		t.Fatalf("SeekToFrame(1): %v", err)
+	}
+	snap, _, err := sd.NextFrame()
+	if err != nil {
+		t.Fatalf("NextFrame: %v", err)
+	}
+	if decodes != 1 {
+		t.Errorf("cached backward seek decoded %d frames, want 1", decodes)
+	}
+
+	// The result must still match uncached playback.
+	ref, err := NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+	ref.NextFrame()
+	wantSnap, _, err := ref.NextFrame()
+	if err != nil {
+		t.Fatalf("NextFrame: %v", err)
+	}
+	if !bytes.Equal(snap.Pix, wantSnap.Pix) {
+		t.Error("cached seek canvas differs from uncached playback")
+	}
+}
@@ -0,0 +1,138 @@
+package webp
+
+import (
+	"bytes"
+	"fmt"
+	"image"
+	"runtime"
+	"sync"
+	"sync/atomic"
+)
+
+// BatchCodec encodes or decodes many independent images with a bounded
+// worker pool. Each worker processes items off a shared queue, so a batch
+// of n images costs min(workers, n) goroutines rather than n, and
+// per-worker state — a reusable [Encoder] session and the output staging
+// buffer — is reused across all items a worker handles. Outputs always
+// preserve input order.
+//
+// A BatchCodec holds no resources between calls (retained codec scratch
+// lives in the package-level pools), so it is safe for concurrent use and
+// needs no Close.
+type BatchCodec struct {
+	workers int
+}
+
+// NewBatchCodec creates a BatchCodec running at most workers items
+// concurrently. workers <= 0 selects GOMAXPROCS.
+func NewBatchCodec(workers int) *BatchCodec {
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	return &BatchCodec{workers: workers}
+}
+
+// DecodeAll decodes every WebP bitstream in inputs and returns the decoded
+// images in the same order. All items are attempted even if some fail:
+// failed slots are nil in the result, and the returned error is the first
+// failure annotated with its index (nil if every item decoded).
+func (c *BatchCodec) DecodeAll(inputs [][]byte) ([]image.Image, error) {
+	out := make([]image.Image, len(inputs))
+	errs := make([]error, len(inputs))
+	c.run(len(inputs), func(next func() (int, bool)) {
+		for {
+			i, ok := next()
+			if !ok {
+				return
+			}
+			out[i], errs[i] = Decode(bytes.NewReader(inputs[i]))
+		}
+	})
+	return out, firstBatchError(errs)
+}
+
+// EncodeAll encodes every image in imgs with the given options and returns
+// the WebP bitstreams in the same order. A nil opts uses [DefaultOptions].
+// Each worker reuses one [Encoder] session across all items it processes,
+// so same-resolution bursts repay the per-image setup cost only once per
+// worker. All items are attempted even if some fail: failed slots are nil,
+// and the returned error is the first failure annotated with its index.
+func (c *BatchCodec) EncodeAll(imgs []image.Image, opts *EncoderOptions) ([][]byte, error) {
+	if opts == nil {
+		opts = DefaultOptions()
+	}
+	// Validate once up front so a bad configuration fails before any work.
+	if err := validateConfig(opts); err != nil {
+		return nil, err
+	}
+
+	out := make([][]byte, len(imgs))
+	errs := make([]error, len(imgs))
+	c.run(len(imgs), func(next func() (int, bool)) {
+		enc, err := NewEncoder(opts)
+		if err != nil {
+			// Already validated; this cannot happen in practice.
+			for i, ok := next(); ok; i, ok = next() {
+				errs[i] = err
+			}
+			return
+		}
+		defer enc.Close()
+		var buf bytes.Buffer
+		for {
+			i, ok := next()
+			if !ok {
+				return
+			}
+			buf.Reset()
+			if err := enc.Encode(&buf, imgs[i]); err != nil {
+				errs[i] = err
+				continue
+			}
+			out[i] = append([]byte(nil), buf.Bytes()...)
+		}
+	})
+	return out, firstBatchError(errs)
+}
+
+// run executes worker goroutines over n items. Each worker receives a
+// next function that claims item indices off a shared atomic counter until
+// the batch is exhausted, balancing uneven per-item cost automatically.
+func (c *BatchCodec) run(n int, worker func(next func() (int, bool))) {
+	if n == 0 {
+		return
+	}
+	workers := c.workers
+	if workers > n {
+		workers = n
+	}
+	var cursor atomic.Int64
+	next := func() (int, bool) {
+		i := int(cursor.Add(1)) - 1
+		return i, i < n
+	}
+	if workers <= 1 {
+		worker(next)
+		return
+	}
+	var wg sync.WaitGroup
+	wg.Add(workers)
+	for w := 0; w < workers; w++ {
+		go func() {
+			defer wg.Done()
+			worker(next)
+		}()
+	}
+	wg.Wait()
+}
+
+// firstBatchError returns the first non-nil error annotated with its item
+// index, or nil if all items succeeded.
+func firstBatchError(errs []error) error {
+	for i, err := range errs {
+		if err != nil {
+			return fmt.Errorf("webp: batch item %d: %w", i, err)
+		}
+	}
+	return nil
+}
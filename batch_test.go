@@ -0,0 +1,134 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"image/color"
+	"strings"
+	"testing"
+)
+
+// TestBatchEncodeAllMatchesOneShot verifies EncodeAll preserves input order
+// and produces byte-identical output to the one-shot Encode for every item,
+// including mixed dimensions.
+func TestBatchEncodeAllMatchesOneShot(t *testing.T) {
+	opts := &EncoderOptions{Quality: 75, Method: 2}
+	var imgs []image.Image
+	for seed := 0; seed < 10; seed++ {
+		w, h := 96, 80
+		if seed%3 == 0 {
+			w, h = 64, 48
+		}
+		imgs = append(imgs, sessionTestImage(w, h, seed))
+	}
+
+	batch := NewBatchCodec(4)
+	got, err := batch.EncodeAll(imgs, opts)
+	if err != nil {
+		t.Fatalf("EncodeAll: %v", err)
+	}
+	if len(got) != len(imgs) {
+		t.Fatalf("EncodeAll returned %d outputs, want %d", len(got), len(imgs))
+	}
+
+	for i, img := range imgs {
+		var want bytes.Buffer
+		if err := Encode(&want, img, opts); err != nil {
+			t.Fatalf("one-shot Encode(%d): %v", i, err)
+		}
+		if !bytes.Equal(got[i], want.Bytes()) {
+			t.Errorf("item %d: batch output (%d bytes) differs from one-shot (%d bytes)",
+				i, len(got[i]), want.Len())
+		}
+	}
+}
+
+// TestBatchDecodeAllOrder round-trips distinct solid-color images through
+// EncodeAll and DecodeAll and verifies each output lands in its input slot.
+func TestBatchDecodeAllOrder(t *testing.T) {
+	const n = 12
+	var imgs []image.Image
+	for i := 0; i < n; i++ {
+		img := image.NewNRGBA(image.Rect(0, 0, 32, 32))
+		c := color.NRGBA{R: uint8(i * 20), G: uint8(255 - i*20), B: uint8(i * 7), A: 255}
+		for p := 0; p < len(img.Pix); p += 4 {
+			img.Pix[p+0] = c.R
+			img.Pix[p+1] = c.G
+			img.Pix[p+2] = c.B
+			img.Pix[p+3] = c.A
+		}
+		imgs = append(imgs, img)
+	}
+
+	batch := NewBatchCodec(0) // default worker count
+	encoded, err := batch.EncodeAll(imgs, &EncoderOptions{Lossless: true})
+	if err != nil {
+		t.Fatalf("EncodeAll: %v", err)
+	}
+	decoded, err := batch.DecodeAll(encoded)
+	if err != nil {
+		t.Fatalf("DecodeAll: %v", err)
+	}
+	for i, img := range decoded {
+		if img == nil {
+			t.Fatalf("item %d: nil image", i)
+		}
+		wr, wg, wb, _ := imgs[i].At(0, 0).RGBA()
+		gr, gg, gb, _ := img.At(0, 0).RGBA()
+		if wr != gr || wg != gg || wb != gb {
+			t.Errorf("item %d: got color (%d,%d,%d), want (%d,%d,%d) — order not preserved?",
+				i, gr>>8, gg>>8, gb>>8, wr>>8, wg>>8, wb>>8)
+		}
+	}
+}
+
+// TestBatchPartialFailure verifies that a failing item does not abort the
+// batch: the other items still complete and the error names the bad index.
+func TestBatchPartialFailure(t *testing.T) {
+	good := sessionTestImage(32, 32, 1)
+	var goodBytes bytes.Buffer
+	if err := Encode(&goodBytes, good, nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	batch := NewBatchCodec(2)
+	out, err := batch.DecodeAll([][]byte{
+		goodBytes.Bytes(),
+		[]byte("not a webp file"),
+		goodBytes.Bytes(),
+	})
+	if err == nil {
+		t.Fatal("DecodeAll: expected error for invalid item")
+	}
+	if !strings.Contains(err.Error(), "item 1") {
+		t.Errorf("error %q does not name the failing index", err)
+	}
+	if out[0] == nil || out[2] == nil {
+		t.Error("valid items were not decoded despite one failure")
+	}
+	if out[1] != nil {
+		t.Error("invalid item produced a non-nil image")
+	}
+
+	encOut, err := batch.EncodeAll([]image.Image{good, nil, good}, nil)
+	if err == nil {
+		t.Fatal("EncodeAll: expected error for nil image")
+	}
+	if !strings.Contains(err.Error(), "item 1") {
+		t.Errorf("error %q does not name the failing index", err)
+	}
+	if encOut[0] == nil || encOut[2] == nil {
+		t.Error("valid items were not encoded despite one failure")
+	}
+}
+
+// TestBatchEmpty verifies the degenerate cases.
+func TestBatchEmpty(t *testing.T) {
+	batch := NewBatchCodec(4)
+	if out, err := batch.DecodeAll(nil); err != nil || len(out) != 0 {
+		t.Errorf("DecodeAll(nil) = %v, %v", out, err)
+	}
+	if out, err := batch.EncodeAll(nil, nil); err != nil || len(out) != 0 {
+		t.Errorf("EncodeAll(nil) = %v, %v", out, err)
+	}
+}
@@ -0,0 +1,184 @@
+package main
+
+import (
+	"bufio"
+	"fmt"
+	"os"
+	"path/filepath"
+	"runtime"
+	"strings"
+	"sync"
+	"time"
+)
+
+// Batch mode: when enc/dec receive several inputs (multiple arguments, a
+// directory, or a -list file), conversions run on a bounded worker pool
+// with file I/O pipelined around the codec work. A loader goroutine reads
+// inputs ahead of the encoders, N workers convert in memory, and the main
+// goroutine writes outputs and prints one machine-readable summary line
+// per file:
+//
+//	ok<TAB>input<TAB>output<TAB>out_bytes<TAB>millis
+//	error<TAB>input<TAB><TAB>0<TAB>0<TAB>message
+//
+// Lines appear in completion order; parse by the first field.
+
+// batchTask is one loaded input travelling from the loader to a worker.
+type batchTask struct {
+	index int
+	input string
+	data  []byte
+	err   error // read error; the worker passes it through
+}
+
+// batchResult is one converted output travelling from a worker to the
+// writer.
+type batchResult struct {
+	index  int
+	input  string
+	output string
+	data   []byte
+	dur    time.Duration
+	err    error
+}
+
+// batchConvert converts one loaded input and returns the encoded bytes and
+// the output extension (e.g. ".webp", ".gif").
+type batchConvert func(data []byte, input string) ([]byte, string, error)
+
+// expandInputs resolves positional arguments plus an optional -list file
+// into a flat input list. Directory arguments are walked (not recursed)
+// for files whose lowercase extension is in exts. The second result
+// reports whether batch mode applies: more than one input, a directory
+// argument, or a list file.
+func expandInputs(args []string, listPath string, exts map[string]bool) ([]string, bool, error) {
+	batch := listPath != "" || len(args) > 1
+	var inputs []string
+	for _, arg := range args {
+		fi, err := os.Stat(arg)
+		if arg != "-" && err == nil && fi.IsDir() {
+			batch = true
+			entries, err := os.ReadDir(arg)
+			if err != nil {
+				return nil, false, err
+			}
+			for _, e := range entries {
+				if e.IsDir() || !exts[strings.ToLower(filepath.Ext(e.Name()))] {
+					continue
+				}
+				inputs = append(inputs, filepath.Join(arg, e.Name()))
+			}
+			continue
+		}
+		inputs = append(inputs, arg)
+	}
+	if listPath != "" {
+		f, err := os.Open(listPath)
+		if err != nil {
+			return nil, false, fmt.Errorf("reading list file: %w", err)
+		}
+		defer f.Close()
+		sc := bufio.NewScanner(f)
+		for sc.Scan() {
+			line := strings.TrimSpace(sc.Text())
+			if line == "" || strings.HasPrefix(line, "#") {
+				continue
+			}
+			inputs = append(inputs, line)
+		}
+		if err := sc.Err(); err != nil {
+			return nil, false, fmt.Errorf("reading list file: %w", err)
+		}
+	}
+	return inputs, batch, nil
+}
+
+// batchOutputPath places the output next to its input, or under outDir
+// when set, swapping the extension.
+func batchOutputPath(input, outDir, ext string) string {
+	base := strings.TrimSuffix(filepath.Base(input), filepath.Ext(input)) + ext
+	if outDir != "" {
+		return filepath.Join(outDir, base)
+	}
+	return filepath.Join(filepath.Dir(input), base)
+}
+
+// runBatch converts inputs concurrently. newWorker is called once per
+// worker goroutine and returns that worker's convert function plus a
+// cleanup hook (for releasing a retained encoder session; either may rely
+// on worker-local state without locking). Returns an error if any file
+// failed.
+func runBatch(inputs []string, outDir string, workers int,
+	newWorker func() (batchConvert, func())) error {
+	if workers <= 0 {
+		workers = runtime.NumCPU()
+	}
+	if workers > len(inputs) {
+		workers = len(inputs)
+	}
+	if outDir != "" {
+		if err := os.MkdirAll(outDir, 0o755); err != nil {
+			return err
+		}
+	}
+	start := time.Now()
+
+	// Stage 1: loader reads files ahead of the workers.
+	tasks := make(chan batchTask, 2*workers)
+	go func() {
+		defer close(tasks)
+		for i, input := range inputs {
+			data, err := os.ReadFile(input)
+			tasks <- batchTask{index: i, input: input, data: data, err: err}
+		}
+	}()
+
+	// Stage 2: workers convert in memory.
+	results := make(chan batchResult, 2*workers)
+	var wg sync.WaitGroup
+	wg.Add(workers)
+	for w := 0; w < workers; w++ {
+		go func() {
+			defer wg.Done()
+			convert, cleanup := newWorker()
+			defer cleanup()
+			for task := range tasks {
+				res := batchResult{index: task.index, input: task.input, err: task.err}
+				if res.err == nil {
+					t0 := time.Now()
+					var ext string
+					res.data, ext, res.err = convert(task.data, task.input)
+					res.dur = time.Since(t0)
+					res.output = batchOutputPath(task.input, outDir, ext)
+				}
+				results <- res
+			}
+		}()
+	}
+	go func() {
+		wg.Wait()
+		close(results)
+	}()
+
+	// Stage 3: write outputs and print per-file summary lines.
+	var failed int
+	for res := range results {
+		if res.err == nil {
+			res.err = os.WriteFile(res.output, res.data, 0o644)
+		}
+		if res.err != nil {
+			failed++
+			fmt.Printf("error\t%s\t\t0\t0\t%s\n", res.input, res.err)
+			continue
+		}
+		fmt.Printf("ok\t%s\t%s\t%d\t%d\n",
+			res.input, res.output, len(res.data), res.dur.Milliseconds())
+	}
+
+	fmt.Fprintf(os.Stderr, "gwebp: %d of %d files converted in %.1fs\n",
+		len(inputs)-failed, len(inputs), time.Since(start).Seconds())
+	if failed > 0 {
+		return fmt.Errorf("%d of %d conversions failed", failed, len(inputs))
+	}
+	return nil
+}
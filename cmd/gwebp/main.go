@@ -2,9 +2,14 @@
 //
 // Usage:
 //
-//	gwebp enc [options] <input>        PNG/JPEG/GIF → WebP (use "-" for stdin)
-//	gwebp dec [options] <input.webp>   WebP → PNG/JPEG/GIF (use "-" for stdin, -o - for stdout)
+//	gwebp enc [options] <input>...     PNG/JPEG/GIF → WebP (use "-" for stdin)
+//	gwebp dec [options] <input.webp>.. WebP → PNG/JPEG/GIF (use "-" for stdin, -o - for stdout)
 //	gwebp info <input.webp>            Display WebP metadata
+//
+// Passing several inputs, a directory, or -list <file> enables batch mode:
+// conversions run concurrently (-j workers) with outputs placed next to
+// each input or under -out_dir, and one tab-separated summary line is
+// printed per file.
 package main
 
 import (
@@ -58,10 +63,12 @@ func main() {
 
 func printUsage() {
 	fmt.Fprintf(os.Stderr, `Usage:
-  gwebp enc [options] <input>        Encode PNG/JPEG/GIF to WebP
-  gwebp dec [options] <input.webp>   Decode WebP to PNG, JPEG, or GIF
+  gwebp enc [options] <input>...     Encode PNG/JPEG/GIF to WebP
+  gwebp dec [options] <input.webp>.. Decode WebP to PNG, JPEG, or GIF
 
 Use "-" as input to read from stdin, "-o -" to write to stdout.
+Several inputs, a directory, or -list <file> run as a concurrent batch
+(-j workers, -out_dir for outputs) with one summary line per file.
 
 Run "gwebp <command> -h" for command-specific options.
 `)
@@ -102,14 +109,22 @@ func runEnc(args []string) error {
 	qmin := fs.Int("qmin", 0, "minimum quality 0-100")
 	qmax := fs.Int("qmax", -1, "maximum quality 0-100 (-1=default)")
 	output := fs.String("o", "", `output path (default: <input>.webp, "-" for stdout)`)
+	workers := fs.Int("j", 0, "concurrent conversions in batch mode (0=all CPUs)")
+	list := fs.String("list", "", "file with input paths, one per line (enables batch mode)")
+	outDir := fs.String("out_dir", "", "output directory in batch mode (default: next to each input)")
 
 	if err := fs.Parse(args); err != nil {
 		return err
 	}
-	if fs.NArg() < 1 {
-		return fmt.Errorf("enc: missing input file\nUsage: gwebp enc [options] <input>")
+	inputs, batch, err := expandInputs(fs.Args(), *list,
+		map[string]bool{".png": true, ".jpg": true, ".jpeg": true, ".gif": true})
+	if err != nil {
+		return fmt.Errorf("enc: %w", err)
+	}
+	if len(inputs) == 0 {
+		return fmt.Errorf("enc: missing input file\nUsage: gwebp enc [options] <input>...")
 	}
-	inputPath := fs.Arg(0)
+	inputPath := inputs[0]
 
 	p, err := parsePreset(*preset)
 	if err != nil {
@@ -172,6 +187,13 @@ func runEnc(args []string) error {
 		opts.QMax = *qmax
 	}
 
+	if batch {
+		if *output != "" {
+			return fmt.Errorf("enc: -o cannot be used in batch mode; use -out_dir")
+		}
+		return runEncBatch(inputs, *outDir, *workers, opts)
+	}
+
 	ext := strings.ToLower(filepath.Ext(inputPath))
 	if ext == ".gif" && inputPath != "-" {
 		return encodeGIF(inputPath, *output, opts)
@@ -179,6 +201,48 @@ func runEnc(args []string) error {
 	return encodeStatic(inputPath, *output, opts)
 }
 
+// runEncBatch converts many inputs to WebP on the worker pool. Each worker
+// keeps one reusable encoder session for static images, so bursts of
+// same-resolution files pay per-image setup once per worker.
+func runEncBatch(inputs []string, outDir string, workers int, opts *webp.EncoderOptions) error {
+	return runBatch(inputs, outDir, workers, func() (batchConvert, func()) {
+		enc, encErr := webp.NewEncoder(opts)
+		convert := func(data []byte, input string) ([]byte, string, error) {
+			if encErr != nil {
+				return nil, "", encErr
+			}
+			var buf bytes.Buffer
+			if strings.ToLower(filepath.Ext(input)) == ".gif" {
+				g, err := gif.DecodeAll(bytes.NewReader(data))
+				if err != nil {
+					return nil, "", fmt.Errorf("decoding GIF: %w", err)
+				}
+				if len(g.Image) == 0 {
+					return nil, "", fmt.Errorf("GIF has no frames")
+				}
+				if err := encodeGIFFrames(&buf, g, opts); err != nil {
+					return nil, "", err
+				}
+				return buf.Bytes(), ".webp", nil
+			}
+			img, _, err := image.Decode(bytes.NewReader(data))
+			if err != nil {
+				return nil, "", fmt.Errorf("decoding input: %w", err)
+			}
+			if err := enc.Encode(&buf, img); err != nil {
+				return nil, "", err
+			}
+			return buf.Bytes(), ".webp", nil
+		}
+		cleanup := func() {
+			if encErr == nil {
+				enc.Close()
+			}
+		}
+		return convert, cleanup
+	})
+}
+
 func parsePreset(s string) (webp.Preset, error) {
 	switch strings.ToLower(s) {
 	case "default":
@@ -352,14 +416,28 @@ func runDec(args []string) error {
 	fs := flag.NewFlagSet("dec", flag.ContinueOnError)
 	output := fs.String("o", "", `output path (default: .png or .gif, "-" for stdout)`)
 	fmtFlag := fs.String("fmt", "", "output format: png, jpeg (auto-detect from extension if omitted)")
+	workers := fs.Int("j", 0, "concurrent conversions in batch mode (0=all CPUs)")
+	list := fs.String("list", "", "file with input paths, one per line (enables batch mode)")
+	outDir := fs.String("out_dir", "", "output directory in batch mode (default: next to each input)")
 
 	if err := fs.Parse(args); err != nil {
 		return err
 	}
-	if fs.NArg() < 1 {
-		return fmt.Errorf("dec: missing input file\nUsage: gwebp dec [options] <input.webp>")
+	inputs, batch, err := expandInputs(fs.Args(), *list, map[string]bool{".webp": true})
+	if err != nil {
+		return fmt.Errorf("dec: %w", err)
+	}
+	if len(inputs) == 0 {
+		return fmt.Errorf("dec: missing input file\nUsage: gwebp dec [options] <input.webp>...")
+	}
+	inputPath := inputs[0]
+
+	if batch {
+		if *output != "" {
+			return fmt.Errorf("dec: -o cannot be used in batch mode; use -out_dir")
+		}
+		return runDecBatch(inputs, *outDir, *workers, *fmtFlag)
 	}
-	inputPath := fs.Arg(0)
 
 	in, err := openInput(inputPath)
 	if err != nil {
@@ -383,6 +461,44 @@ func runDec(args []string) error {
 	return decodeStatic(data, inputPath, *output, *fmtFlag)
 }
 
+// runDecBatch converts many WebP inputs on the worker pool. Animated files
+// become GIFs, static files PNG or JPEG per -fmt.
+func runDecBatch(inputs []string, outDir string, workers int, fmtFlag string) error {
+	return runBatch(inputs, outDir, workers, func() (batchConvert, func()) {
+		convert := func(data []byte, input string) ([]byte, string, error) {
+			feat, err := webp.GetFeatures(bytes.NewReader(data))
+			if err != nil {
+				return nil, "", err
+			}
+			var buf bytes.Buffer
+			if feat.HasAnimation {
+				g, err := webpToGIF(data)
+				if err != nil {
+					return nil, "", err
+				}
+				if err := gif.EncodeAll(&buf, g); err != nil {
+					return nil, "", fmt.Errorf("encoding GIF: %w", err)
+				}
+				return buf.Bytes(), ".gif", nil
+			}
+			img, err := webp.Decode(bytes.NewReader(data))
+			if err != nil {
+				return nil, "", err
+			}
+			outFmt := detectOutputFormat(fmtFlag, "")
+			if err := encodeImage(&buf, img, outFmt); err != nil {
+				return nil, "", err
+			}
+			ext := ".png"
+			if outFmt == "jpeg" {
+				ext = ".jpg"
+			}
+			return buf.Bytes(), ext, nil
+		}
+		return convert, func() {}
+	})
+}
+
 // detectOutputFormat returns "png", "jpeg", or "gif" based on flag/extension.
 func detectOutputFormat(fmtFlag, outputPath string) string {
 	if fmtFlag != "" {
@@ -454,19 +570,21 @@ func encodeImage(w io.Writer, img image.Image, format string) error {
 	}
 }
 
-func decodeAnimated(data []byte, inputPath, outputPath string, feat *webp.Features) error {
+// webpToGIF decodes an animated WebP into an in-memory GIF, quantizing
+// each frame with the Plan9 palette + Floyd-Steinberg dithering.
+func webpToGIF(data []byte) (*gif.GIF, error) {
 	anim, err := animation.DecodeBytes(data)
 	if err != nil {
-		return fmt.Errorf("dec: %w", err)
+		return nil, err
 	}
 
 	if err := anim.DecodeFrames(); err != nil {
-		return fmt.Errorf("dec: decoding frames: %w", err)
+		return nil, fmt.Errorf("decoding frames: %w", err)
 	}
 
 	dec, err := animation.NewAnimDecoder(anim)
 	if err != nil {
-		return fmt.Errorf("dec: %w", err)
+		return nil, err
 	}
 	g := &gif.GIF{
 		LoopCount: anim.LoopCount,
@@ -475,7 +593,7 @@ func decodeAnimated(data []byte, inputPath, outputPath string, feat *webp.Featur
 	for dec.HasNext() {
 		frame, dur, err := dec.NextFrame()
 		if err != nil {
-			return fmt.Errorf("dec: %w", err)
+			return nil, err
 		}
 
 		// Quantize to paletted image using Plan9 palette + Floyd-Steinberg dithering.
@@ -491,6 +609,14 @@ func decodeAnimated(data []byte, inputPath, outputPath string, feat *webp.Featur
 		}
 		g.Delay = append(g.Delay, delay)
 	}
+	return g, nil
+}
+
+func decodeAnimated(data []byte, inputPath, outputPath string, feat *webp.Features) error {
+	g, err := webpToGIF(data)
+	if err != nil {
+		return fmt.Errorf("dec: %w", err)
+	}
 
 	if outputPath == "-" {
 		return gif.EncodeAll(os.Stdout, g)
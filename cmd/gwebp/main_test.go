@@ -636,3 +636,150 @@ func assertContains(t *testing.T, haystack, needle, msg string) {
 		t.Errorf("%s: %q not found in output:\n%s", msg, needle, haystack)
 	}
 }
+
+// --- batch tests ---
+
+// createTestPNGNamed writes an 8x8 gradient PNG with the given name.
+func createTestPNGNamed(t *testing.T, dir, name string) string {
+	t.Helper()
+	src := createTestPNG(t, t.TempDir())
+	data, err := os.ReadFile(src)
+	if err != nil {
+		t.Fatalf("reading test PNG: %v", err)
+	}
+	path := filepath.Join(dir, name)
+	if err := os.WriteFile(path, data, 0o644); err != nil {
+		t.Fatalf("writing test PNG: %v", err)
+	}
+	return path
+}
+
+func TestEnc_BatchMultipleInputs(t *testing.T) {
+	skipIfNoBinary(t)
+	dir := t.TempDir()
+	outDir := filepath.Join(dir, "out")
+	var inputs []string
+	for _, name := range []string{"a.png", "b.png", "c.png"} {
+		inputs = append(inputs, createTestPNGNamed(t, dir, name))
+	}
+
+	args := append([]string{"enc", "-j", "2", "-out_dir", outDir}, inputs...)
+	stdout, stderr, err := runGwebp(t, nil, args...)
+	if err != nil {
+		t.Fatalf("batch enc failed: %v\nstderr: %s", err, stderr)
+	}
+
+	lines := strings.Split(strings.TrimSpace(string(stdout)), "\n")
+	if len(lines) != 3 {
+		t.Fatalf("expected 3 summary lines, got %d:\n%s", len(lines), stdout)
+	}
+	seen := map[string]bool{}
+	for _, line := range lines {
+		fields := strings.Split(line, "\t")
+		if len(fields) != 5 || fields[0] != "ok" {
+			t.Fatalf("bad summary line %q", line)
+		}
+		seen[filepath.Base(fields[1])] = true
+		data, err := os.ReadFile(fields[2])
+		if err != nil {
+			t.Fatalf("reading output %s: %v", fields[2], err)
+		}
+		assertWebPHeader(t, data)
+	}
+	for _, name := range []string{"a.png", "b.png", "c.png"} {
+		if !seen[name] {
+			t.Errorf("no summary line for %s", name)
+		}
+	}
+}
+
+func TestEnc_BatchDirectoryInput(t *testing.T) {
+	skipIfNoBinary(t)
+	dir := t.TempDir()
+	createTestPNGNamed(t, dir, "one.png")
+	createTestPNGNamed(t, dir, "two.png")
+	os.WriteFile(filepath.Join(dir, "ignored.txt"), []byte("x"), 0o644)
+
+	stdout, stderr, err := runGwebp(t, nil, "enc", dir)
+	if err != nil {
+		t.Fatalf("batch enc of directory failed: %v\nstderr: %s", err, stderr)
+	}
+	lines := strings.Split(strings.TrimSpace(string(stdout)), "\n")
+	if len(lines) != 2 {
+		t.Fatalf("expected 2 summary lines, got %d:\n%s", len(lines), stdout)
+	}
+	for _, name := range []string{"one.webp", "two.webp"} {
+		if _, err := os.Stat(filepath.Join(dir, name)); err != nil {
+			t.Errorf("missing output %s: %v", name, err)
+		}
+	}
+}
+
+func TestEnc_BatchListFile(t *testing.T) {
+	skipIfNoBinary(t)
+	dir := t.TempDir()
+	a := createTestPNGNamed(t, dir, "a.png")
+	b := createTestPNGNamed(t, dir, "b.png")
+	listPath := filepath.Join(dir, "inputs.txt")
+	os.WriteFile(listPath, []byte("# comment\n"+a+"\n\n"+b+"\n"), 0o644)
+
+	stdout, stderr, err := runGwebp(t, nil, "enc", "-list", listPath)
+	if err != nil {
+		t.Fatalf("batch enc with list failed: %v\nstderr: %s", err, stderr)
+	}
+	if got := strings.Count(string(stdout), "ok\t"); got != 2 {
+		t.Fatalf("expected 2 ok lines, got %d:\n%s", got, stdout)
+	}
+}
+
+func TestEnc_BatchPartialFailure(t *testing.T) {
+	skipIfNoBinary(t)
+	dir := t.TempDir()
+	good := createTestPNGNamed(t, dir, "good.png")
+	bad := filepath.Join(dir, "bad.png")
+	os.WriteFile(bad, []byte("not a png"), 0o644)
+
+	stdout, _, err := runGwebp(t, nil, "enc", good, bad)
+	if err == nil {
+		t.Fatal("expected nonzero exit for failed conversion")
+	}
+	out := string(stdout)
+	if !strings.Contains(out, "ok\t"+good) {
+		t.Errorf("good input not converted:\n%s", out)
+	}
+	if !strings.Contains(out, "error\t"+bad) {
+		t.Errorf("bad input has no error line:\n%s", out)
+	}
+	if _, err := os.Stat(filepath.Join(dir, "good.webp")); err != nil {
+		t.Errorf("good output missing: %v", err)
+	}
+}
+
+func TestDec_BatchRoundTrip(t *testing.T) {
+	skipIfNoBinary(t)
+	dir := t.TempDir()
+	png1 := createTestPNGNamed(t, dir, "x.png")
+	png2 := createTestPNGNamed(t, dir, "y.png")
+	if _, stderr, err := runGwebp(t, nil, "enc", png1, png2); err != nil {
+		t.Fatalf("batch enc failed: %v\nstderr: %s", err, stderr)
+	}
+
+	outDir := filepath.Join(dir, "decoded")
+	stdout, stderr, err := runGwebp(t, nil, "dec", "-j", "2", "-out_dir", outDir,
+		filepath.Join(dir, "x.webp"), filepath.Join(dir, "y.webp"))
+	if err != nil {
+		t.Fatalf("batch dec failed: %v\nstderr: %s", err, stderr)
+	}
+	if got := strings.Count(string(stdout), "ok\t"); got != 2 {
+		t.Fatalf("expected 2 ok lines, got %d:\n%s", got, stdout)
+	}
+	for _, name := range []string{"x.png", "y.png"} {
+		data, err := os.ReadFile(filepath.Join(outDir, name))
+		if err != nil {
+			t.Fatalf("missing decoded %s: %v", name, err)
+		}
+		if _, err := png.Decode(bytes.NewReader(data)); err != nil {
+			t.Errorf("decoded %s is not a valid PNG: %v", name, err)
+		}
+	}
+}
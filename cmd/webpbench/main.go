@@ -0,0 +1,302 @@
+// Command webpbench measures this package's encode/decode performance
+// against a user-supplied image corpus and tracks it across changes.
+//
+// Usage:
+//
+//	webpbench -corpus <dir> [options]
+//
+// The corpus root's first-level subdirectories name the content
+// categories (photo/, screenshot/, icon/, animation/, ...); files placed
+// directly in the root fall into "uncategorized". PNG, JPEG, and still
+// WebP inputs are re-encoded with the configured options and measured
+// for encode/decode time, output size, allocations, and PSNR/SSIM
+// against the source. Animated WebP inputs are timed decode-only.
+//
+// Results are written as JSON (-out) so they can serve as the baseline
+// for a later run (-baseline): per-file timing deltas are tested for
+// statistical significance, a regression report is printed, and with
+// -profile set, CPU and heap profiles of the worst significant
+// regression are captured for investigation.
+package main
+
+import (
+	"bytes"
+	"flag"
+	"fmt"
+	"image"
+	"image/draw"
+	_ "image/jpeg"
+	_ "image/png"
+	"io"
+	"io/fs"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"time"
+
+	"github.com/deepteams/webp"
+	"github.com/deepteams/webp/animation"
+	"github.com/deepteams/webp/internal/dsp"
+)
+
+func main() {
+	var cfg runConfig
+	flag.StringVar(&cfg.corpus, "corpus", "", "corpus root directory (required)")
+	flag.StringVar(&cfg.out, "out", "", "write results JSON to this file")
+	flag.StringVar(&cfg.baseline, "baseline", "", "diff against this earlier results JSON")
+	flag.StringVar(&cfg.profileDir, "profile", "", "write CPU/heap profiles of the worst regression to this directory")
+	flag.Float64Var(&cfg.quality, "q", 75, "encode quality (0-100)")
+	flag.IntVar(&cfg.method, "m", 4, "encode method (0-6)")
+	flag.BoolVar(&cfg.lossless, "lossless", false, "encode losslessly")
+	flag.IntVar(&cfg.runs, "runs", 5, "timing repetitions per file")
+	flag.Parse()
+
+	if cfg.corpus == "" {
+		flag.Usage()
+		os.Exit(1)
+	}
+	if err := run(&cfg, os.Stdout); err != nil {
+		fmt.Fprintf(os.Stderr, "webpbench: %v\n", err)
+		os.Exit(1)
+	}
+}
+
+type runConfig struct {
+	corpus     string
+	out        string
+	baseline   string
+	profileDir string
+	quality    float64
+	method     int
+	lossless   bool
+	runs       int
+}
+
+func (cfg *runConfig) encoderOptions() *webp.EncoderOptions {
+	return &webp.EncoderOptions{
+		Lossless: cfg.lossless,
+		Quality:  float32(cfg.quality),
+		Method:   cfg.method,
+	}
+}
+
+// corpusFile is one measurable input discovered under the corpus root.
+type corpusFile struct {
+	path     string // absolute (or corpus-relative joined) path on disk
+	relPath  string // path relative to the corpus root, used as the stable key
+	category string // first path element under the root, or "uncategorized"
+}
+
+func run(cfg *runConfig, w io.Writer) error {
+	files, err := collectCorpus(cfg.corpus)
+	if err != nil {
+		return err
+	}
+	if len(files) == 0 {
+		return fmt.Errorf("no PNG/JPEG/WebP files under %s", cfg.corpus)
+	}
+
+	res := &Results{
+		CreatedAt: time.Now().UTC().Format(time.RFC3339),
+		Quality:   cfg.quality,
+		Method:    cfg.method,
+		Lossless:  cfg.lossless,
+		Runs:      cfg.runs,
+	}
+	opts := cfg.encoderOptions()
+	for _, f := range files {
+		fr, err := measureFile(f, opts, cfg.runs)
+		if err != nil {
+			fmt.Fprintf(os.Stderr, "webpbench: %s: %v (skipped)\n", f.relPath, err)
+			continue
+		}
+		res.Files = append(res.Files, fr)
+	}
+	if len(res.Files) == 0 {
+		return fmt.Errorf("no file in %s could be measured", cfg.corpus)
+	}
+
+	printSummary(w, res)
+
+	if cfg.baseline != "" {
+		base, err := loadResults(cfg.baseline)
+		if err != nil {
+			return fmt.Errorf("loading baseline: %w", err)
+		}
+		deltas := diffResults(base, res)
+		printDeltas(w, deltas)
+		if worst := worstRegression(deltas); worst != nil && cfg.profileDir != "" {
+			target := findFile(files, worst.Path)
+			if target == nil {
+				return fmt.Errorf("worst regression %s not found in corpus", worst.Path)
+			}
+			fmt.Fprintf(w, "profiling worst regression %s (%s %.2fx)\n",
+				worst.Path, worst.Metric, worst.Ratio)
+			if err := captureProfiles(cfg.profileDir, *target, opts, cfg.runs); err != nil {
+				return fmt.Errorf("capturing profiles: %w", err)
+			}
+		}
+	}
+
+	if cfg.out != "" {
+		if err := writeResults(cfg.out, res); err != nil {
+			return fmt.Errorf("writing results: %w", err)
+		}
+	}
+	return nil
+}
+
+// collectCorpus walks root and returns the measurable files sorted by
+// relative path, categorized by their first-level subdirectory.
+func collectCorpus(root string) ([]corpusFile, error) {
+	var files []corpusFile
+	err := filepath.WalkDir(root, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			return err
+		}
+		if d.IsDir() {
+			return nil
+		}
+		switch strings.ToLower(filepath.Ext(path)) {
+		case ".png", ".jpg", ".jpeg", ".webp":
+		default:
+			return nil
+		}
+		rel, err := filepath.Rel(root, path)
+		if err != nil {
+			return err
+		}
+		category := "uncategorized"
+		if dir, _ := filepath.Split(rel); dir != "" {
+			category = strings.Split(filepath.ToSlash(dir), "/")[0]
+		}
+		files = append(files, corpusFile{path: path, relPath: filepath.ToSlash(rel), category: category})
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	sort.Slice(files, func(i, j int) bool { return files[i].relPath < files[j].relPath })
+	return files, nil
+}
+
+// measureFile benchmarks one corpus entry. Still images are re-encoded
+// with opts and measured end to end; animated WebP files are timed
+// decode-only since the encoder has no animation assembly of its own to
+// compare against.
+func measureFile(f corpusFile, opts *webp.EncoderOptions, runs int) (FileResult, error) {
+	data, err := os.ReadFile(f.path)
+	if err != nil {
+		return FileResult{}, err
+	}
+	if strings.EqualFold(filepath.Ext(f.path), ".webp") {
+		feat, err := webp.GetFeatures(bytes.NewReader(data))
+		if err != nil {
+			return FileResult{}, err
+		}
+		if feat.HasAnimation {
+			return measureAnimation(f, data, runs)
+		}
+	}
+	img, _, err := image.Decode(bytes.NewReader(data))
+	if err != nil {
+		return FileResult{}, err
+	}
+	return measureStill(f, img, opts, runs)
+}
+
+func measureStill(f corpusFile, img image.Image, opts *webp.EncoderOptions, runs int) (FileResult, error) {
+	bounds := img.Bounds()
+	fr := FileResult{
+		Path:     f.relPath,
+		Category: f.category,
+		Width:    bounds.Dx(),
+		Height:   bounds.Dy(),
+		Frames:   1,
+	}
+
+	var buf bytes.Buffer
+	var encErr error
+	encode := func() {
+		buf.Reset()
+		encErr = webp.Encode(&buf, img, opts)
+	}
+	encode()
+	if encErr != nil {
+		return FileResult{}, fmt.Errorf("encode: %w", encErr)
+	}
+	encoded := append([]byte(nil), buf.Bytes()...)
+	fr.OutputBytes = int64(len(encoded))
+
+	var dec image.Image
+	var decErr error
+	decode := func() { dec, decErr = webp.Decode(bytes.NewReader(encoded)) }
+	decode()
+	if decErr != nil {
+		return FileResult{}, fmt.Errorf("decode: %w", decErr)
+	}
+
+	fr.EncodeNS = timeRuns(runs, encode)
+	fr.DecodeNS = timeRuns(runs, decode)
+	fr.EncodeAllocs = countAllocs(encode)
+	fr.DecodeAllocs = countAllocs(decode)
+
+	srcY := lumaPlane(img)
+	decY := lumaPlane(dec)
+	w, h := fr.Width, fr.Height
+	fr.PSNR = dsp.PSNRFromSSE(dsp.SSE(decY, srcY, w, h, w, w), w*h)
+	fr.SSIM = dsp.SSIMFromBlocks(decY, srcY, w, h, w, w)
+	return fr, nil
+}
+
+func measureAnimation(f corpusFile, data []byte, runs int) (FileResult, error) {
+	var anim *animation.Animation
+	var decErr error
+	decode := func() { anim, decErr = animation.DecodeBytes(data) }
+	decode()
+	if decErr != nil {
+		return FileResult{}, fmt.Errorf("animation decode: %w", decErr)
+	}
+	return FileResult{
+		Path:         f.relPath,
+		Category:     f.category,
+		Width:        anim.CanvasWidth,
+		Height:       anim.CanvasHeight,
+		Frames:       len(anim.Frames),
+		OutputBytes:  int64(len(data)),
+		DecodeNS:     timeRuns(runs, decode),
+		DecodeAllocs: countAllocs(decode),
+	}, nil
+}
+
+// lumaPlane converts img to a tightly packed BT.601 luma plane for the
+// PSNR/SSIM comparisons, matching the weights the encoder's RGB->YUV
+// conversion uses.
+func lumaPlane(img image.Image) []byte {
+	bounds := img.Bounds()
+	w, h := bounds.Dx(), bounds.Dy()
+	nrgba, ok := img.(*image.NRGBA)
+	if !ok {
+		nrgba = image.NewNRGBA(image.Rect(0, 0, w, h))
+		draw.Draw(nrgba, nrgba.Bounds(), img, bounds.Min, draw.Src)
+	}
+	out := make([]byte, w*h)
+	for y := 0; y < h; y++ {
+		row := nrgba.Pix[y*nrgba.Stride:]
+		for x := 0; x < w; x++ {
+			r, g, b := uint32(row[x*4]), uint32(row[x*4+1]), uint32(row[x*4+2])
+			out[y*w+x] = byte((19595*r + 38470*g + 7471*b + 1<<15) >> 16)
+		}
+	}
+	return out
+}
+
+func findFile(files []corpusFile, relPath string) *corpusFile {
+	for i := range files {
+		if files[i].relPath == relPath {
+			return &files[i]
+		}
+	}
+	return nil
+}
@@ -0,0 +1,215 @@
+package main
+
+import (
+	"bytes"
+	"encoding/binary"
+	"image"
+	"image/color"
+	"image/png"
+	"io"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/deepteams/webp"
+	"github.com/deepteams/webp/mux"
+)
+
+func writePNG(t *testing.T, path string, img image.Image) {
+	t.Helper()
+	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+		t.Fatal(err)
+	}
+	var buf bytes.Buffer
+	if err := png.Encode(&buf, img); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(path, buf.Bytes(), 0o644); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func gradientPNG(w, h int) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			img.SetNRGBA(x, y, color.NRGBA{
+				R: uint8(x * 255 / w),
+				G: uint8(y * 255 / h),
+				B: uint8((x + y) % 256),
+				A: 255,
+			})
+		}
+	}
+	return img
+}
+
+func TestNewSample(t *testing.T) {
+	s := newSample([]float64{1, 2, 3})
+	if s.N != 3 || s.Mean != 2 {
+		t.Errorf("got N=%d mean=%v, want N=3 mean=2", s.N, s.Mean)
+	}
+	if s.StdDev != 1 {
+		t.Errorf("StdDev = %v, want 1", s.StdDev)
+	}
+	if s := newSample(nil); s.N != 0 || s.Mean != 0 {
+		t.Errorf("empty sample = %+v, want zero", s)
+	}
+}
+
+func TestSignificantlyDifferent(t *testing.T) {
+	tight := func(mean float64) Sample { return Sample{Mean: mean, StdDev: 1, N: 5} }
+	if !significantlyDifferent(tight(100), tight(200)) {
+		t.Error("well-separated tight samples not flagged")
+	}
+	if significantlyDifferent(tight(100), tight(100)) {
+		t.Error("identical samples flagged")
+	}
+	wide := Sample{Mean: 100, StdDev: 500, N: 5}
+	if significantlyDifferent(wide, Sample{Mean: 130, StdDev: 500, N: 5}) {
+		t.Error("noise-dominated difference flagged")
+	}
+	// Single observations have no spread: any change counts.
+	if !significantlyDifferent(Sample{Mean: 10, N: 1}, Sample{Mean: 11, N: 1}) {
+		t.Error("differing single observations not flagged")
+	}
+}
+
+func TestCollectCorpus(t *testing.T) {
+	root := t.TempDir()
+	writePNG(t, filepath.Join(root, "photo", "a.png"), gradientPNG(8, 8))
+	writePNG(t, filepath.Join(root, "photo", "nested", "b.png"), gradientPNG(8, 8))
+	writePNG(t, filepath.Join(root, "c.png"), gradientPNG(8, 8))
+	if err := os.WriteFile(filepath.Join(root, "notes.txt"), []byte("x"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+
+	files, err := collectCorpus(root)
+	if err != nil {
+		t.Fatalf("collectCorpus: %v", err)
+	}
+	if len(files) != 3 {
+		t.Fatalf("found %d files, want 3", len(files))
+	}
+	want := map[string]string{
+		"c.png":              "uncategorized",
+		"photo/a.png":        "photo",
+		"photo/nested/b.png": "photo",
+	}
+	for _, f := range files {
+		if cat, ok := want[f.relPath]; !ok || cat != f.category {
+			t.Errorf("%s categorized as %q, want %q", f.relPath, f.category, cat)
+		}
+	}
+}
+
+func TestRunCorpusAndDiff(t *testing.T) {
+	root := t.TempDir()
+	writePNG(t, filepath.Join(root, "photo", "grad.png"), gradientPNG(96, 64))
+	writePNG(t, filepath.Join(root, "icon", "flat.png"), image.NewNRGBA(image.Rect(0, 0, 32, 32)))
+
+	outPath := filepath.Join(t.TempDir(), "results.json")
+	cfg := &runConfig{corpus: root, out: outPath, quality: 75, method: 2, runs: 2}
+	if err := run(cfg, io.Discard); err != nil {
+		t.Fatalf("run: %v", err)
+	}
+
+	res, err := loadResults(outPath)
+	if err != nil {
+		t.Fatalf("loadResults: %v", err)
+	}
+	if len(res.Files) != 2 {
+		t.Fatalf("measured %d files, want 2", len(res.Files))
+	}
+	for _, f := range res.Files {
+		if f.OutputBytes <= 0 {
+			t.Errorf("%s: OutputBytes = %d", f.Path, f.OutputBytes)
+		}
+		if f.EncodeNS.N != 2 || f.DecodeNS.N != 2 {
+			t.Errorf("%s: sample sizes (%d, %d), want (2, 2)", f.Path, f.EncodeNS.N, f.DecodeNS.N)
+		}
+		if f.PSNR < 20 || f.SSIM < 0.5 {
+			t.Errorf("%s: PSNR=%.1f SSIM=%.3f implausibly low", f.Path, f.PSNR, f.SSIM)
+		}
+	}
+	cats := summarize(res)
+	if len(cats) != 2 || cats[0].category != "icon" || cats[1].category != "photo" {
+		t.Fatalf("summary categories = %+v, want icon then photo", cats)
+	}
+
+	// Against itself nothing regresses; against a 10x-faster baseline
+	// every encode time is a significant regression.
+	if worst := worstRegression(diffResults(res, res)); worst != nil {
+		t.Errorf("self-diff reported regression: %+v", *worst)
+	}
+	base := *res
+	base.Files = append([]FileResult(nil), res.Files...)
+	for i := range base.Files {
+		base.Files[i].EncodeNS = Sample{Mean: base.Files[i].EncodeNS.Mean / 10, StdDev: 1, N: 5}
+	}
+	worst := worstRegression(diffResults(&base, res))
+	if worst == nil {
+		t.Fatal("deflated baseline produced no regression")
+	}
+	if worst.Metric != "encode_ns" || worst.Ratio < 5 {
+		t.Errorf("worst regression = %+v, want encode_ns with ratio near 10", *worst)
+	}
+
+	profDir := filepath.Join(t.TempDir(), "prof")
+	target := corpusFile{path: filepath.Join(root, worst.Path), relPath: worst.Path, category: "photo"}
+	if err := captureProfiles(profDir, target, cfg.encoderOptions(), 1); err != nil {
+		t.Fatalf("captureProfiles: %v", err)
+	}
+	for _, name := range []string{"cpu.pprof", "heap.pprof"} {
+		st, err := os.Stat(filepath.Join(profDir, name))
+		if err != nil || st.Size() == 0 {
+			t.Errorf("profile %s missing or empty (err=%v)", name, err)
+		}
+	}
+}
+
+func TestMeasureAnimation(t *testing.T) {
+	// Assemble a two-frame animation from a still lossy encode's VP8
+	// payload (a simple-format file is RIFF header + one VP8 chunk).
+	var still bytes.Buffer
+	if err := webp.Encode(&still, gradientPNG(48, 48), &webp.EncoderOptions{Quality: 75}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	data := still.Bytes()
+	payloadLen := binary.LittleEndian.Uint32(data[16:20])
+	payload := data[20 : 20+payloadLen]
+
+	m := mux.NewMuxer()
+	for i := 0; i < 2; i++ {
+		if err := m.AddFrame(payload, &mux.FrameOptions{Duration: 40}); err != nil {
+			t.Fatalf("AddFrame: %v", err)
+		}
+	}
+	var anim bytes.Buffer
+	if err := m.Assemble(&anim); err != nil {
+		t.Fatalf("Assemble: %v", err)
+	}
+
+	root := t.TempDir()
+	path := filepath.Join(root, "animation", "loop.webp")
+	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(path, anim.Bytes(), 0o644); err != nil {
+		t.Fatal(err)
+	}
+
+	fr, err := measureFile(corpusFile{path: path, relPath: "animation/loop.webp", category: "animation"}, nil, 2)
+	if err != nil {
+		t.Fatalf("measureFile: %v", err)
+	}
+	if fr.Frames != 2 {
+		t.Errorf("Frames = %d, want 2", fr.Frames)
+	}
+	if fr.DecodeNS.N != 2 || fr.EncodeNS.N != 0 {
+		t.Errorf("sample sizes (dec=%d, enc=%d), want (2, 0)", fr.DecodeNS.N, fr.EncodeNS.N)
+	}
+	if fr.OutputBytes != int64(anim.Len()) {
+		t.Errorf("OutputBytes = %d, want %d", fr.OutputBytes, anim.Len())
+	}
+}
@@ -0,0 +1,297 @@
+package main
+
+import (
+	"encoding/json"
+	"fmt"
+	"io"
+	"math"
+	"os"
+	"path/filepath"
+	"runtime"
+	"runtime/pprof"
+	"sort"
+	"time"
+
+	"github.com/deepteams/webp"
+)
+
+// Results is the machine-readable output of one benchmark run, and the
+// input format for -baseline.
+type Results struct {
+	CreatedAt string  `json:"created_at"`
+	Quality   float64 `json:"quality"`
+	Method    int     `json:"method"`
+	Lossless  bool    `json:"lossless"`
+	Runs      int     `json:"runs"`
+
+	Files []FileResult `json:"files"`
+}
+
+// FileResult holds the measurements for one corpus file. Animated
+// inputs are decode-only: EncodeNS, EncodeAllocs, PSNR, and SSIM stay
+// zero and OutputBytes is the source file size.
+type FileResult struct {
+	Path     string `json:"path"`
+	Category string `json:"category"`
+	Width    int    `json:"width"`
+	Height   int    `json:"height"`
+	Frames   int    `json:"frames"`
+
+	EncodeNS     Sample `json:"encode_ns"`
+	DecodeNS     Sample `json:"decode_ns"`
+	OutputBytes  int64  `json:"output_bytes"`
+	EncodeAllocs uint64 `json:"encode_allocs"`
+	DecodeAllocs uint64 `json:"decode_allocs"`
+
+	PSNR float64 `json:"psnr"`
+	SSIM float64 `json:"ssim"`
+}
+
+// Sample summarizes repeated timing measurements of one operation.
+type Sample struct {
+	Mean   float64 `json:"mean"`
+	StdDev float64 `json:"std_dev"`
+	N      int     `json:"n"`
+}
+
+func newSample(v []float64) Sample {
+	s := Sample{N: len(v)}
+	if s.N == 0 {
+		return s
+	}
+	for _, x := range v {
+		s.Mean += x
+	}
+	s.Mean /= float64(s.N)
+	if s.N > 1 {
+		var ss float64
+		for _, x := range v {
+			d := x - s.Mean
+			ss += d * d
+		}
+		s.StdDev = math.Sqrt(ss / float64(s.N-1))
+	}
+	return s
+}
+
+// stdErr is the standard error of the mean, the yardstick for the
+// significance test in significantlyDifferent.
+func (s Sample) stdErr() float64 {
+	if s.N <= 1 {
+		return 0
+	}
+	return s.StdDev / math.Sqrt(float64(s.N))
+}
+
+// timeRuns invokes f runs times and summarizes the wall-clock durations.
+func timeRuns(runs int, f func()) Sample {
+	samples := make([]float64, runs)
+	for i := range samples {
+		start := time.Now()
+		f()
+		samples[i] = float64(time.Since(start).Nanoseconds())
+	}
+	return newSample(samples)
+}
+
+// countAllocs reports the heap allocations of a single call to f,
+// serialized to one processor so background goroutines do not pollute
+// the count (same approach as testing.AllocsPerRun).
+func countAllocs(f func()) uint64 {
+	defer runtime.GOMAXPROCS(runtime.GOMAXPROCS(1))
+	runtime.GC()
+	var before, after runtime.MemStats
+	runtime.ReadMemStats(&before)
+	f()
+	runtime.ReadMemStats(&after)
+	return after.Mallocs - before.Mallocs
+}
+
+func writeResults(path string, res *Results) error {
+	data, err := json.MarshalIndent(res, "", "  ")
+	if err != nil {
+		return err
+	}
+	return os.WriteFile(path, append(data, '\n'), 0o644)
+}
+
+func loadResults(path string) (*Results, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	var res Results
+	if err := json.Unmarshal(data, &res); err != nil {
+		return nil, fmt.Errorf("%s: %w", path, err)
+	}
+	return &res, nil
+}
+
+// categorySummary aggregates per-category means for the summary table.
+type categorySummary struct {
+	category string
+	files    int
+	encodeMS float64
+	decodeMS float64
+	bytes    int64
+	psnr     float64
+	ssim     float64
+	stills   int // files contributing to encodeMS/psnr/ssim
+}
+
+func summarize(res *Results) []categorySummary {
+	byCat := make(map[string]*categorySummary)
+	for _, f := range res.Files {
+		c := byCat[f.Category]
+		if c == nil {
+			c = &categorySummary{category: f.Category}
+			byCat[f.Category] = c
+		}
+		c.files++
+		c.decodeMS += f.DecodeNS.Mean / 1e6
+		c.bytes += f.OutputBytes
+		if f.EncodeNS.N > 0 {
+			c.stills++
+			c.encodeMS += f.EncodeNS.Mean / 1e6
+			c.psnr += f.PSNR
+			c.ssim += f.SSIM
+		}
+	}
+	out := make([]categorySummary, 0, len(byCat))
+	for _, c := range byCat {
+		c.decodeMS /= float64(c.files)
+		if c.stills > 0 {
+			c.encodeMS /= float64(c.stills)
+			c.psnr /= float64(c.stills)
+			c.ssim /= float64(c.stills)
+		}
+		out = append(out, *c)
+	}
+	sort.Slice(out, func(i, j int) bool { return out[i].category < out[j].category })
+	return out
+}
+
+func printSummary(w io.Writer, res *Results) {
+	fmt.Fprintf(w, "category\tfiles\tenc_ms\tdec_ms\tbytes\tpsnr\tssim\n")
+	for _, c := range summarize(res) {
+		fmt.Fprintf(w, "%s\t%d\t%.2f\t%.2f\t%d\t%.2f\t%.4f\n",
+			c.category, c.files, c.encodeMS, c.decodeMS, c.bytes, c.psnr, c.ssim)
+	}
+}
+
+// delta is one per-file metric compared between a baseline and the
+// current run. Ratio is current/baseline; >1 means a regression for
+// time and size metrics.
+type delta struct {
+	Path        string
+	Metric      string
+	Base, Cur   Sample
+	Ratio       float64
+	Significant bool
+}
+
+// significantlyDifferent applies a two-sided Welch-style test at
+// roughly 95% confidence: the means must differ by more than twice the
+// combined standard error. Single-run samples have no spread to judge
+// against, so any difference between them counts.
+func significantlyDifferent(a, b Sample) bool {
+	if a.N == 0 || b.N == 0 {
+		return false
+	}
+	se := math.Sqrt(a.stdErr()*a.stdErr() + b.stdErr()*b.stdErr())
+	if se == 0 {
+		return a.Mean != b.Mean
+	}
+	return math.Abs(a.Mean-b.Mean) > 2*se
+}
+
+// diffResults compares the current run against a baseline, matching
+// files by corpus-relative path. Files present in only one run are
+// skipped: they carry no regression signal.
+func diffResults(base, cur *Results) []delta {
+	baseByPath := make(map[string]FileResult, len(base.Files))
+	for _, f := range base.Files {
+		baseByPath[f.Path] = f
+	}
+	var deltas []delta
+	for _, f := range cur.Files {
+		b, ok := baseByPath[f.Path]
+		if !ok {
+			continue
+		}
+		add := func(metric string, bs, cs Sample) {
+			if bs.N == 0 || cs.N == 0 || bs.Mean == 0 {
+				return
+			}
+			deltas = append(deltas, delta{
+				Path:        f.Path,
+				Metric:      metric,
+				Base:        bs,
+				Cur:         cs,
+				Ratio:       cs.Mean / bs.Mean,
+				Significant: significantlyDifferent(bs, cs),
+			})
+		}
+		add("encode_ns", b.EncodeNS, f.EncodeNS)
+		add("decode_ns", b.DecodeNS, f.DecodeNS)
+		add("output_bytes",
+			Sample{Mean: float64(b.OutputBytes), N: 1},
+			Sample{Mean: float64(f.OutputBytes), N: 1})
+	}
+	return deltas
+}
+
+func printDeltas(w io.Writer, deltas []delta) {
+	fmt.Fprintf(w, "path\tmetric\tbase\tcurrent\tratio\tsignificant\n")
+	for _, d := range deltas {
+		fmt.Fprintf(w, "%s\t%s\t%.0f\t%.0f\t%.3f\t%v\n",
+			d.Path, d.Metric, d.Base.Mean, d.Cur.Mean, d.Ratio, d.Significant)
+	}
+}
+
+// worstRegression picks the significant timing delta with the largest
+// slowdown ratio, or nil if nothing significantly regressed. Size
+// deltas are excluded: profiling explains time, not bytes.
+func worstRegression(deltas []delta) *delta {
+	var worst *delta
+	for i := range deltas {
+		d := &deltas[i]
+		if !d.Significant || d.Ratio <= 1 || d.Metric == "output_bytes" {
+			continue
+		}
+		if worst == nil || d.Ratio > worst.Ratio {
+			worst = d
+		}
+	}
+	return worst
+}
+
+// captureProfiles re-runs the regressed file's measured operations
+// under the CPU profiler and snapshots the heap afterwards, writing
+// cpu.pprof and heap.pprof into dir.
+func captureProfiles(dir string, f corpusFile, opts *webp.EncoderOptions, runs int) error {
+	if err := os.MkdirAll(dir, 0o755); err != nil {
+		return err
+	}
+	cpu, err := os.Create(filepath.Join(dir, "cpu.pprof"))
+	if err != nil {
+		return err
+	}
+	defer cpu.Close()
+	if err := pprof.StartCPUProfile(cpu); err != nil {
+		return err
+	}
+	_, measureErr := measureFile(f, opts, runs)
+	pprof.StopCPUProfile()
+	if measureErr != nil {
+		return measureErr
+	}
+
+	heap, err := os.Create(filepath.Join(dir, "heap.pprof"))
+	if err != nil {
+		return err
+	}
+	defer heap.Close()
+	runtime.GC()
+	return pprof.WriteHeapProfile(heap)
+}
@@ -0,0 +1,149 @@
+package webp
+
+import (
+	"errors"
+	"fmt"
+	"image"
+	"io"
+
+	"github.com/deepteams/webp/internal/container"
+	"github.com/deepteams/webp/internal/lossless"
+	"github.com/deepteams/webp/internal/lossy"
+)
+
+// DecodeInto decodes a WebP image from r into a caller-provided destination
+// image, avoiding the per-decode output allocation of [Decode]. The
+// destination bounds must match the encoded dimensions exactly.
+//
+// Accepted destination types mirror what Decode returns:
+//   - *image.YCbCr with 4:2:0 subsampling for lossy images without alpha
+//   - *image.NRGBA for lossless images and for lossy images with alpha
+//
+// Additionally, a lossy image without alpha may be decoded into an
+// *image.NRGBA (the YUV→RGB conversion is performed in place).
+//
+// Internal scratch buffers are pooled, so steady-state decoding of
+// same-sized images performs no per-image heap allocation for pixel data.
+func DecodeInto(r io.Reader, dst image.Image) error {
+	if r == nil {
+		return errors.New("webp: nil reader")
+	}
+	if dst == nil {
+		return errors.New("webp: nil destination image")
+	}
+
+	var frame container.FrameInfo
+	if _, ok := r.(interface{ Len() int }); ok {
+		data, err := readAll(r)
+		if err != nil {
+			return fmt.Errorf("webp: reading data: %w", err)
+		}
+		p, err := container.NewParser(data)
+		if err != nil {
+			return fmt.Errorf("webp: parsing container: %w", err)
+		}
+		frames := p.Frames()
+		if len(frames) == 0 {
+			return ErrNoFrames
+		}
+		frame = frames[0]
+	} else {
+		p, err := container.NewStreamParser(r)
+		if err != nil {
+			return fmt.Errorf("webp: parsing container: %w", err)
+		}
+		frame, err = p.NextFrame()
+		if err == io.EOF {
+			return ErrNoFrames
+		}
+		if err != nil {
+			return fmt.Errorf("webp: parsing container: %w", err)
+		}
+	}
+
+	return decodeFrameInto(frame, dst)
+}
+
+// decodeFrameInto decodes a single frame into dst, dispatching on the
+// bitstream format and destination type.
+func decodeFrameInto(frame container.FrameInfo, dst image.Image) error {
+	if frame.IsLossless {
+		nrgba, ok := dst.(*image.NRGBA)
+		if !ok {
+			return fmt.Errorf("webp: lossless image requires *image.NRGBA destination, got %T", dst)
+		}
+		if err := lossless.DecodeVP8LInto(frame.Payload, nrgba); err != nil {
+			return fmt.Errorf("webp: lossless decode: %w", err)
+		}
+		return nil
+	}
+	return decodeLossyInto(frame.Payload, frame.AlphaData, dst)
+}
+
+// decodeLossyInto decodes a VP8 lossy bitstream into dst.
+func decodeLossyInto(data, alphaData []byte, dst image.Image) error {
+	dec, width, height, yPlane, yStride, uPlane, vPlane, uvStride, err := lossy.DecodeFrame(data)
+	if err != nil {
+		return fmt.Errorf("webp: lossy decode: %w", err)
+	}
+	defer lossy.ReleaseDecoder(dec)
+
+	var alphaPlane []byte
+	if len(alphaData) > 0 {
+		alphaPlane, err = lossy.DecodeAlpha(alphaData, width, height)
+		if err != nil {
+			return fmt.Errorf("webp: alpha decode: %w", err)
+		}
+	}
+
+	switch d := dst.(type) {
+	case *image.YCbCr:
+		if alphaPlane != nil {
+			return errors.New("webp: image has alpha; use an *image.NRGBA destination")
+		}
+		return copyYCbCrInto(d, width, height, yPlane, yStride, uPlane, vPlane, uvStride)
+
+	case *image.NRGBA:
+		if d.Rect.Dx() != width || d.Rect.Dy() != height {
+			return fmt.Errorf("webp: destination size %dx%d does not match image %dx%d",
+				d.Rect.Dx(), d.Rect.Dy(), width, height)
+		}
+		renderNRGBA(d, width, height, yPlane, yStride, uPlane, vPlane, uvStride, alphaPlane)
+		return nil
+
+	default:
+		return fmt.Errorf("webp: unsupported destination type %T", dst)
+	}
+}
+
+// copyYCbCrInto copies the decoder's Y/U/V cache planes into a
+// caller-provided 4:2:0 image.YCbCr, honouring the destination strides.
+func copyYCbCrInto(dst *image.YCbCr, width, height int, yPlane []byte, yStride int, uPlane, vPlane []byte, uvStride int) error {
+	if dst.SubsampleRatio != image.YCbCrSubsampleRatio420 {
+		return fmt.Errorf("webp: destination subsample ratio %v, want 4:2:0", dst.SubsampleRatio)
+	}
+	if dst.Rect.Dx() != width || dst.Rect.Dy() != height {
+		return fmt.Errorf("webp: destination size %dx%d does not match image %dx%d",
+			dst.Rect.Dx(), dst.Rect.Dy(), width, height)
+	}
+
+	chromaW := (width + 1) / 2
+	chromaH := (height + 1) / 2
+
+	yBase := dst.YOffset(dst.Rect.Min.X, dst.Rect.Min.Y)
+	cBase := dst.COffset(dst.Rect.Min.X, dst.Rect.Min.Y)
+	if yBase+(height-1)*dst.YStride+width > len(dst.Y) ||
+		cBase+(chromaH-1)*dst.CStride+chromaW > len(dst.Cb) ||
+		cBase+(chromaH-1)*dst.CStride+chromaW > len(dst.Cr) {
+		return errors.New("webp: destination planes too small")
+	}
+
+	for y := 0; y < height; y++ {
+		copy(dst.Y[yBase+y*dst.YStride:], yPlane[y*yStride:y*yStride+width])
+	}
+	for y := 0; y < chromaH; y++ {
+		copy(dst.Cb[cBase+y*dst.CStride:], uPlane[y*uvStride:y*uvStride+chromaW])
+		copy(dst.Cr[cBase+y*dst.CStride:], vPlane[y*uvStride:y*uvStride+chromaW])
+	}
+	return nil
+}
@@ -0,0 +1,121 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"testing"
+)
+
+func TestDecodeInto_Lossless(t *testing.T) {
+	data := readTestFile(t, "gradient_8x8_lossless.webp")
+
+	want, err := Decode(bytes.NewReader(data))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+
+	dst := image.NewNRGBA(image.Rect(0, 0, 8, 8))
+	if err := DecodeInto(bytes.NewReader(data), dst); err != nil {
+		t.Fatalf("DecodeInto: %v", err)
+	}
+
+	wantNRGBA := want.(*image.NRGBA)
+	if !bytes.Equal(dst.Pix, wantNRGBA.Pix) {
+		t.Error("DecodeInto pixels differ from Decode")
+	}
+}
+
+func TestDecodeInto_LossyYCbCr(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+
+	want, err := Decode(bytes.NewReader(data))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	wantYCbCr := want.(*image.YCbCr)
+
+	dst := image.NewYCbCr(image.Rect(0, 0, 16, 16), image.YCbCrSubsampleRatio420)
+	if err := DecodeInto(bytes.NewReader(data), dst); err != nil {
+		t.Fatalf("DecodeInto: %v", err)
+	}
+
+	if !bytes.Equal(dst.Y, wantYCbCr.Y) || !bytes.Equal(dst.Cb, wantYCbCr.Cb) || !bytes.Equal(dst.Cr, wantYCbCr.Cr) {
+		t.Error("DecodeInto planes differ from Decode")
+	}
+}
+
+func TestDecodeInto_LossyNRGBA(t *testing.T) {
+	// A lossy image without alpha may also be decoded straight to NRGBA.
+	data := readTestFile(t, "red_4x4_lossy.webp")
+
+	dst := image.NewNRGBA(image.Rect(0, 0, 4, 4))
+	if err := DecodeInto(bytes.NewReader(data), dst); err != nil {
+		t.Fatalf("DecodeInto: %v", err)
+	}
+	if dst.Pix[3] != 255 {
+		t.Errorf("alpha = %d, want 255 (opaque)", dst.Pix[3])
+	}
+	if dst.Pix[0] < 200 {
+		t.Errorf("red channel = %d, want a red pixel", dst.Pix[0])
+	}
+}
+
+func TestDecodeInto_Reuse(t *testing.T) {
+	// The same destination must be reusable across decodes of same-sized
+	// images; the second decode should fully overwrite the first.
+	red := readTestFile(t, "red_4x4_lossy.webp")
+	lossless := readTestFile(t, "red_4x4_lossless.webp")
+
+	dst := image.NewNRGBA(image.Rect(0, 0, 4, 4))
+	if err := DecodeInto(bytes.NewReader(red), dst); err != nil {
+		t.Fatalf("first DecodeInto: %v", err)
+	}
+	if err := DecodeInto(bytes.NewReader(lossless), dst); err != nil {
+		t.Fatalf("second DecodeInto: %v", err)
+	}
+
+	want, err := Decode(bytes.NewReader(lossless))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	if !bytes.Equal(dst.Pix, want.(*image.NRGBA).Pix) {
+		t.Error("reused destination differs from fresh Decode")
+	}
+}
+
+func TestDecodeInto_SizeMismatch(t *testing.T) {
+	data := readTestFile(t, "red_4x4_lossy.webp")
+
+	dst := image.NewYCbCr(image.Rect(0, 0, 8, 8), image.YCbCrSubsampleRatio420)
+	if err := DecodeInto(bytes.NewReader(data), dst); err == nil {
+		t.Fatal("expected error for mismatched destination size")
+	}
+
+	nrgba := image.NewNRGBA(image.Rect(0, 0, 8, 8))
+	if err := DecodeInto(bytes.NewReader(readTestFile(t, "red_4x4_lossless.webp")), nrgba); err == nil {
+		t.Fatal("expected error for mismatched lossless destination size")
+	}
+}
+
+func TestDecodeInto_WrongType(t *testing.T) {
+	data := readTestFile(t, "red_4x4_lossless.webp")
+
+	dst := image.NewYCbCr(image.Rect(0, 0, 4, 4), image.YCbCrSubsampleRatio420)
+	if err := DecodeInto(bytes.NewReader(data), dst); err == nil {
+		t.Fatal("expected error for lossless into *image.YCbCr")
+	}
+
+	gray := image.NewGray(image.Rect(0, 0, 4, 4))
+	if err := DecodeInto(bytes.NewReader(readTestFile(t, "red_4x4_lossy.webp")), gray); err == nil {
+		t.Fatal("expected error for unsupported destination type")
+	}
+}
+
+func TestDecodeInto_NilArgs(t *testing.T) {
+	if err := DecodeInto(nil, image.NewNRGBA(image.Rect(0, 0, 1, 1))); err == nil {
+		t.Fatal("expected error for nil reader")
+	}
+	if err := DecodeInto(bytes.NewReader(nil), nil); err == nil {
+		t.Fatal("expected error for nil destination")
+	}
+}
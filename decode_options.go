@@ -0,0 +1,291 @@
+package webp
+
+import (
+	"errors"
+	"fmt"
+	"image"
+	"io"
+
+	"github.com/deepteams/webp/internal/container"
+	"github.com/deepteams/webp/internal/dsp"
+	"github.com/deepteams/webp/internal/lossless"
+	"github.com/deepteams/webp/internal/lossy"
+)
+
+// DecodeOptions configures a [DecodeWithOptions] call.
+type DecodeOptions struct {
+	// Crop requests decoding of a sub-rectangle of the image. The zero
+	// rectangle disables cropping. The rectangle must lie within the image
+	// bounds; rows below it are never decoded. Odd Min coordinates are
+	// rounded down to the nearest even value so the window stays aligned
+	// with the 4:2:0 chroma grid.
+	Crop image.Rectangle
+
+	// ScaledWidth and ScaledHeight request decode-time downscaling to the
+	// given size. If one of them is zero it is derived from the other,
+	// preserving aspect ratio. Both zero (the default) disables scaling.
+	// Upscaling is not supported: the target size must not exceed the
+	// image (or crop window) size. Scaling applies after cropping.
+	ScaledWidth  int
+	ScaledHeight int
+}
+
+// DecodeWithOptions reads a WebP image from r, applying the given options.
+// Cropping stops decoding below the window and limits loop filtering to
+// the macroblocks the window touches. With scaling requested, rescaling is
+// fused into the output path: the Y/U/V (and alpha) planes are box-filtered
+// to the target size before any color conversion, so no full-size RGB
+// intermediate is materialized and upsampling work is only done for pixels
+// that are kept. A nil opts is equivalent to [Decode].
+func DecodeWithOptions(r io.Reader, opts *DecodeOptions) (image.Image, error) {
+	if r == nil {
+		return nil, errors.New("webp: nil reader")
+	}
+	hasCrop := opts != nil && opts.Crop != image.Rectangle{}
+	hasScale := opts != nil && (opts.ScaledWidth != 0 || opts.ScaledHeight != 0)
+	if !hasCrop && !hasScale {
+		return Decode(r)
+	}
+	if hasScale && (opts.ScaledWidth < 0 || opts.ScaledHeight < 0) {
+		return nil, fmt.Errorf("webp: invalid scaled dimensions %dx%d", opts.ScaledWidth, opts.ScaledHeight)
+	}
+
+	frame, err := firstFrame(r)
+	if err != nil {
+		return nil, err
+	}
+
+	// Resolve the crop window (full frame when cropping is off), snapping
+	// the top-left corner to the chroma grid.
+	crop := image.Rect(0, 0, frame.Width, frame.Height)
+	if hasCrop {
+		crop = opts.Crop
+		crop.Min.X &^= 1
+		crop.Min.Y &^= 1
+		if crop.Empty() || !crop.In(image.Rect(0, 0, frame.Width, frame.Height)) {
+			return nil, fmt.Errorf("webp: crop %v exceeds image %dx%d", opts.Crop, frame.Width, frame.Height)
+		}
+	}
+
+	scaledW, scaledH := crop.Dx(), crop.Dy()
+	if hasScale {
+		scaledW, scaledH = dsp.RescalerGetScaledDimensions(
+			crop.Dx(), crop.Dy(), opts.ScaledWidth, opts.ScaledHeight)
+		if scaledW > crop.Dx() || scaledH > crop.Dy() {
+			return nil, fmt.Errorf("webp: scaled dimensions %dx%d exceed source %dx%d (upscaling not supported)",
+				scaledW, scaledH, crop.Dx(), crop.Dy())
+		}
+	}
+
+	if frame.IsLossless {
+		var img *image.NRGBA
+		if hasCrop {
+			img, err = lossless.DecodeVP8LCropped(frame.Payload, crop.Min.X, crop.Min.Y, crop.Dx(), crop.Dy())
+		} else if hasScale {
+			// Fused scaling: rescale during pixel emission.
+			return decodeLosslessScaledOnly(frame.Payload, scaledW, scaledH)
+		}
+		if err != nil {
+			return nil, fmt.Errorf("webp: lossless decode: %w", err)
+		}
+		if hasScale {
+			return rescaleNRGBA(img, scaledW, scaledH), nil
+		}
+		return img, nil
+	}
+	if hasCrop && crop == image.Rect(0, 0, frame.Width, frame.Height) {
+		hasCrop = false // crop covers the whole frame
+	}
+	return decodeLossyWindow(frame.Payload, frame.AlphaData, crop, hasCrop, hasScale, scaledW, scaledH)
+}
+
+// decodeLosslessScaledOnly handles the scale-without-crop lossless path.
+func decodeLosslessScaledOnly(payload []byte, scaledW, scaledH int) (image.Image, error) {
+	img, err := lossless.DecodeVP8LScaled(payload, scaledW, scaledH)
+	if err != nil {
+		return nil, fmt.Errorf("webp: lossless decode: %w", err)
+	}
+	return img, nil
+}
+
+// firstFrame extracts the first image frame from r, streaming when the
+// reader is not already in memory.
+func firstFrame(r io.Reader) (container.FrameInfo, error) {
+	if _, ok := r.(interface{ Len() int }); ok {
+		data, err := readAll(r)
+		if err != nil {
+			return container.FrameInfo{}, fmt.Errorf("webp: reading data: %w", err)
+		}
+		p, err := container.NewParser(data)
+		if err != nil {
+			return container.FrameInfo{}, fmt.Errorf("webp: parsing container: %w", err)
+		}
+		frames := p.Frames()
+		if len(frames) == 0 {
+			return container.FrameInfo{}, ErrNoFrames
+		}
+		return frames[0], nil
+	}
+
+	p, err := container.NewStreamParser(r)
+	if err != nil {
+		return container.FrameInfo{}, fmt.Errorf("webp: parsing container: %w", err)
+	}
+	frame, err := p.NextFrame()
+	if err == io.EOF {
+		return container.FrameInfo{}, ErrNoFrames
+	}
+	if err != nil {
+		return container.FrameInfo{}, fmt.Errorf("webp: parsing container: %w", err)
+	}
+	return frame, nil
+}
+
+// decodeLossyWindow decodes a VP8 bitstream restricted to the crop window,
+// then optionally downscales the windowed YUV planes (and alpha, if
+// present) before color conversion.
+func decodeLossyWindow(data, alphaData []byte, crop image.Rectangle, cropped, hasScale bool, scaledW, scaledH int) (image.Image, error) {
+	var (
+		dec                              *lossy.Decoder
+		width, height, yStride, uvStride int
+		yPlane, uPlane, vPlane           []byte
+		err                              error
+	)
+	if cropped {
+		dec, width, height, yPlane, yStride, uPlane, vPlane, uvStride, err =
+			lossy.DecodeFrameCropped(data, crop.Min.X, crop.Min.Y, crop.Dx(), crop.Dy())
+	} else {
+		dec, width, height, yPlane, yStride, uPlane, vPlane, uvStride, err = lossy.DecodeFrame(data)
+	}
+	if err != nil {
+		return nil, fmt.Errorf("webp: lossy decode: %w", err)
+	}
+	defer lossy.ReleaseDecoder(dec)
+
+	var alphaPlane []byte
+	if len(alphaData) > 0 {
+		alphaPlane, err = lossy.DecodeAlpha(alphaData, width, height)
+		if err != nil {
+			return nil, fmt.Errorf("webp: alpha decode: %w", err)
+		}
+	}
+
+	// Window views into the decoded planes (Min is chroma-grid aligned).
+	cw, ch := crop.Dx(), crop.Dy()
+	ccw := (cw + 1) / 2
+	cch := (ch + 1) / 2
+	yWin := yPlane[crop.Min.Y*yStride+crop.Min.X:]
+	uWin := uPlane[(crop.Min.Y/2)*uvStride+crop.Min.X/2:]
+	vWin := vPlane[(crop.Min.Y/2)*uvStride+crop.Min.X/2:]
+
+	// Alpha window, copied to a contiguous cw-stride buffer when present.
+	var aWin []byte
+	if alphaPlane != nil {
+		aWin = make([]byte, ch*cw)
+		for y := 0; y < ch; y++ {
+			copy(aWin[y*cw:], alphaPlane[(crop.Min.Y+y)*width+crop.Min.X:][:cw])
+		}
+	}
+
+	if !hasScale {
+		if !cropped && aWin == nil {
+			return buildYCbCr(cw, ch, yWin, yStride, uWin, vWin, uvStride), nil
+		}
+		if aWin == nil {
+			return buildYCbCrWindow(cw, ch, yWin, yStride, uWin, vWin, uvStride), nil
+		}
+		return buildNRGBA(cw, ch, yWin, yStride, uWin, vWin, uvStride, aWin), nil
+	}
+
+	scaledCW := (scaledW + 1) / 2
+	scaledCH := (scaledH + 1) / 2
+
+	yLen := scaledH * scaledW
+	cLen := scaledCH * scaledCW
+	buf := make([]byte, yLen+2*cLen)
+	sy := buf[:yLen]
+	su := buf[yLen : yLen+cLen]
+	sv := buf[yLen+cLen:]
+
+	dsp.RescalePlane(yWin, yStride, cw, ch, sy, scaledW, scaledW, scaledH)
+	dsp.RescalePlane(uWin, uvStride, ccw, cch, su, scaledCW, scaledCW, scaledCH)
+	dsp.RescalePlane(vWin, uvStride, ccw, cch, sv, scaledCW, scaledCW, scaledCH)
+
+	if aWin == nil {
+		return &image.YCbCr{
+			Y:              sy,
+			Cb:             su,
+			Cr:             sv,
+			YStride:        scaledW,
+			CStride:        scaledCW,
+			SubsampleRatio: image.YCbCrSubsampleRatio420,
+			Rect:           image.Rect(0, 0, scaledW, scaledH),
+		}, nil
+	}
+
+	scaledAlpha := make([]byte, scaledH*scaledW)
+	dsp.RescalePlane(aWin, cw, cw, ch, scaledAlpha, scaledW, scaledW, scaledH)
+	return buildNRGBA(scaledW, scaledH, sy, scaledW, su, sv, scaledCW, scaledAlpha), nil
+}
+
+// buildYCbCrWindow row-copies a window of the decoder's Y/U/V planes into
+// a compact image.YCbCr. Unlike buildYCbCr it cannot copy whole planes,
+// since a window view does not extend a full stride past its last row.
+func buildYCbCrWindow(width, height int, yWin []byte, yStride int, uWin, vWin []byte, uvStride int) *image.YCbCr {
+	chromaW := (width + 1) / 2
+	chromaH := (height + 1) / 2
+
+	yLen := height * width
+	cLen := chromaH * chromaW
+	buf := make([]byte, yLen+2*cLen)
+	sy := buf[:yLen]
+	su := buf[yLen : yLen+cLen]
+	sv := buf[yLen+cLen:]
+
+	for y := 0; y < height; y++ {
+		copy(sy[y*width:], yWin[y*yStride:y*yStride+width])
+	}
+	for y := 0; y < chromaH; y++ {
+		copy(su[y*chromaW:], uWin[y*uvStride:y*uvStride+chromaW])
+		copy(sv[y*chromaW:], vWin[y*uvStride:y*uvStride+chromaW])
+	}
+
+	return &image.YCbCr{
+		Y:              sy,
+		Cb:             su,
+		Cr:             sv,
+		YStride:        width,
+		CStride:        chromaW,
+		SubsampleRatio: image.YCbCrSubsampleRatio420,
+		Rect:           image.Rect(0, 0, width, height),
+	}
+}
+
+// rescaleNRGBA box-filters an NRGBA image down to dstW x dstH, one channel
+// at a time.
+func rescaleNRGBA(src *image.NRGBA, dstW, dstH int) *image.NRGBA {
+	srcW, srcH := src.Rect.Dx(), src.Rect.Dy()
+	if dstW == srcW && dstH == srcH {
+		return src
+	}
+	dst := image.NewNRGBA(image.Rect(0, 0, dstW, dstH))
+
+	srcPlane := make([]byte, srcW*srcH)
+	dstPlane := make([]byte, dstW*dstH)
+	for c := 0; c < 4; c++ {
+		for y := 0; y < srcH; y++ {
+			row := src.Pix[y*src.Stride : y*src.Stride+srcW*4]
+			for x := 0; x < srcW; x++ {
+				srcPlane[y*srcW+x] = row[x*4+c]
+			}
+		}
+		dsp.RescalePlane(srcPlane, srcW, srcW, srcH, dstPlane, dstW, dstW, dstH)
+		for y := 0; y < dstH; y++ {
+			out := dst.Pix[y*dst.Stride : y*dst.Stride+dstW*4]
+			for x := 0; x < dstW; x++ {
+				out[x*4+c] = dstPlane[y*dstW+x]
+			}
+		}
+	}
+	return dst
+}
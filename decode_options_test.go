@@ -0,0 +1,189 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"testing"
+)
+
+func TestDecodeWithOptions_NilOptions(t *testing.T) {
+	data := readTestFile(t, "red_4x4_lossy.webp")
+	img, err := DecodeWithOptions(bytes.NewReader(data), nil)
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	if img.Bounds().Dx() != 4 || img.Bounds().Dy() != 4 {
+		t.Errorf("bounds = %v, want 4x4", img.Bounds())
+	}
+}
+
+func TestDecodeWithOptions_ScaledLossy(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+	img, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{ScaledWidth: 8, ScaledHeight: 8})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	if img.Bounds().Dx() != 8 || img.Bounds().Dy() != 8 {
+		t.Fatalf("bounds = %v, want 8x8", img.Bounds())
+	}
+	ycbcr, ok := img.(*image.YCbCr)
+	if !ok {
+		t.Fatalf("type = %T, want *image.YCbCr", img)
+	}
+
+	// A solid blue image must stay (approximately) solid blue when scaled.
+	full, err := Decode(bytes.NewReader(data))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	fullYCbCr := full.(*image.YCbCr)
+	for i, v := range ycbcr.Y {
+		if diff := int(v) - int(fullYCbCr.Y[0]); diff < -2 || diff > 2 {
+			t.Fatalf("Y[%d] = %d, want ~%d", i, v, fullYCbCr.Y[0])
+		}
+	}
+}
+
+func TestDecodeWithOptions_ScaledLossless(t *testing.T) {
+	data := readTestFile(t, "gradient_8x8_lossless.webp")
+	img, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{ScaledWidth: 4, ScaledHeight: 4})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	if img.Bounds().Dx() != 4 || img.Bounds().Dy() != 4 {
+		t.Fatalf("bounds = %v, want 4x4", img.Bounds())
+	}
+	if _, ok := img.(*image.NRGBA); !ok {
+		t.Fatalf("type = %T, want *image.NRGBA", img)
+	}
+}
+
+func TestDecodeWithOptions_AspectRatio(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+	img, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{ScaledWidth: 4})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	if img.Bounds().Dx() != 4 || img.Bounds().Dy() != 4 {
+		t.Errorf("bounds = %v, want 4x4 (derived height)", img.Bounds())
+	}
+}
+
+func TestDecodeWithOptions_UpscaleRejected(t *testing.T) {
+	data := readTestFile(t, "red_4x4_lossy.webp")
+	if _, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{ScaledWidth: 8, ScaledHeight: 8}); err == nil {
+		t.Fatal("expected error for upscale request")
+	}
+	if _, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{ScaledWidth: -1}); err == nil {
+		t.Fatal("expected error for negative scaled width")
+	}
+}
+
+func TestDecodeWithOptions_CropLossy(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+	crop := image.Rect(4, 4, 12, 12)
+	img, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{Crop: crop})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	got, ok := img.(*image.YCbCr)
+	if !ok {
+		t.Fatalf("type = %T, want *image.YCbCr", img)
+	}
+	if got.Rect.Dx() != 8 || got.Rect.Dy() != 8 {
+		t.Fatalf("bounds = %v, want 8x8", got.Rect)
+	}
+
+	full, err := Decode(bytes.NewReader(data))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	want := full.(*image.YCbCr)
+	for y := 0; y < 8; y++ {
+		for x := 0; x < 8; x++ {
+			if g, w := got.Y[y*got.YStride+x], want.Y[(y+4)*want.YStride+x+4]; g != w {
+				t.Fatalf("Y(%d,%d) = %d, want %d", x, y, g, w)
+			}
+		}
+	}
+	for y := 0; y < 4; y++ {
+		for x := 0; x < 4; x++ {
+			if g, w := got.Cb[y*got.CStride+x], want.Cb[(y+2)*want.CStride+x+2]; g != w {
+				t.Fatalf("Cb(%d,%d) = %d, want %d", x, y, g, w)
+			}
+			if g, w := got.Cr[y*got.CStride+x], want.Cr[(y+2)*want.CStride+x+2]; g != w {
+				t.Fatalf("Cr(%d,%d) = %d, want %d", x, y, g, w)
+			}
+		}
+	}
+}
+
+func TestDecodeWithOptions_CropLossless(t *testing.T) {
+	data := readTestFile(t, "gradient_8x8_lossless.webp")
+	crop := image.Rect(2, 2, 6, 6)
+	img, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{Crop: crop})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	got, ok := img.(*image.NRGBA)
+	if !ok {
+		t.Fatalf("type = %T, want *image.NRGBA", img)
+	}
+	if got.Rect.Dx() != 4 || got.Rect.Dy() != 4 {
+		t.Fatalf("bounds = %v, want 4x4", got.Rect)
+	}
+
+	full, err := Decode(bytes.NewReader(data))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	want := full.(*image.NRGBA)
+	for y := 0; y < 4; y++ {
+		for x := 0; x < 4; x++ {
+			g := got.NRGBAAt(x, y)
+			w := want.NRGBAAt(x+2, y+2)
+			if g != w {
+				t.Fatalf("pixel (%d,%d) = %v, want %v", x, y, g, w)
+			}
+		}
+	}
+}
+
+func TestDecodeWithOptions_CropAndScale(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+	img, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{
+		Crop:        image.Rect(0, 0, 16, 8),
+		ScaledWidth: 8,
+	})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions: %v", err)
+	}
+	if img.Bounds().Dx() != 8 || img.Bounds().Dy() != 4 {
+		t.Errorf("bounds = %v, want 8x4 (derived from crop aspect)", img.Bounds())
+	}
+}
+
+func TestDecodeWithOptions_CropRejected(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+	for _, crop := range []image.Rectangle{
+		image.Rect(0, 0, 17, 16), // wider than image
+		image.Rect(8, 8, 8, 16),  // empty
+		image.Rect(-2, 0, 8, 8),  // negative origin
+		image.Rect(8, 8, 24, 24), // extends past image
+	} {
+		if _, err := DecodeWithOptions(bytes.NewReader(data), &DecodeOptions{Crop: crop}); err == nil {
+			t.Errorf("crop %v: expected error", crop)
+		}
+	}
+}
+
+func TestDecodeWithOptions_Streaming(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+	img, err := DecodeWithOptions(&streamOnly{r: bytes.NewReader(data)}, &DecodeOptions{ScaledWidth: 8, ScaledHeight: 8})
+	if err != nil {
+		t.Fatalf("DecodeWithOptions (stream): %v", err)
+	}
+	if img.Bounds().Dx() != 8 || img.Bounds().Dy() != 8 {
+		t.Errorf("bounds = %v, want 8x8", img.Bounds())
+	}
+}
@@ -7,7 +7,8 @@ import (
 	"image/color"
 	"io"
 	"math"
-	"sync"
+	"net"
+	"time"
 
 	"github.com/deepteams/webp/internal/container"
 	"github.com/deepteams/webp/internal/lossless"
@@ -15,11 +16,6 @@ import (
 	"github.com/deepteams/webp/sharpyuv"
 )
 
-// argbBuf is a reusable ARGB pixel buffer for lossless encoding.
-type argbBuf struct{ data []uint32 }
-
-var argbPool = sync.Pool{New: func() any { return &argbBuf{} }}
-
 // MaxDimension is the maximum allowed width or height for a WebP image, in
 // pixels. This matches libwebp's WEBP_MAX_DIMENSION constant. Images larger
 // than 16383 pixels in either dimension cannot be represented in the WebP
@@ -118,7 +114,9 @@ type EncoderOptions struct {
 
 	// Partitions controls the number of token partitions (0-3, default 0).
 	// The actual number of partitions is 1 << Partitions (1, 2, 4, or 8).
-	// Matches C libwebp's WebPConfig::partitions.
+	// Macroblock rows are sharded round-robin across the partitions, which
+	// lets multi-threaded decoders entropy-decode rows in parallel at a
+	// small size cost. Matches C libwebp's WebPConfig::partitions.
 	Partitions int
 
 	// Segments controls the number of segments to use during encoding
@@ -184,6 +182,14 @@ type EncoderOptions struct {
 	// XMP holds XMP metadata to embed in the output.
 	// When non-nil, the encoder uses VP8X extended format with the XMP chunk.
 	XMP []byte
+
+	// Stats, when non-nil, is filled with statistics about the encode:
+	// per-stage wall times, output bytes per section, per-segment
+	// quantizers, and (on request) PSNR/SSIM of the result. See
+	// [EncoderStats]. Collection adds negligible overhead unless
+	// ComputeQuality is set. Used by [Encode]; each call overwrites the
+	// previous contents.
+	Stats *EncoderStats
 }
 
 // Options is an alias for backward compatibility.
@@ -443,6 +449,10 @@ func Encode(w io.Writer, img image.Image, opts *EncoderOptions) error {
 		return fmt.Errorf("webp: image dimension %dx%d exceeds maximum %d", imgW, imgH, MaxDimension)
 	}
 
+	if opts.Stats != nil {
+		return encodeWithStats(w, img, opts, imgW, imgH)
+	}
+
 	if opts.Lossless {
 		hasMetadata := len(opts.ICC) > 0 || len(opts.EXIF) > 0 || len(opts.XMP) > 0
 		if !hasMetadata {
@@ -470,11 +480,14 @@ func Encode(w io.Writer, img image.Image, opts *EncoderOptions) error {
 // plane as an ALPH chunk payload using VP8L lossless compression.
 // Returns (vp8Bitstream, alphChunkData, fourcc, error).
 func encodeLossyWithAlpha(img image.Image, opts *EncoderOptions) ([]byte, []byte, uint32, error) {
-	// Cache alpha detection result to avoid redundant full-image scans.
-	hasAlpha := imageHasAlpha(img)
-	if !opts.Exact {
-		img = cleanupTransparentAreaLossyWith(img, hasAlpha)
-	}
+	bs, alphaData, fourcc, enc, err := encodeLossyFrame(nil, img, opts)
+	lossy.ReleaseEncoder(enc)
+	return bs, alphaData, fourcc, err
+}
+
+// lossyEncodeConfig maps the public EncoderOptions to the internal lossy
+// EncodeConfig, resolving sentinel values to the C libwebp defaults.
+func lossyEncodeConfig(opts *EncoderOptions, hasAlpha bool) lossy.EncodeConfig {
 	cfg := lossy.DefaultConfig(int(opts.Quality))
 	cfg.Method = opts.Method
 	if opts.TargetSize > 0 {
@@ -526,38 +539,17 @@ func encodeLossyWithAlpha(img image.Image, opts *EncoderOptions) ([]byte, []byte
 	} else {
 		cfg.HasAlpha = 0
 	}
+	return cfg
+}
 
-	var enc *lossy.VP8Encoder
-	if opts.UseSharpYUV {
-		yuv, err := sharpYUVConvert(img)
-		if err != nil {
-			return nil, nil, 0, fmt.Errorf("webp: sharp yuv: %w", err)
-		}
-		enc = lossy.NewEncoderFromYUV(yuv, img.Bounds().Dx(), img.Bounds().Dy(), cfg)
-	} else {
-		enc = lossy.NewEncoder(img, cfg)
-	}
-
-	defer lossy.ReleaseEncoder(enc)
-
-	bs, err := enc.EncodeFrame()
-	if err != nil {
-		return nil, nil, 0, fmt.Errorf("webp: lossy encode: %w", err)
-	}
-
-	// Check if the source image has any non-opaque alpha.
-	alpha := extractAlphaWith(img, hasAlpha)
-	if alpha == nil {
-		// Fully opaque: simple VP8 with no alpha.
-		return bs, nil, container.FourCCVP8, nil
-	}
-
-	// Encode the alpha plane using the resolved alpha options.
-	// Resolve sentinel / zero-value defaults to match C libwebp:
-	//   alpha_compression: 1 (lossless)
-	//   alpha_filtering:   1 (fast)
-	//   alpha_quality:     100
-	bounds := img.Bounds()
+// alphaEncodeConfig maps the public alpha options to the internal alpha
+// encoder configuration, resolving sentinel / zero-value defaults to match
+// C libwebp:
+//
+//	alpha_compression: 1 (lossless)
+//	alpha_filtering:   1 (fast)
+//	alpha_quality:     100
+func alphaEncodeConfig(opts *EncoderOptions) *lossy.AlphaEncoderConfig {
 	alphaComp := resolveAlphaCompression(opts.AlphaCompression)
 	alphaFilt := resolveAlphaFiltering(opts.AlphaFiltering)
 	alphaQual := resolveAlphaQuality(opts.AlphaQuality)
@@ -580,18 +572,89 @@ func encodeLossyWithAlpha(img image.Image, opts *EncoderOptions) ([]byte, []byte
 		alphaFilterMode = lossy.AlphaFilterModeFast
 	}
 
-	alphaCfg := &lossy.AlphaEncoderConfig{
+	return &lossy.AlphaEncoderConfig{
 		Quality:     alphaQual,
 		Method:      alphaMethod,
 		Filter:      alphaFilterMode,
 		EffortLevel: opts.Method,
 	}
-	alphaData, err := lossy.EncodeAlpha(alpha, bounds.Dx(), bounds.Dy(), alphaCfg)
+}
+
+// encodeLossyFrame is the core lossy encode step. When prev is non-nil
+// and its dimensions match the image, its scratch state (MB info arrays,
+// per-worker buffers, token pages) is reused instead of going back to
+// the pool. The returned encoder must be retained for further reuse or
+// released with lossy.ReleaseEncoder.
+func encodeLossyFrame(prev *lossy.VP8Encoder, img image.Image, opts *EncoderOptions) ([]byte, []byte, uint32, *lossy.VP8Encoder, error) {
+	// Cache alpha detection result to avoid redundant full-image scans.
+	hasAlpha := imageHasAlpha(img)
+	if !opts.Exact {
+		img = cleanupTransparentAreaLossyWith(img, hasAlpha)
+	}
+	cfg := lossyEncodeConfig(opts, hasAlpha)
+
+	var enc *lossy.VP8Encoder
+	if opts.UseSharpYUV {
+		yuv, err := sharpYUVConvert(img)
+		if err != nil {
+			return nil, nil, 0, prev, fmt.Errorf("webp: sharp yuv: %w", err)
+		}
+		enc = lossy.ReuseEncoderFromYUV(prev, yuv, img.Bounds().Dx(), img.Bounds().Dy(), cfg)
+	} else {
+		enc = lossy.ReuseEncoder(prev, img, cfg)
+	}
+
+	// If the source image has any non-opaque alpha, dispatch the alpha-plane
+	// encode on its own goroutine so it overlaps the VP8 frame encode below.
+	// The two bitstreams are fully independent until writeRIFF concatenates
+	// them, and EncodeAlpha works on its own copy of the extracted plane.
+	alpha := extractAlphaWith(img, hasAlpha)
+
+	var (
+		alphaData []byte
+		alphaErr  error
+		alphaDur  time.Duration
+		alphaDone chan struct{}
+	)
+	if alpha != nil {
+		// Encode the alpha plane using the resolved alpha options.
+		bounds := img.Bounds()
+		alphaCfg := alphaEncodeConfig(opts)
+		alphaDone = make(chan struct{})
+		go func() {
+			defer close(alphaDone)
+			t0 := time.Now()
+			alphaData, alphaErr = lossy.EncodeAlpha(alpha, bounds.Dx(), bounds.Dy(), alphaCfg)
+			alphaDur = time.Since(t0)
+		}()
+	}
+
+	bs, err := enc.EncodeFrame()
+	if alphaDone != nil {
+		<-alphaDone
+	}
 	if err != nil {
-		return nil, nil, 0, fmt.Errorf("webp: alpha encode: %w", err)
+		return nil, nil, 0, enc, fmt.Errorf("webp: lossy encode: %w", err)
+	}
+	if st := opts.Stats; st != nil {
+		times := enc.StageTimes()
+		st.AnalysisTime = times.Analysis
+		st.QuantizeTime = times.Quantize
+		st.EntropyTime = times.Entropy
+		st.AlphaTime = alphaDur
+		for i := range st.SegmentQuants {
+			st.SegmentQuants[i] = enc.SegmentQuant(i)
+		}
+	}
+	if alpha == nil {
+		// Fully opaque: simple VP8 with no alpha.
+		return bs, nil, container.FourCCVP8, enc, nil
+	}
+	if alphaErr != nil {
+		return nil, nil, 0, enc, fmt.Errorf("webp: alpha encode: %w", alphaErr)
 	}
 
-	return bs, alphaData, container.FourCCVP8, nil
+	return bs, alphaData, container.FourCCVP8, enc, nil
 }
 
 // encodeLossy encodes the image as a VP8 lossy bitstream (no alpha).
@@ -615,71 +678,79 @@ func validRGBA(img *image.RGBA, w, h int) bool {
 	return img.Stride >= w*4 && len(img.Pix) >= (h-1)*img.Stride+w*4
 }
 
-// encodeLossless encodes the image as a VP8L lossless bitstream.
-func encodeLossless(img image.Image, opts *EncoderOptions) ([]byte, uint32, error) {
+// losslessRowFiller returns a callback that converts rows [y0, y1) of img
+// into non-premultiplied ARGB uint32 values. VP8L stores non-premultiplied
+// (NRGBA) pixel values, so the image's native format is converted to NRGBA
+// before packing. Using RGBA() directly would give premultiplied values,
+// which causes double-premultiplication when the decoder's argbToNRGBA
+// treats them as non-premultiplied on output. When exact is false,
+// fully-transparent pixels are zeroed for better compression.
+func losslessRowFiller(img image.Image, exact bool) func(y0, y1 int, dst []uint32) {
 	bounds := img.Bounds()
 	width := bounds.Dx()
 	height := bounds.Dy()
 
-	// Convert image to non-premultiplied ARGB uint32 slice.
-	// VP8L stores non-premultiplied (NRGBA) pixel values, so we must
-	// convert from the image's native format to NRGBA before packing.
-	// Using RGBA() directly would give premultiplied values, which causes
-	// double-premultiplication when the decoder's argbToNRGBA treats them
-	// as non-premultiplied on output.
-	pixelCount := width * height
-	ab := argbPool.Get().(*argbBuf)
-	if cap(ab.data) >= pixelCount {
-		ab.data = ab.data[:pixelCount]
-	} else {
-		ab.data = make([]uint32, pixelCount)
-	}
-	argb := ab.data
-	if nrgba, ok := img.(*image.NRGBA); ok && validNRGBA(nrgba, width, height) {
-		for y := 0; y < height; y++ {
-			rowOff := (y+bounds.Min.Y-nrgba.Rect.Min.Y)*nrgba.Stride + (bounds.Min.X-nrgba.Rect.Min.X)*4
-			for x := 0; x < width; x++ {
-				off := rowOff + x*4
-				argb[y*width+x] = uint32(nrgba.Pix[off+3])<<24 | uint32(nrgba.Pix[off])<<16 | uint32(nrgba.Pix[off+1])<<8 | uint32(nrgba.Pix[off+2])
+	convert := func(y0, y1 int, dst []uint32) {
+		if nrgba, ok := img.(*image.NRGBA); ok && validNRGBA(nrgba, width, height) {
+			for y := y0; y < y1; y++ {
+				rowOff := (y+bounds.Min.Y-nrgba.Rect.Min.Y)*nrgba.Stride + (bounds.Min.X-nrgba.Rect.Min.X)*4
+				row := dst[(y-y0)*width:]
+				for x := 0; x < width; x++ {
+					off := rowOff + x*4
+					row[x] = uint32(nrgba.Pix[off+3])<<24 | uint32(nrgba.Pix[off])<<16 | uint32(nrgba.Pix[off+1])<<8 | uint32(nrgba.Pix[off+2])
+				}
 			}
-		}
-	} else if rgba, ok := img.(*image.RGBA); ok && validRGBA(rgba, width, height) {
-		for y := 0; y < height; y++ {
-			rowOff := (y+bounds.Min.Y-rgba.Rect.Min.Y)*rgba.Stride + (bounds.Min.X-rgba.Rect.Min.X)*4
-			for x := 0; x < width; x++ {
-				off := rowOff + x*4
-				a := rgba.Pix[off+3]
-				r, g, b := rgba.Pix[off], rgba.Pix[off+1], rgba.Pix[off+2]
-				// Un-premultiply for lossless encoding (VP8L stores NRGBA).
-				if a > 0 && a < 255 {
-					a16 := uint16(a)
-					r = uint8(uint16(r) * 255 / a16)
-					g = uint8(uint16(g) * 255 / a16)
-					b = uint8(uint16(b) * 255 / a16)
+		} else if rgba, ok := img.(*image.RGBA); ok && validRGBA(rgba, width, height) {
+			for y := y0; y < y1; y++ {
+				rowOff := (y+bounds.Min.Y-rgba.Rect.Min.Y)*rgba.Stride + (bounds.Min.X-rgba.Rect.Min.X)*4
+				row := dst[(y-y0)*width:]
+				for x := 0; x < width; x++ {
+					off := rowOff + x*4
+					a := rgba.Pix[off+3]
+					r, g, b := rgba.Pix[off], rgba.Pix[off+1], rgba.Pix[off+2]
+					// Un-premultiply for lossless encoding (VP8L stores NRGBA).
+					if a > 0 && a < 255 {
+						a16 := uint16(a)
+						r = uint8(uint16(r) * 255 / a16)
+						g = uint8(uint16(g) * 255 / a16)
+						b = uint8(uint16(b) * 255 / a16)
+					}
+					row[x] = uint32(a)<<24 | uint32(r)<<16 | uint32(g)<<8 | uint32(b)
 				}
-				argb[y*width+x] = uint32(a)<<24 | uint32(r)<<16 | uint32(g)<<8 | uint32(b)
 			}
-		}
-	} else {
-		for y := 0; y < height; y++ {
-			for x := 0; x < width; x++ {
-				c := color.NRGBAModel.Convert(img.At(bounds.Min.X+x, bounds.Min.Y+y)).(color.NRGBA)
-				argb[y*width+x] = uint32(c.A)<<24 | uint32(c.R)<<16 | uint32(c.G)<<8 | uint32(c.B)
+		} else {
+			for y := y0; y < y1; y++ {
+				row := dst[(y-y0)*width:]
+				for x := 0; x < width; x++ {
+					c := color.NRGBAModel.Convert(img.At(bounds.Min.X+x, bounds.Min.Y+y)).(color.NRGBA)
+					row[x] = uint32(c.A)<<24 | uint32(c.R)<<16 | uint32(c.G)<<8 | uint32(c.B)
+				}
 			}
 		}
 	}
 
-	if !opts.Exact {
-		cleanupTransparentAreaLossless(argb)
+	return func(y0, y1 int, dst []uint32) {
+		convert(y0, y1, dst)
+		if !exact {
+			cleanupTransparentAreaLossless(dst[:(y1-y0)*width])
+		}
 	}
+}
+
+// encodeLossless encodes the image as a VP8L lossless bitstream. Rows are
+// streamed into the encoder strip-by-strip, so no caller-side copy of the
+// full ARGB plane is made.
+func encodeLossless(img image.Image, opts *EncoderOptions) ([]byte, uint32, error) {
+	bounds := img.Bounds()
+	width := bounds.Dx()
+	height := bounds.Dy()
 
 	lcfg := &lossless.EncoderConfig{
 		Quality:             int(opts.Quality),
 		Method:              opts.Method,
 		NearLosslessQuality: 100,
 	}
-	bs, err := lossless.Encode(argb, width, height, lcfg)
-	argbPool.Put(ab)
+	bs, err := lossless.EncodeRows(width, height, lcfg, losslessRowFiller(img, opts.Exact))
 	if err != nil {
 		return nil, 0, fmt.Errorf("webp: lossless encode: %w", err)
 	}
@@ -694,51 +765,6 @@ func encodeLosslessToWriter(w io.Writer, img image.Image, opts *EncoderOptions)
 	width := bounds.Dx()
 	height := bounds.Dy()
 
-	pixelCount := width * height
-	ab := argbPool.Get().(*argbBuf)
-	if cap(ab.data) >= pixelCount {
-		ab.data = ab.data[:pixelCount]
-	} else {
-		ab.data = make([]uint32, pixelCount)
-	}
-	argb := ab.data
-	if nrgba, ok := img.(*image.NRGBA); ok && validNRGBA(nrgba, width, height) {
-		for y := 0; y < height; y++ {
-			rowOff := (y+bounds.Min.Y-nrgba.Rect.Min.Y)*nrgba.Stride + (bounds.Min.X-nrgba.Rect.Min.X)*4
-			for x := 0; x < width; x++ {
-				off := rowOff + x*4
-				argb[y*width+x] = uint32(nrgba.Pix[off+3])<<24 | uint32(nrgba.Pix[off])<<16 | uint32(nrgba.Pix[off+1])<<8 | uint32(nrgba.Pix[off+2])
-			}
-		}
-	} else if rgba, ok := img.(*image.RGBA); ok && validRGBA(rgba, width, height) {
-		for y := 0; y < height; y++ {
-			rowOff := (y+bounds.Min.Y-rgba.Rect.Min.Y)*rgba.Stride + (bounds.Min.X-rgba.Rect.Min.X)*4
-			for x := 0; x < width; x++ {
-				off := rowOff + x*4
-				a := rgba.Pix[off+3]
-				r, g, b := rgba.Pix[off], rgba.Pix[off+1], rgba.Pix[off+2]
-				if a > 0 && a < 255 {
-					a16 := uint16(a)
-					r = uint8(uint16(r) * 255 / a16)
-					g = uint8(uint16(g) * 255 / a16)
-					b = uint8(uint16(b) * 255 / a16)
-				}
-				argb[y*width+x] = uint32(a)<<24 | uint32(r)<<16 | uint32(g)<<8 | uint32(b)
-			}
-		}
-	} else {
-		for y := 0; y < height; y++ {
-			for x := 0; x < width; x++ {
-				c := color.NRGBAModel.Convert(img.At(bounds.Min.X+x, bounds.Min.Y+y)).(color.NRGBA)
-				argb[y*width+x] = uint32(c.A)<<24 | uint32(c.R)<<16 | uint32(c.G)<<8 | uint32(c.B)
-			}
-		}
-	}
-
-	if !opts.Exact {
-		cleanupTransparentAreaLossless(argb)
-	}
-
 	lcfg := &lossless.EncoderConfig{
 		Quality:             int(opts.Quality),
 		Method:              opts.Method,
@@ -746,10 +772,9 @@ func encodeLosslessToWriter(w io.Writer, img image.Image, opts *EncoderOptions)
 	}
 
 	fourcc := container.FourCCVP8L
-	err := lossless.EncodeToWriter(argb, width, height, lcfg, w,
+	err := lossless.EncodeRowsToWriter(width, height, lcfg,
+		losslessRowFiller(img, opts.Exact), w,
 		func(bitstreamSize int) error {
-			// Note: argbPool.Put(ab) moved after EncodeToWriter returns
-			// to avoid use-after-pool-put (V7 security fix).
 			// Write simple RIFF/WEBP header directly to w.
 			payloadSize := uint32(bitstreamSize)
 			paddedPayload := payloadSize + (payloadSize & 1)
@@ -763,7 +788,6 @@ func encodeLosslessToWriter(w io.Writer, img image.Image, opts *EncoderOptions)
 			_, err := w.Write(hdr[:])
 			return err
 		})
-	argbPool.Put(ab) // Return buffer to pool after encoder is done with argb.
 	if err != nil {
 		return fmt.Errorf("webp: lossless encode: %w", err)
 	}
@@ -964,7 +988,13 @@ func writeRIFF(w io.Writer, fourcc uint32, bitstream, alphaData []byte, width, h
 	return writeRIFFSimple(w, fourcc, bitstream)
 }
 
+// riffPadding is the shared RIFF padding byte appended after odd-sized chunk
+// payloads. It is never written to, so all write segments may alias it.
+var riffPadding = []byte{0}
+
 // writeRIFFSimple writes the simple RIFF/WEBP container (no VP8X, no ALPH).
+// The bitstream slice is streamed to w as-is (vectored write) rather than
+// copied into a file-sized buffer.
 func writeRIFFSimple(w io.Writer, fourcc uint32, bitstream []byte) error {
 	payloadSize := uint32(len(bitstream))
 	paddedPayload := payloadSize + (payloadSize & 1) // RIFF requires even alignment
@@ -972,27 +1002,19 @@ func writeRIFFSimple(w io.Writer, fourcc uint32, bitstream []byte) error {
 	// RIFF file size = 4 ("WEBP") + 8 (chunk header) + paddedPayload
 	riffSize := 4 + container.ChunkHeaderSize + paddedPayload
 
-	// Total file: 8 (RIFF + size) + riffSize
-	buf := make([]byte, 8+riffSize)
-
-	// RIFF header.
+	// RIFF header + chunk header.
+	buf := make([]byte, container.RIFFHeaderSize+container.ChunkHeaderSize)
 	binary.LittleEndian.PutUint32(buf[0:4], container.FourCCRIFF)
 	binary.LittleEndian.PutUint32(buf[4:8], riffSize)
 	binary.LittleEndian.PutUint32(buf[8:12], container.FourCCWEBP)
-
-	// Chunk header.
 	binary.LittleEndian.PutUint32(buf[12:16], fourcc)
 	binary.LittleEndian.PutUint32(buf[16:20], payloadSize)
 
-	// Chunk payload.
-	copy(buf[20:], bitstream)
-
-	// Padding byte if odd.
+	segs := net.Buffers{buf, bitstream}
 	if payloadSize&1 != 0 {
-		buf[20+payloadSize] = 0
+		segs = append(segs, riffPadding)
 	}
-
-	_, err := w.Write(buf)
+	_, err := segs.WriteTo(w)
 	return err
 }
 
@@ -1055,8 +1077,9 @@ func writeRIFFExtended(w io.Writer, fourcc uint32, bitstreamData, alphaData []by
 	}
 	riffSize := uint32(riffSize64)
 
-	totalSize := 8 + riffSize
-	buf := make([]byte, totalSize)
+	// RIFF header + VP8X chunk, followed by the payload slices streamed
+	// as-is (vectored write) instead of copied into a file-sized buffer.
+	buf := make([]byte, container.RIFFHeaderSize+container.ChunkHeaderSize+vp8xChunkSize)
 	off := 0
 
 	// RIFF header.
@@ -1079,17 +1102,16 @@ func writeRIFFExtended(w io.Writer, fourcc uint32, bitstreamData, alphaData []by
 	putLE24(buf[off:], uint32(height-1))
 	off += 3
 
-	// writeChunk is a helper to write a chunk inline into buf.
+	segs := net.Buffers{buf}
+
+	// writeChunk appends a chunk's header and payload segments.
 	writeChunk := func(fcc uint32, data []byte) {
-		binary.LittleEndian.PutUint32(buf[off:], fcc)
-		off += 4
-		binary.LittleEndian.PutUint32(buf[off:], uint32(len(data)))
-		off += 4
-		copy(buf[off:], data)
-		off += len(data)
+		hdr := make([]byte, container.ChunkHeaderSize)
+		binary.LittleEndian.PutUint32(hdr[0:4], fcc)
+		binary.LittleEndian.PutUint32(hdr[4:8], uint32(len(data)))
+		segs = append(segs, hdr, data)
 		if len(data)&1 != 0 {
-			buf[off] = 0
-			off++
+			segs = append(segs, riffPadding)
 		}
 	}
 
@@ -1116,7 +1138,7 @@ func writeRIFFExtended(w io.Writer, fourcc uint32, bitstreamData, alphaData []by
 		writeChunk(container.FourCCXMP, xmp)
 	}
 
-	_, err := w.Write(buf)
+	_, err := segs.WriteTo(w)
 	return err
 }
 
@@ -0,0 +1,84 @@
+package webp
+
+import (
+	"fmt"
+	"image"
+	"io"
+
+	"github.com/deepteams/webp/internal/lossy"
+)
+
+// Encoder is a reusable encoding session. Unlike the one-shot [Encode],
+// it keeps all dimension-dependent scratch state (macroblock info arrays,
+// per-worker buffers, token pages) alive between calls, so encoding a
+// burst of same-resolution images repays the per-image setup cost only
+// once. Images with different dimensions are still handled correctly;
+// they simply re-allocate the retained state.
+//
+// An Encoder is not safe for concurrent use. Call [Encoder.Close] when
+// done to return the retained state to the shared pool.
+type Encoder struct {
+	opts EncoderOptions
+	vp8  *lossy.VP8Encoder
+}
+
+// NewEncoder creates a reusable encoding session with the given options.
+// A nil opts uses [DefaultOptions]. The options are copied; later changes
+// to opts do not affect the session.
+func NewEncoder(opts *EncoderOptions) (*Encoder, error) {
+	if opts == nil {
+		opts = DefaultOptions()
+	}
+	if err := validateConfig(opts); err != nil {
+		return nil, err
+	}
+	return &Encoder{opts: *opts}, nil
+}
+
+// Encode writes img to w as a WebP image using the session's options.
+// The output is identical to calling [Encode] with the same options.
+func (e *Encoder) Encode(w io.Writer, img image.Image) error {
+	if w == nil {
+		return fmt.Errorf("webp: nil writer")
+	}
+	if img == nil {
+		return fmt.Errorf("webp: nil image")
+	}
+	opts := &e.opts
+
+	imgW, imgH := img.Bounds().Dx(), img.Bounds().Dy()
+	if imgW <= 0 || imgH <= 0 {
+		return fmt.Errorf("webp: invalid image dimensions %dx%d", imgW, imgH)
+	}
+	if imgW > MaxDimension || imgH > MaxDimension {
+		return fmt.Errorf("webp: image dimension %dx%d exceeds maximum %d", imgW, imgH, MaxDimension)
+	}
+
+	if opts.Lossless {
+		// The lossless encoder has no dimension-dependent session state
+		// worth retaining; use the same paths as the one-shot Encode.
+		hasMetadata := len(opts.ICC) > 0 || len(opts.EXIF) > 0 || len(opts.XMP) > 0
+		if !hasMetadata {
+			return encodeLosslessToWriter(w, img, opts)
+		}
+		bitstream, fourcc, err := encodeLossless(img, opts)
+		if err != nil {
+			return err
+		}
+		return writeRIFF(w, fourcc, bitstream, nil, imgW, imgH, opts)
+	}
+
+	bitstream, alphaData, fourcc, enc, err := encodeLossyFrame(e.vp8, img, opts)
+	e.vp8 = enc
+	if err != nil {
+		return err
+	}
+	return writeRIFF(w, fourcc, bitstream, alphaData, imgW, imgH, opts)
+}
+
+// Close returns the session's retained scratch state to the shared pool.
+// The Encoder must not be used after Close.
+func (e *Encoder) Close() {
+	lossy.ReleaseEncoder(e.vp8)
+	e.vp8 = nil
+}
@@ -0,0 +1,116 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"image/color"
+	"testing"
+)
+
+func sessionTestImage(w, h, seed int) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			img.Set(x, y, color.NRGBA{
+				R: uint8((x*7 + seed) & 0xff),
+				G: uint8((y*5 + seed*3) & 0xff),
+				B: uint8((x + y + seed*11) & 0xff),
+				A: 255,
+			})
+		}
+	}
+	return img
+}
+
+// TestEncoderSessionMatchesOneShot verifies that a reused Encoder produces
+// byte-identical output to the one-shot Encode for a burst of frames.
+func TestEncoderSessionMatchesOneShot(t *testing.T) {
+	opts := &EncoderOptions{Quality: 75, Method: 2}
+	enc, err := NewEncoder(opts)
+	if err != nil {
+		t.Fatalf("NewEncoder: %v", err)
+	}
+	defer enc.Close()
+
+	for seed := 0; seed < 3; seed++ {
+		img := sessionTestImage(96, 80, seed)
+
+		var session, oneShot bytes.Buffer
+		if err := enc.Encode(&session, img); err != nil {
+			t.Fatalf("session Encode(seed=%d): %v", seed, err)
+		}
+		if err := Encode(&oneShot, img, opts); err != nil {
+			t.Fatalf("one-shot Encode(seed=%d): %v", seed, err)
+		}
+		if !bytes.Equal(session.Bytes(), oneShot.Bytes()) {
+			t.Fatalf("seed %d: session output (%d bytes) differs from one-shot (%d bytes)",
+				seed, session.Len(), oneShot.Len())
+		}
+	}
+}
+
+// TestEncoderSessionDimensionChange verifies the session survives a
+// mid-stream dimension change by re-allocating its retained state.
+func TestEncoderSessionDimensionChange(t *testing.T) {
+	enc, err := NewEncoder(nil)
+	if err != nil {
+		t.Fatalf("NewEncoder: %v", err)
+	}
+	defer enc.Close()
+
+	for _, dim := range []struct{ w, h int }{{64, 48}, {128, 96}, {64, 48}} {
+		img := sessionTestImage(dim.w, dim.h, dim.w)
+		var buf bytes.Buffer
+		if err := enc.Encode(&buf, img); err != nil {
+			t.Fatalf("Encode(%dx%d): %v", dim.w, dim.h, err)
+		}
+		decoded, err := Decode(&buf)
+		if err != nil {
+			t.Fatalf("Decode(%dx%d): %v", dim.w, dim.h, err)
+		}
+		b := decoded.Bounds()
+		if b.Dx() != dim.w || b.Dy() != dim.h {
+			t.Fatalf("decoded %dx%d, want %dx%d", b.Dx(), b.Dy(), dim.w, dim.h)
+		}
+	}
+}
+
+// TestEncoderSessionLossless verifies the lossless path works through the
+// session API and round-trips exactly.
+func TestEncoderSessionLossless(t *testing.T) {
+	enc, err := NewEncoder(&EncoderOptions{Lossless: true})
+	if err != nil {
+		t.Fatalf("NewEncoder: %v", err)
+	}
+	defer enc.Close()
+
+	img := sessionTestImage(40, 30, 1)
+	var buf bytes.Buffer
+	if err := enc.Encode(&buf, img); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	decoded, err := Decode(&buf)
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	for y := 0; y < 30; y++ {
+		for x := 0; x < 40; x++ {
+			r0, g0, b0, a0 := img.At(x, y).RGBA()
+			r1, g1, b1, a1 := decoded.At(x, y).RGBA()
+			if r0 != r1 || g0 != g1 || b0 != b1 || a0 != a1 {
+				t.Fatalf("pixel (%d,%d) mismatch", x, y)
+			}
+		}
+	}
+}
+
+// TestEncoderInvalidOptions verifies option validation happens at
+// session construction.
+func TestEncoderInvalidOptions(t *testing.T) {
+	if _, err := NewEncoder(&EncoderOptions{Quality: 200}); err == nil {
+		t.Fatal("expected error for quality 200")
+	}
+	if _, err := NewEncoder(&EncoderOptions{Method: 9}); err == nil {
+		t.Fatal("expected error for method 9")
+	}
+}
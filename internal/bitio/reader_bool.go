@@ -50,14 +50,12 @@ func NewBoolReader(data []byte) *BoolReader {
 // value register. When fewer than 7 bytes remain the slow path
 // loadFinalBytes is used instead.
 func (br *BoolReader) loadNewBytes() {
-	// Fast path: at least 8 bytes available (we read 8, use 7).
+	// Fast path: at least 8 bytes available (we read 8, use 7). The
+	// big-endian load is a single unaligned read (with byte swap folded
+	// into the load on amd64/arm64); dropping the lowest byte leaves 56
+	// bits in MSB-first order.
 	if br.pos+8 <= len(br.buf) {
-		// Read 8 bytes as little-endian uint64, byte-swap to big-endian,
-		// then discard the lowest byte (shift right by 8) to get 56 bits
-		// in the correct MSB-first order.
-		in := binary.LittleEndian.Uint64(br.buf[br.pos:])
-		in = bits.ReverseBytes64(in)
-		in >>= 64 - boolBITS
+		in := binary.BigEndian.Uint64(br.buf[br.pos:]) >> (64 - boolBITS)
 		br.Value = in | (br.Value << boolBITS)
 		br.pos += boolBITS >> 3
 		br.Bits += boolBITS
@@ -173,3 +173,44 @@ func TestBoolReader_LookupTableConsistency(t *testing.T) {
 		}
 	}
 }
+
+func TestBoolReader_BulkLoadMatchesFinalBytes(t *testing.T) {
+	// The same bitstream must decode identically whether refills take the
+	// bulk 8-byte path (plenty of trailing data) or the byte-at-a-time
+	// loadFinalBytes path (exact-length buffer).
+	data := make([]byte, 32)
+	for i := range data {
+		data[i] = byte(i*37 + 11)
+	}
+	padded := make([]byte, len(data)+8)
+	copy(padded, data)
+
+	exact := NewBoolReader(data)
+	bulk := NewBoolReader(padded)
+
+	probs := []uint8{0x80, 10, 245, 128, 63, 200, 1, 254}
+	for i := 0; i < 200; i++ {
+		p := probs[i%len(probs)]
+		if got, want := exact.GetBit(p), bulk.GetBit(p); got != want {
+			t.Fatalf("bit %d (prob %d): exact-length path = %d, padded path = %d", i, p, got, want)
+		}
+	}
+}
+
+func BenchmarkBoolReaderGetBit(b *testing.B) {
+	data := make([]byte, 4096)
+	for i := range data {
+		data[i] = byte(i*131 + 7)
+	}
+	probs := [8]uint8{10, 245, 128, 63, 200, 1, 254, 99}
+	b.SetBytes(int64(len(data)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		br := NewBoolReader(data)
+		// ~8 bits consumed per refill; run enough symbols to stream the
+		// whole buffer through the bulk-load path.
+		for j := 0; j < len(data); j++ {
+			br.GetBit(probs[j&7])
+		}
+	}
+}
@@ -1,12 +1,18 @@
 package bitio
 
-import "encoding/binary"
+import (
+	"encoding/binary"
+	"io"
+)
 
 const (
 	// writerBits is the number of bits flushed at a time (32 on 64-bit).
 	writerBits = 32
 	// writerBytes is the number of bytes written per flush (4 on 64-bit).
 	writerBytes = 4
+	// streamWriterBufSize is the default internal buffer size for
+	// streaming writers created by NewLosslessStreamWriter.
+	streamWriterBufSize = 64 * 1024
 )
 
 // LosslessWriter implements the VP8L accumulator-based bit writer.
@@ -14,12 +20,21 @@ const (
 // Bits are accumulated in a 64-bit register and flushed 32 bits (4 bytes)
 // at a time in little-endian byte order. This matches the format expected
 // by LosslessReader.
+//
+// A writer operates in one of two modes. Buffered writers (NewLosslessWriter,
+// NewLosslessWriterWithBuf) accumulate the whole bitstream in a growing
+// buffer and hand it back via Finish. Streaming writers
+// (NewLosslessStreamWriter) flush completed bytes to an underlying io.Writer
+// through a fixed-size buffer, so output memory stays constant regardless of
+// bitstream length; they are finished with Close instead of Finish.
 type LosslessWriter struct {
-	bits uint64 // bit accumulator
-	used int    // number of bits used in accumulator
-	buf  []byte // output buffer
-	cur  int    // current write position in buf
-	err  error
+	bits    uint64    // bit accumulator
+	used    int       // number of bits used in accumulator
+	buf     []byte    // output buffer
+	cur     int       // current write position in buf
+	w       io.Writer // streaming destination; nil for buffered writers
+	flushed int       // bytes already written to w
+	err     error
 }
 
 // NewLosslessWriter creates a LosslessWriter with an initial buffer
@@ -52,6 +67,25 @@ func NewLosslessWriterWithBuf(buf []byte, expectedSize int) *LosslessWriter {
 	}
 }
 
+// NewLosslessStreamWriter creates a LosslessWriter that streams completed
+// bytes to w through a fixed-size internal buffer. bufSize selects the
+// buffer size; values <= 0 pick the 64 KiB default. Output memory is O(1)
+// in the bitstream length: the buffer never grows, it is written out and
+// reused whenever it fills. The caller must Close the writer to flush the
+// final partial buffer; Finish and Buf are not meaningful in this mode.
+func NewLosslessStreamWriter(w io.Writer, bufSize int) *LosslessWriter {
+	if bufSize <= 0 {
+		bufSize = streamWriterBufSize
+	}
+	if bufSize < 1024 {
+		bufSize = 1024
+	}
+	return &LosslessWriter{
+		buf: make([]byte, bufSize),
+		w:   w,
+	}
+}
+
 // Buf returns the full backing buffer (not just the written portion).
 // Use this to capture the buffer for reuse across encode calls.
 func (bw *LosslessWriter) Buf() []byte {
@@ -81,11 +115,17 @@ func (bw *LosslessWriter) flushBits() {
 	bw.used -= writerBits
 }
 
-// grow ensures at least n bytes of capacity remain at bw.cur.
+// grow ensures at least n bytes of capacity remain at bw.cur. Streaming
+// writers make room by draining the buffer to the destination instead of
+// reallocating, so their buffer size stays fixed.
 func (bw *LosslessWriter) grow(n int) {
 	if bw.cur+n <= len(bw.buf) {
 		return
 	}
+	if bw.w != nil {
+		bw.flushBuf()
+		return
+	}
 	newSize := len(bw.buf) * 3 / 2
 	need := bw.cur + n
 	if newSize < need {
@@ -98,8 +138,32 @@ func (bw *LosslessWriter) grow(n int) {
 	bw.buf = tmp
 }
 
+// flushBuf writes the buffered bytes to the streaming destination and
+// rewinds the buffer. Errors are sticky: after the first write failure the
+// writer silently discards further output and reports the error from Err
+// and Close.
+func (bw *LosslessWriter) flushBuf() {
+	if bw.err != nil {
+		bw.cur = 0
+		return
+	}
+	if bw.cur == 0 {
+		return
+	}
+	n, err := bw.w.Write(bw.buf[:bw.cur])
+	bw.flushed += n
+	if err != nil {
+		bw.err = err
+	} else if n < bw.cur {
+		bw.err = io.ErrShortWrite
+	}
+	bw.cur = 0
+}
+
 // Finish flushes all remaining bits to the output buffer and returns
-// the complete encoded byte slice.
+// the complete encoded byte slice. For streaming writers the bytes have
+// already been handed to the destination, so Finish drains the accumulator
+// and returns nil; use Close to observe write errors.
 func (bw *LosslessWriter) Finish() []byte {
 	// Flush full 32-bit words while possible.
 	for bw.used >= writerBits {
@@ -114,13 +178,55 @@ func (bw *LosslessWriter) Finish() []byte {
 		bw.used -= 8
 	}
 	bw.used = 0
+	if bw.w != nil {
+		bw.flushBuf()
+		return nil
+	}
 	return bw.buf[:bw.cur]
 }
 
+// Close finishes a streaming writer: it drains the accumulator, flushes the
+// internal buffer to the destination, and returns the first write error
+// encountered, if any.
+func (bw *LosslessWriter) Close() error {
+	bw.Finish()
+	return bw.err
+}
+
+// AppendBitstream appends every bit written to src so far — flushed bytes
+// and bits still in its accumulator — onto bw at the current bit position.
+// This splices independently encoded bitstream segments at a bit boundary;
+// src must not be used for further writes afterwards unless it is spliced
+// again in full. src must be a buffered writer: a streaming writer has
+// already handed its bytes to the destination. bw itself may be either.
+func (bw *LosslessWriter) AppendBitstream(src *LosslessWriter) {
+	buf := src.buf[:src.cur]
+	for len(buf) >= writerBytes {
+		bw.WriteBits(binary.LittleEndian.Uint32(buf), writerBits)
+		buf = buf[writerBytes:]
+	}
+	for _, b := range buf {
+		bw.WriteBits(uint32(b), 8)
+	}
+	bits, used := src.bits, src.used
+	for used > 0 {
+		n := used
+		if n >= writerBits {
+			n = writerBits
+			bw.WriteBits(uint32(bits), n)
+		} else {
+			bw.WriteBits(uint32(bits)&(1<<uint(n)-1), n)
+		}
+		bits >>= uint(n)
+		used -= n
+	}
+}
+
 // NumBytes returns the number of encoded bytes, including any partial
-// byte in the accumulator.
+// byte in the accumulator and, for streaming writers, bytes already
+// written to the destination.
 func (bw *LosslessWriter) NumBytes() int {
-	return bw.cur + (bw.used+7)/8
+	return bw.flushed + bw.cur + (bw.used+7)/8
 }
 
 // Err returns the first error encountered during writing, if any.
@@ -1,6 +1,7 @@
 package bitio
 
 import (
+	"errors"
 	"math/rand"
 	"testing"
 )
@@ -303,3 +304,179 @@ func TestLosslessWriter_GrowBeyondInitial(t *testing.T) {
 		}
 	}
 }
+
+func TestLosslessWriter_AppendBitstream(t *testing.T) {
+	// Writing a bit sequence through several spliced writers must produce
+	// the same bytes as writing it through one writer.
+	rng := rand.New(rand.NewSource(97))
+	type write struct {
+		v uint32
+		n int
+	}
+	var writes []write
+	for i := 0; i < 5000; i++ {
+		n := rng.Intn(32) + 1
+		v := rng.Uint32()
+		if n < 32 {
+			v &= 1<<uint(n) - 1
+		}
+		writes = append(writes, write{v, n})
+	}
+
+	serial := NewLosslessWriter(1024)
+	for _, w := range writes {
+		serial.WriteBits(w.v, w.n)
+	}
+	want := serial.Finish()
+
+	// Split the same writes across several writers at arbitrary (bit-
+	// unaligned) boundaries and splice them together.
+	for _, numParts := range []int{2, 3, 7} {
+		spliced := NewLosslessWriter(1024)
+		per := (len(writes) + numParts - 1) / numParts
+		for p := 0; p < numParts; p++ {
+			part := NewLosslessWriter(64)
+			start, end := p*per, (p+1)*per
+			if end > len(writes) {
+				end = len(writes)
+			}
+			for _, w := range writes[start:end] {
+				part.WriteBits(w.v, w.n)
+			}
+			spliced.AppendBitstream(part)
+		}
+		got := spliced.Finish()
+		if len(got) != len(want) {
+			t.Fatalf("%d parts: spliced length %d, want %d", numParts, len(got), len(want))
+		}
+		for i := range got {
+			if got[i] != want[i] {
+				t.Fatalf("%d parts: spliced byte %d = %#x, want %#x", numParts, i, got[i], want[i])
+			}
+		}
+	}
+}
+
+func TestLosslessStreamWriter_MatchesBuffered(t *testing.T) {
+	// A streaming writer flushing through a small fixed buffer must produce
+	// byte-identical output to a buffered writer, including a partial final
+	// byte and spliced sub-writers.
+	rng := rand.New(rand.NewSource(131))
+	type write struct {
+		v uint32
+		n int
+	}
+	var writes []write
+	for i := 0; i < 8000; i++ {
+		n := rng.Intn(32) + 1
+		v := rng.Uint32()
+		if n < 32 {
+			v &= 1<<uint(n) - 1
+		}
+		writes = append(writes, write{v, n})
+	}
+
+	buffered := NewLosslessWriter(1024)
+	for _, w := range writes {
+		buffered.WriteBits(w.v, w.n)
+	}
+	buffered.WriteBits(0x5, 3) // force a partial final byte
+	want := buffered.Finish()
+
+	var out sliceWriter
+	stream := NewLosslessStreamWriter(&out, 1024) // minimum size: many flushes
+	for _, w := range writes {
+		stream.WriteBits(w.v, w.n)
+	}
+	stream.WriteBits(0x5, 3)
+	if err := stream.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	if stream.NumBytes() != len(want) {
+		t.Errorf("NumBytes = %d, want %d", stream.NumBytes(), len(want))
+	}
+	if len(out) != len(want) {
+		t.Fatalf("streamed length %d, want %d", len(out), len(want))
+	}
+	for i := range out {
+		if out[i] != want[i] {
+			t.Fatalf("streamed byte %d = %#x, want %#x", i, out[i], want[i])
+		}
+	}
+	if len(stream.buf) != 1024 {
+		t.Errorf("streaming buffer grew to %d bytes, want fixed 1024", len(stream.buf))
+	}
+}
+
+func TestLosslessStreamWriter_AppendBitstream(t *testing.T) {
+	// Buffered sub-writers spliced into a streaming destination must match
+	// the contiguous result.
+	rng := rand.New(rand.NewSource(211))
+	buffered := NewLosslessWriter(1024)
+	var out sliceWriter
+	stream := NewLosslessStreamWriter(&out, 1024)
+	for p := 0; p < 5; p++ {
+		part := NewLosslessWriter(64)
+		for i := 0; i < 2000; i++ {
+			n := rng.Intn(24) + 1
+			v := rng.Uint32() & (1<<uint(n) - 1)
+			part.WriteBits(v, n)
+		}
+		buffered.AppendBitstream(part)
+		stream.AppendBitstream(part)
+	}
+	want := buffered.Finish()
+	if err := stream.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	if len(out) != len(want) {
+		t.Fatalf("streamed length %d, want %d", len(out), len(want))
+	}
+	for i := range out {
+		if out[i] != want[i] {
+			t.Fatalf("streamed byte %d = %#x, want %#x", i, out[i], want[i])
+		}
+	}
+}
+
+func TestLosslessStreamWriter_WriteError(t *testing.T) {
+	fw := &failAfterWriter{limit: 2048}
+	stream := NewLosslessStreamWriter(fw, 1024)
+	for i := 0; i < 4096; i++ {
+		stream.WriteBits(0xAB, 8) // keeps writing past the failure; must not grow or panic
+	}
+	if err := stream.Close(); err != errWriteFailed {
+		t.Errorf("Close = %v, want errWriteFailed", err)
+	}
+	if stream.Err() != errWriteFailed {
+		t.Errorf("Err = %v, want errWriteFailed", stream.Err())
+	}
+	if len(stream.buf) != 1024 {
+		t.Errorf("buffer grew to %d bytes after write error, want fixed 1024", len(stream.buf))
+	}
+}
+
+// sliceWriter collects written bytes.
+type sliceWriter []byte
+
+func (w *sliceWriter) Write(p []byte) (int, error) {
+	*w = append(*w, p...)
+	return len(p), nil
+}
+
+var errWriteFailed = errors.New("write failed")
+
+// failAfterWriter accepts limit bytes and then fails every write.
+type failAfterWriter struct {
+	written int
+	limit   int
+}
+
+func (w *failAfterWriter) Write(p []byte) (int, error) {
+	if w.written+len(p) > w.limit {
+		return 0, errWriteFailed
+	}
+	w.written += len(p)
+	return len(p), nil
+}
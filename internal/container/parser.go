@@ -120,7 +120,7 @@ func (p *Parser) parseSingleImage(buf []byte) error {
 		frame.HasAlpha = alpha
 		p.features.HasAlpha = alpha
 	} else {
-		w, h, err := parseVP8Header(payload)
+		w, h, err := ParseVP8Header(payload)
 		if err != nil {
 			return err
 		}
@@ -338,7 +338,7 @@ func (p *Parser) parseExtSingleImage(buf []byte) error {
 			return nil
 
 		case FourCCVP8:
-			w, h, err := parseVP8Header(payload)
+			w, h, err := ParseVP8Header(payload)
 			if err != nil {
 				return err
 			}
@@ -458,9 +458,9 @@ func parseFrameSubChunks(frame FrameInfo, buf []byte) (FrameInfo, error) {
 	return frame, nil
 }
 
-// parseVP8Header extracts width and height from a VP8 lossy bitstream header.
+// ParseVP8Header extracts width and height from a VP8 lossy bitstream header.
 // Minimal parsing: 10-byte frame header containing the VP8 signature.
-func parseVP8Header(data []byte) (width, height int, err error) {
+func ParseVP8Header(data []byte) (width, height int, err error) {
 	if len(data) < VP8FrameHeaderSize {
 		return 0, 0, ErrTruncated
 	}
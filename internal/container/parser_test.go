@@ -112,7 +112,7 @@ func TestParseVP8Header(t *testing.T) {
 	// Height: 240 (14 bits LE)
 	binary.LittleEndian.PutUint16(data[8:10], 240)
 
-	w, h, err := parseVP8Header(data)
+	w, h, err := ParseVP8Header(data)
 	if err != nil {
 		t.Fatalf("unexpected error: %v", err)
 	}
@@ -0,0 +1,615 @@
+package container
+
+import (
+	"encoding/binary"
+	"fmt"
+	"io"
+)
+
+// StreamParser incrementally parses a WebP RIFF container from an io.Reader.
+// Unlike Parser, which requires the complete file in one byte slice, a
+// StreamParser reads one chunk at a time, so peak memory and first-frame
+// latency are bounded by the size of the largest single chunk rather than
+// the size of the whole file. This matters for large animations read off a
+// network stream: the first frame can be decoded while later frames are
+// still in flight.
+type StreamParser struct {
+	r         io.Reader
+	features  Features
+	chunks    []Chunk // non-image metadata chunks seen so far (ICCP, EXIF, XMP, ...)
+	remaining int64   // bytes left inside the RIFF payload (after the WEBP tag)
+
+	// One-chunk lookahead: a chunk header that has been read but whose
+	// payload has not been consumed yet.
+	pendingFourCC uint32
+	pendingSize   uint32
+	havePending   bool
+
+	simpleDone bool // a simple (non-VP8X) file's single frame was returned
+	isVP8X     bool
+	animChunks int
+	frameCount int
+}
+
+// NewStreamParser reads and validates the RIFF/WEBP header from r and, for
+// extended (VP8X) files, parses the header chunks up to the first image
+// data. Canvas features are available immediately for VP8X files; for
+// simple VP8/VP8L files the dimensions are filled in by the first call to
+// NextFrame, since they live in the bitstream header.
+func NewStreamParser(r io.Reader) (*StreamParser, error) {
+	var hdr [RIFFHeaderSize]byte
+	if _, err := io.ReadFull(r, hdr[:]); err != nil {
+		return nil, fmt.Errorf("webp: reading RIFF header: %w", err)
+	}
+	riffHdr, _, err := ParseRIFFHeader(hdr[:])
+	if err != nil {
+		return nil, err
+	}
+
+	p := &StreamParser{
+		r: r,
+		// FileSize counts everything after the 8-byte RIFF header,
+		// including the 4-byte WEBP tag already consumed.
+		remaining: int64(riffHdr.FileSize) - TagSize,
+	}
+
+	fourcc, size, err := p.nextChunkHeader()
+	if err != nil {
+		return nil, err
+	}
+
+	switch fourcc {
+	case FourCCVP8X:
+		p.isVP8X = true
+		if err := p.parseVP8XChunk(size); err != nil {
+			return nil, err
+		}
+		// Read ahead through metadata/ANIM chunks so Features() is
+		// complete before the first frame chunk.
+		if err := p.advanceToImageChunk(); err != nil && err != io.EOF {
+			return nil, err
+		}
+	case FourCCVP8:
+		p.features.Format = FormatVP8
+		p.pushBack(fourcc, size)
+	case FourCCVP8L:
+		p.features.Format = FormatVP8L
+		p.pushBack(fourcc, size)
+	default:
+		return nil, fmt.Errorf("%w: unexpected first chunk %s", ErrUnsupported, FourCCString(fourcc))
+	}
+
+	return p, nil
+}
+
+// Features returns the file features parsed so far. For simple VP8/VP8L
+// files Width/Height are zero until the first NextFrame call.
+func (p *StreamParser) Features() Features { return p.features }
+
+// Chunks returns the non-image metadata chunks consumed so far.
+func (p *StreamParser) Chunks() []Chunk { return p.chunks }
+
+// NextFrame reads chunks until a complete image frame has been assembled
+// and returns it. It returns io.EOF once the container is exhausted.
+// Frame payloads reference freshly allocated buffers; they remain valid
+// after subsequent NextFrame calls.
+func (p *StreamParser) NextFrame() (FrameInfo, error) {
+	if !p.isVP8X {
+		return p.nextSimpleFrame(true)
+	}
+	return p.nextExtendedFrame(true)
+}
+
+// NextFrameHeader is like NextFrame but reads only the bitstream headers,
+// skipping the bulk of each payload (seeking when the underlying reader
+// supports it). The returned FrameInfo has Payload and AlphaData nil; its
+// dimensions, alpha and lossless flags are filled in. This makes probing
+// features of a large file cost a bounded number of bytes per chunk.
+func (p *StreamParser) NextFrameHeader() (FrameInfo, error) {
+	if !p.isVP8X {
+		return p.nextSimpleFrame(false)
+	}
+	return p.nextExtendedFrame(false)
+}
+
+// nextSimpleFrame handles non-extended files: a single VP8 or VP8L chunk.
+func (p *StreamParser) nextSimpleFrame(full bool) (FrameInfo, error) {
+	if p.simpleDone {
+		return FrameInfo{}, io.EOF
+	}
+	fourcc, size, err := p.nextChunkHeader()
+	if err != nil {
+		return FrameInfo{}, err
+	}
+	var payload []byte
+	if full {
+		payload, err = p.readPayload(size)
+	} else {
+		payload, err = p.readPayloadPrefix(size, VP8FrameHeaderSize)
+	}
+	if err != nil {
+		return FrameInfo{}, err
+	}
+	p.simpleDone = true
+
+	frame := FrameInfo{
+		IsLossless: fourcc == FourCCVP8L,
+	}
+	if full {
+		frame.Payload = payload
+	}
+	switch fourcc {
+	case FourCCVP8L:
+		w, h, alpha, err := parseVP8LHeader(payload)
+		if err != nil {
+			return FrameInfo{}, err
+		}
+		frame.Width, frame.Height, frame.HasAlpha = w, h, alpha
+		p.features.HasAlpha = alpha
+	case FourCCVP8:
+		w, h, err := ParseVP8Header(payload)
+		if err != nil {
+			return FrameInfo{}, err
+		}
+		frame.Width, frame.Height = w, h
+	default:
+		return FrameInfo{}, fmt.Errorf("%w: unexpected chunk %s", ErrInvalidChunk, FourCCString(fourcc))
+	}
+
+	p.features.Width = frame.Width
+	p.features.Height = frame.Height
+	p.features.CanvasWidth = frame.Width
+	p.features.CanvasHeight = frame.Height
+	p.frameCount++
+	return frame, nil
+}
+
+// nextExtendedFrame handles VP8X files: still images (optional ALPH + VP8/
+// VP8L) and animations (one ANMF chunk per frame).
+func (p *StreamParser) nextExtendedFrame(full bool) (FrameInfo, error) {
+	var frame FrameInfo
+	var alphPayload []byte
+	var haveAlph bool
+
+	for {
+		fourcc, size, err := p.nextChunkHeader()
+		if err != nil {
+			return FrameInfo{}, err
+		}
+
+		switch fourcc {
+		case FourCCANMF:
+			if p.animChunks == 0 {
+				return FrameInfo{}, ErrInvalidChunk // ANIM must precede ANMF
+			}
+			if p.frameCount >= MaxFrames {
+				return FrameInfo{}, fmt.Errorf("%w: too many animation frames (max %d)", ErrInvalidChunk, MaxFrames)
+			}
+			var f FrameInfo
+			if full {
+				payload, err := p.readPayload(size)
+				if err != nil {
+					return FrameInfo{}, err
+				}
+				f, err = parseANMF(payload)
+				if err != nil {
+					return FrameInfo{}, err
+				}
+			} else {
+				f, err = p.readANMFHeader(size)
+				if err != nil {
+					return FrameInfo{}, err
+				}
+			}
+			p.frameCount++
+			return f, nil
+
+		case FourCCALPH:
+			if p.animChunks > 0 || p.features.HasAnim || p.frameCount > 0 {
+				return FrameInfo{}, ErrInvalidChunk
+			}
+			if full {
+				alphPayload, err = p.readPayload(size)
+			} else {
+				err = p.skipPayload(size)
+			}
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			haveAlph = true
+			frame.HasAlpha = true
+			p.features.HasAlpha = true
+
+		case FourCCVP8L:
+			if p.animChunks > 0 || p.features.HasAnim || p.frameCount > 0 {
+				return FrameInfo{}, ErrInvalidChunk
+			}
+			if haveAlph {
+				return FrameInfo{}, ErrInvalidChunk // VP8L has its own alpha
+			}
+			var payload []byte
+			if full {
+				payload, err = p.readPayload(size)
+			} else {
+				payload, err = p.readPayloadPrefix(size, VP8LFrameHeaderSize)
+			}
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			w, h, alpha, err := parseVP8LHeader(payload)
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			frame.Width, frame.Height = w, h
+			frame.IsLossless = true
+			if alpha {
+				frame.HasAlpha = true
+				p.features.HasAlpha = true
+			}
+			if full {
+				frame.Payload = payload
+			}
+			p.features.Width = w
+			p.features.Height = h
+			p.frameCount++
+			return frame, nil
+
+		case FourCCVP8:
+			if p.animChunks > 0 || p.features.HasAnim || p.frameCount > 0 {
+				return FrameInfo{}, ErrInvalidChunk
+			}
+			var payload []byte
+			if full {
+				payload, err = p.readPayload(size)
+			} else {
+				payload, err = p.readPayloadPrefix(size, VP8FrameHeaderSize)
+			}
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			w, h, err := ParseVP8Header(payload)
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			frame.Width, frame.Height = w, h
+			if full {
+				frame.Payload = payload
+				frame.AlphaData = alphPayload
+			}
+			p.features.Width = w
+			p.features.Height = h
+			p.frameCount++
+			return frame, nil
+
+		default:
+			// Metadata or unknown chunk between frames.
+			if err := p.consumeMetadataChunk(fourcc, size); err != nil {
+				return FrameInfo{}, err
+			}
+		}
+	}
+}
+
+// readANMFHeader reads the 16-byte ANMF header plus the sub-chunk headers
+// inside the ANMF payload, skipping the image data itself. Only frame
+// geometry, duration, dispose/blend and alpha/lossless flags are filled in.
+func (p *StreamParser) readANMFHeader(size uint32) (FrameInfo, error) {
+	if int(size) < ANMFChunkSize {
+		return FrameInfo{}, ErrInvalidChunk
+	}
+	padded := int64(PaddedSize(size))
+	if padded > p.remaining {
+		return FrameInfo{}, ErrTruncated
+	}
+
+	var hdr [ANMFChunkSize]byte
+	if _, err := io.ReadFull(p.r, hdr[:]); err != nil {
+		return FrameInfo{}, ErrTruncated
+	}
+	p.remaining -= ANMFChunkSize
+	inner := padded - ANMFChunkSize // sub-chunk bytes left inside this ANMF
+
+	frame := FrameInfo{
+		XOffset:  2 * readLE24(hdr[0:3]),
+		YOffset:  2 * readLE24(hdr[3:6]),
+		Width:    1 + readLE24(hdr[6:9]),
+		Height:   1 + readLE24(hdr[9:12]),
+		Duration: readLE24(hdr[12:15]),
+	}
+	bits := hdr[15]
+	if bits&1 != 0 {
+		frame.DisposeMethod = DisposeBackground
+	}
+	if bits&2 != 0 {
+		frame.BlendMethod = BlendNone
+	}
+	if uint64(frame.Width)*uint64(frame.Height) >= MaxImageArea {
+		return FrameInfo{}, ErrInvalidImage
+	}
+
+	// Walk the sub-chunks, reading only bitstream headers.
+	for inner >= ChunkHeaderSize {
+		var sub [ChunkHeaderSize]byte
+		if _, err := io.ReadFull(p.r, sub[:]); err != nil {
+			return FrameInfo{}, ErrTruncated
+		}
+		p.remaining -= ChunkHeaderSize
+		inner -= ChunkHeaderSize
+
+		subFourCC := binary.LittleEndian.Uint32(sub[0:4])
+		subSize := binary.LittleEndian.Uint32(sub[4:8])
+		subPadded := int64(PaddedSize(subSize))
+		if subPadded > inner {
+			return FrameInfo{}, ErrTruncated
+		}
+
+		switch subFourCC {
+		case FourCCALPH:
+			frame.HasAlpha = true
+			if err := p.skipPayload(subSize); err != nil {
+				return FrameInfo{}, err
+			}
+			inner -= subPadded
+			continue
+
+		case FourCCVP8L:
+			prefix, err := p.readPayloadPrefix(subSize, VP8LFrameHeaderSize)
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			inner -= subPadded
+			_, _, alpha, err := parseVP8LHeader(prefix)
+			if err != nil {
+				return FrameInfo{}, err
+			}
+			frame.IsLossless = true
+			if alpha {
+				frame.HasAlpha = true
+			}
+
+		case FourCCVP8:
+			if err := p.skipPayload(subSize); err != nil {
+				return FrameInfo{}, err
+			}
+			inner -= subPadded
+
+		default:
+			if err := p.skipPayload(subSize); err != nil {
+				return FrameInfo{}, err
+			}
+			inner -= subPadded
+			continue
+		}
+		break
+	}
+
+	// Skip whatever is left of the ANMF payload.
+	if inner > 0 {
+		if err := p.skipPayload(uint32(inner)); err != nil {
+			return FrameInfo{}, err
+		}
+	}
+	return frame, nil
+}
+
+// parseVP8XChunk reads and parses the VP8X payload, mirroring Parser.parseVP8X.
+func (p *StreamParser) parseVP8XChunk(size uint32) error {
+	if size != uint32(VP8XChunkSize) {
+		return ErrInvalidVP8X
+	}
+	payload, err := p.readPayload(size)
+	if err != nil {
+		return err
+	}
+
+	flags := uint32(payload[0])
+	if flags & ^AllValidFlags != 0 {
+		return ErrInvalidFlags
+	}
+	p.features.Format = FormatVP8X
+	p.features.HasAnim = flags&AnimationFlag != 0
+	p.features.HasAlpha = flags&AlphaFlag != 0
+	p.features.HasICCP = flags&ICCPFlag != 0
+	p.features.HasEXIF = flags&EXIFFlag != 0
+	p.features.HasXMP = flags&XMPFlag != 0
+
+	p.features.CanvasWidth = 1 + readLE24(payload[4:7])
+	p.features.CanvasHeight = 1 + readLE24(payload[7:10])
+	p.features.Width = p.features.CanvasWidth
+	p.features.Height = p.features.CanvasHeight
+	if uint64(p.features.CanvasWidth)*uint64(p.features.CanvasHeight) >= MaxImageArea {
+		return ErrInvalidImage
+	}
+
+	p.features.LoopCount = 1
+	p.features.BGColor = 0xFFFFFFFF
+	return nil
+}
+
+// advanceToImageChunk consumes metadata and ANIM chunks, stopping with the
+// first image chunk (ANMF/ALPH/VP8/VP8L) left pending for NextFrame.
+func (p *StreamParser) advanceToImageChunk() error {
+	for {
+		fourcc, size, err := p.nextChunkHeader()
+		if err != nil {
+			return err
+		}
+		switch fourcc {
+		case FourCCANMF, FourCCALPH, FourCCVP8, FourCCVP8L:
+			// Push back for NextFrame.
+			p.pushBack(fourcc, size)
+			return nil
+		default:
+			if err := p.consumeMetadataChunk(fourcc, size); err != nil {
+				return err
+			}
+		}
+	}
+}
+
+// consumeMetadataChunk reads a non-image chunk's payload, recording it in
+// p.chunks subject to the same flag and size checks as Parser.
+func (p *StreamParser) consumeMetadataChunk(fourcc uint32, size uint32) error {
+	switch fourcc {
+	case FourCCVP8X:
+		return ErrInvalidChunk // duplicate VP8X
+
+	case FourCCANIM:
+		if int(size) < ANIMChunkSize {
+			return ErrInvalidChunk
+		}
+		payload, err := p.readPayload(size)
+		if err != nil {
+			return err
+		}
+		p.animChunks++
+		p.features.BGColor = binary.LittleEndian.Uint32(payload[0:4])
+		p.features.LoopCount = int(binary.LittleEndian.Uint16(payload[4:6]))
+		return nil
+
+	case FourCCICCP, FourCCEXIF, FourCCXMP:
+		keep := (fourcc == FourCCICCP && p.features.HasICCP) ||
+			(fourcc == FourCCEXIF && p.features.HasEXIF) ||
+			(fourcc == FourCCXMP && p.features.HasXMP)
+		if !keep {
+			return p.skipPayload(size)
+		}
+		if size > MaxMetadataSize {
+			return fmt.Errorf("%w: %s chunk too large (%d bytes, max %d)", ErrInvalidChunk, FourCCString(fourcc), size, MaxMetadataSize)
+		}
+		payload, err := p.readPayload(size)
+		if err != nil {
+			return err
+		}
+		p.chunks = append(p.chunks, Chunk{FourCC: fourcc, Payload: payload})
+		return nil
+
+	default:
+		if len(p.chunks) >= MaxChunks {
+			return fmt.Errorf("%w: too many chunks (max %d)", ErrInvalidChunk, MaxChunks)
+		}
+		if size > MaxMetadataSize {
+			return fmt.Errorf("%w: unknown chunk %s too large (%d bytes, max %d)", ErrInvalidChunk, FourCCString(fourcc), size, MaxMetadataSize)
+		}
+		payload, err := p.readPayload(size)
+		if err != nil {
+			return err
+		}
+		p.chunks = append(p.chunks, Chunk{FourCC: fourcc, Payload: payload})
+		return nil
+	}
+}
+
+// pushBack stores an already-read chunk header in the lookahead slot so the
+// next nextChunkHeader call returns it without touching the stream.
+func (p *StreamParser) pushBack(fourcc, size uint32) {
+	p.pendingFourCC = fourcc
+	p.pendingSize = size
+	p.havePending = true
+}
+
+// nextChunkHeader returns the next chunk's FourCC and payload size, either
+// from the lookahead slot or by reading 8 bytes from the stream. It
+// returns io.EOF when the RIFF payload is exhausted.
+func (p *StreamParser) nextChunkHeader() (uint32, uint32, error) {
+	if p.havePending {
+		p.havePending = false
+		return p.pendingFourCC, p.pendingSize, nil
+	}
+	if p.remaining < ChunkHeaderSize {
+		return 0, 0, io.EOF
+	}
+	var hdr [ChunkHeaderSize]byte
+	if _, err := io.ReadFull(p.r, hdr[:]); err != nil {
+		if err == io.EOF || err == io.ErrUnexpectedEOF {
+			return 0, 0, ErrTruncated
+		}
+		return 0, 0, fmt.Errorf("webp: reading chunk header: %w", err)
+	}
+	p.remaining -= ChunkHeaderSize
+	fourcc, size, err := ReadChunkHeader(hdr[:])
+	if err != nil {
+		return 0, 0, err
+	}
+	return fourcc, size, nil
+}
+
+// readPayload reads a chunk payload plus its RIFF padding byte, returning
+// the unpadded payload in a fresh buffer.
+func (p *StreamParser) readPayload(size uint32) ([]byte, error) {
+	padded := int64(PaddedSize(size))
+	if padded > p.remaining {
+		return nil, ErrTruncated
+	}
+	if size > uint32(MaxReadChunkSize) {
+		return nil, fmt.Errorf("webp: chunk too large for streaming (%d bytes, max %d)", size, MaxReadChunkSize)
+	}
+	buf := make([]byte, padded)
+	if _, err := io.ReadFull(p.r, buf); err != nil {
+		if err == io.EOF || err == io.ErrUnexpectedEOF {
+			return nil, ErrTruncated
+		}
+		return nil, fmt.Errorf("webp: reading chunk payload: %w", err)
+	}
+	p.remaining -= padded
+	return buf[:size], nil
+}
+
+// readPayloadPrefix reads the first n bytes of a chunk payload into a small
+// buffer and skips the remainder (plus padding). If the payload is shorter
+// than n, the whole payload is returned.
+func (p *StreamParser) readPayloadPrefix(size uint32, n int) ([]byte, error) {
+	padded := int64(PaddedSize(size))
+	if padded > p.remaining {
+		return nil, ErrTruncated
+	}
+	if int64(n) > int64(size) {
+		n = int(size)
+	}
+	buf := make([]byte, n)
+	if _, err := io.ReadFull(p.r, buf); err != nil {
+		if err == io.EOF || err == io.ErrUnexpectedEOF {
+			return nil, ErrTruncated
+		}
+		return nil, fmt.Errorf("webp: reading chunk payload: %w", err)
+	}
+	p.remaining -= int64(n)
+	if err := p.skip(padded - int64(n)); err != nil {
+		return nil, err
+	}
+	return buf, nil
+}
+
+// skipPayload discards a chunk payload (plus padding) without buffering it.
+func (p *StreamParser) skipPayload(size uint32) error {
+	padded := int64(PaddedSize(size))
+	if padded > p.remaining {
+		return ErrTruncated
+	}
+	return p.skip(padded)
+}
+
+// skip advances the stream by n bytes, seeking when the reader supports it
+// and falling back to a copy into io.Discard otherwise.
+func (p *StreamParser) skip(n int64) error {
+	if n == 0 {
+		return nil
+	}
+	if s, ok := p.r.(io.Seeker); ok {
+		if _, err := s.Seek(n, io.SeekCurrent); err == nil {
+			p.remaining -= n
+			return nil
+		}
+		// Fall through to the copying path on seek failure (e.g. pipes
+		// wrapped in types that implement Seeker conditionally).
+	}
+	m, err := io.CopyN(io.Discard, p.r, n)
+	p.remaining -= m
+	if err != nil {
+		if err == io.EOF {
+			return ErrTruncated
+		}
+		return fmt.Errorf("webp: skipping chunk payload: %w", err)
+	}
+	return nil
+}
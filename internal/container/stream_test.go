@@ -0,0 +1,135 @@
+package container
+
+import (
+	"bytes"
+	"io"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+// streamTestFiles lists the still-image fixtures shared with the in-memory
+// parser tests.
+var streamTestFiles = []string{
+	"red_4x4_lossy.webp",
+	"red_4x4_lossless.webp",
+	"blue_16x16_lossy.webp",
+	"gradient_8x8_lossless.webp",
+}
+
+func readTestFile(t *testing.T, name string) []byte {
+	t.Helper()
+	data, err := os.ReadFile(filepath.Join("..", "..", "testdata", name))
+	if err != nil {
+		t.Fatalf("reading %s: %v", name, err)
+	}
+	return data
+}
+
+// TestStreamParser_MatchesParser verifies that the streaming parser produces
+// the same frames and features as the whole-buffer Parser.
+func TestStreamParser_MatchesParser(t *testing.T) {
+	for _, name := range streamTestFiles {
+		t.Run(name, func(t *testing.T) {
+			data := readTestFile(t, name)
+
+			ref, err := NewParser(data)
+			if err != nil {
+				t.Fatalf("NewParser: %v", err)
+			}
+
+			sp, err := NewStreamParser(bytes.NewReader(data))
+			if err != nil {
+				t.Fatalf("NewStreamParser: %v", err)
+			}
+
+			var frames []FrameInfo
+			for {
+				frame, err := sp.NextFrame()
+				if err == io.EOF {
+					break
+				}
+				if err != nil {
+					t.Fatalf("NextFrame: %v", err)
+				}
+				frames = append(frames, frame)
+			}
+
+			refFrames := ref.Frames()
+			if len(frames) != len(refFrames) {
+				t.Fatalf("frame count = %d, want %d", len(frames), len(refFrames))
+			}
+			for i := range frames {
+				if frames[i].Width != refFrames[i].Width || frames[i].Height != refFrames[i].Height {
+					t.Errorf("frame %d: size %dx%d, want %dx%d",
+						i, frames[i].Width, frames[i].Height, refFrames[i].Width, refFrames[i].Height)
+				}
+				if frames[i].IsLossless != refFrames[i].IsLossless {
+					t.Errorf("frame %d: IsLossless = %v, want %v", i, frames[i].IsLossless, refFrames[i].IsLossless)
+				}
+				if !bytes.Equal(frames[i].Payload, refFrames[i].Payload) {
+					t.Errorf("frame %d: payload differs (%d vs %d bytes)",
+						i, len(frames[i].Payload), len(refFrames[i].Payload))
+				}
+			}
+
+			if sp.Features() != ref.Features() {
+				t.Errorf("features = %+v, want %+v", sp.Features(), ref.Features())
+			}
+		})
+	}
+}
+
+// slowReader returns at most one byte per Read call, exercising the
+// short-read paths a network stream would hit.
+type slowReader struct {
+	data []byte
+}
+
+func (r *slowReader) Read(p []byte) (int, error) {
+	if len(r.data) == 0 {
+		return 0, io.EOF
+	}
+	p[0] = r.data[0]
+	r.data = r.data[1:]
+	return 1, nil
+}
+
+func TestStreamParser_OneBytePerRead(t *testing.T) {
+	data := readTestFile(t, "red_4x4_lossy.webp")
+
+	sp, err := NewStreamParser(&slowReader{data: data})
+	if err != nil {
+		t.Fatalf("NewStreamParser: %v", err)
+	}
+	frame, err := sp.NextFrame()
+	if err != nil {
+		t.Fatalf("NextFrame: %v", err)
+	}
+	if frame.Width != 4 || frame.Height != 4 {
+		t.Fatalf("frame size = %dx%d, want 4x4", frame.Width, frame.Height)
+	}
+	if _, err := sp.NextFrame(); err != io.EOF {
+		t.Fatalf("second NextFrame = %v, want io.EOF", err)
+	}
+}
+
+func TestStreamParser_Truncated(t *testing.T) {
+	data := readTestFile(t, "blue_16x16_lossy.webp")
+
+	// Cutting inside the frame payload must surface ErrTruncated (the RIFF
+	// header still declares the full size).
+	sp, err := NewStreamParser(bytes.NewReader(data[:len(data)-4]))
+	if err != nil {
+		t.Fatalf("NewStreamParser: %v", err)
+	}
+	if _, err := sp.NextFrame(); err != ErrTruncated {
+		t.Fatalf("NextFrame = %v, want ErrTruncated", err)
+	}
+}
+
+func TestStreamParser_BadMagic(t *testing.T) {
+	if _, err := NewStreamParser(bytes.NewReader([]byte("JUNKJUNKJUNK"))); err == nil {
+		t.Fatal("expected error for non-RIFF input")
+	}
+}
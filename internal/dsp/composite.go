@@ -0,0 +1,58 @@
+package dsp
+
+// Animation canvas compositing kernels. These operate on rows of
+// non-premultiplied RGBA pixels (4 bytes per pixel, R-G-B-A order), as used
+// by the animation package's canvas reconstruction.
+
+// Dispatch variable for the SIMD-accelerated row blend.
+var BlendRowNRGBAFunc = blendRowNRGBAGo
+
+// BlendRowNRGBA composites src over dst for one row of non-premultiplied
+// RGBA pixels, matching the C libwebp BlendPixelNonPremult formula exactly.
+// dst and src must be the same length and a multiple of 4 bytes.
+func BlendRowNRGBA(dst, src []byte) {
+	BlendRowNRGBAFunc(dst, src)
+}
+
+func blendRowNRGBAGo(dst, src []byte) {
+	for i := 0; i+4 <= len(src); i += 4 {
+		srcA := uint32(src[i+3])
+		if srcA == 0 {
+			continue
+		}
+		dstA := uint32(dst[i+3])
+		if srcA == 255 || dstA == 0 {
+			dst[i] = src[i]
+			dst[i+1] = src[i+1]
+			dst[i+2] = src[i+2]
+			dst[i+3] = src[i+3]
+			continue
+		}
+		blendPixelNonPremult(dst[i:i+4:i+4], src[i:i+4:i+4], srcA, dstA)
+	}
+}
+
+// blendPixelNonPremult performs "src over dst" for a single pixel with
+// 0 < srcA < 255 and dstA > 0. This matches C libwebp BlendPixelNonPremult:
+//
+//	dst_factor_a = (dst_a * (256 - src_a)) >> 8
+//	blend_a      = src_a + dst_factor_a
+//	scale        = (1 << 24) / blend_a
+//	blend_ch     = (src_ch * src_a + dst_ch * dst_factor_a) * scale >> 24
+func blendPixelNonPremult(dst, src []byte, srcA, dstA uint32) {
+	dstFactorA := (dstA * (256 - srcA)) >> 8
+	blendA := srcA + dstFactorA
+	if blendA == 0 {
+		dst[0], dst[1], dst[2], dst[3] = 0, 0, 0, 0
+		return
+	}
+	scale := uint32(1<<24) / blendA
+	for c := 0; c < 3; c++ {
+		v := (uint32(src[c])*srcA + uint32(dst[c])*dstFactorA) * scale >> 24
+		if v > 255 {
+			v = 255
+		}
+		dst[c] = byte(v)
+	}
+	dst[3] = byte(blendA)
+}
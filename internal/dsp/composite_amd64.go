@@ -0,0 +1,39 @@
+//go:build amd64
+
+package dsp
+
+func init() {
+	BlendRowNRGBAFunc = blendRowNRGBASSE2
+}
+
+// blendRowExtremeSSE2 processes leading 4-pixel groups whose four source
+// alphas are all 0x00 (fully transparent: dst untouched) or all 0xFF (fully
+// opaque: 16-byte copy). It returns the number of bytes consumed, stopping
+// at the first mixed group or when fewer than 16 bytes remain.
+//
+//go:noescape
+func blendRowExtremeSSE2(dst, src []byte) int
+
+// blendRowNRGBASSE2 blends src over dst one row at a time. Animation frames
+// are dominated by runs of fully opaque or fully transparent pixels, which
+// the SSE2 kernel classifies and handles 4 pixels per iteration; the exact
+// non-premultiplied blend needs a per-pixel reciprocal that does not
+// vectorize, so mixed groups fall back to the scalar formula before vector
+// scanning resumes.
+func blendRowNRGBASSE2(dst, src []byte) {
+	n := len(src)
+	if len(dst) < n {
+		n = len(dst)
+	}
+	i := 0
+	for {
+		i += blendRowExtremeSSE2(dst[i:n], src[i:n])
+		if n-i < 16 {
+			break
+		}
+		// Mixed 4-pixel group: exact scalar blend.
+		blendRowNRGBAGo(dst[i:i+16], src[i:i+16])
+		i += 16
+	}
+	blendRowNRGBAGo(dst[i:n], src[i:n])
+}
@@ -0,0 +1,62 @@
+#include "textflag.h"
+
+// Animation canvas compositing - AMD64 SSE2 assembly.
+//
+// Pixel layout in memory (non-premultiplied RGBA):
+//   byte 0 = R, byte 1 = G, byte 2 = B, byte 3 = A
+//
+// blendRowExtremeSSE2 scans 4-pixel (16-byte) groups and handles the two
+// extreme alpha cases that dominate animation frames:
+//   - all four source alphas 0x00: source is invisible, skip the group
+//   - all four source alphas 0xFF: source is opaque, copy the group
+// It stops at the first group with mixed alphas (the caller applies the
+// exact scalar blend there) or when fewer than 16 bytes remain.
+
+// func blendRowExtremeSSE2(dst, src []byte) int
+// Arguments (Plan9 ABI):
+//   dst_base+0(FP)  = pointer to dst row
+//   src_base+24(FP) = pointer to src row
+//   src_len+32(FP)  = src length in bytes
+//   ret+48(FP)      = number of bytes consumed
+TEXT ·blendRowExtremeSSE2(SB), NOSPLIT, $0-56
+	MOVQ dst_base+0(FP), DI
+	MOVQ src_base+24(FP), SI
+	MOVQ src_len+32(FP), CX
+	XORQ AX, AX                 // AX = bytes consumed
+
+	// X5 = 0xFF000000 per 32-bit lane (alpha byte mask).
+	PCMPEQL X5, X5              // X5 = all ones
+	PSLLL   $24, X5             // X5 = 0xFF000000 x4
+
+blend_loop:
+	LEAQ 16(AX), BX
+	CMPQ BX, CX
+	JA   blend_done             // fewer than 16 bytes remain
+
+	MOVOU (SI)(AX*1), X0        // X0 = 4 source pixels
+	MOVO  X0, X1
+	PAND  X5, X1                // X1 = isolated alpha bytes
+
+	// All transparent? (every alpha lane == 0)
+	PXOR     X2, X2
+	PCMPEQL  X1, X2             // X2 lane = all ones where alpha lane == 0
+	MOVMSKPS X2, DX
+	CMPL     DX, $0x0F
+	JE       blend_skip
+
+	// All opaque? (every alpha lane == 0xFF000000)
+	MOVO     X5, X3
+	PCMPEQL  X1, X3             // X3 lane = all ones where alpha == 0xFF
+	MOVMSKPS X3, DX
+	CMPL     DX, $0x0F
+	JNE      blend_done         // mixed group: caller blends it
+
+	MOVOU X0, (DI)(AX*1)        // opaque: straight copy
+
+blend_skip:
+	ADDQ $16, AX
+	JMP  blend_loop
+
+blend_done:
+	MOVQ AX, ret+48(FP)
+	RET
@@ -0,0 +1,130 @@
+package dsp
+
+import (
+	"bytes"
+	"math/rand"
+	"testing"
+)
+
+// blendRowReference applies the per-pixel non-premultiplied "src over dst"
+// formula directly, as the animation package's scalar blend did.
+func blendRowReference(dst, src []byte) {
+	for i := 0; i+4 <= len(src); i += 4 {
+		srcA := uint32(src[i+3])
+		if srcA == 0 {
+			continue
+		}
+		dstA := uint32(dst[i+3])
+		if srcA == 255 || dstA == 0 {
+			copy(dst[i:i+4], src[i:i+4])
+			continue
+		}
+		dstFactorA := (dstA * (256 - srcA)) >> 8
+		blendA := srcA + dstFactorA
+		scale := uint32(1<<24) / blendA
+		for c := 0; c < 3; c++ {
+			v := (uint32(src[i+c])*srcA + uint32(dst[i+c])*dstFactorA) * scale >> 24
+			if v > 255 {
+				v = 255
+			}
+			dst[i+c] = byte(v)
+		}
+		dst[i+3] = byte(blendA)
+	}
+}
+
+// blendTestRow builds a row mixing long opaque and transparent runs (the
+// animation common case) with stretches of arbitrary alpha.
+func blendTestRow(rng *rand.Rand, pixels int) []byte {
+	row := make([]byte, pixels*4)
+	i := 0
+	for i < pixels {
+		run := 1 + rng.Intn(16)
+		if i+run > pixels {
+			run = pixels - i
+		}
+		var alpha int
+		switch rng.Intn(3) {
+		case 0:
+			alpha = 0
+		case 1:
+			alpha = 255
+		default:
+			alpha = rng.Intn(256)
+		}
+		for k := 0; k < run; k++ {
+			o := (i + k) * 4
+			row[o] = byte(rng.Intn(256))
+			row[o+1] = byte(rng.Intn(256))
+			row[o+2] = byte(rng.Intn(256))
+			row[o+3] = byte(alpha)
+		}
+		i += run
+	}
+	return row
+}
+
+func TestBlendRowNRGBAConformance(t *testing.T) {
+	rng := rand.New(rand.NewSource(47))
+	for iter := 0; iter < 500; iter++ {
+		pixels := 1 + rng.Intn(200)
+		src := blendTestRow(rng, pixels)
+		dst := blendTestRow(rng, pixels)
+
+		want := copyBuf(dst)
+		blendRowReference(want, src)
+
+		gotGo := copyBuf(dst)
+		blendRowNRGBAGo(gotGo, src)
+		if !bytes.Equal(gotGo, want) {
+			t.Fatalf("iter %d (%d px): Go implementation differs from reference", iter, pixels)
+		}
+
+		gotDisp := copyBuf(dst)
+		BlendRowNRGBA(gotDisp, src)
+		if !bytes.Equal(gotDisp, want) {
+			t.Fatalf("iter %d (%d px): dispatched implementation differs from reference", iter, pixels)
+		}
+	}
+}
+
+func TestBlendRowNRGBAExtremes(t *testing.T) {
+	// All-opaque source must become a straight copy; all-transparent source
+	// must leave dst untouched.
+	const pixels = 67 // not a multiple of 4, exercises the scalar tail
+	rng := rand.New(rand.NewSource(48))
+	dst := blendTestRow(rng, pixels)
+
+	opaque := blendTestRow(rng, pixels)
+	for i := 3; i < len(opaque); i += 4 {
+		opaque[i] = 255
+	}
+	got := copyBuf(dst)
+	BlendRowNRGBA(got, opaque)
+	if !bytes.Equal(got, opaque) {
+		t.Error("opaque source: dst != src after blend")
+	}
+
+	transparent := blendTestRow(rng, pixels)
+	for i := 3; i < len(transparent); i += 4 {
+		transparent[i] = 0
+	}
+	got = copyBuf(dst)
+	BlendRowNRGBA(got, transparent)
+	if !bytes.Equal(got, dst) {
+		t.Error("transparent source: dst modified by blend")
+	}
+}
+
+func BenchmarkBlendRowNRGBA(b *testing.B) {
+	rng := rand.New(rand.NewSource(49))
+	src := blendTestRow(rng, 1920)
+	dst := blendTestRow(rng, 1920)
+	work := copyBuf(dst)
+	b.SetBytes(int64(len(src)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		copy(work, dst)
+		BlendRowNRGBA(work, src)
+	}
+}
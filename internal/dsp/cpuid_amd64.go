@@ -2,13 +2,17 @@
 
 package dsp
 
-// hasAVX2 is set at init time by probing CPUID for AVX2 support.
+// hasAVX2 and hasAVX512 are set at init time by probing CPUID.
 // This file is cpuid_amd64.go (alphabetically before dsp_amd64.go),
-// so hasAVX2 is ready before the dispatch init() runs.
-var hasAVX2 bool
+// so both are ready before the dispatch init() runs.
+var (
+	hasAVX2   bool
+	hasAVX512 bool
+)
 
 func init() {
 	hasAVX2 = cpuidAVX2Check()
+	hasAVX512 = cpuidAVX512Check()
 }
 
 // HasAVX2 returns true if the CPU supports AVX2 and the OS has enabled
@@ -17,5 +21,27 @@ func HasAVX2() bool {
 	return hasAVX2
 }
 
+// HasAVX512 returns true if the CPU supports AVX-512 F/BW/VL and the OS has
+// enabled ZMM and opmask state saving. Exported for use by other internal
+// packages.
+func HasAVX512() bool {
+	return hasAVX512
+}
+
+// SIMDTier names the instruction-set tier the dispatch selected at
+// init: "avx512", "avx2", or the unconditional "sse2" baseline.
+func SIMDTier() string {
+	if hasAVX512 {
+		return "avx512"
+	}
+	if hasAVX2 {
+		return "avx2"
+	}
+	return "sse2"
+}
+
 //go:noescape
 func cpuidAVX2Check() bool
+
+//go:noescape
+func cpuidAVX512Check() bool
@@ -39,3 +39,46 @@ TEXT ·cpuidAVX2Check(SB), NOSPLIT, $0-1
 no_avx2:
 	MOVB $0, ret+0(FP)
 	RET
+
+// AVX-512 feature detection.
+//
+// Checks requirements for safe AVX-512 usage:
+//   1. CPUID leaf 1: OSXSAVE bit (ECX bit 27)
+//   2. XGETBV ECX=0: XMM (bit 1), YMM (bit 2), opmask (bit 5),
+//      ZMM0-15 upper halves (bit 6) and ZMM16-31 (bit 7) enabled by OS
+//   3. CPUID leaf 7: AVX512F (EBX bit 16), AVX512BW (EBX bit 30),
+//      AVX512VL (EBX bit 31)
+//
+// Returns 1 if all checks pass, 0 otherwise.
+
+// func cpuidAVX512Check() bool
+TEXT ·cpuidAVX512Check(SB), NOSPLIT, $0-1
+	// Step 1: CPUID leaf 1 — check OSXSAVE (ECX bit 27).
+	MOVL $1, AX
+	XORL CX, CX
+	CPUID
+	BTL  $27, CX
+	JCC  no_avx512
+
+	// Step 2: XGETBV ECX=0 — OS must save XMM/YMM/opmask/ZMM state.
+	XORL CX, CX
+	// XGETBV: 0F 01 D0
+	BYTE $0x0F; BYTE $0x01; BYTE $0xD0
+	ANDL $0xE6, AX         // mask bits 1, 2, 5, 6, 7
+	CMPL AX, $0xE6         // all must be set
+	JNE  no_avx512
+
+	// Step 3: CPUID leaf 7, subleaf 0 — AVX512F + AVX512BW + AVX512VL.
+	MOVL $7, AX
+	XORL CX, CX
+	CPUID
+	ANDL $0xC0010000, BX   // bits 16, 30, 31
+	CMPL BX, $0xC0010000
+	JNE  no_avx512
+
+	MOVB $1, ret+0(FP)
+	RET
+
+no_avx512:
+	MOVB $0, ret+0(FP)
+	RET
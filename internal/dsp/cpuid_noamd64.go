@@ -2,6 +2,8 @@
 
 package dsp
 
+import "runtime"
+
 // hasAVX2 is always false on non-amd64 platforms.
 var hasAVX2 = false
 
@@ -9,3 +11,18 @@ var hasAVX2 = false
 func HasAVX2() bool {
 	return false
 }
+
+// HasAVX512 returns false on non-amd64 platforms.
+func HasAVX512() bool {
+	return false
+}
+
+// SIMDTier names the instruction-set tier in use: "neon" on arm64,
+// where the assembly kernels are unconditional, and "go" on platforms
+// served by the pure Go fallbacks.
+func SIMDTier() string {
+	if runtime.GOARCH == "arm64" {
+		return "neon"
+	}
+	return "go"
+}
@@ -49,6 +49,15 @@ func init() {
 		Transform = transformTwoDecAVX2
 		TransformUV = transformUVAVX2
 	}
+
+	// Third tier: AVX-512 (F+BW+VL) for the widest elementwise loops, where
+	// 64-byte vectors genuinely double throughput over YMM. Block-shaped
+	// kernels (4x4/16x16 transforms, loop filter) stay on AVX2 — their rows
+	// don't fill a ZMM register.
+	if hasAVX512 {
+		AddGreenToBlueAndRedFunc = addGreenToBlueAndRedAVX512
+		SubtractGreenFunc = subtractGreenAVX512
+	}
 }
 
 // --- SSE2 assembly function stubs ---
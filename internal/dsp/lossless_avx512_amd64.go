@@ -0,0 +1,11 @@
+//go:build amd64
+
+package dsp
+
+// AVX-512 versions of lossless green channel transforms.
+
+//go:noescape
+func addGreenToBlueAndRedAVX512(argb []uint32, numPixels int)
+
+//go:noescape
+func subtractGreenAVX512(argb []uint32, numPixels int)
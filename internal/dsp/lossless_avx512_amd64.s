@@ -0,0 +1,181 @@
+#include "textflag.h"
+
+// VP8L lossless color transforms — AMD64 AVX-512 assembly.
+//
+// AVX-512 versions of addGreenToBlueAndRed and subtractGreen.
+// Same algorithm as AVX2 but processes 16 pixels (64 bytes) per ZMM
+// iteration; remaining pixels fall through YMM/XMM widths and a scalar
+// tail. Requires AVX512F + AVX512BW (byte add/sub) + AVX512VL.
+
+// func addGreenToBlueAndRedAVX512(argb []uint32, numPixels int)
+TEXT ·addGreenToBlueAndRedAVX512(SB), NOSPLIT, $0-32
+	MOVQ argb_base+0(FP), SI    // SI = pointer to pixel data
+	MOVQ numPixels+24(FP), CX   // CX = number of pixels
+
+	CMPQ CX, $0
+	JLE  addgreen_avx512_done
+
+	// Build the 0x000000FF mask in Z5.
+	VPTERNLOGD $0xFF, Z5, Z5, Z5 // Z5 = all 1s
+	VPSRLD     $24, Z5, Z5       // Z5 = 0x000000FF x16
+
+	// Process 16 pixels (64 bytes) per iteration.
+	MOVQ CX, DX
+	SHRQ $4, DX                  // DX = numPixels / 16
+	JZ   addgreen_avx512_tail8
+
+addgreen_avx512_loop16:
+	VMOVDQU32 (SI), Z0           // Z0 = 16 pixels
+	VPSRLD    $8, Z0, Z1        // Z1 = pixels >> 8
+	VPANDD    Z5, Z1, Z1        // Z1 = green in byte 0
+	VPSLLD    $16, Z1, Z2       // Z2 = green in byte 2 (red position)
+	VPORD     Z2, Z1, Z1        // Z1 = [G, 0, G, 0] per pixel
+	VPADDB    Z1, Z0, Z0        // Z0 = pixels + green
+	VMOVDQU32 Z0, (SI)
+
+	ADDQ $64, SI
+	DECQ DX
+	JNZ  addgreen_avx512_loop16
+
+addgreen_avx512_tail8:
+	// 8 remaining pixels (YMM width).
+	TESTQ $8, CX
+	JZ    addgreen_avx512_tail4
+
+	VMOVDQU (SI), Y0
+	VPSRLD  $8, Y0, Y1
+	VPAND   Y5, Y1, Y1
+	VPSLLD  $16, Y1, Y2
+	VPOR    Y2, Y1, Y1
+	VPADDB  Y1, Y0, Y0
+	VMOVDQU Y0, (SI)
+	ADDQ    $32, SI
+
+addgreen_avx512_tail4:
+	// 4 remaining pixels (XMM width).
+	TESTQ $4, CX
+	JZ    addgreen_avx512_tail
+
+	VMOVDQU (SI), X0
+	VPSRLD  $8, X0, X1
+	VPAND   X5, X1, X1
+	VPSLLD  $16, X1, X2
+	VPOR    X2, X1, X1
+	VPADDB  X1, X0, X0
+	VMOVDQU X0, (SI)
+	ADDQ    $16, SI
+
+addgreen_avx512_tail:
+	// Handle remaining 0-3 pixels one at a time.
+	ANDQ $3, CX
+	JZ   addgreen_avx512_done
+
+addgreen_avx512_tail_loop:
+	MOVL  (SI), AX
+	MOVL  AX, BX
+	SHRL  $8, BX
+	ANDL  $0xFF, BX
+	MOVL  BX, DX
+	SHLL  $16, DX
+	ORL   BX, DX
+	MOVL  AX, R8
+	ANDL  $0x00FF00FF, R8
+	ADDL  DX, R8
+	ANDL  $0x00FF00FF, R8
+	ANDL  $0xFF00FF00, AX
+	ORL   R8, AX
+	MOVL  AX, (SI)
+	ADDQ  $4, SI
+	DECQ  CX
+	JNZ   addgreen_avx512_tail_loop
+
+addgreen_avx512_done:
+	VZEROUPPER
+	RET
+
+// func subtractGreenAVX512(argb []uint32, numPixels int)
+TEXT ·subtractGreenAVX512(SB), NOSPLIT, $0-32
+	MOVQ argb_base+0(FP), SI    // SI = pointer to pixel data
+	MOVQ numPixels+24(FP), CX   // CX = number of pixels
+
+	CMPQ CX, $0
+	JLE  subgreen_avx512_done
+
+	// Build the 0x000000FF mask in Z5.
+	VPTERNLOGD $0xFF, Z5, Z5, Z5
+	VPSRLD     $24, Z5, Z5       // Z5 = 0x000000FF x16
+
+	// Process 16 pixels per iteration.
+	MOVQ CX, DX
+	SHRQ $4, DX
+	JZ   subgreen_avx512_tail8
+
+subgreen_avx512_loop16:
+	VMOVDQU32 (SI), Z0           // Z0 = 16 pixels
+	VPSRLD    $8, Z0, Z1        // shift right 8
+	VPANDD    Z5, Z1, Z1        // isolate green
+	VPSLLD    $16, Z1, Z2       // green to red position
+	VPORD     Z2, Z1, Z1        // [G, 0, G, 0]
+	VPSUBB    Z1, Z0, Z0        // pixels - green
+	VMOVDQU32 Z0, (SI)
+
+	ADDQ $64, SI
+	DECQ DX
+	JNZ  subgreen_avx512_loop16
+
+subgreen_avx512_tail8:
+	TESTQ $8, CX
+	JZ    subgreen_avx512_tail4
+
+	VMOVDQU (SI), Y0
+	VPSRLD  $8, Y0, Y1
+	VPAND   Y5, Y1, Y1
+	VPSLLD  $16, Y1, Y2
+	VPOR    Y2, Y1, Y1
+	VPSUBB  Y1, Y0, Y0
+	VMOVDQU Y0, (SI)
+	ADDQ    $32, SI
+
+subgreen_avx512_tail4:
+	TESTQ $4, CX
+	JZ    subgreen_avx512_tail
+
+	VMOVDQU (SI), X0
+	VPSRLD  $8, X0, X1
+	VPAND   X5, X1, X1
+	VPSLLD  $16, X1, X2
+	VPOR    X2, X1, X1
+	VPSUBB  X1, X0, X0
+	VMOVDQU X0, (SI)
+	ADDQ    $16, SI
+
+subgreen_avx512_tail:
+	ANDQ $3, CX
+	JZ   subgreen_avx512_done
+
+subgreen_avx512_tail_loop:
+	MOVL  (SI), AX
+	MOVL  AX, BX
+	SHRL  $8, BX
+	ANDL  $0xFF, BX
+	MOVL  AX, R8
+	SHRL  $16, R8
+	ANDL  $0xFF, R8
+	SUBL  BX, R8
+	ANDL  $0xFF, R8
+	MOVL  AX, R9
+	ANDL  $0xFF, R9
+	SUBL  BX, R9
+	ANDL  $0xFF, R9
+	ANDL  $0xFF00FF00, AX
+	SHLL  $16, R8
+	ORL   R8, AX
+	ORL   R9, AX
+	MOVL  AX, (SI)
+	ADDQ  $4, SI
+	DECQ  CX
+	JNZ   subgreen_avx512_tail_loop
+
+subgreen_avx512_done:
+	VZEROUPPER
+	RET
@@ -83,11 +83,13 @@ func RescalerInit(r *Rescaler, srcWidth, srcHeight, dstWidth, dstHeight int) {
 		r.YAccum = r.YAdd
 	}
 
-	// Fixed-point scale factors.
+	// Fixed-point scale factors. FYScale is needed by both export paths:
+	// expand uses it to normalise interpolated rows, shrink uses it to carry
+	// the fractional part of the last imported row into the next output row.
 	if !r.XExpand && r.XSub > 0 {
 		r.FXScale = rescalerFrac(1, r.XSub)
 	}
-	if r.YExpand && r.YSub > 0 {
+	if r.YSub > 0 {
 		r.FYScale = rescalerFrac(1, r.YSub)
 	}
 	if !r.YExpand && r.XAdd > 0 && r.YAdd > 0 {
@@ -256,6 +258,51 @@ func rescalerExportRowShrink(r *Rescaler, dst []byte) {
 	}
 }
 
+// RescalePlane downscales a single 8-bit plane from srcW x srcH to
+// dstW x dstH using the incremental box-filter rescaler. Rows are imported
+// and exported one at a time, so no intermediate full-size buffer is
+// needed beyond the two DstWidth-sized accumulators. Destination
+// dimensions must not exceed the source dimensions.
+func RescalePlane(src []byte, srcStride, srcW, srcH int, dst []byte, dstStride, dstW, dstH int) {
+	if srcW <= 0 || srcH <= 0 || dstW <= 0 || dstH <= 0 {
+		return
+	}
+	var r Rescaler
+	RescalerInit(&r, srcW, srcH, dstW, dstH)
+	for y := 0; y < srcH; y++ {
+		RescalerImportRow(&r, src[y*srcStride:y*srcStride+srcW])
+		for r.DstY < dstH && RescalerExportRow(&r, dst[r.DstY*dstStride:r.DstY*dstStride+dstW]) {
+		}
+	}
+	// Flush any remaining output rows (expand mode can trail the input).
+	for r.DstY < dstH && RescalerExportRow(&r, dst[r.DstY*dstStride:r.DstY*dstStride+dstW]) {
+	}
+}
+
+// RescalerGetScaledDimensions computes the missing scaled dimension(s)
+// preserving aspect ratio, following libwebp's
+// WebPRescalerGetScaledDimensions. If one of scaledW/scaledH is zero it is
+// derived from the other; both zero is invalid and returns the source size.
+func RescalerGetScaledDimensions(srcW, srcH, scaledW, scaledH int) (int, int) {
+	w, h := scaledW, scaledH
+	if w == 0 && h == 0 {
+		return srcW, srcH
+	}
+	if w == 0 {
+		w = (srcW*h + srcH/2) / srcH
+	}
+	if h == 0 {
+		h = (srcH*w + srcW/2) / srcW
+	}
+	if w == 0 {
+		w = 1
+	}
+	if h == 0 {
+		h = 1
+	}
+	return w, h
+}
+
 // RescalerHasDstRow returns true if a destination row is ready for export.
 func RescalerHasDstRow(r *Rescaler) bool {
 	return r.YAccum <= 0
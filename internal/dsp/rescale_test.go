@@ -0,0 +1,86 @@
+package dsp
+
+import "testing"
+
+func TestRescalePlane_Uniform(t *testing.T) {
+	const srcW, srcH = 17, 13
+	const dstW, dstH = 5, 4
+	src := make([]byte, srcW*srcH)
+	for i := range src {
+		src[i] = 200
+	}
+	dst := make([]byte, dstW*dstH)
+	RescalePlane(src, srcW, srcW, srcH, dst, dstW, dstW, dstH)
+	for i, v := range dst {
+		if v < 199 || v > 201 {
+			t.Fatalf("dst[%d] = %d, want ~200", i, v)
+		}
+	}
+}
+
+func TestRescalePlane_HalfAverages(t *testing.T) {
+	// A 2x2-blocked image shrunk by exactly 2 must produce per-block averages.
+	const srcW, srcH = 4, 4
+	src := []byte{
+		0, 100, 10, 30,
+		200, 100, 50, 70,
+		255, 255, 0, 0,
+		255, 255, 0, 0,
+	}
+	dst := make([]byte, 4)
+	RescalePlane(src, srcW, srcW, srcH, dst, 2, 2, 2)
+
+	want := []byte{100, 40, 255, 0}
+	for i := range want {
+		diff := int(dst[i]) - int(want[i])
+		if diff < -1 || diff > 1 {
+			t.Errorf("dst[%d] = %d, want %d±1", i, dst[i], want[i])
+		}
+	}
+}
+
+func TestRescalePlane_NonIntegerRatio(t *testing.T) {
+	// Shrinking a horizontal ramp by a non-integer factor must preserve
+	// the overall gradient (monotonic, endpoints near source endpoints).
+	const srcW, srcH = 10, 10
+	src := make([]byte, srcW*srcH)
+	for y := 0; y < srcH; y++ {
+		for x := 0; x < srcW; x++ {
+			src[y*srcW+x] = byte(x * 255 / (srcW - 1))
+		}
+	}
+	const dstW, dstH = 7, 3
+	dst := make([]byte, dstW*dstH)
+	RescalePlane(src, srcW, srcW, srcH, dst, dstW, dstW, dstH)
+
+	for y := 0; y < dstH; y++ {
+		row := dst[y*dstW : (y+1)*dstW]
+		for x := 1; x < dstW; x++ {
+			if row[x] < row[x-1] {
+				t.Fatalf("row %d not monotonic: %v", y, row)
+			}
+		}
+		if row[0] > 40 || row[dstW-1] < 215 {
+			t.Errorf("row %d endpoints %d..%d, want ~0..~255", y, row[0], row[dstW-1])
+		}
+	}
+}
+
+func TestRescalerGetScaledDimensions(t *testing.T) {
+	tests := []struct {
+		srcW, srcH, inW, inH, wantW, wantH int
+	}{
+		{4000, 3000, 400, 300, 400, 300},
+		{4000, 3000, 400, 0, 400, 300},
+		{4000, 3000, 0, 300, 400, 300},
+		{4000, 3000, 0, 0, 4000, 3000},
+		{100, 1, 10, 0, 10, 1},
+	}
+	for _, tt := range tests {
+		w, h := RescalerGetScaledDimensions(tt.srcW, tt.srcH, tt.inW, tt.inH)
+		if w != tt.wantW || h != tt.wantH {
+			t.Errorf("RescalerGetScaledDimensions(%d,%d,%d,%d) = %dx%d, want %dx%d",
+				tt.srcW, tt.srcH, tt.inW, tt.inH, w, h, tt.wantW, tt.wantH)
+		}
+	}
+}
@@ -414,3 +414,85 @@ func BenchmarkTDisto4x4SSE2(b *testing.B) {
 		tDisto4x4SSE2(a, ref)
 	}
 }
+
+// ---------- AVX-512 conformance tests ----------
+// These verify AVX-512 implementations produce bit-exact results vs SSE2.
+// On non-AVX-512 machines, the tests are skipped.
+
+func TestAddGreenAVX512Conformance(t *testing.T) {
+	if !HasAVX512() {
+		t.Skip("AVX-512 not available")
+	}
+	rng := rand.New(rand.NewSource(510))
+	for iter := 0; iter < 500; iter++ {
+		n := rng.Intn(128) + 1
+		sse2Pix := make([]uint32, n)
+		for i := range sse2Pix {
+			sse2Pix[i] = rng.Uint32()
+		}
+		avx512Pix := make([]uint32, n)
+		copy(avx512Pix, sse2Pix)
+
+		addGreenToBlueAndRedSSE2(sse2Pix, n)
+		addGreenToBlueAndRedAVX512(avx512Pix, n)
+
+		for i := range sse2Pix {
+			if sse2Pix[i] != avx512Pix[i] {
+				t.Fatalf("iter %d, pixel %d: SSE2=0x%08x AVX512=0x%08x", iter, i, sse2Pix[i], avx512Pix[i])
+			}
+		}
+	}
+}
+
+func TestSubtractGreenAVX512Conformance(t *testing.T) {
+	if !HasAVX512() {
+		t.Skip("AVX-512 not available")
+	}
+	rng := rand.New(rand.NewSource(511))
+	for iter := 0; iter < 500; iter++ {
+		n := rng.Intn(128) + 1
+		sse2Pix := make([]uint32, n)
+		for i := range sse2Pix {
+			sse2Pix[i] = rng.Uint32()
+		}
+		avx512Pix := make([]uint32, n)
+		copy(avx512Pix, sse2Pix)
+
+		subtractGreenSSE2(sse2Pix, n)
+		subtractGreenAVX512(avx512Pix, n)
+
+		for i := range sse2Pix {
+			if sse2Pix[i] != avx512Pix[i] {
+				t.Fatalf("iter %d, pixel %d: SSE2=0x%08x AVX512=0x%08x", iter, i, sse2Pix[i], avx512Pix[i])
+			}
+		}
+	}
+}
+
+func BenchmarkAddGreenAVX512(b *testing.B) {
+	if !HasAVX512() {
+		b.Skip("AVX-512 not available")
+	}
+	pixels := make([]uint32, 256)
+	for i := range pixels {
+		pixels[i] = uint32(i * 0x01010101)
+	}
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		addGreenToBlueAndRedAVX512(pixels, len(pixels))
+	}
+}
+
+func BenchmarkSubtractGreenAVX512(b *testing.B) {
+	if !HasAVX512() {
+		b.Skip("AVX-512 not available")
+	}
+	pixels := make([]uint32, 256)
+	for i := range pixels {
+		pixels[i] = uint32(i * 0x01010101)
+	}
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		subtractGreenAVX512(pixels, len(pixels))
+	}
+}
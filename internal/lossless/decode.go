@@ -8,6 +8,7 @@ import (
 	"sync"
 
 	"github.com/deepteams/webp/internal/bitio"
+	"github.com/deepteams/webp/internal/dsp"
 )
 
 // losslessDecoderPool caches Decoder structs between decode calls so that the
@@ -78,6 +79,9 @@ type Decoder struct {
 	argbCache []uint32
 	// Reusable buffer for applyInverseTransforms output (pooled).
 	transformBuf []uint32
+	// Reusable slab backing the per-stage intermediate buffers of the
+	// pipelined decode path (only needed for multi-transform chains).
+	stageBuf []uint32
 
 	// Huffman metadata for the current image level.
 	hdr metadata
@@ -88,39 +92,144 @@ type Decoder struct {
 	transformsSeen uint32
 
 	// Reusable scratch buffers for Huffman decoding.
-	codeLengthsBuf []int             // reusable buffer for readHuffmanCode
+	codeLengthsBuf []int               // reusable buffer for readHuffmanCode
 	huffScratch    HuffmanTableScratch // slab allocator for Huffman tables
 
 	// Pooled buffers to reduce allocations across decode calls.
-	colorCacheBuf  []uint32    // reusable color cache backing array
+	colorCacheBuf  []uint32     // reusable color cache backing array
 	htreeGroupsBuf []HTreeGroup // reusable HTreeGroup slice
 
 	// recursionDepth tracks sub-image recursion depth to prevent
 	// stack overflow from malicious bitstreams.
 	recursionDepth int
+
+	// rowFunc, when non-nil, is called by decodeImageData each time a row
+	// completes (rows < row are fully decoded). Used by the pipelined
+	// decode path to overlap inverse transforms with entropy decoding.
+	rowFunc func(row int)
 }
 
 // metadata holds the Huffman-related state for the current decode level.
 type metadata struct {
-	colorCacheSize      int
-	colorCache          *ColorCache
-	huffmanImage        []uint32
+	colorCacheSize       int
+	colorCache           *ColorCache
+	huffmanImage         []uint32
 	huffmanSubsampleBits int
-	huffmanXSize        int
-	huffmanMask         int
-	numHTreeGroups      int
-	htreeGroups         []HTreeGroup
+	huffmanXSize         int
+	huffmanMask          int
+	numHTreeGroups       int
+	htreeGroups          []HTreeGroup
 }
 
 // DecodeVP8L decodes a VP8L bitstream (the payload after the VP8L fourcc and
 // chunk size) and returns an NRGBA image.
 func DecodeVP8L(data []byte) (*image.NRGBA, error) {
+	return decodeVP8L(data, nil)
+}
+
+// DecodeVP8LInto decodes a VP8L bitstream into a caller-provided NRGBA
+// image whose bounds must match the bitstream dimensions. No output
+// allocation is performed, allowing the destination to be reused across
+// decodes.
+func DecodeVP8LInto(data []byte, dst *image.NRGBA) error {
+	if dst == nil {
+		return fmt.Errorf("lossless: nil destination image")
+	}
+	_, err := decodeVP8L(data, dst)
+	return err
+}
+
+// DecodeVP8LScaled decodes a VP8L bitstream and downscales it to
+// scaledW x scaledH during pixel emission, so no full-size NRGBA image is
+// ever materialized. The scaled dimensions must be positive and must not
+// exceed the bitstream dimensions.
+func DecodeVP8LScaled(data []byte, scaledW, scaledH int) (*image.NRGBA, error) {
+	if scaledW <= 0 || scaledH <= 0 {
+		return nil, fmt.Errorf("lossless: invalid scaled dimensions %dx%d", scaledW, scaledH)
+	}
+	dec := acquireDecoder()
+	defer releaseDecoder(dec)
+
+	out, err := dec.decodePixels(data)
+	if err != nil {
+		return nil, err
+	}
+	if scaledW > dec.Width || scaledH > dec.Height {
+		return nil, fmt.Errorf("lossless: scaled dimensions %dx%d exceed image %dx%d",
+			scaledW, scaledH, dec.Width, dec.Height)
+	}
+
+	img := image.NewNRGBA(image.Rect(0, 0, scaledW, scaledH))
+	rescaleARGBToNRGBA(out, dec.Width, dec.Height, img)
+	return img, nil
+}
+
+// DecodeVP8LCropped decodes a VP8L bitstream and returns only the
+// requested window. Pixel emission stops after the last row of the crop
+// window, so content below it is never entropy-decoded or transformed.
+// The crop rectangle must lie within the image bounds.
+func DecodeVP8LCropped(data []byte, cropX, cropY, cropW, cropH int) (*image.NRGBA, error) {
+	if cropX < 0 || cropY < 0 || cropW <= 0 || cropH <= 0 {
+		return nil, fmt.Errorf("lossless: invalid crop %dx%d+%d+%d", cropW, cropH, cropX, cropY)
+	}
 	dec := acquireDecoder()
 	defer releaseDecoder(dec)
 
+	out, err := dec.decodePixelsRows(data, cropY+cropH)
+	if err != nil {
+		return nil, err
+	}
+	if cropX+cropW > dec.Width || cropY+cropH > dec.Height {
+		return nil, fmt.Errorf("lossless: crop %dx%d+%d+%d exceeds image %dx%d",
+			cropW, cropH, cropX, cropY, dec.Width, dec.Height)
+	}
+
+	img := image.NewNRGBA(image.Rect(0, 0, cropW, cropH))
+	for y := 0; y < cropH; y++ {
+		src := out[(cropY+y)*dec.Width+cropX : (cropY+y)*dec.Width+cropX+cropW]
+		argbToNRGBARows(src, img.Pix[y*img.Stride:], img.Stride, cropW, 0, 1)
+	}
+	return img, nil
+}
+
+// decodeVP8L is the shared implementation: if dst is nil a fresh NRGBA is
+// allocated, otherwise pixels are written into dst.
+func decodeVP8L(data []byte, dst *image.NRGBA) (*image.NRGBA, error) {
+	dec := acquireDecoder()
+	defer releaseDecoder(dec)
+
+	out, err := dec.decodePixels(data)
+	if err != nil {
+		return nil, err
+	}
+
+	if dst == nil {
+		dst = image.NewNRGBA(image.Rect(0, 0, dec.Width, dec.Height))
+	} else if dst.Rect.Dx() != dec.Width || dst.Rect.Dy() != dec.Height {
+		return nil, fmt.Errorf("lossless: destination size %dx%d does not match image %dx%d",
+			dst.Rect.Dx(), dst.Rect.Dy(), dec.Width, dec.Height)
+	}
+	argbToNRGBAInto(out, dst, dec.Width, dec.Height)
+	return dst, nil
+}
+
+// decodePixels runs the full VP8L decode pipeline and returns the ARGB
+// pixel buffer (dec.Width x dec.Height). The returned slice aliases the
+// decoder's pooled buffers and is only valid until the decoder is released.
+func (dec *Decoder) decodePixels(data []byte) ([]uint32, error) {
+	return dec.decodePixelsRows(data, 0)
+}
+
+// decodePixelsRows is like decodePixels but stops pixel emission after
+// lastRow rows (0 or out-of-range means the full height). Rows past
+// lastRow in the returned buffer are undefined.
+func (dec *Decoder) decodePixelsRows(data []byte, lastRow int) ([]uint32, error) {
 	if err := dec.decodeHeader(data); err != nil {
 		return nil, err
 	}
+	if lastRow <= 0 || lastRow > dec.Height {
+		lastRow = dec.Height
+	}
 
 	// Pre-allocate the Huffman table slab. 64K entries covers most images;
 	// BuildHuffmanTableScratch falls back to make() if the slab is exhausted.
@@ -177,16 +286,103 @@ func DecodeVP8L(data []byte) (*image.NRGBA, error) {
 		dec.transformBuf = make([]uint32, numAlloc)
 	}
 
-	// Decode the entropy-coded image data using the transform width.
-	if err := dec.decodeImageData(dec.pixels[:numPixTrans], tw, dec.Height, dec.Height); err != nil {
+	// Pipeline entropy decoding and inverse transforms on two goroutines
+	// when the image is large enough to pay for the hand-off.
+	if dec.shouldPipelineTransforms(lastRow) {
+		return dec.decodePixelsPipelined(numPixTrans, numPixOrig, tw, lastRow)
+	}
+
+	// Decode the entropy-coded image data using the transform width,
+	// stopping after lastRow rows.
+	if err := dec.decodeImageData(dec.pixels[:numPixTrans], tw, dec.Height, lastRow); err != nil {
 		return nil, err
 	}
 
 	// Apply inverse transforms. The transforms know the original width
 	// and will expand packed pixels back to the full image dimensions.
-	out := dec.applyInverseTransforms(dec.pixels[:numPixOrig])
+	if lastRow < dec.Height {
+		return dec.applyInverseTransformsRows(dec.pixels[:numPixOrig], lastRow), nil
+	}
+	return dec.applyInverseTransforms(dec.pixels[:numPixOrig]), nil
+}
 
-	return argbToNRGBA(out, dec.Width, dec.Height), nil
+// pipelineRowBatch is how many decoded rows are accumulated before they
+// are handed to the transform goroutine. Large enough to amortize the
+// channel hand-off, small enough to keep both stages busy.
+const pipelineRowBatch = 64
+
+// shouldPipelineTransforms reports whether the pipelined decode path is
+// worthwhile: there must be transforms to overlap with, a spare core to
+// run them on, and enough pixels to amortize the goroutine hand-off.
+// The entropy-coded symbol stream itself is strictly serial (bit offsets
+// of later tiles are unknown until earlier ones are decoded), so overlap
+// with the inverse transforms is where the available parallelism lies.
+func (dec *Decoder) shouldPipelineTransforms(lastRow int) bool {
+	return runtime.GOMAXPROCS(0) > 1 &&
+		dec.nextTransform > 0 &&
+		dec.Width*lastRow >= minPixelsForParallel
+}
+
+// decodePixelsPipelined runs entropy decoding on the calling goroutine
+// while a second goroutine applies the inverse transforms to finished row
+// ranges behind it. The transform stage only reads rows the entropy stage
+// has already written (the channel send orders the hand-off), and writes
+// only to the separate transform output buffer.
+func (dec *Decoder) decodePixelsPipelined(numPixTrans, numPixOrig, tw, lastRow int) ([]uint32, error) {
+	packed := dec.pixels[:numPixTrans]
+
+	// Each transform stage writes to its own buffer. The stages cannot
+	// share one buffer the way the whole-image path does: the predictor
+	// inverse reads the previous row of its *own* output as context, and
+	// with a shared buffer the next stage would have overwritten that row
+	// in place before the following batch arrives. The final stage writes
+	// to transformBuf; earlier stages slice a reusable slab.
+	nStages := dec.nextTransform
+	stages := make([][]uint32, nStages)
+	if nStages > 1 {
+		need := (nStages - 1) * numPixOrig
+		if cap(dec.stageBuf) >= need {
+			dec.stageBuf = dec.stageBuf[:need]
+		} else {
+			dec.stageBuf = make([]uint32, need)
+		}
+		for i := 0; i < nStages-1; i++ {
+			stages[i] = dec.stageBuf[i*numPixOrig : (i+1)*numPixOrig]
+		}
+	}
+	stages[nStages-1] = dec.transformBuf
+
+	rowCh := make(chan int, 4)
+	done := make(chan []uint32, 1)
+
+	go func() {
+		processed := 0
+		out := dec.transformBuf
+		for r := range rowCh {
+			out = dec.applyInverseTransformsRowRange(packed, processed, r, stages)
+			processed = r
+		}
+		if processed < lastRow {
+			out = dec.applyInverseTransformsRowRange(packed, processed, lastRow, stages)
+		}
+		done <- out
+	}()
+
+	sent := 0
+	dec.rowFunc = func(row int) {
+		if row-sent >= pipelineRowBatch && row <= lastRow {
+			rowCh <- row
+			sent = row
+		}
+	}
+	err := dec.decodeImageData(packed, tw, dec.Height, lastRow)
+	dec.rowFunc = nil
+	close(rowCh)
+	out := <-done
+	if err != nil {
+		return nil, err
+	}
+	return out[:numPixOrig], nil
 }
 
 // decodeHeader reads the VP8L header: signature, width, height, alpha, version.
@@ -333,12 +529,11 @@ func (dec *Decoder) updateDecoder(width, height int) {
 
 const numArgbCacheRows = 16
 
-// argbToNRGBA converts an ARGB pixel buffer to image.NRGBA.
-// VP8L internal pixel order is ARGB (alpha in bits 31..24, red 23..16,
-// green 15..8, blue 7..0).
+// argbToNRGBAInto converts an ARGB pixel buffer into an existing
+// image.NRGBA. VP8L internal pixel order is ARGB (alpha in bits 31..24,
+// red 23..16, green 15..8, blue 7..0).
 // For large images, the conversion is parallelized across rows.
-func argbToNRGBA(pixels []uint32, width, height int) *image.NRGBA {
-	img := image.NewNRGBA(image.Rect(0, 0, width, height))
+func argbToNRGBAInto(pixels []uint32, img *image.NRGBA, width, height int) {
 	pix := img.Pix
 	stride := img.Stride
 
@@ -362,9 +557,49 @@ func argbToNRGBA(pixels []uint32, width, height int) *image.NRGBA {
 	} else {
 		argbToNRGBARows(pixels, pix, stride, width, 0, height)
 	}
+}
+
+// argbToNRGBA converts an ARGB pixel buffer to a freshly allocated
+// image.NRGBA.
+func argbToNRGBA(pixels []uint32, width, height int) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, width, height))
+	argbToNRGBAInto(pixels, img, width, height)
 	return img
 }
 
+// rescaleARGBToNRGBA box-filters an ARGB pixel buffer down to the bounds of
+// img, one channel at a time. Channels are rescaled independently (no alpha
+// premultiply), which matches the plane-wise rescaling used for lossy
+// decode output.
+func rescaleARGBToNRGBA(pixels []uint32, width, height int, img *image.NRGBA) {
+	dstW := img.Rect.Dx()
+	dstH := img.Rect.Dy()
+
+	srcRow := make([]byte, width)
+	dstRow := make([]byte, dstW)
+
+	// Channel shifts in the ARGB word, ordered to match NRGBA byte layout.
+	shifts := [4]uint{16, 8, 0, 24} // R, G, B, A
+	for c := 0; c < 4; c++ {
+		shift := shifts[c]
+		var r dsp.Rescaler
+		dsp.RescalerInit(&r, width, height, dstW, dstH)
+		for y := 0; y < height; y++ {
+			row := pixels[y*width : y*width+width]
+			for x, px := range row {
+				srcRow[x] = uint8(px >> shift)
+			}
+			dsp.RescalerImportRow(&r, srcRow)
+			for r.DstY < dstH && dsp.RescalerExportRow(&r, dstRow) {
+				off := (r.DstY-1)*img.Stride + c
+				for x := 0; x < dstW; x++ {
+					img.Pix[off+x*4] = dstRow[x]
+				}
+			}
+		}
+	}
+}
+
 // argbToNRGBARows converts a range of rows from ARGB to NRGBA byte layout.
 func argbToNRGBARows(pixels []uint32, pix []byte, stride, width, yStart, yEnd int) {
 	for y := yStart; y < yEnd; y++ {
@@ -429,4 +664,3 @@ func NRGBAToARGB(img *image.NRGBA) []uint32 {
 func ARGBToNRGBA(pixels []uint32, width, height int) *image.NRGBA {
 	return argbToNRGBA(pixels, width, height)
 }
-
@@ -456,6 +456,7 @@ func (dec *Decoder) decodeImageData(data []uint32, width, height, lastRow int) e
 	colorCacheLimit := lenCodeLimit + hdr.colorCacheSize
 	colorCache := hdr.colorCache
 	mask := hdr.huffmanMask
+	rowFunc := dec.rowFunc
 
 	pos := 0
 	lastCached := 0 // 8.2: exact position tracking like C's last_cached pointer
@@ -496,6 +497,9 @@ func (dec *Decoder) decodeImageData(data []uint32, width, height, lastRow int) e
 						lastCached++
 					}
 				}
+				if rowFunc != nil {
+					rowFunc(row)
+				}
 			}
 			continue
 		}
@@ -525,6 +529,9 @@ func (dec *Decoder) decodeImageData(data []uint32, width, height, lastRow int) e
 							lastCached++
 						}
 					}
+					if rowFunc != nil {
+						rowFunc(row)
+					}
 				}
 				continue
 			}
@@ -598,6 +605,9 @@ func (dec *Decoder) decodeImageData(data []uint32, width, height, lastRow int) e
 						lastCached++
 					}
 				}
+				if rowFunc != nil {
+					rowFunc(row)
+				}
 			}
 		} else if code < lenCodeLimit {
 			// Backward reference (LZ77 copy).
@@ -650,9 +660,14 @@ func (dec *Decoder) decodeImageData(data []uint32, width, height, lastRow int) e
 			copyBlock32(data, pos, dist, length)
 			pos += length
 			col += length
-			for col >= width {
-				col -= width
-				row++
+			if col >= width {
+				for col >= width {
+					col -= width
+					row++
+				}
+				if rowFunc != nil {
+					rowFunc(row)
+				}
 			}
 			if col&mask != 0 {
 				htreeGroup = dec.getHTreeGroup(col, row)
@@ -696,6 +711,9 @@ func (dec *Decoder) decodeImageData(data []uint32, width, height, lastRow int) e
 						lastCached++
 					}
 				}
+				if rowFunc != nil {
+					rowFunc(row)
+				}
 			}
 		} else {
 			return ErrBitstream
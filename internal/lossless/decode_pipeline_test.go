@@ -0,0 +1,71 @@
+package lossless
+
+import (
+	"testing"
+)
+
+// gradientARGB builds a photo-like ARGB image that the encoder compresses
+// with the predictor and subtract-green transforms.
+func gradientARGB(width, height int) []uint32 {
+	argb := make([]uint32, width*height)
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			r := uint32((x * 255) / width)
+			g := uint32((y * 255) / height)
+			b := uint32(((x + y) * 255) / (width + height))
+			argb[y*width+x] = 0xff000000 | r<<16 | g<<8 | b
+		}
+	}
+	return argb
+}
+
+// paletteARGB builds a few-color image that the encoder compresses with
+// the color-indexing transform (packed, sub-byte pixels).
+func paletteARGB(width, height int) []uint32 {
+	colors := [4]uint32{0xff102030, 0xffa0b0c0, 0xffff0000, 0xff00ff00}
+	argb := make([]uint32, width*height)
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			argb[y*width+x] = colors[(x/7+y/5)&3]
+		}
+	}
+	return argb
+}
+
+// TestDecodePipelined round-trips images large enough to take the
+// pipelined decode path (entropy decoding overlapped with inverse
+// transforms) and verifies bit-exact reconstruction.
+func TestDecodePipelined(t *testing.T) {
+	cases := []struct {
+		name  string
+		w, h  int
+		pixFn func(w, h int) []uint32
+	}{
+		{"gradient", 512, 512, gradientARGB},
+		{"palette", 300, 400, paletteARGB},
+	}
+	for _, tc := range cases {
+		t.Run(tc.name, func(t *testing.T) {
+			argb := tc.pixFn(tc.w, tc.h)
+			data, err := Encode(argb, tc.w, tc.h, DefaultEncoderConfig())
+			if err != nil {
+				t.Fatalf("Encode: %v", err)
+			}
+
+			dec := acquireDecoder()
+			defer releaseDecoder(dec)
+			out, err := dec.decodePixels(data)
+			if err != nil {
+				t.Fatalf("decodePixels: %v", err)
+			}
+			if dec.nextTransform > 0 && !dec.shouldPipelineTransforms(dec.Height) {
+				t.Logf("note: image did not take the pipelined path")
+			}
+			for i := 0; i < tc.w*tc.h; i++ {
+				if out[i] != argb[i] {
+					t.Fatalf("pixel %d = %08x, want %08x", i, out[i], argb[i])
+				}
+			}
+		})
+	}
+}
@@ -152,9 +152,69 @@ func (dec *Decoder) applyInverseTransforms(pixels []uint32) []uint32 {
 	return out[:numPix]
 }
 
+// applyInverseTransformsRows is like applyInverseTransforms but only
+// processes the first numRows rows, for cropped decodes that stop pixel
+// emission early. All transform types preserve the vertical dimension, so
+// limiting the row range is safe.
+func (dec *Decoder) applyInverseTransformsRows(pixels []uint32, numRows int) []uint32 {
+	numPix := len(pixels)
+	rows := pixels
+	out := dec.transformBuf
+	if out == nil || len(out) < numPix {
+		out = make([]uint32, numPix)
+	}
+
+	for n := dec.nextTransform - 1; n >= 0; n-- {
+		t := &dec.transforms[n]
+		rowEnd := numRows
+		if rowEnd > t.YSize {
+			rowEnd = t.YSize
+		}
+		inverseTransform(t, 0, rowEnd, rows, out)
+		rows = out
+	}
+
+	if dec.nextTransform == 0 {
+		return pixels
+	}
+	return out[:numPix]
+}
+
+// applyInverseTransformsRowRange applies all transforms in reverse order to
+// the absolute row range [rowStart, rowEnd) and returns the final output
+// buffer. It requires at least one transform and that all rows before
+// rowStart have already been processed into each stage's buffer (the
+// predictor transform reads the previous row of its own output as context),
+// which the pipelined decode path guarantees by handing out strictly
+// increasing row ranges. stages holds one output buffer per transform, in
+// application order; they must be distinct so a later stage cannot clobber
+// the context rows an earlier stage needs for the next batch.
+func (dec *Decoder) applyInverseTransformsRowRange(pixels []uint32, rowStart, rowEnd int, stages [][]uint32) []uint32 {
+	rows := pixels
+	var out []uint32
+
+	for i, n := 0, dec.nextTransform-1; n >= 0; i, n = i+1, n-1 {
+		t := &dec.transforms[n]
+		re := rowEnd
+		if re > t.YSize {
+			re = t.YSize
+		}
+		rs := rowStart
+		if rs > re {
+			rs = re
+		}
+		out = stages[i]
+		inverseTransform(t, rs, re, rows, out)
+		rows = out
+	}
+	return out
+}
+
 // inverseTransform applies a single inverse transform to the pixel data.
-// Row-independent transforms (SubtractGreen, CrossColor) are parallelized
-// for large images.
+// in and out are full-image buffers; rowStart/rowEnd select the absolute
+// row range to process, so the transform can be applied incrementally as
+// rows are decoded. Row-independent transforms (SubtractGreen, CrossColor)
+// are parallelized for large images.
 func inverseTransform(t *Transform, rowStart, rowEnd int, in, out []uint32) {
 	width := t.XSize
 	numRows := rowEnd - rowStart
@@ -162,7 +222,8 @@ func inverseTransform(t *Transform, rowStart, rowEnd int, in, out []uint32) {
 
 	switch t.Type {
 	case SubtractGreenTransform:
-		addGreenToBlueAndRed(in, numPixels, out)
+		off := rowStart * width
+		addGreenToBlueAndRed(in[off:], numPixels, out[off:])
 
 	case PredictorTransform:
 		predictorInverseTransform(t, rowStart, rowEnd, in, out)
@@ -201,8 +262,8 @@ func addGreenToBlueAndRed(src []uint32, numPixels int, dst []uint32) {
 // Row slices are pre-computed for BCE elimination.
 func predictorInverseTransform(t *Transform, yStart, yEnd int, in, out []uint32) {
 	width := t.XSize
-	inOff := 0
-	outOff := 0
+	inOff := yStart * width
+	outOff := inOff
 
 	if yStart == 0 {
 		// First row: pixel 0 uses predictor 0 (black + residual = residual).
@@ -575,8 +636,8 @@ func colorIndexInverseTransform(t *Transform, yStart, yEnd int, src, dst []uint3
 		countMask := pixelsPerByte - 1
 		bitMask := uint32((1 << bitsPerPixel) - 1)
 
-		srcOff := 0
-		dstOff := 0
+		srcOff := yStart * VP8LSubSampleSize(width, t.Bits)
+		dstOff := yStart * width
 		for y := yStart; y < yEnd; y++ {
 			var packedPixels uint32
 			for x := 0; x < width; x++ {
@@ -594,8 +655,8 @@ func colorIndexInverseTransform(t *Transform, yStart, yEnd int, src, dst []uint3
 		}
 	} else {
 		// 1:1 mapping (8 bits per pixel, no sub-byte packing).
-		srcOff := 0
-		dstOff := 0
+		srcOff := yStart * width
+		dstOff := srcOff
 		for y := yStart; y < yEnd; y++ {
 			for x := 0; x < width; x++ {
 				idx := getARGBIndex(src[srcOff])
@@ -3,10 +3,11 @@ package lossless
 import (
 	"errors"
 	"io"
-	"sort"
+	"runtime"
 	"sync"
 
 	"github.com/deepteams/webp/internal/bitio"
+	"github.com/deepteams/webp/internal/pool"
 )
 
 // losslessEncoderPool reuses Encoder structs across successive lossless
@@ -36,6 +37,7 @@ func acquireEncoder(width, height int, config *EncoderConfig) *Encoder {
 	enc.useSubtractGreen = false
 	enc.usePredict = false
 	enc.useCrossColor = false
+	enc.arena.Reset()
 	return enc
 }
 
@@ -117,19 +119,19 @@ type Encoder struct {
 	huffScratch    *HuffmanScratch  // reusable Huffman tree scratch buffers
 	brScratch      BackwardRefsScratch // reusable backward refs scratch
 
+	// Per-encode bump arena for minor scratch buffers (sorted/delta
+	// palette, histogram image, predictor residuals). Reset at the top of
+	// each encode; its chunks are retained with the pooled encoder, so the
+	// steady state is pointer bumps with no allocator round-trips.
+	arena pool.Arena
+
 	// Minor reusable buffers.
-	sortedPalette  []uint32
-	deltaPalette   []uint32
-	histoImageBuf  []uint32
-	subImageHisto  *Histogram
-	huffCodes      [][HuffmanCodesPerMetaCode]*HuffmanTreeCode
+	subImageHisto *Histogram
+	huffCodes     [][HuffmanCodesPerMetaCode]*HuffmanTreeCode
 
 	// Reusable histogram slabs for GetHistoImageSymbols.
 	histoScratch HistoScratch
 
-	// Reusable residuals buffer for ResidualImage.
-	residualsBuf []uint32
-
 	// Reusable color cache for storeImageData.
 	storeCC *ColorCache
 
@@ -227,16 +229,20 @@ func EncodeToWriter(argb []uint32, width, height int, config *EncoderConfig,
 	}
 	enc.applyTransforms()
 
+	// Without a size-first header callback the bitstream can be streamed to
+	// w through a fixed-size buffer, keeping output memory constant.
+	if writeHeader == nil {
+		return enc.streamTo(w)
+	}
+
 	bs, err := enc.encodeStream()
 	if err != nil {
 		return err
 	}
 
 	// Write the header (RIFF framing) before the bitstream.
-	if writeHeader != nil {
-		if err := writeHeader(len(bs)); err != nil {
-			return err
-		}
+	if err := writeHeader(len(bs)); err != nil {
+		return err
 	}
 
 	// Write the bitstream directly from the pooled buffer.
@@ -251,6 +257,126 @@ func EncodeToWriter(argb []uint32, width, height int, config *EncoderConfig,
 	return err
 }
 
+// streamTo encodes the transformed image directly to w through a streaming
+// bit writer. This is only possible when no caller needs the total
+// bitstream size before the bytes are written; RIFF framing does, so the
+// container paths keep the buffered writer.
+func (enc *Encoder) streamTo(w io.Writer) error {
+	bw := bitio.NewLosslessStreamWriter(w, 0)
+	enc.encodeStreamTo(bw)
+	if err := bw.Close(); err != nil {
+		return err
+	}
+	if bw.NumBytes()&1 != 0 {
+		_, err := w.Write([]byte{0})
+		return err
+	}
+	return nil
+}
+
+// EncodeRowsToWriter encodes an image delivered strip-by-strip through
+// fillRows and writes the VP8L bitstream to w, like EncodeToWriter but
+// without requiring the caller to materialize the full ARGB plane first.
+// fillRows must write rows [y0, y1) of the image into dst (length
+// (y1-y0)*width) in ARGB order; strips are sized to the histogram tile
+// height for the configured method. The encoder still holds one full
+// plane internally — the global LZ77 match window and the two-pass
+// histogram clustering need the whole transformed image — so this saves
+// the caller-side copy, roughly halving peak transient memory.
+func EncodeRowsToWriter(width, height int, config *EncoderConfig,
+	fillRows func(y0, y1 int, dst []uint32),
+	w io.Writer, writeHeader func(bitstreamSize int) error) error {
+	if width <= 0 || height <= 0 || width > 16383 || height > 16383 {
+		return ErrImageTooLarge
+	}
+	if config == nil {
+		config = DefaultEncoderConfig()
+	}
+
+	enc := acquireEncoder(width, height, config)
+	defer releaseEncoder(enc)
+
+	enc.importRows(fillRows)
+
+	enc.analyze()
+	if config.NearLosslessQuality < 100 {
+		ApplyNearLossless(enc.argb, width, height, enc.predictorBits, config.NearLosslessQuality)
+	}
+	enc.applyTransforms()
+
+	if writeHeader == nil {
+		return enc.streamTo(w)
+	}
+
+	bs, err := enc.encodeStream()
+	if err != nil {
+		return err
+	}
+
+	if err := writeHeader(len(bs)); err != nil {
+		return err
+	}
+
+	if _, err = w.Write(bs); err != nil {
+		return err
+	}
+
+	if len(bs)&1 != 0 {
+		_, err = w.Write([]byte{0})
+	}
+	return err
+}
+
+// EncodeRows is the buffer-returning counterpart of EncodeRowsToWriter.
+func EncodeRows(width, height int, config *EncoderConfig,
+	fillRows func(y0, y1 int, dst []uint32)) ([]byte, error) {
+	if width <= 0 || height <= 0 || width > 16383 || height > 16383 {
+		return nil, ErrImageTooLarge
+	}
+	if config == nil {
+		config = DefaultEncoderConfig()
+	}
+
+	enc := acquireEncoder(width, height, config)
+	defer releaseEncoder(enc)
+
+	enc.importRows(fillRows)
+
+	enc.analyze()
+	if config.NearLosslessQuality < 100 {
+		ApplyNearLossless(enc.argb, width, height, enc.predictorBits, config.NearLosslessQuality)
+	}
+	enc.applyTransforms()
+
+	bs, err := enc.encodeStream()
+	if err != nil {
+		return nil, err
+	}
+	// Copy the result so it does not alias the pooled writerBuf.
+	out := make([]byte, len(bs))
+	copy(out, bs)
+	return out, nil
+}
+
+// importRows fills enc.argb from the row callback, one histogram-tile-high
+// strip at a time.
+func (enc *Encoder) importRows(fillRows func(y0, y1 int, dst []uint32)) {
+	pixelCount := enc.width * enc.height
+	if cap(enc.argb) >= pixelCount {
+		enc.argb = enc.argb[:pixelCount]
+	} else {
+		enc.argb = make([]uint32, pixelCount)
+	}
+	strip := 1 << uint(getHistoBits(enc.config.Method, false, enc.width, enc.height))
+	for y0 := 0; y0 < enc.height; y0 += strip {
+		y1 := y0 + strip
+		if y1 > enc.height {
+			y1 = enc.height
+		}
+		fillRows(y0, y1, enc.argb[y0*enc.width:y1*enc.width])
+	}
+}
+
 // analyze determines which transforms to use and sets encoding parameters.
 func (enc *Encoder) analyze() {
 	quality := enc.config.Quality
@@ -398,8 +524,8 @@ func (enc *Encoder) applyTransforms() {
 
 	if enc.usePredict {
 		data, residuals := ResidualImage(enc.argb, enc.width, enc.height,
-			enc.predictorBits, enc.config.Quality, enc.residualsBuf)
-		enc.residualsBuf = residuals
+			enc.predictorBits, enc.config.Quality,
+			enc.arena.Uint32(enc.width*enc.height))
 		enc.argb = residuals
 		enc.transforms = append(enc.transforms, Transform{
 			Type:  PredictorTransform,
@@ -426,17 +552,13 @@ func (enc *Encoder) applyTransforms() {
 // applyPaletteTransform applies the color indexing transform, and optionally
 // the predictor transform on the palette-indexed data (kPaletteAndSpatial).
 func (enc *Encoder) applyPaletteTransform() {
-	// Sort palette for better compression.
-	if cap(enc.sortedPalette) >= enc.paletteSize {
-		enc.sortedPalette = enc.sortedPalette[:enc.paletteSize]
-	} else {
-		enc.sortedPalette = make([]uint32, enc.paletteSize)
-	}
-	sortedPalette := enc.sortedPalette
+	// Order the palette for better compression: the entries are stored
+	// delta-coded and the index image is entropy-coded, so entry order
+	// affects both. ColorIndexBuild returns the palette sorted by value;
+	// sortPalette keeps or improves on that order per method.
+	sortedPalette := enc.arena.Uint32(enc.paletteSize)
 	copy(sortedPalette, enc.palette[:enc.paletteSize])
-	sort.Slice(sortedPalette, func(i, j int) bool {
-		return sortedPalette[i] < sortedPalette[j]
-	})
+	sortPalette(enc.argb, enc.width, enc.height, sortedPalette, enc.config.Method)
 
 	packed, packedWidth := ApplyPaletteTransform(enc.argb, enc.width, enc.height, sortedPalette)
 	enc.argb = packed
@@ -456,8 +578,8 @@ func (enc *Encoder) applyPaletteTransform() {
 	// C reference which passes enc->current_width to ApplyPredictFilter.
 	if enc.usePredict {
 		data, residuals := ResidualImage(enc.argb, enc.currentWidth, enc.height,
-			enc.predictorBits, enc.config.Quality, enc.residualsBuf)
-		enc.residualsBuf = residuals
+			enc.predictorBits, enc.config.Quality,
+			enc.arena.Uint32(enc.currentWidth*enc.height))
 		enc.argb = residuals
 		enc.transforms = append(enc.transforms, Transform{
 			Type:  PredictorTransform,
@@ -485,15 +607,23 @@ func paletteCodeBits(paletteSize int) int {
 
 // encodeStream encodes the transformed image to a VP8L bitstream.
 func (enc *Encoder) encodeStream() ([]byte, error) {
+	// Estimated output size.
+	estimatedSize := enc.width*enc.height + 1024
+	bw := bitio.NewLosslessWriterWithBuf(enc.writerBuf, estimatedSize)
+	enc.encodeStreamTo(bw)
+	result := bw.Finish()
+	enc.writerBuf = bw.Buf()
+	return result, nil
+}
+
+// encodeStreamTo writes the VP8L bitstream for the transformed image to bw,
+// which may be buffered or streaming.
+func (enc *Encoder) encodeStreamTo(bw *bitio.LosslessWriter) {
 	width := enc.width
 	height := enc.height
 	quality := enc.config.Quality
 	currentWidth := enc.currentWidth
 
-	// Estimated output size.
-	estimatedSize := width*height + 1024
-	bw := bitio.NewLosslessWriterWithBuf(enc.writerBuf, estimatedSize)
-
 	// Write VP8L header.
 	// Signature byte.
 	bw.WriteBits(VP8LMagicByte, 8)
@@ -603,15 +733,7 @@ func (enc *Encoder) encodeStream() ([]byte, error) {
 		txSize := VP8LSubSampleSize(currentWidth, histoBits)
 		tySize := VP8LSubSampleSize(height, histoBits)
 		histoImageSize := txSize * tySize
-		if cap(enc.histoImageBuf) >= histoImageSize {
-			enc.histoImageBuf = enc.histoImageBuf[:histoImageSize]
-			for i := range enc.histoImageBuf {
-				enc.histoImageBuf[i] = 0
-			}
-		} else {
-			enc.histoImageBuf = make([]uint32, histoImageSize)
-		}
-		histoImage := enc.histoImageBuf
+		histoImage := enc.arena.Uint32(histoImageSize)
 		for i, s := range symbols {
 			if i < histoImageSize {
 				histoImage[i] = uint32(s) << 8
@@ -653,10 +775,6 @@ func (enc *Encoder) encodeStream() ([]byte, error) {
 
 	// Write image data using backward refs + Huffman codes.
 	enc.storeImageData(bw, refs, symbols, huffCodes, currentWidth, histoBits, cacheBits)
-
-	result := bw.Finish()
-	enc.writerBuf = bw.Buf()
-	return result, nil
 }
 
 // writeTransformData writes transform-specific data to the bitstream.
@@ -821,12 +939,7 @@ func (enc *Encoder) storeSubImageData(
 // encodePalette writes the palette colors to the bitstream.
 func (enc *Encoder) encodePalette(bw *bitio.LosslessWriter, palette []uint32) {
 	// Delta-encode palette: first pixel is literal, rest are deltas.
-	if cap(enc.deltaPalette) >= len(palette) {
-		enc.deltaPalette = enc.deltaPalette[:len(palette)]
-	} else {
-		enc.deltaPalette = make([]uint32, len(palette))
-	}
-	deltaPalette := enc.deltaPalette
+	deltaPalette := enc.arena.Uint32(len(palette))
 	deltaPalette[0] = palette[0]
 	for i := 1; i < len(palette); i++ {
 		deltaPalette[i] = subPixelsEnc(palette[i], palette[i-1])
@@ -918,7 +1031,7 @@ func optimizeSampling(image []uint32, fullWidth, fullHeight, bits, maxBits int)
 func (enc *Encoder) encodeHistogramImage(bw *bitio.LosslessWriter, symbols []uint16, width, height, histoBits int) {
 	txSize := VP8LSubSampleSize(width, histoBits)
 	tySize := VP8LSubSampleSize(height, histoBits)
-	histoImage := make([]uint32, txSize*tySize)
+	histoImage := enc.arena.Uint32(txSize * tySize)
 	for i, s := range symbols {
 		if i < len(histoImage) {
 			// Pack histogram index in the green channel.
@@ -943,9 +1056,99 @@ func (enc *Encoder) storeImageData(
 		enc.storeCC = cc
 	}
 
-	x := 0
-	y := 0
-	for _, v := range refs.Refs() {
+	tokens := refs.Refs()
+	if numWorkers := runtime.GOMAXPROCS(0); numWorkers > 1 &&
+		len(tokens) >= minRefsForParallelStore {
+		enc.storeImageDataParallel(bw, tokens, symbols, huffCodes,
+			width, histoBits, numWorkers)
+		return
+	}
+
+	enc.storeImageTokens(bw, tokens, 0, 0, symbols, huffCodes,
+		width, histoBits, cc)
+}
+
+// minRefsForParallelStore gates the strip-parallel bitstream emission:
+// below this many tokens the per-strip writer setup and the bit-level
+// splice cost more than the serial symbol loop.
+const minRefsForParallelStore = 1 << 15
+
+// storeImageDataParallel splits the token stream into contiguous strips,
+// emits each strip into its own LosslessWriter on a worker goroutine, and
+// splices the per-strip bitstreams onto bw in order with bit-level
+// concatenation. The emitted bits depend only on the tokens and their
+// (x, y)-addressed Huffman codes, never on the color cache state: cache
+// maintenance during storage only re-inserts values at the slot they
+// already occupy (entries live at the hash of their value), so strips can
+// be encoded independently with the cache skipped entirely.
+func (enc *Encoder) storeImageDataParallel(
+	bw *bitio.LosslessWriter,
+	tokens []PixOrCopy,
+	symbols []uint16,
+	huffCodes [][HuffmanCodesPerMetaCode]*HuffmanTreeCode,
+	width, histoBits, numWorkers int,
+) {
+	type strip struct {
+		start int // index of the strip's first token
+		x, y  int // pixel position of that token
+		out   *bitio.LosslessWriter
+	}
+
+	// A cheap position scan locates the starting (x, y) of each strip;
+	// token positions are cumulative, so this is the only serial part.
+	strips := make([]strip, numWorkers)
+	estimate := len(tokens)/numWorkers*3 + 1024
+	x, y := 0, 0
+	next := 0
+	for i := range tokens {
+		if i*numWorkers >= next*len(tokens) && next < numWorkers {
+			strips[next] = strip{start: i, x: x, y: y,
+				out: bitio.NewLosslessWriter(estimate)}
+			next++
+		}
+		x += tokens[i].Length()
+		for x >= width {
+			x -= width
+			y++
+		}
+	}
+	strips = strips[:next]
+
+	var wg sync.WaitGroup
+	wg.Add(len(strips))
+	for s := range strips {
+		go func(s int) {
+			defer wg.Done()
+			end := len(tokens)
+			if s+1 < len(strips) {
+				end = strips[s+1].start
+			}
+			enc.storeImageTokens(strips[s].out, tokens[strips[s].start:end],
+				strips[s].x, strips[s].y, symbols, huffCodes,
+				width, histoBits, nil)
+		}(s)
+	}
+	wg.Wait()
+
+	for s := range strips {
+		bw.AppendBitstream(strips[s].out)
+	}
+}
+
+// storeImageTokens emits the Huffman-coded symbols for a contiguous token
+// range starting at pixel position (x, y). cc, when non-nil, is kept in
+// sync with the pixel stream (serial path only; see storeImageDataParallel
+// for why the output does not depend on it).
+func (enc *Encoder) storeImageTokens(
+	bw *bitio.LosslessWriter,
+	tokens []PixOrCopy,
+	x, y int,
+	symbols []uint16,
+	huffCodes [][HuffmanCodesPerMetaCode]*HuffmanTreeCode,
+	width, histoBits int,
+	cc *ColorCache,
+) {
+	for _, v := range tokens {
 		// Determine which histogram to use.
 		histoIdx := 0
 		if len(huffCodes) > 1 && histoBits > 0 {
@@ -5,6 +5,7 @@ import (
 	"runtime"
 	"sort"
 	"sync"
+	"sync/atomic"
 )
 
 // VP8L histogram clustering for lossless encoding.
@@ -1137,19 +1138,25 @@ func histogramCombineStochastic(imageHisto *HistoSet, minClusterSize int) bool {
 		randRange := uint32((len(histograms) - 1) * len(histograms))
 		numTries := len(histograms) / 2
 
-		for j := 0; len(histograms) >= 2 && j < numTries; j++ {
-			tmp := lehmerRand(&seed) % randRange
-			idx1 := int(tmp / uint32(len(histograms)-1))
-			idx2 := int(tmp % uint32(len(histograms)-1))
-			if idx2 >= idx1 {
-				idx2++
-			}
+		if numWorkers := runtime.GOMAXPROCS(0); numWorkers > 1 &&
+			numTries >= minTriesForParallelCombine {
+			seed = stochasticTriesParallel(&q, histograms, &bestCost, seed,
+				randRange, numTries, numWorkers)
+		} else {
+			for j := 0; len(histograms) >= 2 && j < numTries; j++ {
+				tmp := lehmerRand(&seed) % randRange
+				idx1 := int(tmp / uint32(len(histograms)-1))
+				idx2 := int(tmp % uint32(len(histograms)-1))
+				if idx2 >= idx1 {
+					idx2++
+				}
 
-			currCost := q.push(histograms, idx1, idx2, bestCost)
-			if currCost < 0 {
-				bestCost = currCost
-				if q.size() == histoQueueSize {
-					break
+				currCost := q.push(histograms, idx1, idx2, bestCost)
+				if currCost < 0 {
+					bestCost = currCost
+					if q.size() == histoQueueSize {
+						break
+					}
 				}
 			}
 		}
@@ -1240,6 +1247,110 @@ func histogramCombineStochastic(imageHisto *HistoSet, minClusterSize int) bool {
 	return len(histograms) <= minClusterSize
 }
 
+// minTriesForParallelCombine gates the parallel candidate evaluation in the
+// stochastic combine: each candidate costs five entropy scans, so the
+// per-iteration goroutine fan-out only pays off with enough of them.
+const minTriesForParallelCombine = 64
+
+// stochasticTriesBatch bounds how many candidates are evaluated ahead of the
+// serial replay. The serial loop stops as soon as the queue fills, so
+// evaluating all numTries candidates up front could waste work when the
+// queue is already nearly full from a previous iteration.
+const stochasticTriesBatch = 256
+
+// stochasticTriesParallel runs one outer iteration of the stochastic combine
+// with the candidate-pair entropy evaluations fanned out across worker
+// goroutines. The result is bit-exact with the serial loop: the PRNG draws
+// are generated up front (the seed is rewound if the replay breaks early),
+// the full combined cost of each pair is computed without a threshold, and
+// the queue updates — including the evolving bestCost threshold and the
+// early break when the queue fills — are replayed serially. This is sound
+// because the serial path's threshold only short-circuits the entropy
+// accumulation: with non-negative per-stream costs, the evaluation succeeds
+// exactly when the full cost is below the threshold.
+// Returns the PRNG seed after the draws actually consumed.
+func stochasticTriesParallel(q *histoQueue, histograms []*Histogram,
+	bestCost *float64, seed, randRange uint32, numTries, numWorkers int) uint32 {
+
+	type candidate struct {
+		idx1, idx2 int
+		seedAfter  uint32
+		cost       float64
+		costs      [5]float64
+	}
+
+	cands := make([]candidate, numTries)
+	for j := range cands {
+		tmp := lehmerRand(&seed) % randRange
+		idx1 := int(tmp / uint32(len(histograms)-1))
+		idx2 := int(tmp % uint32(len(histograms)-1))
+		if idx2 >= idx1 {
+			idx2++
+		}
+		if idx1 > idx2 {
+			idx1, idx2 = idx2, idx1
+		}
+		cands[j] = candidate{idx1: idx1, idx2: idx2, seedAfter: seed}
+	}
+
+	inf := math.Inf(1)
+	for batchStart := 0; batchStart < numTries; batchStart += stochasticTriesBatch {
+		batchEnd := batchStart + stochasticTriesBatch
+		if batchEnd > numTries {
+			batchEnd = numTries
+		}
+
+		// Evaluate the batch in parallel; histograms are read-only here.
+		var nextCand int32 = int32(batchStart)
+		var wg sync.WaitGroup
+		wg.Add(numWorkers)
+		for w := 0; w < numWorkers; w++ {
+			go func() {
+				defer wg.Done()
+				for {
+					j := int(atomic.AddInt32(&nextCand, 1)) - 1
+					if j >= batchEnd {
+						return
+					}
+					c := &cands[j]
+					c.cost, c.costs, _ = getCombinedHistogramEntropy(
+						histograms[c.idx1], histograms[c.idx2], inf)
+				}
+			}()
+		}
+		wg.Wait()
+
+		// Serial replay of the queue updates, mirroring q.push.
+		for j := batchStart; j < batchEnd; j++ {
+			c := &cands[j]
+			if len(q.queue) >= q.maxSize {
+				continue
+			}
+			sumCost := histograms[c.idx1].bitCost + histograms[c.idx2].bitCost
+			costThreshold := *bestCost + sumCost
+			if costThreshold <= 0 || c.cost >= costThreshold {
+				continue
+			}
+			q.queue = append(q.queue, histogramPair{
+				idx1:      c.idx1,
+				idx2:      c.idx2,
+				costDiff:  c.cost - sumCost,
+				costCombo: c.cost,
+				costs:     c.costs,
+			})
+			q.updateHead(len(q.queue) - 1)
+			currCost := c.cost - sumCost
+			if currCost < 0 {
+				*bestCost = currCost
+				if q.size() == q.maxSize {
+					return c.seedAfter
+				}
+			}
+		}
+	}
+	return seed
+}
+
 // ---------------------------------------------------------------------------
 // Histogram remap (refinement pass)
 // ---------------------------------------------------------------------------
@@ -1630,6 +1741,12 @@ func histogramBuild(xsize, histoBits int, refs *BackwardRefs, imageHisto *HistoS
 	histoXSize := VP8LSubSampleSize(xsize, histoBits)
 	imageHisto.clearAll()
 
+	if numWorkers := runtime.GOMAXPROCS(0); numWorkers > 1 &&
+		len(refs.refs) >= minRefsForParallelBuild {
+		histogramBuildParallel(xsize, histoBits, refs, imageHisto, numWorkers)
+		return
+	}
+
 	x, y := 0, 0
 	for i := range refs.refs {
 		v := &refs.refs[i]
@@ -1642,3 +1759,78 @@ func histogramBuild(xsize, histoBits int, refs *BackwardRefs, imageHisto *HistoS
 		}
 	}
 }
+
+// minRefsForParallelBuild gates the parallel histogram build: below this
+// many tokens the boundary scan and goroutine hand-off cost more than the
+// serial accumulation loop.
+const minRefsForParallelBuild = 1 << 14
+
+// histogramBuildParallel accumulates per-tile histograms on worker
+// goroutines. The token stream itself is serial (each token's position
+// depends on the cumulative lengths before it), but a token contributes
+// only to the tile of its starting position, so after a cheap position
+// scan splits the stream at tile-row boundaries, tokens starting in
+// different tile-rows write disjoint histograms and the chunks can be
+// processed independently. Workers claim chunks dynamically since tile-row
+// token counts are highly uneven (long copies skip whole rows).
+func histogramBuildParallel(xsize, histoBits int, refs *BackwardRefs, imageHisto *HistoSet, numWorkers int) {
+	histoXSize := VP8LSubSampleSize(xsize, histoBits)
+
+	type rowChunk struct {
+		start int // index of the first token starting in this tile-row
+		x, y  int // pixel position of that token
+	}
+
+	// Scan token start positions, recording the first token of each
+	// tile-row. A long copy can span several tile-rows, in which case the
+	// rows without any starting token get no chunk of their own.
+	chunks := []rowChunk{{0, 0, 0}}
+	x, y := 0, 0
+	tileRow := 0
+	for i := range refs.refs {
+		if y>>histoBits != tileRow {
+			tileRow = y >> histoBits
+			chunks = append(chunks, rowChunk{i, x, y})
+		}
+		x += refs.refs[i].Length()
+		for x >= xsize {
+			x -= xsize
+			y++
+		}
+	}
+
+	if numWorkers > len(chunks) {
+		numWorkers = len(chunks)
+	}
+
+	var nextChunk int32
+	var wg sync.WaitGroup
+	wg.Add(numWorkers)
+	for w := 0; w < numWorkers; w++ {
+		go func() {
+			defer wg.Done()
+			for {
+				c := int(atomic.AddInt32(&nextChunk, 1)) - 1
+				if c >= len(chunks) {
+					return
+				}
+				end := len(refs.refs)
+				if c+1 < len(chunks) {
+					end = chunks[c+1].start
+				}
+				x, y := chunks[c].x, chunks[c].y
+				for i := chunks[c].start; i < end; i++ {
+					v := &refs.refs[i]
+					ix := (y>>histoBits)*histoXSize + (x >> histoBits)
+					imageHisto.histos[ix].AddSingle(v, xsize, 0)
+					x += v.Length()
+					for x >= xsize {
+						x -= xsize
+						y++
+					}
+				}
+			}
+		}()
+	}
+	wg.Wait()
+}
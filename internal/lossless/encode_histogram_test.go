@@ -2,6 +2,7 @@ package lossless
 
 import (
 	"math"
+	"runtime"
 	"testing"
 )
 
@@ -494,3 +495,138 @@ func TestGetHistoImageSymbols(t *testing.T) {
 		}
 	}
 }
+
+// TestHistogramCombineStochasticParallelMatchesSerial verifies that the
+// parallel candidate evaluation in the stochastic combine replays the
+// serial loop bit-exactly: same merges, same costs, same PRNG state.
+func TestHistogramCombineStochasticParallelMatchesSerial(t *testing.T) {
+	const n = 200
+	build := func() *HistoSet {
+		hs := allocateHistoSet(n, 0)
+		seed := uint32(11)
+		for i := 0; i < n; i++ {
+			h := hs.histos[i]
+			for k := 0; k < 40; k++ {
+				h.Literal[lehmerRand(&seed)%280] += lehmerRand(&seed) % 50
+				h.Red[lehmerRand(&seed)%256] += lehmerRand(&seed) % 30
+				h.Blue[lehmerRand(&seed)%256] += lehmerRand(&seed) % 30
+			}
+			h.Alpha[0] = 640
+			h.computeHistogramCost()
+		}
+		return hs
+	}
+
+	serial := build()
+	prev := runtime.GOMAXPROCS(1)
+	serialGreedy := histogramCombineStochastic(serial, 16)
+	runtime.GOMAXPROCS(4)
+	parallel := build()
+	parallelGreedy := histogramCombineStochastic(parallel, 16)
+	runtime.GOMAXPROCS(prev)
+
+	if serialGreedy != parallelGreedy {
+		t.Fatalf("doGreedy: parallel %v, serial %v", parallelGreedy, serialGreedy)
+	}
+	if parallel.Size() != serial.Size() {
+		t.Fatalf("cluster count: parallel %d, serial %d", parallel.Size(), serial.Size())
+	}
+	for i := 0; i < serial.Size(); i++ {
+		a, b := serial.histos[i], parallel.histos[i]
+		if a.bitCost != b.bitCost {
+			t.Fatalf("cluster %d bitCost: parallel %v, serial %v", i, b.bitCost, a.bitCost)
+		}
+		for k := range a.Literal {
+			if a.Literal[k] != b.Literal[k] {
+				t.Fatalf("cluster %d literal[%d]: parallel %d, serial %d",
+					i, k, b.Literal[k], a.Literal[k])
+			}
+		}
+	}
+}
+
+// TestLosslessEncodeDecodeParallelRoundTrip checks that a high-quality
+// encode taken with the parallel histogram paths engaged still decodes to
+// the exact source pixels. (Whole-bitstream parity across GOMAXPROCS is
+// not guaranteed: other encoder stages already make GOMAXPROCS-dependent
+// tie-breaks.)
+func TestLosslessEncodeDecodeParallelRoundTrip(t *testing.T) {
+	const w, h = 512, 512
+	argb := gradientARGB(w, h)
+	cfg := &EncoderConfig{Quality: 95, Method: 5, NearLosslessQuality: 100}
+
+	prev := runtime.GOMAXPROCS(4)
+	data, err := Encode(argb, w, h, cfg)
+	runtime.GOMAXPROCS(prev)
+	if err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	dec := acquireDecoder()
+	defer releaseDecoder(dec)
+	out, err := dec.decodePixels(data)
+	if err != nil {
+		t.Fatalf("decodePixels: %v", err)
+	}
+	for i := 0; i < w*h; i++ {
+		if out[i] != argb[i] {
+			t.Fatalf("round-trip mismatch at pixel %d with parallel histogram paths", i)
+		}
+	}
+}
+
+// TestHistogramBuildParallelMatchesSerial compares the parallel per-tile
+// histogram accumulation directly against the serial loop on a token
+// stream with literals, copies spanning rows, and cache hits.
+func TestHistogramBuildParallelMatchesSerial(t *testing.T) {
+	const xsize, histoBits = 300, 4
+	refs := NewBackwardRefs(0)
+	seed := uint32(7)
+	total := 0
+	for total < 3*minRefsForParallelBuild {
+		r := lehmerRand(&seed)
+		switch r % 3 {
+		case 0:
+			refs.Add(LiteralPixel(0xff000000 | r))
+			total++
+		case 1:
+			length := int(r%600) + 1
+			refs.Add(CopyPixel(length, int(r%1024)+1))
+			total += length
+		default:
+			refs.Add(CachePixel(int(r % 16)))
+			total++
+		}
+	}
+
+	histoXSize := VP8LSubSampleSize(xsize, histoBits)
+	ysize := total/xsize + 2
+	histoYSize := VP8LSubSampleSize(ysize, histoBits)
+	n := histoXSize * histoYSize
+
+	want := allocateHistoSet(n, 0)
+	histogramBuild(xsize, histoBits, refs, want)
+
+	got := allocateHistoSet(n, 0)
+	got.clearAll()
+	histogramBuildParallel(xsize, histoBits, refs, got, 4)
+
+	for i := 0; i < n; i++ {
+		a, b := want.histos[i], got.histos[i]
+		for k := range a.Literal {
+			if a.Literal[k] != b.Literal[k] {
+				t.Fatalf("tile %d literal[%d]: got %d, want %d", i, k, b.Literal[k], a.Literal[k])
+			}
+		}
+		for k := 0; k < 256; k++ {
+			if a.Red[k] != b.Red[k] || a.Blue[k] != b.Blue[k] || a.Alpha[k] != b.Alpha[k] {
+				t.Fatalf("tile %d argb histograms differ at %d", i, k)
+			}
+		}
+		for k := range a.Distance {
+			if a.Distance[k] != b.Distance[k] {
+				t.Fatalf("tile %d distance[%d]: got %d, want %d", i, k, b.Distance[k], a.Distance[k])
+			}
+		}
+	}
+}
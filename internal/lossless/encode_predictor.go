@@ -830,11 +830,12 @@ func ColorIndexBuild(argb []uint32, width, height int) (palette []uint32, palett
 //   - palette <= 16 colors: 4-bit indices, 2 pixels per uint32
 //   - otherwise:            8-bit indices, 1 pixel per uint32
 func ApplyPaletteTransform(argb []uint32, width, height int, palette []uint32) (packed []uint32, packedWidth int) {
-	// Build inverse lookup: color -> index.
-	invLookup := make(map[uint32]uint32, len(palette))
-	for i, c := range palette {
-		invLookup[c] = uint32(i)
-	}
+	// Inverse lookup: a collision-free hash built once per image, with a
+	// one-entry cache in front of it since palettized images are dominated
+	// by runs of identical pixels.
+	lut := buildPaletteLookup(palette)
+	prevPix := ^argb[0]
+	var prevIdx uint32
 
 	paletteSize := len(palette)
 
@@ -863,14 +864,21 @@ func ApplyPaletteTransform(argb []uint32, width, height int, palette []uint32) (
 		if pixelsPerWord == 1 {
 			// No packing: encode each index in the green channel.
 			for x := 0; x < width; x++ {
-				idx := invLookup[argb[srcRow+x]]
-				packed[dstRow+x] = ARGBBlack | (idx << 8)
+				if pix := argb[srcRow+x]; pix != prevPix {
+					prevIdx = lut.index(pix)
+					prevPix = pix
+				}
+				packed[dstRow+x] = ARGBBlack | (prevIdx << 8)
 			}
 		} else {
 			// Pack multiple indices into each uint32.
 			bitMask := uint32((1 << bitsPerPixel) - 1)
 			for x := 0; x < width; x++ {
-				idx := invLookup[argb[srcRow+x]] & bitMask
+				if pix := argb[srcRow+x]; pix != prevPix {
+					prevIdx = lut.index(pix)
+					prevPix = pix
+				}
+				idx := prevIdx & bitMask
 				wordPos := x / pixelsPerWord
 				bitPos := uint((x % pixelsPerWord) * bitsPerPixel)
 				if bitPos == 0 {
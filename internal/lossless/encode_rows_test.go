@@ -0,0 +1,72 @@
+package lossless
+
+import (
+	"bytes"
+	"testing"
+)
+
+// TestEncodeRowsMatchesEncode verifies that the row-streaming import path
+// produces a bitstream identical to Encode on the same pixels.
+func TestEncodeRowsMatchesEncode(t *testing.T) {
+	const w, h = 160, 113 // not a multiple of the strip height
+	argb := gradientARGB(w, h)
+
+	want, err := Encode(argb, w, h, DefaultEncoderConfig())
+	if err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	var calls int
+	got, err := EncodeRows(w, h, DefaultEncoderConfig(),
+		func(y0, y1 int, dst []uint32) {
+			calls++
+			copy(dst, argb[y0*w:y1*w])
+		})
+	if err != nil {
+		t.Fatalf("EncodeRows: %v", err)
+	}
+
+	if calls < 2 {
+		t.Fatalf("fillRows called %d times, want strip-by-strip delivery", calls)
+	}
+	if !bytes.Equal(got, want) {
+		t.Fatalf("EncodeRows output differs from Encode: %d vs %d bytes",
+			len(got), len(want))
+	}
+}
+
+// TestEncodeRowsToWriterMatchesEncode checks the writer variant emits the
+// same bitstream with the size reported up front.
+func TestEncodeRowsToWriterMatchesEncode(t *testing.T) {
+	const w, h = 96, 64
+	argb := paletteARGB(w, h)
+
+	want, err := Encode(argb, w, h, DefaultEncoderConfig())
+	if err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	var buf bytes.Buffer
+	reported := -1
+	err = EncodeRowsToWriter(w, h, DefaultEncoderConfig(),
+		func(y0, y1 int, dst []uint32) {
+			copy(dst, argb[y0*w:y1*w])
+		}, &buf, func(bitstreamSize int) error {
+			reported = bitstreamSize
+			return nil
+		})
+	if err != nil {
+		t.Fatalf("EncodeRowsToWriter: %v", err)
+	}
+
+	if reported != len(want) {
+		t.Fatalf("reported bitstream size %d, want %d", reported, len(want))
+	}
+	got := buf.Bytes()
+	if len(got)&1 != 0 {
+		t.Fatalf("output not RIFF-padded: %d bytes", len(got))
+	}
+	if !bytes.Equal(got[:len(want)], want) {
+		t.Fatal("EncodeRowsToWriter bitstream differs from Encode")
+	}
+}
@@ -0,0 +1,46 @@
+package lossless
+
+import (
+	"runtime"
+	"testing"
+)
+
+// noisyARGB builds a poorly compressible image so the token stream is
+// dominated by literals and comfortably exceeds the parallel-store
+// threshold.
+func noisyARGB(width, height int) []uint32 {
+	argb := make([]uint32, width*height)
+	seed := uint32(3)
+	for i := range argb {
+		argb[i] = 0xff000000 | lehmerRand(&seed)&0x00ffffff
+	}
+	return argb
+}
+
+// TestStoreImageDataParallelRoundTrip pushes a literal-heavy image through
+// the strip-parallel bitstream emission (forced via GOMAXPROCS) and checks
+// exact reconstruction.
+func TestStoreImageDataParallelRoundTrip(t *testing.T) {
+	const w, h = 256, 256 // 64k literal tokens > minRefsForParallelStore
+	argb := noisyARGB(w, h)
+
+	prev := runtime.GOMAXPROCS(4)
+	data, err := Encode(argb, w, h, DefaultEncoderConfig())
+	runtime.GOMAXPROCS(prev)
+	if err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	dec := acquireDecoder()
+	defer releaseDecoder(dec)
+	out, err := dec.decodePixels(data)
+	if err != nil {
+		t.Fatalf("decodePixels: %v", err)
+	}
+	for i := 0; i < w*h; i++ {
+		if out[i] != argb[i] {
+			t.Fatalf("round-trip mismatch at pixel %d: got %08x, want %08x",
+				i, out[i], argb[i])
+		}
+	}
+}
@@ -83,16 +83,36 @@ type HashChain struct {
 	// Format: offset = value >> maxLengthBits, length = value & maxLength.
 	OffsetLength     []uint32
 	size             int
+	extraShift       uint     // 18-bit hash is narrowed by this for small tables
 	hashToFirstIndex []int32  // reusable between Fill() calls
-	chainBuf         []uint32 // separate chain buffer for parallel second pass
+	chainBuf         []uint32 // chain buffer for parallel or windowed second pass
+}
+
+// minHashBits is the smallest hash table used for tiny images; below this
+// the table no longer dominates the chain's footprint.
+const minHashBits = 12
+
+// hashBitsForSize returns the hash table bits for an image of the given
+// pixel count: the full 18-bit table for large images, shrinking to keep
+// roughly four buckets per position on small ones. Tiny sprites then pay
+// kilobytes instead of the fixed 1 MB table, and the per-Fill table clear
+// shrinks with it.
+func hashBitsForSize(size int) int {
+	bits := hashBits
+	for bits > minHashBits && 1<<(bits-1) >= 4*size {
+		bits--
+	}
+	return bits
 }
 
 // NewHashChain creates a hash chain for an image of the given pixel count.
 func NewHashChain(size int) *HashChain {
+	bits := hashBitsForSize(size)
 	return &HashChain{
 		OffsetLength:     make([]uint32, size),
 		size:             size,
-		hashToFirstIndex: make([]int32, hashSize),
+		extraShift:       uint(hashBits - bits),
+		hashToFirstIndex: make([]int32, 1<<bits),
 	}
 }
 
@@ -155,6 +175,15 @@ func (hc *HashChain) Fill(argb []uint32, quality int, xsize, ysize int, lowEffor
 	iterMax := getMaxItersForQuality(quality) // 9.4
 	winSize := uint32(GetWindowSizeForHashChain(quality, xsize))
 
+	// Huge images: bound chain state by the search window instead of the
+	// pixel count. The whole-image modes below keep chain links for every
+	// position (and the parallel mode copies them), which for very large
+	// inputs costs far more than the window can ever use.
+	if size >= windowedFillMinPixels && size > 2*int(winSize) {
+		hc.fillWindowed(argb, xsize, size, iterMax, winSize, lowEffort)
+		return
+	}
+
 	// Reuse hashToFirstIndex from the HashChain struct.
 	hashToFirstIndex := hc.hashToFirstIndex
 	for i := range hashToFirstIndex {
@@ -186,7 +215,7 @@ func (hc *HashChain) Fill(argb []uint32, quality int, xsize, ysize int, lowEffor
 				length = maxLength
 			}
 			for length > 0 {
-				hashCode := getPixPairHash64Values(tmp0, length)
+				hashCode := getPixPairHash64Values(tmp0, length) >> hc.extraShift
 				chainSlice[pos] = uint32(hashToFirstIndex[hashCode])
 				hashToFirstIndex[hashCode] = int32(pos)
 				pos++
@@ -195,7 +224,7 @@ func (hc *HashChain) Fill(argb []uint32, quality int, xsize, ysize int, lowEffor
 			argbComp = false
 		} else {
 			// Normal: hash two consecutive pixels.
-			hashCode := getPixPairHash64(argb[pos:])
+			hashCode := getPixPairHash64(argb[pos:]) >> hc.extraShift
 			chainSlice[pos] = uint32(hashToFirstIndex[hashCode])
 			hashToFirstIndex[hashCode] = int32(pos)
 			pos++
@@ -204,7 +233,7 @@ func (hc *HashChain) Fill(argb []uint32, quality int, xsize, ysize int, lowEffor
 	}
 	// Process the penultimate pixel.
 	if size >= 3 {
-		chainSlice[size-2] = uint32(hashToFirstIndex[getPixPairHash64(argb[size-2:])])
+		chainSlice[size-2] = uint32(hashToFirstIndex[getPixPairHash64(argb[size-2:])>>hc.extraShift])
 	}
 
 	// Decide between parallel and serial second pass.
@@ -455,6 +484,205 @@ func fillMatchRange(offsetLength, chain []uint32, argb []uint32, xsize, size, it
 	}
 }
 
+// windowedFillMinPixels is the pixel count above which Fill switches to
+// the sliding-window mode. Below it the whole-image modes are faster and
+// their chain state is affordable.
+const windowedFillMinPixels = 1 << 23
+
+// fillWindowed is the sliding-window second pass for very large images.
+// The image is processed right-to-left in window-sized chunks; chain
+// links are rebuilt per chunk for the chunk plus one preceding window, so
+// chain storage is bounded by twice the search window instead of the
+// pixel count. Matches cannot reach further back than the window anyway,
+// so the only quality difference from fillSerial is that left-extension
+// stops at chunk boundaries.
+func (hc *HashChain) fillWindowed(argb []uint32, xsize, size, iterMax int, winSize uint32, lowEffort bool) {
+	win := int(winSize)
+	if win < 1 {
+		win = 1
+	}
+	linksCap := 2 * win
+	if linksCap > size {
+		linksCap = size
+	}
+	if cap(hc.chainBuf) >= linksCap {
+		hc.chainBuf = hc.chainBuf[:linksCap]
+	} else {
+		hc.chainBuf = make([]uint32, linksCap)
+	}
+
+	hc.OffsetLength[0] = 0
+	hc.OffsetLength[size-1] = 0
+
+	for c1 := size; c1 > 1; {
+		c0 := c1 - win
+		if c0 < 1 {
+			c0 = 1
+		}
+		lo := c0 - win
+		if lo < 0 {
+			lo = 0
+		}
+		hc.buildWindowLinks(argb, lo, c1, size)
+		hc.matchChunk(argb, xsize, size, iterMax, winSize, lo, c0, c1, lowEffort)
+		c1 = c0
+	}
+}
+
+// buildWindowLinks builds chain links for positions [lo, hi) into
+// hc.chainBuf (indexed by pos-lo), using the same repeated-pixel hashing
+// as the whole-image first pass. Links hold absolute positions and never
+// point below lo.
+func (hc *HashChain) buildWindowLinks(argb []uint32, lo, hi, size int) {
+	hashToFirstIndex := hc.hashToFirstIndex
+	for i := range hashToFirstIndex {
+		hashToFirstIndex[i] = -1
+	}
+	links := hc.chainBuf
+
+	hiLink := hi
+	if hiLink > size-2 {
+		hiLink = size - 2
+	}
+
+	argbComp := argb[lo] == argb[lo+1]
+	for pos := lo; pos < hiLink; {
+		argbCompNext := argb[pos+1] == argb[pos+2]
+		if argbComp && argbCompNext {
+			// 9.1: runs of one color hash as (pixel, remaining length).
+			tmp0 := argb[pos]
+			length := uint32(1)
+			for pos+int(length)+2 < size && argb[pos+int(length)+2] == argb[pos] {
+				length++
+			}
+			if length > maxLength {
+				skip := int(length - maxLength)
+				for k := 0; k < skip && pos+k < hiLink; k++ {
+					links[pos+k-lo] = uint32(0xFFFFFFFF)
+				}
+				pos += skip
+				length = maxLength
+			}
+			for length > 0 && pos < hiLink {
+				hashCode := getPixPairHash64Values(tmp0, length) >> hc.extraShift
+				links[pos-lo] = uint32(hashToFirstIndex[hashCode])
+				hashToFirstIndex[hashCode] = int32(pos)
+				pos++
+				length--
+			}
+			argbComp = false
+		} else {
+			hashCode := getPixPairHash64(argb[pos:]) >> hc.extraShift
+			links[pos-lo] = uint32(hashToFirstIndex[hashCode])
+			hashToFirstIndex[hashCode] = int32(pos)
+			pos++
+			argbComp = argbCompNext
+		}
+	}
+	// Penultimate pixel of the image, when it falls in this range.
+	if hi >= size-1 && size-2 >= lo {
+		links[size-2-lo] = uint32(hashToFirstIndex[getPixPairHash64(argb[size-2:])>>hc.extraShift])
+	}
+}
+
+// matchChunk runs the fillSerial match-and-extend loop for base positions
+// [c0, c1), reading chain links from hc.chainBuf relative to lo.
+func (hc *HashChain) matchChunk(argb []uint32, xsize, size, iterMax int, winSize uint32, lo, c0, c1 int, lowEffort bool) {
+	chain := hc.chainBuf
+	hiPos := c1 - 1
+	if hiPos > size-2 {
+		hiPos = size - 2
+	}
+	loPos := uint32(c0)
+
+	for basePosition := uint32(hiPos); basePosition >= loPos; {
+		maxLen := maxFindCopyLength(int(uint32(size) - 1 - basePosition))
+		argbStart := argb[basePosition:]
+		iter := iterMax
+		bestLength := 0
+		bestDistance := uint32(0)
+		minPos := int32(0)
+		if basePosition > winSize {
+			minPos = int32(basePosition - winSize)
+		}
+		lengthMax := maxLen
+		if lengthMax > 256 {
+			lengthMax = 256
+		}
+
+		pos := int32(chain[int(basePosition)-lo])
+
+		// 9.5: Spatial heuristics - check pixel above and to the left.
+		if !lowEffort {
+			if basePosition >= uint32(xsize) {
+				currLength := findMatchLength(argb[basePosition-uint32(xsize):], argbStart, bestLength, maxLen)
+				if currLength > bestLength {
+					bestLength = currLength
+					bestDistance = uint32(xsize)
+				}
+				iter--
+			}
+			currLength := findMatchLength(argb[basePosition-1:], argbStart, bestLength, maxLen)
+			if currLength > bestLength {
+				bestLength = currLength
+				bestDistance = 1
+			}
+			iter--
+			if bestLength == maxLength {
+				pos = minPos - 1
+			}
+		}
+
+		bestArgb := argbStart[bestLength]
+
+		for ; pos >= minPos && iter > 0; pos = int32(chain[int(pos)-lo]) {
+			iter--
+
+			if argb[pos+int32(bestLength)] != bestArgb {
+				continue
+			}
+
+			currLength := findMatchLength(argb[pos:], argbStart, 0, maxLen)
+			if bestLength < currLength {
+				bestLength = currLength
+				bestDistance = basePosition - uint32(pos)
+				bestArgb = argbStart[bestLength]
+				if bestLength >= lengthMax {
+					break
+				}
+			}
+		}
+
+		// 9.3: Left-extension, stopping at the chunk boundary.
+		maxBasePosition := basePosition
+		for {
+			if bestLength > maxLength {
+				bestLength = maxLength
+			}
+			hc.OffsetLength[basePosition] = (bestDistance << maxLengthBits) | uint32(bestLength)
+			basePosition--
+			if bestDistance == 0 || basePosition < loPos {
+				break
+			}
+			if basePosition < bestDistance ||
+				argb[basePosition-bestDistance] != argb[basePosition] {
+				break
+			}
+			if bestLength == maxLength && bestDistance != 1 &&
+				basePosition+uint32(maxLength) < maxBasePosition {
+				break
+			}
+			if bestLength < maxLength {
+				bestLength++
+				maxBasePosition = basePosition
+			}
+		}
+		if basePosition < loPos {
+			break
+		}
+	}
+}
+
 // DistanceToPlaneCode converts a pixel distance to a VP8L plane distance code.
 // xsize is the image width. The plane code optimizes for horizontal/vertical
 // distances commonly found in images.
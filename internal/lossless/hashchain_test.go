@@ -0,0 +1,92 @@
+package lossless
+
+import "testing"
+
+// checkMatchesValid verifies every (offset, length) pair in the chain
+// points at genuinely identical pixels.
+func checkMatchesValid(t *testing.T, hc *HashChain, argb []uint32, size int) int {
+	t.Helper()
+	found := 0
+	for pos := 0; pos < size; pos++ {
+		length := hc.GetLength(pos)
+		if length == 0 {
+			continue
+		}
+		offset := hc.GetOffset(pos)
+		if offset <= 0 || offset > pos {
+			t.Fatalf("pos %d: invalid offset %d (length %d)", pos, offset, length)
+		}
+		if pos+length > size {
+			t.Fatalf("pos %d: length %d runs past image end", pos, length)
+		}
+		for k := 0; k < length; k++ {
+			if argb[pos-offset+k] != argb[pos+k] {
+				t.Fatalf("pos %d: match (offset %d, length %d) differs at %d", pos, offset, length, k)
+			}
+		}
+		found++
+	}
+	return found
+}
+
+// tiledARGB produces a repetitive image with plenty of LZ77 matches.
+func tiledARGB(width, height int) []uint32 {
+	argb := make([]uint32, width*height)
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			argb[y*width+x] = 0xff000000 | uint32((x%13)*17)<<16 | uint32((y%7)*31)<<8 | uint32((x+y)%5)
+		}
+	}
+	return argb
+}
+
+func TestHashBitsForSize(t *testing.T) {
+	cases := []struct {
+		size, wantBits int
+	}{
+		{16, minHashBits},
+		{64 * 64, 14},
+		{256 * 256, 18},
+		{1 << 24, 18},
+	}
+	for _, tc := range cases {
+		if got := hashBitsForSize(tc.size); got != tc.wantBits {
+			t.Errorf("hashBitsForSize(%d) = %d, want %d", tc.size, got, tc.wantBits)
+		}
+	}
+}
+
+func TestHashChainSmallImage(t *testing.T) {
+	const w, h = 64, 64
+	argb := tiledARGB(w, h)
+	hc := NewHashChain(w * h)
+	if len(hc.hashToFirstIndex) >= hashSize {
+		t.Fatalf("small image got full %d-entry hash table", len(hc.hashToFirstIndex))
+	}
+	hc.Fill(argb, 75, w, h, false)
+	if found := checkMatchesValid(t, hc, argb, w*h); found == 0 {
+		t.Error("no matches found in repetitive image")
+	}
+}
+
+func TestHashChainWindowedMode(t *testing.T) {
+	const w, h = 200, 300
+	const winSize = 1024
+	argb := tiledARGB(w, h)
+	size := w * h
+
+	hc := NewHashChain(size)
+	hc.fillWindowed(argb, w, size, getMaxItersForQuality(75), winSize, false)
+
+	if found := checkMatchesValid(t, hc, argb, size); found == 0 {
+		t.Error("no matches found in repetitive image")
+	}
+	if got := len(hc.chainBuf); got > 2*winSize {
+		t.Errorf("chain buffer holds %d entries, want at most %d", got, 2*winSize)
+	}
+	for pos := 0; pos < size; pos++ {
+		if off := hc.GetOffset(pos); off > winSize {
+			t.Fatalf("pos %d: offset %d exceeds window %d", pos, off, winSize)
+		}
+	}
+}
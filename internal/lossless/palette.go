@@ -0,0 +1,342 @@
+package lossless
+
+// Palette mapping and ordering for the color-indexing transform.
+//
+// Mapping: pixels are translated to palette indices through a small hash
+// table built once per image. Three hash functions are tried in order and
+// the first one that is collision-free over the palette gives O(1)
+// lookups with no per-pixel verification; if all three collide the lookup
+// falls back to binary search over the palette sorted by color value.
+//
+// Ordering: palette entries are delta-coded in the bitstream and the
+// indexed image is entropy-coded, so entry order matters. Two heuristics
+// are provided: a greedy nearest-color chain that minimizes component
+// deltas between consecutive entries, and the modified Zeng method which
+// orders entries by how often their colors neighbor each other in the
+// image ("A Survey on Palette Reordering Methods for Improving the
+// Compression of Color-Indexed Images", Pinho and Neves).
+//
+// Reference: libwebp/src/utils/palette.c, libwebp/src/enc/vp8l_enc.c
+
+import "sort"
+
+const (
+	// paletteInvSizeBits is the log2 size of the inverse-lookup hash table.
+	paletteInvSizeBits = 11
+	paletteInvSize     = 1 << paletteInvSizeBits
+)
+
+// Hash functions tried when building the inverse lookup, cheapest first.
+// The multiplicative hashes ignore alpha, so palettes whose entries differ
+// only in alpha fall through to the binary-search path.
+
+// hashGreenOnly indexes by the green byte alone: exact for grayscale-like
+// palettes where every entry has a distinct green value.
+func hashGreenOnly(c uint32) uint32 {
+	return (c >> 8) & 0xff
+}
+
+func hashMult1(c uint32) uint32 {
+	return ((c & 0x00ffffff) * 4222244071) >> (32 - paletteInvSizeBits)
+}
+
+func hashMult2(c uint32) uint32 {
+	return ((c & 0x00ffffff) * 0x7fffffff) >> (32 - paletteInvSizeBits)
+}
+
+// paletteLookup maps an ARGB color known to be in the palette to its
+// palette index. Build once per image with buildPaletteLookup.
+type paletteLookup struct {
+	hashIndex int     // 0..2 selects a hash function, 3 = binary search
+	table     []uint8 // hash slot -> palette index
+	sorted    []uint32
+	sortedIdx []uint8 // position in sorted -> index in the original palette
+}
+
+// buildPaletteLookup constructs the inverse color -> index mapping for
+// palette. Colors not present in the palette map to an arbitrary index.
+func buildPaletteLookup(palette []uint32) *paletteLookup {
+	hashFns := [3]func(uint32) uint32{hashGreenOnly, hashMult1, hashMult2}
+	lut := &paletteLookup{}
+	for fn := 0; fn < len(hashFns); fn++ {
+		var seen [paletteInvSize]bool
+		collision := false
+		for _, c := range palette {
+			h := hashFns[fn](c)
+			if seen[h] {
+				collision = true
+				break
+			}
+			seen[h] = true
+		}
+		if !collision {
+			lut.hashIndex = fn
+			lut.table = make([]uint8, paletteInvSize)
+			for i, c := range palette {
+				lut.table[hashFns[fn](c)] = uint8(i)
+			}
+			return lut
+		}
+	}
+
+	// No collision-free hash: binary search over the value-sorted palette.
+	lut.hashIndex = len(hashFns)
+	lut.sorted = append([]uint32(nil), palette...)
+	sort.Slice(lut.sorted, func(i, j int) bool {
+		return lut.sorted[i] < lut.sorted[j]
+	})
+	lut.sortedIdx = make([]uint8, len(palette))
+	for i, c := range palette {
+		lut.sortedIdx[searchColor(lut.sorted, c)] = uint8(i)
+	}
+	return lut
+}
+
+// index returns the palette index of c.
+func (lut *paletteLookup) index(c uint32) uint32 {
+	switch lut.hashIndex {
+	case 0:
+		return uint32(lut.table[hashGreenOnly(c)])
+	case 1:
+		return uint32(lut.table[hashMult1(c)])
+	case 2:
+		return uint32(lut.table[hashMult2(c)])
+	default:
+		return uint32(lut.sortedIdx[searchColor(lut.sorted, c)])
+	}
+}
+
+// searchColor returns the position of c in the sorted color slice, or the
+// insertion point if c is absent.
+func searchColor(sorted []uint32, c uint32) int {
+	lo, hi := 0, len(sorted)
+	for lo < hi {
+		mid := int(uint(lo+hi) >> 1)
+		if sorted[mid] < c {
+			lo = mid + 1
+		} else {
+			hi = mid
+		}
+	}
+	return lo
+}
+
+// ---------------------------------------------------------------------------
+// Palette ordering
+// ---------------------------------------------------------------------------
+
+// sortPalette orders palette in place for the color-indexing transform.
+// The input must be sorted by color value (as produced by ColorIndexBuild);
+// that order is kept when its deltas are already monotonous, since delta
+// coding then needs no sign changes. Otherwise higher methods run the
+// modified Zeng reordering, which scans the image once to measure color
+// adjacency, and lower methods use the cheaper minimize-deltas chain.
+func sortPalette(argb []uint32, width, height int, palette []uint32, method int) {
+	if len(palette) <= 2 || !paletteHasNonMonotonousDeltas(palette) {
+		return
+	}
+	if method >= 4 {
+		paletteSortModifiedZeng(argb, width, height, palette)
+		return
+	}
+	paletteSortMinimizeDeltas(palette)
+}
+
+// paletteHasNonMonotonousDeltas reports whether successive palette deltas
+// change sign in any RGB channel. A monotonous palette is already in its
+// cheapest order for delta coding. Matches the C reference
+// PaletteHasNonMonotonousDeltas.
+func paletteHasNonMonotonousDeltas(palette []uint32) bool {
+	predict := uint32(0)
+	signFound := uint32(0)
+	for _, c := range palette {
+		diff := subPixels(c, predict)
+		rd := (diff >> 16) & 0xff
+		gd := (diff >> 8) & 0xff
+		bd := diff & 0xff
+		if rd != 0 {
+			if rd < 0x80 {
+				signFound |= 1
+			} else {
+				signFound |= 2
+			}
+		}
+		if gd != 0 {
+			if gd < 0x80 {
+				signFound |= 8
+			} else {
+				signFound |= 16
+			}
+		}
+		if bd != 0 {
+			if bd < 0x80 {
+				signFound |= 64
+			} else {
+				signFound |= 128
+			}
+		}
+		predict = c
+	}
+	return signFound&(signFound<<1) != 0 // both signs seen in one channel
+}
+
+// paletteComponentDistance returns the modular distance of one delta
+// component: small values and values close to 256 both code cheaply.
+func paletteComponentDistance(v uint32) uint32 {
+	if v <= 128 {
+		return v
+	}
+	return 256 - v
+}
+
+// paletteColorDistance scores the coding cost of the delta between two
+// palette entries, weighting RGB above alpha. Matches the C reference
+// PaletteColorDistance.
+func paletteColorDistance(col1, col2 uint32) uint32 {
+	const moreWeightForRGBThanForAlpha = 9
+	diff := subPixels(col1, col2)
+	score := paletteComponentDistance(diff & 0xff)
+	score += paletteComponentDistance((diff >> 8) & 0xff)
+	score += paletteComponentDistance((diff >> 16) & 0xff)
+	score *= moreWeightForRGBThanForAlpha
+	score += paletteComponentDistance((diff >> 24) & 0xff)
+	return score
+}
+
+// paletteSortMinimizeDeltas greedily chains palette entries so each entry
+// is the remaining color closest to its predecessor, minimizing the
+// delta-coded palette cost. Matches the C reference
+// PaletteSortMinimizeDeltas.
+func paletteSortMinimizeDeltas(palette []uint32) {
+	predict := uint32(0)
+	for i := range palette {
+		bestIx := i
+		bestScore := ^uint32(0)
+		for k := i; k < len(palette); k++ {
+			if score := paletteColorDistance(palette[k], predict); score < bestScore {
+				bestScore = score
+				bestIx = k
+			}
+		}
+		palette[i], palette[bestIx] = palette[bestIx], palette[i]
+		predict = palette[i]
+	}
+}
+
+// buildCooccurrence counts, for every pair of palette indices, how often
+// their colors are horizontal or vertical neighbors in the image. The
+// returned matrix is symmetric.
+func buildCooccurrence(argb []uint32, width, height int, palette []uint32) []uint32 {
+	n := len(palette)
+	co := make([]uint32, n*n)
+	lut := buildPaletteLookup(palette)
+
+	lineTop := make([]uint8, width)
+	lineCur := make([]uint8, width)
+	prevPix := ^argb[0]
+	var prevIdx uint8
+	for y := 0; y < height; y++ {
+		lineTop, lineCur = lineCur, lineTop
+		row := argb[y*width : (y+1)*width]
+		for x, pix := range row {
+			if pix != prevPix {
+				prevIdx = uint8(lut.index(pix))
+				prevPix = pix
+			}
+			lineCur[x] = prevIdx
+			if x > 0 {
+				co[int(prevIdx)*n+int(lineCur[x-1])]++
+			}
+			if y > 0 {
+				co[int(prevIdx)*n+int(lineTop[x])]++
+			}
+		}
+	}
+	for i := 0; i < n; i++ {
+		for j := i + 1; j < n; j++ {
+			sum := co[i*n+j] + co[j*n+i]
+			co[i*n+j] = sum
+			co[j*n+i] = sum
+		}
+	}
+	return co
+}
+
+// paletteSortModifiedZeng reorders palette in place so that colors which
+// frequently neighbor each other in the image get nearby indices. It grows
+// a chain from the most co-occurring pair, repeatedly adding the unused
+// color with the highest total co-occurrence against the chain, placed at
+// whichever end it has the stronger affinity for.
+func paletteSortModifiedZeng(argb []uint32, width, height int, palette []uint32) {
+	n := len(palette)
+	co := buildCooccurrence(argb, width, height, palette)
+
+	// Seed the chain with the pair that occurs together most often.
+	bestI, bestJ := 0, 1
+	bestCo := uint32(0)
+	for i := 0; i < n; i++ {
+		for j := i + 1; j < n; j++ {
+			if co[i*n+j] > bestCo {
+				bestCo = co[i*n+j]
+				bestI, bestJ = i, j
+			}
+		}
+	}
+	chain := make([]uint8, 2, n)
+	chain[0] = uint8(bestI)
+	chain[1] = uint8(bestJ)
+
+	// Remaining candidates with their running co-occurrence sum against
+	// the chain; the sum is updated incrementally as the chain grows.
+	type candidate struct {
+		index uint8
+		sum   uint32
+	}
+	cands := make([]candidate, 0, n-2)
+	for i := 0; i < n; i++ {
+		if i == bestI || i == bestJ {
+			continue
+		}
+		cands = append(cands, candidate{
+			index: uint8(i),
+			sum:   co[i*n+bestI] + co[i*n+bestJ],
+		})
+	}
+
+	for len(cands) > 0 {
+		best := 0
+		for i := 1; i < len(cands); i++ {
+			if cands[i].sum > cands[best].sum {
+				best = i
+			}
+		}
+		next := cands[best].index
+		cands[best] = cands[len(cands)-1]
+		cands = cands[:len(cands)-1]
+
+		// Positive position-weighted affinity means the new color clusters
+		// with the head of the chain; prepend there, otherwise append.
+		delta := int64(0)
+		m := len(chain)
+		for pos, l := range chain {
+			delta += int64(m-1-2*pos) * int64(co[int(next)*n+int(l)])
+		}
+		if delta > 0 {
+			chain = append(chain, 0)
+			copy(chain[1:], chain)
+			chain[0] = next
+		} else {
+			chain = append(chain, next)
+		}
+
+		for i := range cands {
+			cands[i].sum += co[int(next)*n+int(cands[i].index)]
+		}
+	}
+
+	reordered := make([]uint32, n)
+	for pos, idx := range chain {
+		reordered[pos] = palette[idx]
+	}
+	copy(palette, reordered)
+}
@@ -0,0 +1,113 @@
+package lossless
+
+import (
+	"math/rand"
+	"testing"
+)
+
+func TestPaletteLookup(t *testing.T) {
+	cases := []struct {
+		name    string
+		palette []uint32
+	}{
+		{"distinct green", []uint32{0xff000000, 0xff001100, 0xff002200, 0xff00ff00}},
+		{"shared green", []uint32{0xff100000, 0xff200000, 0xff300000, 0xff100001, 0xff200001}},
+		{"alpha only", []uint32{0x00123456, 0x40123456, 0x80123456, 0xff123456}},
+		{"single color", []uint32{0xff804020}},
+	}
+	rng := rand.New(rand.NewSource(35))
+	full := make([]uint32, 0, 256)
+	seen := map[uint32]bool{}
+	for len(full) < 256 {
+		c := rng.Uint32()
+		if !seen[c] {
+			seen[c] = true
+			full = append(full, c)
+		}
+	}
+	cases = append(cases, struct {
+		name    string
+		palette []uint32
+	}{"random 256", full})
+
+	for _, tc := range cases {
+		lut := buildPaletteLookup(tc.palette)
+		for want, c := range tc.palette {
+			if got := lut.index(c); got != uint32(want) {
+				t.Errorf("%s: index(%08x) = %d, want %d (hashIndex %d)",
+					tc.name, c, got, want, lut.hashIndex)
+			}
+		}
+	}
+}
+
+func TestSortPaletteIsPermutation(t *testing.T) {
+	const w, h = 40, 30
+	rng := rand.New(rand.NewSource(7))
+	colors := make([]uint32, 32)
+	for i := range colors {
+		colors[i] = 0xff000000 | rng.Uint32()&0xffffff
+	}
+	argb := make([]uint32, w*h)
+	for i := range argb {
+		argb[i] = colors[rng.Intn(len(colors))]
+	}
+	base, size, ok := ColorIndexBuild(argb, w, h)
+	if !ok {
+		t.Fatal("ColorIndexBuild failed")
+	}
+
+	for method := 0; method <= 6; method++ {
+		pal := append([]uint32(nil), base[:size]...)
+		sortPalette(argb, w, h, pal, method)
+		want := map[uint32]bool{}
+		for _, c := range base[:size] {
+			want[c] = true
+		}
+		for _, c := range pal {
+			if !want[c] {
+				t.Fatalf("method %d: color %08x missing from input palette", method, c)
+			}
+			delete(want, c)
+		}
+		if len(want) != 0 {
+			t.Fatalf("method %d: %d input colors lost in reordering", method, len(want))
+		}
+	}
+}
+
+func TestPaletteRoundTripAllMethods(t *testing.T) {
+	const w, h = 120, 80
+	rng := rand.New(rand.NewSource(19))
+	// Non-monotonous multi-color palette so the reordering heuristics run.
+	colors := make([]uint32, 64)
+	for i := range colors {
+		colors[i] = 0xff000000 | rng.Uint32()&0xffffff
+	}
+	argb := make([]uint32, w*h)
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			argb[y*w+x] = colors[(x/3+y/2)%len(colors)]
+		}
+	}
+
+	for _, method := range []int{0, 3, 4, 6} {
+		cfg := DefaultEncoderConfig()
+		cfg.Method = method
+		data, err := Encode(argb, w, h, cfg)
+		if err != nil {
+			t.Fatalf("method %d: Encode: %v", method, err)
+		}
+		img, err := DecodeVP8L(data)
+		if err != nil {
+			t.Fatalf("method %d: DecodeVP8L: %v", method, err)
+		}
+		got := NRGBAToARGB(img)
+		for i := range argb {
+			if got[i] != argb[i] {
+				t.Fatalf("method %d: pixel %d = %08x, want %08x",
+					method, i, got[i], argb[i])
+			}
+		}
+	}
+}
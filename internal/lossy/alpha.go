@@ -4,6 +4,8 @@ import (
 	"encoding/binary"
 	"fmt"
 	"math"
+	"runtime"
+	"sync"
 
 	"github.com/deepteams/webp/internal/lossless"
 )
@@ -546,7 +548,10 @@ func alphaVP8LStream(payload []byte, width, height int) []byte {
 }
 
 // applyFiltersAndEncode tries the filter(s) selected by getFilterMap and
-// returns the best (smallest) encoding.
+// returns the best (smallest) encoding. When several filters are in play
+// (Best mode tries all four) the candidate encodes are independent — each
+// one filters into its own buffer and runs its own VP8L sub-encode — so
+// they run on separate goroutines when more than one CPU is available.
 func applyFiltersAndEncode(alpha []byte, width, height, method, filter int,
 	reduceLevels bool, effortLevel int) ([]byte, error) {
 
@@ -555,32 +560,56 @@ func applyFiltersAndEncode(alpha []byte, width, height, method, filter int,
 	type trial struct {
 		data  []byte
 		score int
+		err   error
 	}
-	best := trial{score: math.MaxInt32}
+	var trials [alphaFilterLast]*trial
 
-	for f := AlphaFilterNone; f < alphaFilterLast && tryMap != 0; f++ {
-		if tryMap&1 != 0 {
-			result, score, err := encodeAlphaInternal(alpha, width, height,
+	var filters []int
+	for f := AlphaFilterNone; f < alphaFilterLast; f++ {
+		if tryMap&(1<<uint(f)) != 0 {
+			filters = append(filters, f)
+		}
+	}
+	if len(filters) == 0 {
+		// Fallback: no filter.
+		filters = []int{AlphaFilterNone}
+	}
+
+	if len(filters) > 1 && runtime.GOMAXPROCS(0) > 1 {
+		var wg sync.WaitGroup
+		for _, f := range filters {
+			wg.Add(1)
+			go func(f int) {
+				defer wg.Done()
+				data, score, err := encodeAlphaInternal(alpha, width, height,
+					method, f, reduceLevels, effortLevel)
+				trials[f] = &trial{data: data, score: score, err: err}
+			}(f)
+		}
+		wg.Wait()
+	} else {
+		for _, f := range filters {
+			data, score, err := encodeAlphaInternal(alpha, width, height,
 				method, f, reduceLevels, effortLevel)
-			if err != nil {
-				return nil, err
-			}
-			if score < best.score {
-				best.data = result
-				best.score = score
-			}
+			trials[f] = &trial{data: data, score: score, err: err}
 		}
-		tryMap >>= 1
 	}
 
-	if best.data == nil {
-		// Fallback: no filter.
-		result, _, err := encodeAlphaInternal(alpha, width, height,
-			method, AlphaFilterNone, reduceLevels, effortLevel)
-		if err != nil {
-			return nil, err
+	// Pick the winner in ascending filter order so ties resolve exactly as
+	// the old serial loop did.
+	best := trial{score: math.MaxInt32}
+	for f := AlphaFilterNone; f < alphaFilterLast; f++ {
+		t := trials[f]
+		if t == nil {
+			continue
+		}
+		if t.err != nil {
+			return nil, t.err
+		}
+		if t.score < best.score {
+			best.data = t.data
+			best.score = t.score
 		}
-		best.data = result
 	}
 
 	return best.data, nil
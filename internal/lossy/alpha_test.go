@@ -0,0 +1,85 @@
+package lossy
+
+import (
+	"bytes"
+	"runtime"
+	"testing"
+)
+
+// alphaTestPlane builds a synthetic alpha plane with smooth gradients and a
+// hard-edged transparent region, so all four filter candidates score
+// differently.
+func alphaTestPlane(width, height int) []byte {
+	plane := make([]byte, width*height)
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			v := byte((x*255)/width/2 + (y*255)/height/2)
+			if x > width/3 && x < 2*width/3 && y > height/4 {
+				v = 0
+			}
+			plane[y*width+x] = v
+		}
+	}
+	return plane
+}
+
+// TestEncodeAlphaBestFilterParallelMatchesSerial checks that the concurrent
+// filter-candidate search in applyFiltersAndEncode produces a bit-identical
+// ALPH payload to the serial path (forced via GOMAXPROCS(1)).
+func TestEncodeAlphaBestFilterParallelMatchesSerial(t *testing.T) {
+	const width, height = 97, 64
+	plane := alphaTestPlane(width, height)
+
+	cfg := &AlphaEncoderConfig{
+		Quality:     100,
+		Method:      AlphaLosslessCompression,
+		Filter:      AlphaFilterModeBest,
+		EffortLevel: 4,
+	}
+
+	got, err := EncodeAlpha(plane, width, height, cfg)
+	if err != nil {
+		t.Fatalf("EncodeAlpha (parallel): %v", err)
+	}
+
+	prev := runtime.GOMAXPROCS(1)
+	want, err := EncodeAlpha(plane, width, height, cfg)
+	runtime.GOMAXPROCS(prev)
+	if err != nil {
+		t.Fatalf("EncodeAlpha (serial): %v", err)
+	}
+
+	if !bytes.Equal(got, want) {
+		t.Fatalf("parallel filter search output differs from serial: %d vs %d bytes",
+			len(got), len(want))
+	}
+}
+
+// TestEncodeAlphaRoundTrip checks encode -> decode recovers the exact plane
+// for every filter mode at lossless quality.
+func TestEncodeAlphaRoundTrip(t *testing.T) {
+	const width, height = 80, 51
+	plane := alphaTestPlane(width, height)
+
+	for _, mode := range []int{
+		AlphaFilterModeNone, AlphaFilterModeFast, AlphaFilterModeBest,
+	} {
+		cfg := &AlphaEncoderConfig{
+			Quality:     100,
+			Method:      AlphaLosslessCompression,
+			Filter:      mode,
+			EffortLevel: 4,
+		}
+		data, err := EncodeAlpha(plane, width, height, cfg)
+		if err != nil {
+			t.Fatalf("EncodeAlpha filter mode %d: %v", mode, err)
+		}
+		decoded, err := DecodeAlpha(data, width, height)
+		if err != nil {
+			t.Fatalf("DecodeAlpha filter mode %d: %v", mode, err)
+		}
+		if !bytes.Equal(decoded, plane) {
+			t.Fatalf("filter mode %d: round-trip mismatch", mode)
+		}
+	}
+}
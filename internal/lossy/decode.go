@@ -4,6 +4,8 @@ import (
 	"encoding/binary"
 	"fmt"
 	"sync"
+	"sync/atomic"
+	"time"
 
 	"github.com/deepteams/webp/internal/bitio"
 	"github.com/deepteams/webp/internal/dsp"
@@ -37,6 +39,9 @@ func acquireDecoder() *Decoder {
 		dec.skipP = 0
 		dec.filterType = 0
 		dec.AlphaData = nil
+		dec.statEntropyNS.Store(0)
+		dec.statReconNS.Store(0)
+		dec.statFilterNS.Store(0)
 		return dec
 	}
 	return &Decoder{}
@@ -86,28 +91,28 @@ type PictureHeader struct {
 
 // SegmentHeader describes segment-based quantizer/filter overrides.
 type SegmentHeader struct {
-	UseSegment    bool
-	UpdateMap     bool
-	AbsoluteDelta bool
-	Quantizer     [NumMBSegments]int8
+	UseSegment     bool
+	UpdateMap      bool
+	AbsoluteDelta  bool
+	Quantizer      [NumMBSegments]int8
 	FilterStrength [NumMBSegments]int8
 }
 
 // FilterHeader describes the loop filter parameters.
 type FilterHeader struct {
-	Simple     bool
-	Level      int
-	Sharpness  int
-	UseLFDelta bool
+	Simple      bool
+	Level       int
+	Sharpness   int
+	UseLFDelta  bool
 	RefLFDelta  [NumRefLFDeltas]int
 	ModeLFDelta [NumModeLFDeltas]int
 }
 
 // FInfo holds per-macroblock filter strength info.
 type FInfo struct {
-	FLimit   uint8
-	FILevel  uint8
-	FInner   bool
+	FLimit    uint8
+	FILevel   uint8
+	FInner    bool
 	HevThresh uint8
 }
 
@@ -121,7 +126,7 @@ type MB struct {
 type MBData struct {
 	Coeffs    [384]int16 // (16+4+4) * 16
 	IsI4x4    bool
-	IModes    [16]uint8  // one 16x16 mode or sixteen 4x4 modes
+	IModes    [16]uint8 // one 16x16 mode or sixteen 4x4 modes
 	UVMode    uint8
 	NonZeroY  uint32
 	NonZeroUV uint32
@@ -146,22 +151,22 @@ type OutputFunc func(mbY, mbW, mbH int, y []byte, yStride int, u, v []byte, uvSt
 // Decoder is the VP8 lossy bitstream decoder.
 type Decoder struct {
 	// Headers
-	frmHdr  FrameHeader
-	picHdr  PictureHeader
+	frmHdr    FrameHeader
+	picHdr    PictureHeader
 	filterHdr FilterHeader
-	segHdr  SegmentHeader
+	segHdr    SegmentHeader
 
 	// Dimensions in macroblock units.
 	mbW, mbH int
 
 	// Macroblock position and parsing bounds.
-	mbX, mbY   int
+	mbX, mbY     int
 	tlMBX, tlMBY int
 	brMBX, brMBY int
 
 	// Partitions.
-	br    *bitio.BoolReader   // partition 0 (header/modes)
-	parts [MaxNumPartitions]*bitio.BoolReader
+	br               *bitio.BoolReader // partition 0 (header/modes)
+	parts            [MaxNumPartitions]*bitio.BoolReader
 	numPartsMinusOne uint32
 
 	// Probabilities.
@@ -186,9 +191,9 @@ type Decoder struct {
 	mbData []MBData     // per-MB data (mbW)
 
 	// Cache for output rows.
-	cacheY, cacheU, cacheV []byte
-	cacheYStride           int
-	cacheUVStride          int
+	cacheY, cacheU, cacheV          []byte
+	cacheYStride                    int
+	cacheUVStride                   int
 	cacheYOff, cacheUOff, cacheVOff int // offsets into cache for extra filter rows
 
 	// slab is the single backing allocation for intraT+yuvB+cacheY/U/V,
@@ -200,6 +205,22 @@ type Decoder struct {
 
 	// Scratch space reused across macroblock decodes to avoid heap escapes.
 	dcScratch [16]int16
+
+	// Per-stage timing telemetry, accumulated in nanoseconds over the
+	// frame decode (one add per macroblock row). The parallel path adds
+	// from several goroutines, hence the atomics.
+	statEntropyNS atomic.Int64
+	statReconNS   atomic.Int64
+	statFilterNS  atomic.Int64
+}
+
+// StageTimings reports how long the last decode spent in each stage:
+// entropy (boolean-coder token parsing), reconstruction (prediction and
+// inverse transform), and the loop filter. On the parallel path the
+// stages overlap in wall time, so the values are summed per-goroutine
+// durations rather than a wall-clock breakdown.
+func (dec *Decoder) StageTimings() (entropyNS, reconNS, filterNS int64) {
+	return dec.statEntropyNS.Load(), dec.statReconNS.Load(), dec.statFilterNS.Load()
 }
 
 // DecodeFrame decodes a complete VP8 lossy frame from data.
@@ -240,6 +261,92 @@ func DecodeFrame(data []byte) (dec *Decoder, width, height int, y []byte, yStrid
 	return
 }
 
+// kFilterExtraRows is the number of extra pixels the loop filter reads
+// around an edge, per filter type (none, simple, complex).
+var kFilterExtraRows = [3]int{0, 2, 8}
+
+// DecodeFrameCropped is like DecodeFrame but limits decoding to the
+// macroblock rows covering the crop window: rows below the window are
+// never entropy-decoded, reconstructed, or filtered, and filtering is
+// restricted to the macroblocks the window (plus filter margins) touches.
+// The returned planes are full-stride; rows at or below the last cropped
+// macroblock row are undefined. The crop rectangle must lie within the
+// frame.
+func DecodeFrameCropped(data []byte, cropX, cropY, cropW, cropH int) (dec *Decoder, width, height int, y []byte, yStride int, u, v []byte, uvStride int, err error) {
+	dec = acquireDecoder()
+
+	if err = dec.parseHeaders(data); err != nil {
+		ReleaseDecoder(dec)
+		dec = nil
+		return
+	}
+
+	width = dec.picHdr.Width
+	height = dec.picHdr.Height
+	if cropX < 0 || cropY < 0 || cropW <= 0 || cropH <= 0 ||
+		cropX+cropW > width || cropY+cropH > height {
+		ReleaseDecoder(dec)
+		dec = nil
+		err = fmt.Errorf("vp8: crop %dx%d+%d+%d exceeds frame %dx%d", cropW, cropH, cropX, cropY, width, height)
+		return
+	}
+
+	if err = dec.initFrame(); err != nil {
+		ReleaseDecoder(dec)
+		dec = nil
+		return
+	}
+
+	dec.precomputeFilterStrengths()
+	dec.setCropBounds(cropX, cropY, cropX+cropW, cropY+cropH)
+
+	if err = dec.parseFrame(); err != nil {
+		ReleaseDecoder(dec)
+		dec = nil
+		return
+	}
+
+	yStride = dec.cacheYStride
+	uvStride = dec.cacheUVStride
+	lastY := dec.brMBY * 16
+	if lastY > height {
+		lastY = height
+	}
+	y = dec.cacheY[:lastY*yStride]
+	u = dec.cacheU[:((lastY+1)/2)*uvStride]
+	v = dec.cacheV[:((lastY+1)/2)*uvStride]
+	return
+}
+
+// setCropBounds restricts the decode loop and loop filter to the
+// macroblocks covering the given pixel window, widened by the filter's
+// extra pixels as in libwebp's VP8EnterCritical.
+func (dec *Decoder) setCropBounds(x0, y0, x1, y1 int) {
+	extra := kFilterExtraRows[dec.filterType]
+
+	tlX := (x0 - extra) >> 4
+	tlY := (y0 - extra) >> 4
+	if tlX < 0 {
+		tlX = 0
+	}
+	if tlY < 0 {
+		tlY = 0
+	}
+	dec.tlMBX = tlX
+	dec.tlMBY = tlY
+
+	brX := (x1 + 15 + extra) >> 4
+	brY := (y1 + 15 + extra) >> 4
+	if brX > dec.mbW {
+		brX = dec.mbW
+	}
+	if brY > dec.mbH {
+		brY = dec.mbH
+	}
+	dec.brMBX = brX
+	dec.brMBY = brY
+}
+
 // parseHeaders reads the VP8 frame and picture headers, segment/filter info,
 // partitions, quantizers, and probability tables.
 func (dec *Decoder) parseHeaders(data []byte) error {
@@ -528,10 +635,20 @@ func (dec *Decoder) initFrame() error {
 	return nil
 }
 
-// parseFrame is the main decode loop over all macroblock rows.
+// parseFrame decodes all macroblock rows, choosing between the serial
+// loop and the row-pipelined parallel path.
 func (dec *Decoder) parseFrame() error {
+	if dec.useParallelFrame() {
+		return dec.parseFrameParallel()
+	}
+	return dec.parseFrameSerial()
+}
+
+// parseFrameSerial is the single-threaded decode loop over all macroblock rows.
+func (dec *Decoder) parseFrameSerial() error {
 	for dec.mbY = 0; dec.mbY < dec.brMBY; dec.mbY++ {
 		tokenBR := dec.parts[dec.mbY&int(dec.numPartsMinusOne)]
+		rowStart := time.Now()
 
 		// Parse intra modes for this row.
 		if err := dec.parseIntraModeRow(); err != nil {
@@ -549,11 +666,16 @@ func (dec *Decoder) parseFrame() error {
 		dec.initScanline()
 
 		// Reconstruct and filter the row.
+		reconStart := time.Now()
+		dec.statEntropyNS.Add(reconStart.Sub(rowStart).Nanoseconds())
 		dec.reconstructRow()
+		filterStart := time.Now()
+		dec.statReconNS.Add(filterStart.Sub(reconStart).Nanoseconds())
 
-		// Apply filtering.
-		if dec.filterType > 0 {
+		// Apply filtering (only rows that can affect the crop window).
+		if dec.filterType > 0 && dec.mbY >= dec.tlMBY {
 			dec.filterRowAt(dec.mbY)
+			dec.statFilterNS.Add(time.Since(filterStart).Nanoseconds())
 		}
 	}
 	return nil
@@ -282,7 +282,17 @@ func (dec *Decoder) precomputeFilterStrengths() {
 // filterRowAt applies the loop filter to the given macroblock row.
 func (dec *Decoder) filterRowAt(mbY int) {
 	for mbX := dec.tlMBX; mbX < dec.brMBX; mbX++ {
-		dec.doFilter(mbX, mbY)
+		dec.doFilter(mbX, mbY, &dec.fInfo[mbX])
+	}
+}
+
+// filterRowInfo applies the loop filter to row mbY using an explicit
+// per-row filter info slice, leaving dec.fInfo untouched. The pipelined
+// filter stage uses it because it runs concurrently with the entropy
+// pass, which repoints dec.fInfo row by row.
+func (dec *Decoder) filterRowInfo(fInfo []FInfo, mbY int) {
+	for mbX := dec.tlMBX; mbX < dec.brMBX; mbX++ {
+		dec.doFilter(mbX, mbY, &fInfo[mbX])
 	}
 }
 
@@ -290,8 +300,7 @@ func (dec *Decoder) filterRowAt(mbY int) {
 // Uses base-offset approach: passes the full cache buffer plus an offset
 // so that negative-context access (e.g. p[off-3*bps]) always resolves to
 // a valid positive index.
-func (dec *Decoder) doFilter(mbX, mbY int) {
-	finfo := &dec.fInfo[mbX]
+func (dec *Decoder) doFilter(mbX, mbY int, finfo *FInfo) {
 	limit := int(finfo.FLimit)
 	if limit == 0 {
 		return
@@ -107,17 +107,20 @@ func brSync(br *bitio.BoolReader, brV uint64, brR uint32, brB int) {
 
 // getCoeffsInline is the hot-path version of getCoeffs with manually-inlined
 // GetBit/GetSigned operations. It keeps BoolReader state in local variables
-// to minimize memory traffic.
-func getCoeffsInline(br *bitio.BoolReader, bands *[17]*BandProbas, ctx int, dq0, dq1 int, n int, out []int16) int {
+// to minimize memory traffic. tbl is the position-indexed probability table
+// for the coefficient type, precomputed at header-parse time; advancing a
+// band is plain indexing into one contiguous table rather than a pointer
+// dereference per position.
+func getCoeffsInline(br *bitio.BoolReader, tbl *CoeffProbas, ctx int, dq0, dq1 int, n int, out []int16) int {
 	// Hoist BoolReader hot state into locals for register residency.
 	brV := br.Value
 	brR := br.Range
 	brB := br.Bits
 
 	// BCE hints: n ranges [0,15], n+1 ranges [1,16]; out indices are KZigzag values [0,15].
-	_ = bands[16]
+	_ = tbl[16]
 	_ = out[15]
-	p := bands[n].Probas[ctx][:]
+	p := tbl[n][ctx][:]
 	for ; n < 16; n++ {
 		// Inline: if br.GetBit(p[0]) == 0 { return n }
 		if brB < 0 {
@@ -140,7 +143,7 @@ func getCoeffsInline(br *bitio.BoolReader, bands *[17]*BandProbas, ctx int, dq0,
 				break
 			}
 			n++
-			p = bands[n].Probas[0][:]
+			p = tbl[n][0][:]
 			if n == 16 {
 				brSync(br, brV, brR, brB)
 				return 16
@@ -151,7 +154,7 @@ func getCoeffsInline(br *bitio.BoolReader, bands *[17]*BandProbas, ctx int, dq0,
 		if brB < 0 {
 			brV, brB = brLoad(br, brV, brB)
 		}
-		pCtx := &bands[n+1].Probas
+		pCtx := &tbl[n+1]
 		var v int
 		bit, brV, brR, brB = fastBit(p[2], brV, brR, brB)
 		if bit == 0 {
@@ -311,7 +314,7 @@ func b2i(b bool) int {
 
 // parseResiduals decodes all residual coefficients for one macroblock.
 func (dec *Decoder) parseResiduals(mb, leftMB *MB, block *MBData, tokenBR *bitio.BoolReader) {
-	bands := &dec.proba.BandsPtr
+	coeffs := &dec.proba.Coeffs
 	q := &dec.dqm[block.Segment&3]
 	dst := block.Coeffs[:]
 
@@ -323,7 +326,7 @@ func (dec *Decoder) parseResiduals(mb, leftMB *MB, block *MBData, tokenBR *bitio
 	var nonZeroY uint32
 	var nonZeroUV uint32
 	var first int
-	var acProba *[17]*BandProbas
+	var acProba *CoeffProbas
 
 	if !block.IsI4x4 {
 		// Parse DC (i16-DC = type 1).
@@ -334,7 +337,7 @@ func (dec *Decoder) parseResiduals(mb, leftMB *MB, block *MBData, tokenBR *bitio
 			dc[i] = 0
 		}
 		ctx := int(mb.NzDC) + int(leftMB.NzDC)
-		nz := getCoeffsInline(tokenBR, &bands[1], ctx, q.Y2Mat[0], q.Y2Mat[1], 0, dc[:])
+		nz := getCoeffsInline(tokenBR, &coeffs[1], ctx, q.Y2Mat[0], q.Y2Mat[1], 0, dc[:])
 		if nz > 0 {
 			mb.NzDC = 1
 			leftMB.NzDC = 1
@@ -353,10 +356,10 @@ func (dec *Decoder) parseResiduals(mb, leftMB *MB, block *MBData, tokenBR *bitio
 			}
 		}
 		first = 1
-		acProba = &bands[0] // i16-AC = type 0
+		acProba = &coeffs[0] // i16-AC = type 0
 	} else {
 		first = 0
-		acProba = &bands[3] // i4-AC = type 3
+		acProba = &coeffs[3] // i4-AC = type 3
 	}
 
 	// Luma AC.
@@ -397,7 +400,7 @@ func (dec *Decoder) parseResiduals(mb, leftMB *MB, block *MBData, tokenBR *bitio
 			l := lnz & 1
 			for x := 0; x < 2; x++ {
 				ctx := int(l) + int(tnz&1)
-				nz := getCoeffsInline(tokenBR, &bands[2], ctx, q.UVMat[0], q.UVMat[1], 0, dst)
+				nz := getCoeffsInline(tokenBR, &coeffs[2], ctx, q.UVMat[0], q.UVMat[1], 0, dst)
 				if nz > 0 {
 					l = 1
 				} else {
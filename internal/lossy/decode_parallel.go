@@ -0,0 +1,354 @@
+package lossy
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/deepteams/webp/internal/dsp"
+)
+
+// decodeParallelState holds pooled buffers for parallel decoding.
+//
+// Unlike the serial path, which reuses one row of MBData for the whole
+// frame, the parallel path stores per-MB data for every row so the serial
+// entropy pass can run ahead of the reconstruction workers (the encoder's
+// mbInfo array uses the same full-frame layout).
+type decodeParallelState struct {
+	mbData  []MBData // full-frame per-MB data (mbW * mbH)
+	fInfo   []FInfo  // full-frame filter info (mbW * mbH)
+	yuvBs   [][]byte // per-worker BPS-strided reconstruction buffers
+	entropy *rowSync // entropy progress: done==1 once a row is fully parsed
+	recon   *rowSync // reconstruction progress per row, in MBs
+	nextRow atomic.Int32
+	failed  atomic.Bool
+}
+
+var decodeParallelPool sync.Pool
+
+// getDecodeParallelState returns a pooled or new state sized for the frame.
+// mbData is not cleared on reuse: parseResiduals rewrites all coefficients
+// and skipped blocks carry zero NonZero bits, so stale data is never read
+// (the serial path relies on the same property when reusing its row).
+func getDecodeParallelState(numWorkers, mbW, mbH int) *decodeParallelState {
+	if v := decodeParallelPool.Get(); v != nil {
+		ps := v.(*decodeParallelState)
+		if len(ps.yuvBs) >= numWorkers && cap(ps.mbData) >= mbW*mbH && len(ps.entropy.rows) >= mbH {
+			ps.mbData = ps.mbData[:mbW*mbH]
+			ps.fInfo = ps.fInfo[:mbW*mbH]
+			for i := 0; i < mbH; i++ {
+				ps.entropy.rows[i].done.Store(0)
+				ps.recon.rows[i].done.Store(0)
+			}
+			ps.nextRow.Store(0)
+			ps.failed.Store(false)
+			return ps
+		}
+		// Too small, discard and allocate fresh.
+	}
+	ps := &decodeParallelState{
+		mbData:  make([]MBData, mbW*mbH),
+		fInfo:   make([]FInfo, mbW*mbH),
+		yuvBs:   make([][]byte, numWorkers),
+		entropy: newRowSync(mbH),
+		recon:   newRowSync(mbH),
+	}
+	for i := range ps.yuvBs {
+		ps.yuvBs[i] = make([]byte, YUVSize)
+	}
+	return ps
+}
+
+func putDecodeParallelState(ps *decodeParallelState) {
+	decodeParallelPool.Put(ps)
+}
+
+// useParallelFrame reports whether the frame should be decoded with the
+// row-pipelined parallel path.
+func (dec *Decoder) useParallelFrame() bool {
+	if runtime.GOMAXPROCS(0) <= 1 {
+		return false
+	}
+	// Cropped decodes keep the serial path: the wavefront bookkeeping is
+	// not worth it for partial frames.
+	if dec.tlMBX != 0 || dec.tlMBY != 0 || dec.brMBX != dec.mbW || dec.brMBY != dec.mbH {
+		return false
+	}
+	// Small frames finish serially before the goroutine setup pays off.
+	return dec.mbW >= 8 && dec.mbH >= 8
+}
+
+// parseFrameParallel decodes the frame with a three-stage pipeline:
+//
+//   - Entropy decoding stays serial on the calling goroutine (partition-0
+//     intra modes and the non-zero context chain are strictly sequential)
+//     and publishes finished rows to the workers.
+//   - Reconstruction runs wavefront-parallel across worker goroutines with
+//     the same row-dependency rule as encodeFrameParallel: row y may
+//     reconstruct MB x once row y-1 has finished MB x+1, whose stashed
+//     bottom pixels provide the top and top-right prediction context.
+//   - The loop filter runs serially one row behind reconstruction, on its
+//     own goroutine. Filtering row y only touches output rows y-1 and y,
+//     which are final once row y is reconstructed, so it overlaps both the
+//     entropy pass and workers still reconstructing later rows.
+//
+// The output is bit-exact with the serial path: prediction always reads the
+// pre-filter samples stashed in yuvT, and the synchronization only orders
+// work that the serial loop already performs in the same relative order.
+func (dec *Decoder) parseFrameParallel() error {
+	mbW := dec.mbW
+	mbH := dec.mbH
+
+	// Cap workers like the encoder: the wavefront is at most a few rows
+	// deep, so extra goroutines only add sync contention.
+	numWorkers := runtime.GOMAXPROCS(0)
+	if numWorkers > 6 {
+		numWorkers = 6
+	}
+	if numWorkers > mbH {
+		numWorkers = mbH
+	}
+
+	ps := getDecodeParallelState(numWorkers, mbW, mbH)
+	defer putDecodeParallelState(ps)
+
+	// The entropy pass below points dec.mbData/dec.fInfo into the pooled
+	// full-frame arrays row by row; restore the decoder's own buffers
+	// before returning so pooled state is never aliased across decoders.
+	origMBData, origFInfo := dec.mbData, dec.fInfo
+	defer func() {
+		dec.mbData, dec.fInfo = origMBData, origFInfo
+	}()
+
+	// Stage 3: loop filter on its own goroutine, trailing reconstruction
+	// row by row. Filtering row y only writes the bottom lines of row y-1
+	// and row y, both final once row y is reconstructed (prediction reads
+	// pre-filter samples from yuvT, never from the filtered cache), so the
+	// whole filter cost hides behind the entropy and reconstruction stages
+	// instead of running after the entropy pass on the calling goroutine.
+	filterDone := make(chan struct{})
+	if dec.filterType > 0 {
+		go func() {
+			defer close(filterDone)
+			for y := 0; y < mbH; y++ {
+				ps.recon.waitFor(y, int32(mbW))
+				if ps.failed.Load() {
+					continue // keep consuming signals; output is discarded
+				}
+				start := time.Now()
+				dec.filterRowInfo(ps.fInfo[y*mbW:(y+1)*mbW], y)
+				dec.statFilterNS.Add(time.Since(start).Nanoseconds())
+			}
+		}()
+	} else {
+		close(filterDone)
+	}
+
+	var wg sync.WaitGroup
+	for wi := 0; wi < numWorkers; wi++ {
+		wg.Add(1)
+		go func(buf []byte) {
+			defer wg.Done()
+			for {
+				y := int(ps.nextRow.Add(1) - 1)
+				if y >= mbH {
+					return
+				}
+				ps.entropy.waitFor(y, 1)
+				if ps.failed.Load() {
+					// Unblock rows below and keep draining.
+					ps.recon.signal(y, int32(mbW))
+					continue
+				}
+				start := time.Now()
+				dec.reconstructRowParallel(y, ps.mbData[y*mbW:(y+1)*mbW], buf, ps.recon)
+				dec.statReconNS.Add(time.Since(start).Nanoseconds())
+			}
+		}(ps.yuvBs[wi])
+	}
+
+	// Stage 1: serial entropy pass, producing rows for the workers.
+	var decErr error
+	for y := 0; y < mbH; y++ {
+		tokenBR := dec.parts[y&int(dec.numPartsMinusOne)]
+		dec.mbY = y
+		dec.mbData = ps.mbData[y*mbW : (y+1)*mbW]
+		dec.fInfo = ps.fInfo[y*mbW : (y+1)*mbW]
+		rowStart := time.Now()
+
+		if err := dec.parseIntraModeRow(); err != nil {
+			decErr = err
+		} else {
+			for dec.mbX = 0; dec.mbX < mbW; dec.mbX++ {
+				if err := dec.decodeMB(tokenBR); err != nil {
+					decErr = err
+					break
+				}
+			}
+		}
+		dec.initScanline()
+		dec.statEntropyNS.Add(time.Since(rowStart).Nanoseconds())
+
+		if decErr != nil {
+			ps.failed.Store(true)
+			for ; y < mbH; y++ {
+				ps.entropy.signal(y, 1)
+			}
+			break
+		}
+		ps.entropy.signal(y, 1)
+	}
+
+	wg.Wait()
+	<-filterDone
+	return decErr
+}
+
+// reconstructRowParallel is the worker-side variant of reconstructRow: it
+// reconstructs one macroblock row into its own BPS-strided buffer,
+// synchronizing on the row above through rs before each macroblock and
+// publishing its own progress after each one.
+func (dec *Decoder) reconstructRowParallel(mbY int, mbData []MBData, buf []byte, rs *rowSync) {
+	bps := BPS
+	yBase := YOff
+	uBase := UOff
+	vBase := VOff
+
+	// Initialize left-most column border pixels.
+	for j := 0; j < 16; j++ {
+		buf[yBase+j*bps-1] = 129
+	}
+	for j := 0; j < 8; j++ {
+		buf[uBase+j*bps-1] = 129
+		buf[vBase+j*bps-1] = 129
+	}
+
+	// Init top-left corner.
+	if mbY > 0 {
+		buf[yBase-1-bps] = 129
+		buf[uBase-1-bps] = 129
+		buf[vBase-1-bps] = 129
+	} else {
+		fillBytes(buf[yBase-bps-1:], 127, 16+4+1)
+		fillBytes(buf[uBase-bps-1:], 127, 8+1)
+		fillBytes(buf[vBase-bps-1:], 127, 8+1)
+	}
+
+	for mbX := 0; mbX < dec.mbW; mbX++ {
+		// Wait for the row above to complete MB x+1: its stashed bottom
+		// pixels are this MB's top and top-right prediction context.
+		if mbY > 0 {
+			waitX := int32(mbX + 2)
+			if waitX > int32(dec.mbW) {
+				waitX = int32(dec.mbW)
+			}
+			rs.waitFor(mbY-1, waitX)
+		}
+
+		block := &mbData[mbX]
+
+		// Slices pointing into the buffer at the current offset.
+		yDst := buf[yBase:]
+		uDst := buf[uBase:]
+		vDst := buf[vBase:]
+
+		// Rotate left samples from the previous block.
+		if mbX > 0 {
+			for j := -1; j < 16; j++ {
+				copy(buf[yBase+j*bps-4:yBase+j*bps], buf[yBase+j*bps+12:yBase+j*bps+16])
+			}
+			for j := -1; j < 8; j++ {
+				copy(buf[uBase+j*bps-4:uBase+j*bps], buf[uBase+j*bps+4:uBase+j*bps+8])
+				copy(buf[vBase+j*bps-4:vBase+j*bps], buf[vBase+j*bps+4:vBase+j*bps+8])
+			}
+		}
+
+		// Bring top samples into the cache.
+		topYUV := &dec.yuvT[mbX]
+		coeffs := block.Coeffs[:]
+		bits := block.NonZeroY
+
+		if mbY > 0 {
+			copy(buf[yBase-bps:], topYUV.Y[:])
+			copy(buf[uBase-bps:], topYUV.U[:])
+			copy(buf[vBase-bps:], topYUV.V[:])
+		}
+
+		// Predict and add residuals.
+		if block.IsI4x4 {
+			// 4x4 prediction.
+			topRight := buf[yBase-bps+16:]
+
+			if mbY > 0 {
+				if mbX >= dec.mbW-1 {
+					// On rightmost border: replicate last top pixel.
+					fillBytes(topRight, topYUV.Y[15], 4)
+				} else {
+					copy(topRight[:4], dec.yuvT[mbX+1].Y[:4])
+				}
+			}
+			// Replicate top-right below for each sub-block row.
+			for r := 1; r <= 3; r++ {
+				off := r * 4 * bps
+				copy(topRight[off:off+4], topRight[:4])
+			}
+
+			for n := 0; n < 16; n++ {
+				blockOff := yBase + kScan[n]
+				dsp.PredLuma4Direct(int(block.IModes[n]), buf, blockOff)
+				doTransform(bits, coeffs[n*16:], buf[blockOff:])
+				bits <<= 2
+			}
+		} else {
+			// 16x16 prediction.
+			predFunc := checkMode(mbX, mbY, int(block.IModes[0]))
+			dsp.PredLuma16[predFunc](buf, yBase)
+			if bits != 0 {
+				for n := 0; n < 16; n++ {
+					doTransform(bits, coeffs[n*16:], buf[yBase+kScan[n]:])
+					bits <<= 2
+				}
+			}
+		}
+
+		// Chroma prediction and transform.
+		bitsUV := block.NonZeroUV
+		predFunc := checkMode(mbX, mbY, int(block.UVMode))
+		dsp.PredChroma8[predFunc](buf, uBase)
+		dsp.PredChroma8[predFunc](buf, vBase)
+		doUVTransform(bitsUV>>0, coeffs[16*16:], uDst)
+		doUVTransform(bitsUV>>8, coeffs[20*16:], vDst)
+
+		// Stash top samples for the next row.
+		if mbY < dec.mbH-1 {
+			copy(topYUV.Y[:], yDst[15*bps:15*bps+16])
+			copy(topYUV.U[:], uDst[7*bps:7*bps+8])
+			copy(topYUV.V[:], vDst[7*bps:7*bps+8])
+		}
+
+		// Transfer reconstructed samples to the output cache.
+		yStride := dec.cacheYStride
+		uvStride := dec.cacheUVStride
+		yOffset := mbY * 16 * yStride
+		uvOffset := mbY * 8 * uvStride
+		yOut := dec.cacheY[mbX*16+yOffset:]
+		uOut := dec.cacheU[mbX*8+uvOffset:]
+		vOut := dec.cacheV[mbX*8+uvOffset:]
+		_ = yOut[15*yStride+15] // BCE hint
+		_ = yDst[15*bps+15]     // BCE hint
+		_ = uOut[7*uvStride+7]  // BCE hint
+		_ = vOut[7*uvStride+7]  // BCE hint
+		_ = uDst[7*bps+7]       // BCE hint
+		_ = vDst[7*bps+7]       // BCE hint
+		for j := 0; j < 16; j++ {
+			copy(yOut[j*yStride:j*yStride+16], yDst[j*bps:j*bps+16])
+		}
+		for j := 0; j < 8; j++ {
+			copy(uOut[j*uvStride:j*uvStride+8], uDst[j*bps:j*bps+8])
+			copy(vOut[j*uvStride:j*uvStride+8], vDst[j*bps:j*bps+8])
+		}
+
+		rs.signal(mbY, int32(mbX+1))
+	}
+}
@@ -0,0 +1,99 @@
+package lossy
+
+import (
+	"fmt"
+	"testing"
+)
+
+// decodeWith runs a full decode using the given frame loop and returns
+// copies of the YUV planes.
+func decodeWith(t *testing.T, data []byte, parallel bool) (y, u, v []byte, yStride, uvStride int) {
+	t.Helper()
+	dec := acquireDecoder()
+	defer ReleaseDecoder(dec)
+
+	if err := dec.parseHeaders(data); err != nil {
+		t.Fatalf("parseHeaders: %v", err)
+	}
+	if err := dec.initFrame(); err != nil {
+		t.Fatalf("initFrame: %v", err)
+	}
+	dec.precomputeFilterStrengths()
+
+	var err error
+	if parallel {
+		err = dec.parseFrameParallel()
+	} else {
+		err = dec.parseFrameSerial()
+	}
+	if err != nil {
+		t.Fatalf("parseFrame (parallel=%v): %v", parallel, err)
+	}
+
+	height := dec.picHdr.Height
+	yStride = dec.cacheYStride
+	uvStride = dec.cacheUVStride
+	y = append([]byte(nil), dec.cacheY[:height*yStride]...)
+	u = append([]byte(nil), dec.cacheU[:((height+1)/2)*uvStride]...)
+	v = append([]byte(nil), dec.cacheV[:((height+1)/2)*uvStride]...)
+	return
+}
+
+// TestParseFrameParallelMatchesSerial verifies the parallel decode path is
+// bit-exact with the serial one, including frames with odd dimensions and
+// with the loop filter active.
+func TestParseFrameParallelMatchesSerial(t *testing.T) {
+	sizes := []struct{ w, h int }{{160, 128}, {257, 131}, {128, 400}}
+	for _, sz := range sizes {
+		t.Run(fmt.Sprintf("%dx%d", sz.w, sz.h), func(t *testing.T) {
+			img := colorPatternImage(sz.w, sz.h)
+			enc := NewEncoder(img, DefaultConfig(75))
+			data, err := enc.EncodeFrame()
+			if err != nil {
+				t.Fatalf("EncodeFrame: %v", err)
+			}
+
+			sy, su, sv, _, _ := decodeWith(t, data, false)
+			py, pu, pv, _, _ := decodeWith(t, data, true)
+
+			for i := 0; i < len(sy); i++ {
+				if sy[i] != py[i] {
+					t.Fatalf("Y plane differs at %d: serial=%d parallel=%d", i, sy[i], py[i])
+				}
+			}
+			for i := 0; i < len(su); i++ {
+				if su[i] != pu[i] {
+					t.Fatalf("U plane differs at %d: serial=%d parallel=%d", i, su[i], pu[i])
+				}
+				if sv[i] != pv[i] {
+					t.Fatalf("V plane differs at %d: serial=%d parallel=%d", i, sv[i], pv[i])
+				}
+			}
+		})
+	}
+}
+
+// TestParseFrameParallelTruncated checks that a truncated bitstream fails
+// cleanly (no hang, no panic) on the parallel path.
+func TestParseFrameParallelTruncated(t *testing.T) {
+	img := colorPatternImage(160, 128)
+	enc := NewEncoder(img, DefaultConfig(75))
+	data, err := enc.EncodeFrame()
+	if err != nil {
+		t.Fatalf("EncodeFrame: %v", err)
+	}
+
+	dec := acquireDecoder()
+	defer ReleaseDecoder(dec)
+	truncated := data[:len(data)*3/4]
+	if err := dec.parseHeaders(truncated); err != nil {
+		t.Skipf("truncation already caught in headers: %v", err)
+	}
+	if err := dec.initFrame(); err != nil {
+		t.Fatalf("initFrame: %v", err)
+	}
+	dec.precomputeFilterStrengths()
+	if err := dec.parseFrameParallel(); err == nil {
+		t.Fatal("expected error for truncated bitstream")
+	}
+}
@@ -22,6 +22,7 @@ func parseProba(br BoolSource, dec *Decoder) {
 		for b := 0; b < 16+1; b++ {
 			p.BandsPtr[t][b] = &p.Bands[t][KBands[b]]
 		}
+		p.buildCoeffTables(t)
 	}
 
 	dec.useSkipProba = br.GetBit(0x80) != 0
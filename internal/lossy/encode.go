@@ -6,6 +6,7 @@ import (
 	"math"
 	"runtime"
 	"sync"
+	"time"
 
 	"github.com/deepteams/webp/internal/dsp"
 )
@@ -121,8 +122,9 @@ type VP8Encoder struct {
 	tokens TokenBuffer
 
 	// Statistics from encoding loop.
-	nzCounts [NumMBSegments][9]int
-	stats    EncStats
+	nzCounts   [NumMBSegments][9]int
+	stats      EncStats
+	stageTimes StageTimes
 
 	// Filter parameters.
 	filterHdr FilterHeader
@@ -383,6 +385,43 @@ func ReleaseEncoder(enc *VP8Encoder) {
 	}
 }
 
+// ReuseEncoder reinitializes enc for another frame, keeping all
+// dimension-dependent buffers alive when the new image has the same
+// macroblock dimensions. When enc is nil or the dimensions differ, it
+// falls back to the pool via NewEncoder (releasing enc first).
+func ReuseEncoder(enc *VP8Encoder, img image.Image, cfg EncodeConfig) *VP8Encoder {
+	bounds := img.Bounds()
+	w := bounds.Dx()
+	h := bounds.Dy()
+	if enc != nil && enc.mbW == (w+15)>>4 && enc.mbH == (h+15)>>4 {
+		enc.resetForReuse(cfg, w, h)
+		enc.importImage(img)
+		enc.initSegments()
+		enc.initEncoderParams()
+		ResetProba(&enc.proba)
+		enc.tokens.Reset()
+		return enc
+	}
+	ReleaseEncoder(enc)
+	return NewEncoder(img, cfg)
+}
+
+// ReuseEncoderFromYUV is ReuseEncoder for pre-computed YCbCr 4:2:0 planes
+// (the SharpYUV path).
+func ReuseEncoderFromYUV(enc *VP8Encoder, yuv *image.YCbCr, width, height int, cfg EncodeConfig) *VP8Encoder {
+	if enc != nil && enc.mbW == (width+15)>>4 && enc.mbH == (height+15)>>4 {
+		enc.resetForReuse(cfg, width, height)
+		enc.importYCbCr(yuv)
+		enc.initSegments()
+		enc.initEncoderParams()
+		ResetProba(&enc.proba)
+		enc.tokens.Reset()
+		return enc
+	}
+	ReleaseEncoder(enc)
+	return NewEncoderFromYUV(yuv, width, height, cfg)
+}
+
 // resetForReuse clears mutable state so a pooled encoder can be reused.
 // The caller must have verified that mbW and mbH match.
 //
@@ -1322,6 +1361,8 @@ func (enc *VP8Encoder) setupFilterStrength() {
 // EncodeFrame is the main entry point: encodes the image and returns the
 // VP8 bitstream (without RIFF container).
 func (enc *VP8Encoder) EncodeFrame() ([]byte, error) {
+	stageStart := time.Now()
+
 	// Analysis pass: assign segments and choose global parameters.
 	enc.analysis()
 	enc.setSegmentProbas()
@@ -1334,6 +1375,8 @@ func (enc *VP8Encoder) EncodeFrame() ([]byte, error) {
 	if enc.config.Method < 3 {
 		enc.statLoop()
 	}
+	enc.stageTimes.Analysis = time.Since(stageStart)
+	stageStart = time.Now()
 
 	// Determine if we need multi-pass search (matching C libwebp's do_search).
 	doSearch := enc.config.TargetSize > 0 || enc.config.TargetPSNR > 0
@@ -1372,6 +1415,8 @@ func (enc *VP8Encoder) EncodeFrame() ([]byte, error) {
 			break
 		}
 	}
+	enc.stageTimes.Quantize = time.Since(stageStart)
+	stageStart = time.Now()
 
 	// Final probability optimization: collect statistics from the coefficient
 	// data, compute optimal probability tables, and re-record tokens.
@@ -1389,6 +1434,7 @@ func (enc *VP8Encoder) EncodeFrame() ([]byte, error) {
 	if err != nil {
 		return nil, err
 	}
+	enc.stageTimes.Entropy = time.Since(stageStart)
 	enc.computeStats(frameData)
 	return frameData, nil
 }
@@ -1549,12 +1595,14 @@ func (enc *VP8Encoder) adjustQuantForTarget() bool {
 	}
 
 	if enc.rateCtrl.doSizeSearch {
-		// Size-based convergence: emit a trial frame and measure byte size.
-		trialData, err := enc.emitFrame()
-		if err != nil {
-			return true // give up on error
-		}
-		enc.rateCtrl.value = float64(len(trialData))
+		// Size-based convergence: re-cost the recorded token stream instead
+		// of emitting a trial bitstream. Summing entropy costs is an O(tokens)
+		// table walk, whereas a trial emitFrame runs the boolean coder over
+		// every partition just to throw the bytes away. The constant accounts
+		// for the frame tag, headers and mode partition (matching C libwebp's
+		// HEADER_SIZE_ESTIMATE in its token loop).
+		const headerSizeEstimate = 15 + 20 + 10
+		enc.rateCtrl.value = float64(enc.tokens.EstimateSize() + headerSizeEstimate)
 	} else {
 		// PSNR-based convergence: compute PSNR from accumulated distortion.
 		// The pixel count is 384 per macroblock (16*16 Y + 8*8 U + 8*8 V),
@@ -1620,6 +1668,19 @@ func (enc *VP8Encoder) Stats() EncStats {
 	return enc.stats
 }
 
+// StageTimes records wall-clock time spent in the major phases of
+// EncodeFrame, for the public encoder statistics surface.
+type StageTimes struct {
+	Analysis time.Duration // segment analysis + probability seeding
+	Quantize time.Duration // mode decision, quantization, token recording
+	Entropy  time.Duration // probability optimization + bitstream emission
+}
+
+// StageTimes returns the phase timings of the most recent EncodeFrame.
+func (enc *VP8Encoder) StageTimes() StageTimes {
+	return enc.stageTimes
+}
+
 // SegmentQuant returns the quantizer value for a segment.
 func (enc *VP8Encoder) SegmentQuant(seg int) int {
 	return enc.dqm[seg].Quant
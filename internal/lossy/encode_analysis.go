@@ -37,11 +37,15 @@ func (enc *VP8Encoder) analysis() {
 
 	// Compute alpha (complexity) for each macroblock.
 	// Use pre-allocated buffer from enc.analysisAlphas.
+	// The alpha histogram is accumulated per-worker during the (parallel)
+	// pass and merged here, so assignSegments doesn't need a second serial
+	// walk over all macroblocks.
 	alphas := enc.analysisAlphas[:len(enc.mbInfo)]
 	for i := range alphas {
 		alphas[i] = 0
 	}
-	globalUVAlpha := computeAlphas(enc, alphas)
+	var histo [maxAlpha + 1]int
+	globalUVAlpha := computeAlphas(enc, alphas, &histo)
 
 	// Store global alpha and UV alpha (matching C enc->alpha, enc->uv_alpha).
 	enc.globalAlpha = 0
@@ -57,7 +61,7 @@ func (enc *VP8Encoder) analysis() {
 		enc.dqm[0].Beta = 0
 	} else {
 		// K-means clustering of alphas into segments.
-		assignSegments(enc, alphas, numSegs)
+		assignSegments(enc, &histo, numSegs)
 	}
 
 	// Unified segment parameter setup (matching C VP8SetSegmentParams).
@@ -239,18 +243,20 @@ func (enc *VP8Encoder) simplifySegments(numSegs int) int {
 // computeAlphas estimates the complexity of each macroblock using DCT-based
 // histogram analysis matching libwebp's MBAnalyzeBestIntra16Mode.
 // Higher alpha = more complex (more high-frequency energy in the residual).
-// Returns the global UV alpha average (0-255) for adaptive UV quantization.
+// Returns the global UV alpha average (0-255) for adaptive UV quantization,
+// and fills histo with the distribution of mixed alpha values (consumed by
+// assignSegments, so the clustering pass doesn't re-walk all macroblocks).
 // For segment assignment, luma and UV alphas are mixed per libwebp:
 //   mixed = (3*lumaAlpha + uvAlpha + 2) >> 2
-func computeAlphas(enc *VP8Encoder, alphas []int) int {
+func computeAlphas(enc *VP8Encoder, alphas []int, histo *[maxAlpha + 1]int) int {
 	total := enc.mbH * enc.mbW
 	if total == 0 {
 		return 0
 	}
 
 	numWorkers := runtime.GOMAXPROCS(0)
-	if numWorkers > total {
-		numWorkers = total
+	if numWorkers > enc.mbH {
+		numWorkers = enc.mbH
 	}
 	if numWorkers < 1 {
 		numWorkers = 1
@@ -258,31 +264,30 @@ func computeAlphas(enc *VP8Encoder, alphas []int) int {
 
 	// Single-threaded fast path.
 	if numWorkers == 1 {
-		return computeAlphasSerial(enc, alphas)
+		return computeAlphasSerial(enc, alphas, histo)
 	}
 
-	// Parallel: each worker processes a range of MB rows.
+	// Parallel: workers claim MB rows dynamically via an atomic counter so a
+	// few expensive rows can't leave the static-partition stragglers idle.
+	// Each worker accumulates a private alpha histogram and UV sum; both are
+	// merged once after the pass.
 	var uvAlphaSum int64
+	var nextRow int32
+	var histoMu sync.Mutex
 	var wg sync.WaitGroup
 
-	// Distribute rows across workers.
-	rowsPerWorker := (enc.mbH + numWorkers - 1) / numWorkers
-
 	for wi := 0; wi < numWorkers; wi++ {
-		startY := wi * rowsPerWorker
-		endY := startY + rowsPerWorker
-		if endY > enc.mbH {
-			endY = enc.mbH
-		}
-		if startY >= endY {
-			break
-		}
 		wg.Add(1)
-		go func(startY, endY int) {
+		go func() {
 			defer wg.Done()
 			var w analysisWorker
+			var localHisto [maxAlpha + 1]int
 			localUVSum := 0
-			for mbY := startY; mbY < endY; mbY++ {
+			for {
+				mbY := int(atomic.AddInt32(&nextRow, 1)) - 1
+				if mbY >= enc.mbH {
+					break
+				}
 				for mbX := 0; mbX < enc.mbW; mbX++ {
 					idx := mbY*enc.mbW + mbX
 					lumaAlpha := computeMBAlphaDCTWorker(enc, &w, mbX, mbY)
@@ -297,11 +302,19 @@ func computeAlphas(enc *VP8Encoder, alphas []int) int {
 					}
 					alphas[idx] = mixed
 					enc.mbInfo[idx].Alpha = mixed
+					localHisto[mixed]++
 					localUVSum += uvAlpha
 				}
 			}
 			atomic.AddInt64(&uvAlphaSum, int64(localUVSum))
-		}(startY, endY)
+			histoMu.Lock()
+			for a, n := range localHisto {
+				if n != 0 {
+					histo[a] += n
+				}
+			}
+			histoMu.Unlock()
+		}()
 	}
 	wg.Wait()
 
@@ -309,7 +322,7 @@ func computeAlphas(enc *VP8Encoder, alphas []int) int {
 }
 
 // computeAlphasSerial is the single-threaded path for small images.
-func computeAlphasSerial(enc *VP8Encoder, alphas []int) int {
+func computeAlphasSerial(enc *VP8Encoder, alphas []int, histo *[maxAlpha + 1]int) int {
 	src := enc.tmpAnSrc[:]
 	pred := enc.tmpAnPred[:]
 
@@ -331,6 +344,7 @@ func computeAlphasSerial(enc *VP8Encoder, alphas []int) int {
 			}
 			alphas[idx] = mixed
 			enc.mbInfo[idx].Alpha = mixed
+			histo[mixed]++
 			uvAlphaSum += uvAlpha
 		}
 	}
@@ -734,18 +748,12 @@ const maxItersKMeans = 6
 // histogram-based k-means, matching C libwebp's AssignSegments (analysis_enc.c:135-222).
 // The key difference from per-MB k-means is iterating on histogram bins rather
 // than individual MBs, which is both faster and matches the C behavior exactly.
-func assignSegments(enc *VP8Encoder, alphas []int, numSegs int) {
-	total := len(alphas)
-	if total == 0 {
+// histo is the per-alpha-value MB count accumulated during computeAlphas.
+func assignSegments(enc *VP8Encoder, histo *[maxAlpha + 1]int, numSegs int) {
+	if enc.mbW*enc.mbH == 0 {
 		return
 	}
 
-	// Build histogram: histo[a] = count of MBs with alpha value a.
-	var histo [maxAlpha + 1]int
-	for _, a := range alphas {
-		histo[a]++
-	}
-
 	// Bracket the input: find min and max alpha values with non-zero counts.
 	minA := 0
 	for minA <= maxAlpha && histo[minA] == 0 {
@@ -0,0 +1,159 @@
+package lossy
+
+import (
+	"github.com/deepteams/webp/internal/dsp"
+)
+
+// NewEncoderForRows creates a VP8 encoder whose source planes are filled
+// incrementally with ImportRowPair, for push-style callers that produce
+// scanlines top-to-bottom and cannot hold a full frame. The encoder is
+// fully initialized (segments, probabilities, token buffer); the caller
+// must import every source row pair and then call FinishImport before
+// EncodeFrame.
+func NewEncoderForRows(width, height int, cfg EncodeConfig) *VP8Encoder {
+	mbW := (width + 15) >> 4
+	mbH := (height + 15) >> 4
+
+	// Try to reuse a pooled encoder with matching dimensions.
+	if v := encoderPool.Get(); v != nil {
+		enc := v.(*VP8Encoder)
+		if enc.mbW == mbW && enc.mbH == mbH {
+			enc.resetForReuse(cfg, width, height)
+			enc.initSegments()
+			enc.initEncoderParams()
+			ResetProba(&enc.proba)
+			enc.tokens.Reset()
+			dsp.InitGammaTables()
+			return enc
+		}
+	}
+
+	enc := &VP8Encoder{
+		config: cfg,
+		width:  width,
+		height: height,
+		mbW:    mbW,
+		mbH:    mbH,
+	}
+
+	enc.numParts = 1 << uint(cfg.Partitions)
+	if enc.numParts > MaxNumPartitions {
+		enc.numParts = MaxNumPartitions
+	}
+
+	enc.allocateBuffers()
+	enc.initSegments()
+	enc.initEncoderParams()
+	ResetProba(&enc.proba)
+	enc.tokens.Init(enc.mbW * enc.mbH)
+	dsp.InitGammaTables()
+
+	return enc
+}
+
+// ImportRowPair converts two consecutive NRGBA scanlines (rows 2*pairY and
+// 2*pairY+1) into the encoder's Y/U/V planes, replicating the right edge
+// out to the macroblock boundary. row1 may be nil for the final pair of an
+// odd-height image, in which case row0 is replicated, matching
+// importImage's bottom-edge handling. Each row holds width*4 bytes in
+// R,G,B,A order.
+//
+// The conversion always feeds the real alpha values into the gamma-correct
+// chroma averaging; for opaque rows this is identical to importImage's
+// opaque fast path, and for translucent rows it applies the same
+// alpha-weighted averaging that prevents color bleeding at transparency
+// edges.
+func (enc *VP8Encoder) ImportRowPair(pairY int, row0, row1 []byte) {
+	w := enc.width
+	padW := enc.mbW * 16
+	uvWidth := (padW + 1) >> 1
+
+	rowR := enc.serialRowR
+	rowG := enc.serialRowG
+	rowB := enc.serialRowB
+	rowA := enc.serialRowA
+	rows := [2][]byte{row0, row1}
+	if row1 == nil {
+		rows[1] = row0
+	}
+
+	for i := 0; i < 2; i++ {
+		src := rows[i]
+		for x := 0; x < w; x++ {
+			off := x * 4
+			rowR[i][x] = src[off]
+			rowG[i][x] = src[off+1]
+			rowB[i][x] = src[off+2]
+			rowA[i][x] = src[off+3]
+		}
+		for x := w; x < padW; x++ {
+			rowR[i][x] = rowR[i][w-1]
+			rowG[i][x] = rowG[i][w-1]
+			rowB[i][x] = rowB[i][w-1]
+			rowA[i][x] = rowA[i][w-1]
+		}
+
+		dstBase := (pairY*2 + i) * enc.yStride
+		for x := 0; x < padW; x++ {
+			enc.yPlane[dstBase+x] = dsp.RGBToY(int(rowR[i][x]), int(rowG[i][x]), int(rowB[i][x]))
+		}
+	}
+
+	planarR := enc.serialPlanarR[:padW*2]
+	planarG := enc.serialPlanarG[:padW*2]
+	planarB := enc.serialPlanarB[:padW*2]
+	planarA := enc.serialPlanarA[:padW*2]
+	copy(planarR[:padW], rowR[0])
+	copy(planarR[padW:], rowR[1])
+	copy(planarG[:padW], rowG[0])
+	copy(planarG[padW:], rowG[1])
+	copy(planarB[:padW], rowB[0])
+	copy(planarB[padW:], rowB[1])
+	copy(planarA[:padW], rowA[0])
+	copy(planarA[padW:], rowA[1])
+	dsp.AccumulateRGBA(planarR, planarG, planarB, planarA, padW, enc.serialTmpRGB, padW)
+	dsp.ConvertRGBA32ToUV(enc.serialTmpRGB, enc.uPlane[pairY*enc.uvStride:], enc.vPlane[pairY*enc.uvStride:], uvWidth)
+}
+
+// FinishImport pads the Y/U/V planes below the last imported source row by
+// replicating the bottom edge out to the macroblock boundary. Must be
+// called after the final ImportRowPair and before EncodeFrame.
+func (enc *VP8Encoder) FinishImport() {
+	h := enc.height
+	padW := enc.mbW * 16
+	padH := enc.mbH * 16
+
+	// The last imported pair wrote Y rows up to 2*ceil(h/2)-1.
+	yFilled := (h + 1) &^ 1
+	for y := yFilled; y < padH; y++ {
+		copy(enc.yPlane[y*enc.yStride:y*enc.yStride+padW], enc.yPlane[(yFilled-1)*enc.yStride:])
+	}
+
+	padUVW := (padW + 1) >> 1
+	padUVH := (padH + 1) >> 1
+	uvFilled := (h + 1) >> 1
+	if uvFilled < padUVH {
+		// importImage derives padding chroma rows from the replicated last
+		// source row, not from the last real row pair, so recompute one
+		// padding row from the bottom scanline still held in the serial
+		// row buffers (ImportRowPair always leaves it in index 1).
+		planarR := enc.serialPlanarR[:padW*2]
+		planarG := enc.serialPlanarG[:padW*2]
+		planarB := enc.serialPlanarB[:padW*2]
+		planarA := enc.serialPlanarA[:padW*2]
+		copy(planarR[:padW], enc.serialRowR[1])
+		copy(planarR[padW:], enc.serialRowR[1])
+		copy(planarG[:padW], enc.serialRowG[1])
+		copy(planarG[padW:], enc.serialRowG[1])
+		copy(planarB[:padW], enc.serialRowB[1])
+		copy(planarB[padW:], enc.serialRowB[1])
+		copy(planarA[:padW], enc.serialRowA[1])
+		copy(planarA[padW:], enc.serialRowA[1])
+		dsp.AccumulateRGBA(planarR, planarG, planarB, planarA, padW, enc.serialTmpRGB, padW)
+		dsp.ConvertRGBA32ToUV(enc.serialTmpRGB, enc.uPlane[uvFilled*enc.uvStride:], enc.vPlane[uvFilled*enc.uvStride:], padUVW)
+		for y := uvFilled + 1; y < padUVH; y++ {
+			copy(enc.uPlane[y*enc.uvStride:y*enc.uvStride+padUVW], enc.uPlane[uvFilled*enc.uvStride:])
+			copy(enc.vPlane[y*enc.uvStride:y*enc.uvStride+padUVW], enc.vPlane[uvFilled*enc.uvStride:])
+		}
+	}
+}
@@ -2,6 +2,7 @@ package lossy
 
 import (
 	"encoding/binary"
+	"runtime"
 	"sync"
 
 	"github.com/deepteams/webp/internal/bitio"
@@ -101,15 +102,42 @@ func (enc *VP8Encoder) emitPartition0() []byte {
 	return result
 }
 
-// emitTokenPartitions writes the token data partitions.
+// emitTokenPartitions writes the token data partitions. With multiple
+// partitions each one has its own arithmetic writer and reads a disjoint
+// set of macroblock rows from the shared token buffer, so they are
+// emitted concurrently when more than one CPU is available.
 func (enc *VP8Encoder) emitTokenPartitions() [][]byte {
 	parts := make([][]byte, enc.numParts)
-	for i := 0; i < enc.numParts; i++ {
+
+	emitPart := func(i int) {
 		bw := getBoolWriter(enc.mbW * enc.mbH * 32 / enc.numParts)
 		enc.tokens.EmitTokensPartitioned(bw, i, enc.numParts, enc.mbW)
 		parts[i] = append([]byte(nil), bw.Finish()...)
 		putBoolWriter(bw)
 	}
+
+	if enc.numParts > 1 {
+		// Record the end-of-tokens sentinel once before any writer starts;
+		// the per-partition emission is read-only after that.
+		enc.tokens.FinishTokenIndex()
+	}
+
+	if enc.numParts == 1 || runtime.GOMAXPROCS(0) == 1 {
+		for i := 0; i < enc.numParts; i++ {
+			emitPart(i)
+		}
+		return parts
+	}
+
+	var wg sync.WaitGroup
+	wg.Add(enc.numParts)
+	for i := 0; i < enc.numParts; i++ {
+		go func(i int) {
+			defer wg.Done()
+			emitPart(i)
+		}(i)
+	}
+	wg.Wait()
 	return parts
 }
 
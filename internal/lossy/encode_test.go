@@ -1,9 +1,11 @@
 package lossy
 
 import (
+	"bytes"
 	"image"
 	"image/color"
 	"math/rand"
+	"runtime"
 	"testing"
 )
 
@@ -811,6 +813,83 @@ func TestInitPassStats_TargetSizePrecedence(t *testing.T) {
 	}
 }
 
+func TestTokenPartitionsParallelEmissionMatchesSerial(t *testing.T) {
+	// Concurrent per-partition writers must produce the same partitions as
+	// the serial loop; they read disjoint MB rows from the same buffer.
+	img := gradientImage(160, 128)
+	cfg := DefaultConfig(75)
+	cfg.Method = 4
+	cfg.Partitions = 3 // 8 partitions
+	enc := NewEncoder(img, cfg)
+	if _, err := enc.EncodeFrame(); err != nil {
+		t.Fatalf("EncodeFrame: %v", err)
+	}
+	defer ReleaseEncoder(enc)
+
+	prev := runtime.GOMAXPROCS(1)
+	serial := enc.emitTokenPartitions()
+	runtime.GOMAXPROCS(4)
+	parallel := enc.emitTokenPartitions()
+	runtime.GOMAXPROCS(prev)
+
+	if len(serial) != len(parallel) {
+		t.Fatalf("partition count: serial %d, parallel %d", len(serial), len(parallel))
+	}
+	for i := range serial {
+		if !bytes.Equal(serial[i], parallel[i]) {
+			t.Errorf("partition %d differs: serial %d bytes, parallel %d bytes",
+				i, len(serial[i]), len(parallel[i]))
+		}
+	}
+}
+
+func TestTokenBufferEstimateSize(t *testing.T) {
+	// The entropy-cost estimate used by the TargetSize search should stay
+	// close to the real token partition size produced by the boolean coder.
+	img := gradientImage(64, 64)
+	cfg := DefaultConfig(75)
+	cfg.Method = 4
+
+	enc := NewEncoder(img, cfg)
+	if _, err := enc.EncodeFrame(); err != nil {
+		t.Fatalf("EncodeFrame failed: %v", err)
+	}
+	est := enc.tokens.EstimateSize()
+	actual := enc.stats.Residuals
+	if actual == 0 {
+		t.Fatal("no token partition bytes recorded")
+	}
+	diff := est - actual
+	if diff < 0 {
+		diff = -diff
+	}
+	// Allow 5% + a few bytes of slack for coder carry/flush overhead.
+	if diff > actual/20+8 {
+		t.Errorf("EstimateSize = %d, actual token partition = %d bytes", est, actual)
+	}
+}
+
+func TestEncodeFrameWithTargetSize(t *testing.T) {
+	// The size search should land in the neighborhood of the byte target.
+	img := gradientImage(96, 96)
+	cfg := DefaultConfig(75)
+	cfg.TargetSize = 1200
+
+	enc := NewEncoder(img, cfg)
+	bs, err := enc.EncodeFrame()
+	if err != nil {
+		t.Fatalf("EncodeFrame with TargetSize failed: %v", err)
+	}
+	if len(bs) == 0 {
+		t.Fatal("EncodeFrame with TargetSize produced empty bitstream")
+	}
+	// Rate control is approximate (and bounded by qmin/qmax), so only
+	// reject wild misses.
+	if len(bs) > 2*cfg.TargetSize {
+		t.Errorf("coded size %d is more than twice the %d-byte target", len(bs), cfg.TargetSize)
+	}
+}
+
 func TestEncodeFrameWithTargetPSNR(t *testing.T) {
 	// Verify that a full encode succeeds with TargetPSNR enabled.
 	img := gradientImage(32, 32)
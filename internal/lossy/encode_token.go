@@ -4,6 +4,7 @@ import (
 	"unsafe"
 
 	"github.com/deepteams/webp/internal/bitio"
+	"github.com/deepteams/webp/internal/dsp"
 )
 
 // tokenPageSize is the number of tokens per page in the TokenBuffer.
@@ -299,6 +300,27 @@ func (tb *TokenBuffer) recordLevelVP8(level int, p []uint8) int {
 	return count
 }
 
+// EstimateSize returns the estimated coded size of the token stream in
+// bytes, computed by summing the entropy cost of each recorded bit at its
+// recorded probability (matching C libwebp's VP8EstimateTokenSize). This is
+// much cheaper than a trial emission through the boolean coder and is
+// typically within a percent of the real partition size.
+func (tb *TokenBuffer) EstimateSize() int {
+	cost := 0
+	for _, page := range tb.pages {
+		for i := 0; i < page.count; i++ {
+			tok := page.tokens[i]
+			p := tok.Prob
+			if tok.Bit != 0 {
+				p = 255 - p
+			}
+			cost += int(dsp.VP8EntropyCost[p])
+		}
+	}
+	// Costs are in 1/256-bit units: >> 8 for bits, >> 3 for bytes.
+	return (cost + 1024) >> 11
+}
+
 // EmitTokens writes all recorded tokens to a boolean writer.
 // Uses batch encoding to keep BoolWriter hot state in registers.
 func (tb *TokenBuffer) EmitTokens(bw *bitio.BoolWriter) {
@@ -314,9 +336,19 @@ func (tb *TokenBuffer) EmitTokens(bw *bitio.BoolWriter) {
 	}
 }
 
+// FinishTokenIndex records the end-of-tokens sentinel so the per-MB token
+// index covers the last macroblock. Must be called after recording ends
+// and before EmitTokensPartitioned; concurrent partition writers then
+// only read the buffer.
+func (tb *TokenBuffer) FinishTokenIndex() {
+	tb.mbStart[tb.totalMB] = tb.tokenCount()
+}
+
 // EmitTokensPartitioned writes tokens partitioned by macroblock row for
 // multi-partition output. partIdx selects which partition (0..numParts-1),
-// numParts is the total number of partitions.
+// numParts is the total number of partitions. The caller must have called
+// FinishTokenIndex; emission itself is read-only, so different partitions
+// may be written concurrently.
 // Each MB row is assigned to partition (mbY & (numParts-1)), matching libwebp's
 // VP8IteratorSetRow which uses: bw = &enc->parts[y & (enc->num_parts - 1)].
 func (tb *TokenBuffer) EmitTokensPartitioned(bw *bitio.BoolWriter, partIdx, numParts, mbW int) {
@@ -327,8 +359,6 @@ func (tb *TokenBuffer) EmitTokensPartitioned(bw *bitio.BoolWriter, partIdx, numP
 	}
 
 	totalMB := tb.totalMB
-	// Mark the end sentinel so we know the range of the last MB.
-	tb.mbStart[totalMB] = tb.tokenCount()
 
 	for mbIdx := 0; mbIdx < totalMB; mbIdx++ {
 		mbY := mbIdx / mbW
@@ -33,62 +33,24 @@ func TrellisQuantizeBlock(
 	_ = in[15]
 	_ = out[15]
 
+	// Batched candidate-level computation: neutral-bias levels (L0) and
+	// high-bias levels (threshLevel) for all 16 coefficients in one pass.
+	// SIMD on amd64 (same kernels as QuantizeCoeffs), scalar elsewhere.
+	// Values carry the sign of the input coefficient.
+	var l0Buf, threshBuf [16]int16
+	trellisCandidateLevels(in, &l0Buf, &threshBuf, sq, firstCoeff)
+
 	// Quick pre-scan: if neutral-bias quantization gives all-zero levels for
 	// every coefficient, the trellis result is trivially all-zero. This avoids
 	// the expensive main loop for flat/near-zero blocks (~30-50% of blocks).
 	{
 		nonZero := false
-		n := firstCoeff
-
-		// Handle DC coefficient separately (uses DCIQuant).
-		if n == 0 {
-			raw := int(in[KZigzag[0]])
-			if raw < 0 {
-				raw = -raw
-			}
-			coeff0 := raw + int(sq.Sharpen[KZigzag[0]])
-			if coeff0 < 0 {
-				coeff0 = 0
-			}
-			nonZero = coeff0*sq.DCIQuant>>17 > 0
-			n = 1
-		}
-
-		// AC coefficients (all use IQuant). Unrolled by 4.
-		iquant := sq.IQuant
-		for !nonZero && n+3 < 16 {
-			var maxCoeff int
-			for k := 0; k < 4; k++ {
-				raw := int(in[KZigzag[n+k]])
-				if raw < 0 {
-					raw = -raw
-				}
-				c := raw + int(sq.Sharpen[KZigzag[n+k]])
-				if c > maxCoeff {
-					maxCoeff = c
-				}
-			}
-			if maxCoeff > 0 && maxCoeff*iquant>>17 > 0 {
-				nonZero = true
-			}
-			n += 4
-		}
-		// Remainder.
-		for !nonZero && n < 16 {
-			raw := int(in[KZigzag[n]])
-			if raw < 0 {
-				raw = -raw
-			}
-			coeff0 := raw + int(sq.Sharpen[KZigzag[n]])
-			if coeff0 < 0 {
-				coeff0 = 0
-			}
-			if coeff0*iquant>>17 > 0 {
+		for n := firstCoeff; n < 16; n++ {
+			if l0Buf[KZigzag[n]] != 0 {
 				nonZero = true
+				break
 			}
-			n++
 		}
-
 		if !nonZero {
 			for i := range out[:16] {
 				out[i] = 0
@@ -137,9 +99,8 @@ func TrellisQuantizeBlock(
 	bestLastN := -1
 	bestLastCtx := -1
 
-	// Pre-extract AC quant/iquant (DC only used for n==0).
+	// Pre-extract AC quant (DC only used for n==0).
 	acQuant := sq.Quant
-	acIQuant := sq.IQuant
 	lambdaI64 := int64(lambda)
 	bands := &proba.Bands[ctxType]
 
@@ -163,21 +124,19 @@ func TrellisQuantizeBlock(
 		}
 
 		quant := acQuant
-		iquant := acIQuant
 		if n == 0 {
 			quant = sq.DCQuant
-			iquant = sq.DCIQuant
 		}
 
-		// Neutral bias quantization (level0).
-		L0 := coeff0 * iquant >> 17
-		if L0 > 2047 {
-			L0 = 2047
+		// Candidate levels from the batched pre-pass:
+		// neutral bias (level0) and high bias (thresh_level).
+		L0 := int(l0Buf[zigIdx])
+		if L0 < 0 {
+			L0 = -L0
 		}
-		// High bias quantization (thresh_level).
-		threshLevel := int(uint32(coeff0)*uint32(iquant)+65536) >> 17
-		if threshLevel > 2047 {
-			threshLevel = 2047
+		threshLevel := int(threshBuf[zigIdx])
+		if threshLevel < 0 {
+			threshLevel = -threshLevel
 		}
 
 		weight := int64(kWeightTrellis[zigIdx])
@@ -323,6 +282,64 @@ func TrellisQuantizeBlock(
 	return last
 }
 
+// trellisCandidateLevelsGo is the pure-Go reference implementation of
+// trellisCandidateLevels: for all 16 coefficients (raster order) it computes
+// the neutral-bias level into l0 and the high-bias (+65536) level into thresh,
+// with the sign of the input applied and magnitudes clamped to 2047.
+// DC (position 0) uses DCIQuant when firstCoeff == 0, otherwise it is zeroed.
+func trellisCandidateLevelsGo(in []int16, l0, thresh *[16]int16, sq *SegmentQuant, firstCoeff int) {
+	_ = in[15]
+	if firstCoeff == 0 {
+		v := int(in[0])
+		sign := 1
+		if v < 0 {
+			sign = -1
+			v = -v
+		}
+		v += int(sq.Sharpen[0])
+		if v < 0 {
+			v = 0
+		}
+		lv := v * sq.DCIQuant >> 17
+		if lv > 2047 {
+			lv = 2047
+		}
+		tv := int(uint32(v)*uint32(sq.DCIQuant)+65536) >> 17
+		if tv > 2047 {
+			tv = 2047
+		}
+		l0[0] = int16(sign * lv)
+		thresh[0] = int16(sign * tv)
+	} else {
+		l0[0] = 0
+		thresh[0] = 0
+	}
+
+	iq := sq.IQuant
+	for n := 1; n < 16; n++ {
+		v := int(in[n])
+		sign := 1
+		if v < 0 {
+			sign = -1
+			v = -v
+		}
+		v += int(sq.Sharpen[n])
+		if v < 0 {
+			v = 0
+		}
+		lv := v * iq >> 17
+		if lv > 2047 {
+			lv = 2047
+		}
+		tv := int(uint32(v)*uint32(iq)+65536) >> 17
+		if tv > 2047 {
+			tv = 2047
+		}
+		l0[n] = int16(sign * lv)
+		thresh[n] = int16(sign * tv)
+	}
+}
+
 // fastVariableLevelCost computes the probability-dependent part of the level cost
 // with specialized fast paths for common levels (1-4), avoiding the general loop.
 func fastVariableLevelCost(level int, probas *[NumProbas]uint8, ecost *[256]uint16) int {
@@ -0,0 +1,46 @@
+//go:build amd64
+
+package lossy
+
+import "github.com/deepteams/webp/internal/dsp"
+
+// trellisCandidateLevels computes both trellis candidate levels (neutral bias
+// and high bias) for all 16 coefficients using the SSE2/AVX2 AC quantization
+// kernels — one pass per bias. The DC position uses AC parameters in the SIMD
+// pass and is fixed up with scalar code, matching QuantizeCoeffs.
+func trellisCandidateLevels(in []int16, l0, thresh *[16]int16, sq *SegmentQuant, firstCoeff int) {
+	if dsp.HasAVX2() {
+		quantizeACAVX2(in, l0[:], sq.Sharpen[:], sq.IQuant, 0)
+		quantizeACAVX2(in, thresh[:], sq.Sharpen[:], sq.IQuant, 65536)
+	} else {
+		quantizeACSSE2(in, l0[:], sq.Sharpen[:], sq.IQuant, 0)
+		quantizeACSSE2(in, thresh[:], sq.Sharpen[:], sq.IQuant, 65536)
+	}
+
+	// Fix DC (position 0): the kernels applied AC parameters to it.
+	if firstCoeff == 0 {
+		v := int(in[0])
+		sign := 1
+		if v < 0 {
+			sign = -1
+			v = -v
+		}
+		v += int(sq.Sharpen[0])
+		if v < 0 {
+			v = 0
+		}
+		lv := v * sq.DCIQuant >> 17
+		if lv > 2047 {
+			lv = 2047
+		}
+		tv := int(uint32(v)*uint32(sq.DCIQuant)+65536) >> 17
+		if tv > 2047 {
+			tv = 2047
+		}
+		l0[0] = int16(sign * lv)
+		thresh[0] = int16(sign * tv)
+	} else {
+		l0[0] = 0
+		thresh[0] = 0
+	}
+}
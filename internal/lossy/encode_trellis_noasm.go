@@ -0,0 +1,10 @@
+//go:build !amd64
+
+package lossy
+
+// trellisCandidateLevels computes both trellis candidate levels (neutral bias
+// and high bias) for all 16 coefficients. Uses the pure Go reference
+// implementation.
+func trellisCandidateLevels(in []int16, l0, thresh *[16]int16, sq *SegmentQuant, firstCoeff int) {
+	trellisCandidateLevelsGo(in, l0, thresh, sq, firstCoeff)
+}
@@ -5,6 +5,14 @@ type BandProbas struct {
 	Probas [NumCTX][NumProbas]uint8
 }
 
+// CoeffProbas holds one coefficient type's probabilities indexed directly by
+// coefficient position [0..16]. The KBands position-to-band mapping is
+// pre-applied when the table is built, so the coefficient decode loop
+// advances through positions with plain array arithmetic instead of a
+// pointer chase per band change, and the whole table for one type (561
+// bytes) stays within a handful of cache lines.
+type CoeffProbas [16 + 1][NumCTX][NumProbas]uint8
+
 // Proba collects all frame-persistent probabilities for VP8 decoding.
 type Proba struct {
 	// Segments holds the segment tree probabilities (3 values).
@@ -17,6 +25,20 @@ type Proba struct {
 	// BandsPtr maps coefficient position to the corresponding BandProbas.
 	// Used for fast lookup during coefficient decoding.
 	BandsPtr [NumTypes][16 + 1]*BandProbas
+
+	// Coeffs holds position-indexed copies of Bands for the hot coefficient
+	// decode loop. Rebuilt (buildCoeffTables) whenever the per-frame
+	// probabilities change.
+	Coeffs [NumTypes]CoeffProbas
+}
+
+// buildCoeffTables regenerates the position-indexed coefficient tables for
+// one type from the band probabilities. Called at header-parse time, after
+// any per-frame probability updates have been applied.
+func (p *Proba) buildCoeffTables(t int) {
+	for b := 0; b < 16+1; b++ {
+		p.Coeffs[t][b] = p.Bands[t][KBands[b]].Probas
+	}
 }
 
 // ResetProba initializes segment probabilities to default (255) and sets up
@@ -37,6 +59,7 @@ func ResetProba(p *Proba) {
 		for b := 0; b < 16+1; b++ {
 			p.BandsPtr[t][b] = &p.Bands[t][KBands[b]]
 		}
+		p.buildCoeffTables(t)
 	}
 }
 
@@ -0,0 +1,203 @@
+package pool
+
+// Arena is a bump allocator scoped to a single encode or decode operation.
+// All scratch allocations made through it come from a few large chunks;
+// individual allocations are pointer bumps, and the whole arena is recycled
+// at once with Reset (keeping the chunks for the next operation) or Release
+// (returning byte chunks to the global bucketed pools).
+//
+// The intended pattern is an Arena embedded in a retained encoder/decoder
+// struct: Reset at the top of each operation, bump-allocate all scratch, and
+// let the chunks carry over to the next operation. Allocations are zeroed,
+// like make. An Arena must not be used from multiple goroutines without
+// external synchronization, and slices obtained from it are invalid after
+// the next Reset or Release.
+type Arena struct {
+	byteChunks [][]byte
+	byteIdx    int
+	byteOff    int
+
+	u32Chunks [][]uint32
+	u32Idx    int
+	u32Off    int
+
+	i32Chunks [][]int32
+	i32Idx    int
+	i32Off    int
+
+	i16Chunks [][]int16
+	i16Idx    int
+	i16Off    int
+}
+
+// arenaMinChunk is the minimum chunk size in elements. Chunks double up to
+// arenaMaxChunk as the arena grows, so a handful of chunks covers any
+// operation while small operations stay small.
+const (
+	arenaMinChunk = 16 * 1024
+	arenaMaxChunk = 1024 * 1024
+)
+
+// arenaChunkSize picks the size for a new chunk: at least n, at least the
+// minimum, and growing geometrically from the previous chunk's size.
+func arenaChunkSize(n, prev int) int {
+	size := arenaMinChunk
+	if prev*2 > size {
+		size = prev * 2
+	}
+	if size > arenaMaxChunk {
+		size = arenaMaxChunk
+	}
+	if n > size {
+		size = n
+	}
+	return size
+}
+
+// Bytes returns a zeroed byte slice of the given length.
+func (a *Arena) Bytes(n int) []byte {
+	for a.byteIdx < len(a.byteChunks) {
+		c := a.byteChunks[a.byteIdx]
+		if a.byteOff+n <= len(c) {
+			s := c[a.byteOff : a.byteOff+n : a.byteOff+n]
+			a.byteOff += n
+			clearBytes(s)
+			return s
+		}
+		a.byteIdx++
+		a.byteOff = 0
+	}
+	prev := 0
+	if len(a.byteChunks) > 0 {
+		prev = len(a.byteChunks[len(a.byteChunks)-1])
+	}
+	c := Get(arenaChunkSize(n, prev))
+	a.byteChunks = append(a.byteChunks, c)
+	a.byteIdx = len(a.byteChunks) - 1
+	a.byteOff = n
+	s := c[0:n:n]
+	clearBytes(s)
+	return s
+}
+
+// Uint32 returns a zeroed uint32 slice of the given length.
+func (a *Arena) Uint32(n int) []uint32 {
+	for a.u32Idx < len(a.u32Chunks) {
+		c := a.u32Chunks[a.u32Idx]
+		if a.u32Off+n <= len(c) {
+			s := c[a.u32Off : a.u32Off+n : a.u32Off+n]
+			a.u32Off += n
+			clearUint32(s)
+			return s
+		}
+		a.u32Idx++
+		a.u32Off = 0
+	}
+	prev := 0
+	if len(a.u32Chunks) > 0 {
+		prev = len(a.u32Chunks[len(a.u32Chunks)-1])
+	}
+	c := make([]uint32, arenaChunkSize(n, prev))
+	a.u32Chunks = append(a.u32Chunks, c)
+	a.u32Idx = len(a.u32Chunks) - 1
+	a.u32Off = n
+	return c[0:n:n]
+}
+
+// Int32 returns a zeroed int32 slice of the given length.
+func (a *Arena) Int32(n int) []int32 {
+	for a.i32Idx < len(a.i32Chunks) {
+		c := a.i32Chunks[a.i32Idx]
+		if a.i32Off+n <= len(c) {
+			s := c[a.i32Off : a.i32Off+n : a.i32Off+n]
+			a.i32Off += n
+			clearInt32(s)
+			return s
+		}
+		a.i32Idx++
+		a.i32Off = 0
+	}
+	prev := 0
+	if len(a.i32Chunks) > 0 {
+		prev = len(a.i32Chunks[len(a.i32Chunks)-1])
+	}
+	c := make([]int32, arenaChunkSize(n, prev))
+	a.i32Chunks = append(a.i32Chunks, c)
+	a.i32Idx = len(a.i32Chunks) - 1
+	a.i32Off = n
+	return c[0:n:n]
+}
+
+// Int16 returns a zeroed int16 slice of the given length.
+func (a *Arena) Int16(n int) []int16 {
+	for a.i16Idx < len(a.i16Chunks) {
+		c := a.i16Chunks[a.i16Idx]
+		if a.i16Off+n <= len(c) {
+			s := c[a.i16Off : a.i16Off+n : a.i16Off+n]
+			a.i16Off += n
+			clearInt16(s)
+			return s
+		}
+		a.i16Idx++
+		a.i16Off = 0
+	}
+	prev := 0
+	if len(a.i16Chunks) > 0 {
+		prev = len(a.i16Chunks[len(a.i16Chunks)-1])
+	}
+	c := make([]int16, arenaChunkSize(n, prev))
+	a.i16Chunks = append(a.i16Chunks, c)
+	a.i16Idx = len(a.i16Chunks) - 1
+	a.i16Off = n
+	return c[0:n:n]
+}
+
+// Reset rewinds the arena for the next operation. Chunks are kept, so a
+// retained arena reaches a steady state with zero allocations per operation.
+// All slices previously returned by the arena become invalid.
+func (a *Arena) Reset() {
+	a.byteIdx, a.byteOff = 0, 0
+	a.u32Idx, a.u32Off = 0, 0
+	a.i32Idx, a.i32Off = 0, 0
+	a.i16Idx, a.i16Off = 0, 0
+}
+
+// Release drops all chunks, returning byte chunks to the global bucketed
+// pools. Use it when the owning encoder/decoder is done for good; prefer
+// Reset between operations.
+func (a *Arena) Release() {
+	for _, c := range a.byteChunks {
+		Put(c)
+	}
+	a.byteChunks = nil
+	a.u32Chunks = nil
+	a.i32Chunks = nil
+	a.i16Chunks = nil
+	a.Reset()
+}
+
+// clearBytes and friends zero a slice; the compiler lowers each loop to
+// memclr.
+func clearBytes(s []byte) {
+	for i := range s {
+		s[i] = 0
+	}
+}
+
+func clearUint32(s []uint32) {
+	for i := range s {
+		s[i] = 0
+	}
+}
+
+func clearInt32(s []int32) {
+	for i := range s {
+		s[i] = 0
+	}
+}
+
+func clearInt16(s []int16) {
+	for i := range s {
+		s[i] = 0
+	}
+}
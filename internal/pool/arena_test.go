@@ -0,0 +1,121 @@
+package pool
+
+import "testing"
+
+func TestArenaZeroed(t *testing.T) {
+	var a Arena
+	b := a.Bytes(100)
+	u := a.Uint32(50)
+	for i := range b {
+		b[i] = 0xAB
+	}
+	for i := range u {
+		u[i] = 0xDEADBEEF
+	}
+	// After Reset the same memory is handed out again and must be zeroed.
+	a.Reset()
+	b2 := a.Bytes(100)
+	u2 := a.Uint32(50)
+	for i, v := range b2 {
+		if v != 0 {
+			t.Fatalf("Bytes after Reset: b2[%d] = %#x, want 0", i, v)
+		}
+	}
+	for i, v := range u2 {
+		if v != 0 {
+			t.Fatalf("Uint32 after Reset: u2[%d] = %#x, want 0", i, v)
+		}
+	}
+}
+
+func TestArenaDisjoint(t *testing.T) {
+	var a Arena
+	x := a.Uint32(10)
+	y := a.Uint32(10)
+	x[9] = 1
+	if y[0] != 0 {
+		t.Error("consecutive allocations overlap")
+	}
+	// Full-capacity sub-slicing must prevent append from spilling into the
+	// next allocation.
+	x = append(x, 7)
+	if y[0] != 0 {
+		t.Error("append to one allocation clobbered the next")
+	}
+}
+
+func TestArenaReuseSteadyState(t *testing.T) {
+	var a Arena
+	// Warm up with a representative workload.
+	for i := 0; i < 3; i++ {
+		a.Reset()
+		a.Bytes(1000)
+		a.Uint32(4096)
+		a.Int16(512)
+		a.Int32(256)
+	}
+	chunks := len(a.byteChunks) + len(a.u32Chunks) + len(a.i16Chunks) + len(a.i32Chunks)
+
+	allocs := testing.AllocsPerRun(100, func() {
+		a.Reset()
+		a.Bytes(1000)
+		a.Uint32(4096)
+		a.Int16(512)
+		a.Int32(256)
+	})
+	if allocs != 0 {
+		t.Errorf("steady state allocs per operation = %v, want 0", allocs)
+	}
+	if got := len(a.byteChunks) + len(a.u32Chunks) + len(a.i16Chunks) + len(a.i32Chunks); got != chunks {
+		t.Errorf("chunk count grew from %d to %d at steady state", chunks, got)
+	}
+}
+
+func TestArenaLargeAllocation(t *testing.T) {
+	var a Arena
+	// Larger than any chunk class: must still be satisfied in one piece.
+	n := 3 * arenaMaxChunk
+	u := a.Uint32(n)
+	if len(u) != n {
+		t.Fatalf("len = %d, want %d", len(u), n)
+	}
+	u[0], u[n-1] = 1, 2
+}
+
+func TestArenaRelease(t *testing.T) {
+	var a Arena
+	a.Bytes(Size64K)
+	a.Uint32(100)
+	a.Release()
+	if len(a.byteChunks) != 0 || len(a.u32Chunks) != 0 {
+		t.Error("Release did not drop chunks")
+	}
+	// The arena must be reusable after Release.
+	b := a.Bytes(16)
+	for i, v := range b {
+		if v != 0 {
+			t.Fatalf("Bytes after Release: b[%d] = %#x, want 0", i, v)
+		}
+	}
+}
+
+func BenchmarkArenaUint32(b *testing.B) {
+	var a Arena
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		a.Reset()
+		for j := 0; j < 16; j++ {
+			a.Uint32(2048)
+		}
+	}
+}
+
+func BenchmarkMakeUint32(b *testing.B) {
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		for j := 0; j < 16; j++ {
+			s := make([]uint32, 2048)
+			_ = s
+		}
+	}
+}
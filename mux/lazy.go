@@ -0,0 +1,445 @@
+package mux
+
+import (
+	"encoding/binary"
+	"fmt"
+	"io"
+
+	"github.com/deepteams/webp/internal/container"
+)
+
+// ChunkRef describes a chunk payload by its location in the underlying file,
+// without holding the payload bytes.
+type ChunkRef struct {
+	ID     ChunkID
+	Offset int64 // Payload offset from the start of the file.
+	Size   int64 // Payload size in bytes (excluding header and padding).
+}
+
+// Valid reports whether the reference points at an actual chunk.
+func (c ChunkRef) Valid() bool {
+	return c.Size > 0 || c.ID != 0
+}
+
+// FrameRef describes an animation frame (or the sole image) by the location
+// of its chunks. It carries the same metadata as FrameInfo but references
+// the bitstream instead of holding it.
+type FrameRef struct {
+	Bitstream   ChunkRef // VP8/VP8L payload location.
+	Alpha       ChunkRef // Standalone ALPH payload location (invalid if absent).
+	Width       int
+	Height      int
+	OffsetX     int
+	OffsetY     int
+	Duration    int
+	IsKeyframe  bool
+	HasAlpha    bool
+	BlendMode   BlendMode
+	DisposeMode DisposeMode
+}
+
+// BytesReaderAt adapts an in-memory buffer (for example an mmap'd file) to
+// the io.ReaderAt accepted by NewLazyDemuxer while letting the demuxer hand
+// out sub-slices of it without copying.
+type BytesReaderAt []byte
+
+// ReadAt implements io.ReaderAt.
+func (b BytesReaderAt) ReadAt(p []byte, off int64) (int, error) {
+	if off < 0 || off >= int64(len(b)) {
+		return 0, io.EOF
+	}
+	n := copy(p, b[off:])
+	if n < len(p) {
+		return n, io.EOF
+	}
+	return n, nil
+}
+
+// Bytes returns the underlying buffer. LazyDemuxer uses this (via the
+// bytesBacked interface) to return zero-copy sub-slices from ChunkBytes.
+func (b BytesReaderAt) Bytes() []byte {
+	return b
+}
+
+// bytesBacked is implemented by ReaderAt sources whose full contents are
+// addressable in memory, enabling zero-copy payload access.
+type bytesBacked interface {
+	Bytes() []byte
+}
+
+// LazyDemuxer parses a WebP container from an io.ReaderAt without loading
+// chunk payloads. Construction reads only the chunk directory — each chunk's
+// fourCC, offset and size, plus the few header bytes needed for features and
+// frame metadata — so opening a multi-gigabyte file touches a handful of
+// pages. Payloads are accessed on demand through ChunkReader (an
+// io.SectionReader into the source) or ChunkBytes (a zero-copy sub-slice
+// when the source is memory-backed, e.g. BytesReaderAt over an mmap).
+type LazyDemuxer struct {
+	r    io.ReaderAt
+	size int64
+
+	features Features
+	chunks   []ChunkRef
+	frames   []FrameRef
+	// ANIM parameters.
+	bgColor   uint32
+	loopCount int
+}
+
+// NewLazyDemuxer parses the chunk directory of a WebP file of the given size
+// from r.
+func NewLazyDemuxer(r io.ReaderAt, size int64) (*LazyDemuxer, error) {
+	d := &LazyDemuxer{r: r, size: size}
+	if err := d.parse(); err != nil {
+		return nil, err
+	}
+	return d, nil
+}
+
+// GetFeatures returns the features extracted from the WebP file.
+func (d *LazyDemuxer) GetFeatures() Features {
+	return d.features
+}
+
+// NumFrames returns the number of frames.
+func (d *LazyDemuxer) NumFrames() int {
+	return len(d.frames)
+}
+
+// LoopCount returns the animation loop count (0 = infinite).
+func (d *LazyDemuxer) LoopCount() int {
+	return d.loopCount
+}
+
+// BackgroundColor returns the ANIM background color (ARGB).
+func (d *LazyDemuxer) BackgroundColor() uint32 {
+	return d.bgColor
+}
+
+// Frame returns the frame reference for the given 0-based index.
+func (d *LazyDemuxer) Frame(index int) (*FrameRef, error) {
+	if index < 0 || index >= len(d.frames) {
+		return nil, ErrFrameOutRange
+	}
+	fr := d.frames[index]
+	return &fr, nil
+}
+
+// GetChunk returns the reference for the first chunk with the given ID.
+func (d *LazyDemuxer) GetChunk(id ChunkID) (ChunkRef, error) {
+	for _, c := range d.chunks {
+		if c.ID == id {
+			return c, nil
+		}
+	}
+	return ChunkRef{}, ErrChunkNotFound
+}
+
+// Chunks returns the full chunk directory in file order.
+// The returned slice must not be modified.
+func (d *LazyDemuxer) Chunks() []ChunkRef {
+	return d.chunks
+}
+
+// ChunkReader returns a reader over the referenced payload. No bytes are
+// read until the caller reads from it.
+func (d *LazyDemuxer) ChunkReader(ref ChunkRef) *io.SectionReader {
+	return io.NewSectionReader(d.r, ref.Offset, ref.Size)
+}
+
+// ChunkBytes returns the referenced payload. When the source is
+// memory-backed (implements Bytes() []byte, like BytesReaderAt), the result
+// is a sub-slice of the underlying buffer with no copying; otherwise the
+// payload is read into a fresh buffer.
+func (d *LazyDemuxer) ChunkBytes(ref ChunkRef) ([]byte, error) {
+	if ref.Offset < 0 || ref.Size < 0 || ref.Offset+ref.Size > d.size {
+		return nil, ErrTruncated
+	}
+	if bb, ok := d.r.(bytesBacked); ok {
+		data := bb.Bytes()
+		if ref.Offset+ref.Size > int64(len(data)) {
+			return nil, ErrTruncated
+		}
+		return data[ref.Offset : ref.Offset+ref.Size : ref.Offset+ref.Size], nil
+	}
+	buf := make([]byte, ref.Size)
+	if _, err := d.r.ReadAt(buf, ref.Offset); err != nil {
+		return nil, fmt.Errorf("mux: reading chunk %s: %w", fourCCString(ref.ID), err)
+	}
+	return buf, nil
+}
+
+// readAt reads len(buf) bytes at off, mapping short reads to ErrTruncated.
+func (d *LazyDemuxer) readAt(buf []byte, off int64) error {
+	if n, err := d.r.ReadAt(buf, off); n < len(buf) {
+		if err == nil || err == io.EOF {
+			return ErrTruncated
+		}
+		return err
+	}
+	return nil
+}
+
+// parse validates the RIFF header and records the chunk directory.
+func (d *LazyDemuxer) parse() error {
+	var hdr [container.RIFFHeaderSize]byte
+	if d.size < container.RIFFHeaderSize {
+		return ErrInvalidRIFF
+	}
+	if err := d.readAt(hdr[:], 0); err != nil {
+		return ErrInvalidRIFF
+	}
+	if binary.LittleEndian.Uint32(hdr[0:4]) != FourCCRIFF ||
+		binary.LittleEndian.Uint32(hdr[8:12]) != FourCCWEBP {
+		return ErrInvalidRIFF
+	}
+	fileSize := binary.LittleEndian.Uint32(hdr[4:8])
+	end := int64(fileSize) + 8
+	if end > d.size {
+		// Allow truncated data — work with what we have.
+		end = d.size
+	}
+
+	pos := int64(container.RIFFHeaderSize)
+	first := true
+	for pos+container.ChunkHeaderSize <= end {
+		var ch [container.ChunkHeaderSize]byte
+		if err := d.readAt(ch[:], pos); err != nil {
+			break
+		}
+		id := binary.LittleEndian.Uint32(ch[0:4])
+		payloadSize := int64(binary.LittleEndian.Uint32(ch[4:8]))
+		payloadOff := pos + container.ChunkHeaderSize
+		if payloadOff+payloadSize > end {
+			if first {
+				return ErrTruncated
+			}
+			break
+		}
+		ref := ChunkRef{ID: id, Offset: payloadOff, Size: payloadSize}
+		d.chunks = append(d.chunks, ref)
+
+		if first {
+			switch id {
+			case FourCCVP8X:
+				if err := d.parseVP8XRef(ref); err != nil {
+					return err
+				}
+			case FourCCVP8, FourCCVP8L:
+				return d.parseSimpleRef(ref)
+			default:
+				return fmt.Errorf("mux: unknown first chunk %s", fourCCString(id))
+			}
+			first = false
+		} else {
+			if err := d.parseExtendedChunkRef(ref); err != nil {
+				return err
+			}
+		}
+
+		pos = payloadOff + payloadSize
+		if payloadSize%2 != 0 {
+			pos++ // RIFF chunks are 2-byte aligned.
+		}
+	}
+
+	if first || len(d.frames) == 0 {
+		return ErrNoImage
+	}
+	return nil
+}
+
+// parseSimpleRef handles a non-extended (single VP8/VP8L chunk) file.
+func (d *LazyDemuxer) parseSimpleRef(ref ChunkRef) error {
+	probe, err := d.probe(ref, 10)
+	if err != nil {
+		return err
+	}
+	fr := FrameRef{Bitstream: ref, IsKeyframe: true}
+	if ref.ID == FourCCVP8 {
+		fr.Width, fr.Height, err = parseVP8Dimensions(probe)
+		if err != nil {
+			return err
+		}
+		d.features = Features{Width: fr.Width, Height: fr.Height, Format: FormatLossy}
+	} else {
+		var hasAlpha bool
+		fr.Width, fr.Height, hasAlpha, err = parseVP8LDimensions(probe)
+		if err != nil {
+			return err
+		}
+		fr.HasAlpha = hasAlpha
+		d.features = Features{Width: fr.Width, Height: fr.Height, HasAlpha: hasAlpha, Format: FormatLossless}
+	}
+	d.frames = []FrameRef{fr}
+	return nil
+}
+
+// parseVP8XRef extracts canvas features from the VP8X chunk.
+func (d *LazyDemuxer) parseVP8XRef(ref ChunkRef) error {
+	if ref.Size < container.VP8XChunkSize {
+		return ErrInvalidVP8X
+	}
+	data, err := d.probe(ref, container.VP8XChunkSize)
+	if err != nil {
+		return ErrInvalidVP8X
+	}
+	flags := data[0]
+	canvasWidth := int(data[4]) | int(data[5])<<8 | int(data[6])<<16
+	canvasHeight := int(data[7]) | int(data[8])<<8 | int(data[9])<<16
+	d.features = Features{
+		Width:        canvasWidth + 1,
+		Height:       canvasHeight + 1,
+		HasAlpha:     flags&flagAlpha != 0,
+		HasAnimation: flags&flagAnimation != 0,
+		HasICC:       flags&flagICCP != 0,
+		HasEXIF:      flags&flagEXIF != 0,
+		HasXMP:       flags&flagXMP != 0,
+		Format:       FormatExtended,
+	}
+	return nil
+}
+
+// parseExtendedChunkRef dispatches on a top-level chunk following VP8X.
+func (d *LazyDemuxer) parseExtendedChunkRef(ref ChunkRef) error {
+	switch ref.ID {
+	case FourCCANIM:
+		if ref.Size < container.ANIMChunkSize {
+			return ErrInvalidANIM
+		}
+		data, err := d.probe(ref, container.ANIMChunkSize)
+		if err != nil {
+			return ErrInvalidANIM
+		}
+		d.bgColor = binary.LittleEndian.Uint32(data[0:4])
+		d.loopCount = int(binary.LittleEndian.Uint16(data[4:6]))
+	case FourCCANMF:
+		return d.parseANMFRef(ref)
+	case FourCCVP8, FourCCVP8L, FourCCALPH:
+		// Non-animated extended file: single image with possible alpha.
+		// The ALPH chunk precedes VP8/VP8L and creates frames[0], so keep
+		// routing image chunks here until the bitstream is recorded.
+		if !d.features.HasAnimation && (len(d.frames) == 0 || !d.frames[0].Bitstream.Valid()) {
+			return d.parseSingleExtendedRef(ref)
+		}
+	}
+	return nil
+}
+
+// parseANMFRef records an animation frame from an ANMF chunk, reading only
+// the 16-byte frame header and the sub-chunk headers inside it.
+func (d *LazyDemuxer) parseANMFRef(ref ChunkRef) error {
+	if ref.Size < container.ANMFChunkSize {
+		return ErrInvalidANMF
+	}
+	hdr, err := d.probe(ref, container.ANMFChunkSize)
+	if err != nil {
+		return ErrInvalidANMF
+	}
+
+	fr := FrameRef{
+		OffsetX:  (int(hdr[0]) | int(hdr[1])<<8 | int(hdr[2])<<16) * 2,
+		OffsetY:  (int(hdr[3]) | int(hdr[4])<<8 | int(hdr[5])<<16) * 2,
+		Width:    (int(hdr[6]) | int(hdr[7])<<8 | int(hdr[8])<<16) + 1,
+		Height:   (int(hdr[9]) | int(hdr[10])<<8 | int(hdr[11])<<16) + 1,
+		Duration: int(hdr[12]) | int(hdr[13])<<8 | int(hdr[14])<<16,
+	}
+	if uint64(fr.Width)*uint64(fr.Height) >= container.MaxImageArea {
+		return fmt.Errorf("%w: frame dimensions %dx%d too large", ErrInvalidANMF, fr.Width, fr.Height)
+	}
+	flagByte := hdr[15]
+	fr.DisposeMode = DisposeNone
+	if flagByte&0x01 != 0 {
+		fr.DisposeMode = DisposeBackground
+	}
+	fr.BlendMode = BlendAlpha
+	if flagByte&0x02 != 0 {
+		fr.BlendMode = BlendNone
+	}
+
+	// Walk the frame's image sub-chunks, recording locations only.
+	pos := ref.Offset + container.ANMFChunkSize
+	frameEnd := ref.Offset + ref.Size
+	for pos+container.ChunkHeaderSize <= frameEnd {
+		var ch [container.ChunkHeaderSize]byte
+		if err := d.readAt(ch[:], pos); err != nil {
+			break
+		}
+		subID := binary.LittleEndian.Uint32(ch[0:4])
+		subSize := int64(binary.LittleEndian.Uint32(ch[4:8]))
+		subOff := pos + container.ChunkHeaderSize
+		if subOff+subSize > frameEnd {
+			break
+		}
+		subRef := ChunkRef{ID: subID, Offset: subOff, Size: subSize}
+		switch subID {
+		case FourCCVP8, FourCCVP8L:
+			fr.Bitstream = subRef
+		case FourCCALPH:
+			fr.Alpha = subRef
+		}
+		pos = subOff + subSize
+		if subSize%2 != 0 && pos < frameEnd {
+			pos++
+		}
+	}
+
+	// Per-frame alpha, matching Demuxer: a standalone ALPH chunk or the
+	// VP8L header alpha bit (a 5-byte probe).
+	fr.HasAlpha = fr.Alpha.Valid()
+	if !fr.HasAlpha && fr.Bitstream.Valid() && fr.Bitstream.Size >= 5 {
+		probe, err := d.probe(fr.Bitstream, 5)
+		if err == nil {
+			fr.HasAlpha = frameDataHasAlpha(probe)
+		}
+	}
+
+	if len(d.frames) >= maxFrames {
+		return fmt.Errorf("%w: exceeded limit of %d", ErrTooManyFrames, maxFrames)
+	}
+	fr.IsKeyframe = len(d.frames) == 0
+	d.frames = append(d.frames, fr)
+	return nil
+}
+
+// parseSingleExtendedRef handles the image chunks of a non-animated VP8X
+// file. It is called for the first ALPH or VP8/VP8L chunk; the remaining
+// image chunk (if any) is picked up by later parseExtendedChunkRef calls
+// through the same path.
+func (d *LazyDemuxer) parseSingleExtendedRef(ref ChunkRef) error {
+	var fr *FrameRef
+	if len(d.frames) == 0 {
+		d.frames = []FrameRef{{
+			Width:      d.features.Width,
+			Height:     d.features.Height,
+			IsKeyframe: true,
+		}}
+	}
+	fr = &d.frames[0]
+	switch ref.ID {
+	case FourCCALPH:
+		fr.Alpha = ref
+		fr.HasAlpha = true
+	case FourCCVP8, FourCCVP8L:
+		fr.Bitstream = ref
+		if !fr.HasAlpha && ref.Size >= 5 {
+			probe, err := d.probe(ref, 5)
+			if err == nil {
+				fr.HasAlpha = frameDataHasAlpha(probe)
+			}
+		}
+	}
+	return nil
+}
+
+// probe reads the first n bytes of a chunk payload (clamped to its size).
+func (d *LazyDemuxer) probe(ref ChunkRef, n int) ([]byte, error) {
+	if int64(n) > ref.Size {
+		n = int(ref.Size)
+	}
+	buf := make([]byte, n)
+	if err := d.readAt(buf, ref.Offset); err != nil {
+		return nil, err
+	}
+	return buf, nil
+}
@@ -0,0 +1,229 @@
+package mux
+
+import (
+	"bytes"
+	"encoding/binary"
+	"io"
+	"testing"
+
+	"github.com/deepteams/webp/internal/container"
+)
+
+// countingReaderAt counts the bytes read through it, to verify that the lazy
+// demuxer touches only chunk headers and probes at construction time.
+type countingReaderAt struct {
+	r         io.ReaderAt
+	bytesRead int
+}
+
+func (c *countingReaderAt) ReadAt(p []byte, off int64) (int, error) {
+	n, err := c.r.ReadAt(p, off)
+	c.bytesRead += n
+	return n, err
+}
+
+func TestLazyDemuxSimpleVP8(t *testing.T) {
+	bitstream := makeVP8Keyframe(160, 120)
+	webp := buildSimpleWebP(FourCCVP8, bitstream)
+
+	d, err := NewLazyDemuxer(BytesReaderAt(webp), int64(len(webp)))
+	if err != nil {
+		t.Fatalf("NewLazyDemuxer: %v", err)
+	}
+
+	feat := d.GetFeatures()
+	if feat.Width != 160 || feat.Height != 120 {
+		t.Errorf("features = %dx%d, want 160x120", feat.Width, feat.Height)
+	}
+	if feat.Format != FormatLossy {
+		t.Errorf("format = %v, want FormatLossy", feat.Format)
+	}
+	if d.NumFrames() != 1 {
+		t.Fatalf("NumFrames = %d, want 1", d.NumFrames())
+	}
+
+	fr, err := d.Frame(0)
+	if err != nil {
+		t.Fatalf("Frame(0): %v", err)
+	}
+	got, err := d.ChunkBytes(fr.Bitstream)
+	if err != nil {
+		t.Fatalf("ChunkBytes: %v", err)
+	}
+	if !bytes.Equal(got, bitstream) {
+		t.Error("bitstream payload mismatch")
+	}
+	// Memory-backed source: the payload must be a sub-slice of the input,
+	// not a copy.
+	if &got[0] != &webp[fr.Bitstream.Offset] {
+		t.Error("ChunkBytes copied the payload for a memory-backed source")
+	}
+}
+
+func TestLazyDemuxAnimatedParity(t *testing.T) {
+	frame1 := makeVP8Keyframe(100, 100)
+	frame2 := makeVP8LData(40, 30, true)
+
+	animData := make([]byte, container.ANIMChunkSize)
+	binary.LittleEndian.PutUint32(animData[0:4], 0xFF112233)
+	binary.LittleEndian.PutUint16(animData[4:6], 3)
+
+	anmf1 := buildANMFData(0, 0, 100, 100, 50, BlendAlpha, DisposeNone, FourCCVP8, frame1)
+	anmf2 := buildANMFData(10, 20, 40, 30, 100, BlendNone, DisposeBackground, FourCCVP8L, frame2)
+
+	chunks := []Chunk{
+		{ID: FourCCANIM, Size: uint32(len(animData)), Data: animData},
+		{ID: FourCCANMF, Size: uint32(len(anmf1)), Data: anmf1},
+		{ID: FourCCANMF, Size: uint32(len(anmf2)), Data: anmf2},
+	}
+	webp := buildVP8XWebP(byte(flagAnimation), 100, 100, chunks...)
+
+	eager, err := NewDemuxer(webp)
+	if err != nil {
+		t.Fatalf("NewDemuxer: %v", err)
+	}
+	lazy, err := NewLazyDemuxer(BytesReaderAt(webp), int64(len(webp)))
+	if err != nil {
+		t.Fatalf("NewLazyDemuxer: %v", err)
+	}
+
+	if lazy.GetFeatures() != eager.GetFeatures() {
+		t.Errorf("features = %+v, want %+v", lazy.GetFeatures(), eager.GetFeatures())
+	}
+	if lazy.NumFrames() != eager.NumFrames() {
+		t.Fatalf("NumFrames = %d, want %d", lazy.NumFrames(), eager.NumFrames())
+	}
+	if lazy.LoopCount() != eager.LoopCount() {
+		t.Errorf("LoopCount = %d, want %d", lazy.LoopCount(), eager.LoopCount())
+	}
+	if lazy.BackgroundColor() != eager.BackgroundColor() {
+		t.Errorf("BackgroundColor = 0x%08x, want 0x%08x", lazy.BackgroundColor(), eager.BackgroundColor())
+	}
+
+	payloads := [][]byte{frame1, frame2}
+	for i := 0; i < eager.NumFrames(); i++ {
+		fi, err := eager.Frame(i)
+		if err != nil {
+			t.Fatalf("eager Frame(%d): %v", i, err)
+		}
+		fr, err := lazy.Frame(i)
+		if err != nil {
+			t.Fatalf("lazy Frame(%d): %v", i, err)
+		}
+		if fr.Width != fi.Width || fr.Height != fi.Height ||
+			fr.OffsetX != fi.OffsetX || fr.OffsetY != fi.OffsetY ||
+			fr.Duration != fi.Duration || fr.IsKeyframe != fi.IsKeyframe ||
+			fr.HasAlpha != fi.HasAlpha || fr.BlendMode != fi.BlendMode ||
+			fr.DisposeMode != fi.DisposeMode {
+			t.Errorf("frame %d metadata mismatch: lazy %+v, eager %+v", i, fr, fi)
+		}
+		got, err := lazy.ChunkBytes(fr.Bitstream)
+		if err != nil {
+			t.Fatalf("ChunkBytes frame %d: %v", i, err)
+		}
+		if !bytes.Equal(got, payloads[i]) {
+			t.Errorf("frame %d bitstream payload mismatch", i)
+		}
+	}
+}
+
+func TestLazyDemuxMetadataOnDemand(t *testing.T) {
+	// A large ICC chunk should not be read at construction time.
+	icc := make([]byte, 1<<20)
+	for i := range icc {
+		icc[i] = byte(i)
+	}
+	bitstream := makeVP8Keyframe(64, 64)
+	chunks := []Chunk{
+		{ID: FourCCICCP, Size: uint32(len(icc)), Data: icc},
+		{ID: FourCCVP8, Size: uint32(len(bitstream)), Data: bitstream},
+	}
+	webp := buildVP8XWebP(byte(flagICCP), 64, 64, chunks...)
+
+	cr := &countingReaderAt{r: BytesReaderAt(webp)}
+	d, err := NewLazyDemuxer(cr, int64(len(webp)))
+	if err != nil {
+		t.Fatalf("NewLazyDemuxer: %v", err)
+	}
+	if cr.bytesRead >= len(icc) {
+		t.Errorf("construction read %d bytes of a %d-byte file; chunk directory parse should skip payloads",
+			cr.bytesRead, len(webp))
+	}
+
+	ref, err := d.GetChunk(FourCCICCP)
+	if err != nil {
+		t.Fatalf("GetChunk(ICCP): %v", err)
+	}
+	if ref.Size != int64(len(icc)) {
+		t.Errorf("ICCP size = %d, want %d", ref.Size, len(icc))
+	}
+	got, err := io.ReadAll(d.ChunkReader(ref))
+	if err != nil {
+		t.Fatalf("reading ICCP payload: %v", err)
+	}
+	if !bytes.Equal(got, icc) {
+		t.Error("ICCP payload mismatch")
+	}
+
+	if _, err := d.GetChunk(FourCCEXIF); err != ErrChunkNotFound {
+		t.Errorf("GetChunk(EXIF) = %v, want ErrChunkNotFound", err)
+	}
+}
+
+func TestLazyDemuxSingleExtendedWithAlpha(t *testing.T) {
+	alpha := []byte{1, 2, 3, 4}
+	bitstream := makeVP8Keyframe(32, 32)
+	chunks := []Chunk{
+		{ID: FourCCALPH, Size: uint32(len(alpha)), Data: alpha},
+		{ID: FourCCVP8, Size: uint32(len(bitstream)), Data: bitstream},
+	}
+	webp := buildVP8XWebP(byte(flagAlpha), 32, 32, chunks...)
+
+	d, err := NewLazyDemuxer(BytesReaderAt(webp), int64(len(webp)))
+	if err != nil {
+		t.Fatalf("NewLazyDemuxer: %v", err)
+	}
+	fr, err := d.Frame(0)
+	if err != nil {
+		t.Fatalf("Frame(0): %v", err)
+	}
+	if !fr.HasAlpha || !fr.Alpha.Valid() {
+		t.Fatal("frame should reference a standalone ALPH chunk")
+	}
+	got, err := d.ChunkBytes(fr.Alpha)
+	if err != nil {
+		t.Fatalf("ChunkBytes(alpha): %v", err)
+	}
+	if !bytes.Equal(got, alpha) {
+		t.Error("ALPH payload mismatch")
+	}
+
+	if !fr.Bitstream.Valid() {
+		t.Fatal("frame should reference the VP8 chunk following ALPH")
+	}
+	got, err = d.ChunkBytes(fr.Bitstream)
+	if err != nil {
+		t.Fatalf("ChunkBytes(bitstream): %v", err)
+	}
+	if !bytes.Equal(got, bitstream) {
+		t.Error("VP8 payload mismatch")
+	}
+}
+
+func TestLazyDemuxInvalid(t *testing.T) {
+	if _, err := NewLazyDemuxer(BytesReaderAt([]byte("not a webp file")), 15); err != ErrInvalidRIFF {
+		t.Errorf("bad RIFF: err = %v, want ErrInvalidRIFF", err)
+	}
+
+	webp := buildSimpleWebP(FourCCVP8, makeVP8Keyframe(10, 10))
+	d, err := NewLazyDemuxer(BytesReaderAt(webp), int64(len(webp)))
+	if err != nil {
+		t.Fatalf("NewLazyDemuxer: %v", err)
+	}
+	if _, err := d.Frame(1); err != ErrFrameOutRange {
+		t.Errorf("Frame(1) err = %v, want ErrFrameOutRange", err)
+	}
+	if _, err := d.Frame(-1); err != ErrFrameOutRange {
+		t.Errorf("Frame(-1) err = %v, want ErrFrameOutRange", err)
+	}
+}
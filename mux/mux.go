@@ -6,6 +6,7 @@ import (
 	"fmt"
 	"io"
 	"math"
+	"net"
 
 	"github.com/deepteams/webp/internal/container"
 )
@@ -216,18 +217,41 @@ func (m *Muxer) needsVP8X() bool {
 }
 
 // Assemble writes the complete WebP file to w.
+//
+// Assembly is zero-copy: the muxer computes the chunk layout, builds the
+// small header segments, and streams the original payload slices straight to
+// w as a vectored write (net.Buffers). Writers that support writev (e.g.
+// *net.TCPConn) receive the whole file in gathered system calls; other
+// writers receive one Write per segment. Either way, re-muxing a large
+// animation costs header-sized allocations, not a second copy of the file.
 func (m *Muxer) Assemble(w io.Writer) error {
-	if err := m.validate(); err != nil {
+	segs, err := m.segments()
+	if err != nil {
 		return err
 	}
+	_, err = segs.WriteTo(w)
+	return err
+}
+
+// segments returns the complete file as an ordered gather list. Header
+// segments are freshly allocated; payload segments alias the slices passed
+// to AddFrame/AddChunk.
+func (m *Muxer) segments() (net.Buffers, error) {
+	if err := m.validate(); err != nil {
+		return nil, err
+	}
 
 	// If single frame with no metadata, write simple format.
 	if !m.needsVP8X() {
-		return m.assembleSimple(w)
+		return m.simpleSegments()
 	}
-	return m.assembleExtended(w)
+	return m.extendedSegments()
 }
 
+// chunkPadding is the shared RIFF padding byte appended after odd-sized
+// payloads. It is never written to, so all segments may alias it.
+var chunkPadding = []byte{0}
+
 // validate checks the muxer state for consistency before assembling.
 // This mirrors libwebp's MuxValidate from muxinternal.c.
 func (m *Muxer) validate() error {
@@ -291,8 +315,8 @@ func (m *Muxer) hasAlpha() bool {
 	return false
 }
 
-// assembleSimple writes a simple (non-extended) WebP file.
-func (m *Muxer) assembleSimple(w io.Writer) error {
+// simpleSegments builds a simple (non-extended) WebP file gather list.
+func (m *Muxer) simpleSegments() (net.Buffers, error) {
 	frame := m.frames[0]
 	chunkID := detectBitstreamType(frame.data)
 	chunkSize := uint32(len(frame.data))
@@ -313,22 +337,15 @@ func (m *Muxer) assembleSimple(w io.Writer) error {
 	// Chunk header.
 	writeChunkHeader(buf[12:20], chunkID, chunkSize)
 
-	if _, err := w.Write(buf); err != nil {
-		return err
-	}
-	if _, err := w.Write(frame.data); err != nil {
-		return err
-	}
+	segs := net.Buffers{buf, frame.data}
 	if chunkSize%2 != 0 {
-		if _, err := w.Write([]byte{0}); err != nil {
-			return err
-		}
+		segs = append(segs, chunkPadding)
 	}
-	return nil
+	return segs, nil
 }
 
-// assembleExtended writes an extended (VP8X) WebP file.
-func (m *Muxer) assembleExtended(w io.Writer) error {
+// extendedSegments builds an extended (VP8X) WebP file gather list.
+func (m *Muxer) extendedSegments() (net.Buffers, error) {
 	animated := m.isAnimated()
 
 	// Build VP8X flags.
@@ -396,20 +413,20 @@ func (m *Muxer) assembleExtended(w io.Writer) error {
 	}
 
 	if riffPayload64 > uint64(math.MaxUint32) {
-		return fmt.Errorf("mux: RIFF payload too large (%d bytes, exceeds 4GB limit)", riffPayload64)
+		return nil, fmt.Errorf("mux: RIFF payload too large (%d bytes, exceeds 4GB limit)", riffPayload64)
 	}
 	riffPayload := uint32(riffPayload64)
 
-	// Write RIFF header.
+	var segs net.Buffers
+
+	// RIFF header.
 	header := make([]byte, container.RIFFHeaderSize)
 	binary.LittleEndian.PutUint32(header[0:4], FourCCRIFF)
 	binary.LittleEndian.PutUint32(header[4:8], riffPayload)
 	binary.LittleEndian.PutUint32(header[8:12], FourCCWEBP)
-	if _, err := w.Write(header); err != nil {
-		return err
-	}
+	segs = append(segs, header)
 
-	// Write VP8X chunk.
+	// VP8X chunk.
 	vp8xBuf := make([]byte, container.ChunkHeaderSize+container.VP8XChunkSize)
 	writeChunkHeader(vp8xBuf[0:8], FourCCVP8X, container.VP8XChunkSize)
 	vp8xBuf[8] = flags
@@ -418,56 +435,42 @@ func (m *Muxer) assembleExtended(w io.Writer) error {
 	putLE24(vp8xBuf[12:15], canvasW-1)
 	// Canvas height-1 as 24-bit LE at offset 15..17.
 	putLE24(vp8xBuf[15:18], canvasH-1)
-	if _, err := w.Write(vp8xBuf); err != nil {
-		return err
-	}
+	segs = append(segs, vp8xBuf)
 
-	// Write ICC chunk.
+	// ICC chunk.
 	if m.iccData != nil {
-		if err := writeDataChunk(w, FourCCICCP, m.iccData); err != nil {
-			return err
-		}
+		segs = appendDataChunk(segs, FourCCICCP, m.iccData)
 	}
 
-	// Write ANIM chunk.
+	// ANIM chunk.
 	if animated {
 		animBuf := make([]byte, container.ChunkHeaderSize+container.ANIMChunkSize)
 		writeChunkHeader(animBuf[0:8], FourCCANIM, container.ANIMChunkSize)
 		binary.LittleEndian.PutUint32(animBuf[8:12], m.bgColor)
 		binary.LittleEndian.PutUint16(animBuf[12:14], uint16(m.loopCount))
-		if _, err := w.Write(animBuf); err != nil {
-			return err
-		}
+		segs = append(segs, animBuf)
 	}
 
-	// Write frames.
+	// Frames.
 	for _, f := range m.frames {
 		if animated {
-			if err := m.writeANMFChunk(w, f); err != nil {
-				return err
-			}
+			segs = m.appendANMFChunk(segs, f)
 		} else {
-			if err := writeDataChunk(w, detectBitstreamType(f.data), f.data); err != nil {
-				return err
-			}
+			segs = appendDataChunk(segs, detectBitstreamType(f.data), f.data)
 		}
 	}
 
-	// Write EXIF chunk.
+	// EXIF chunk.
 	if m.exifData != nil {
-		if err := writeDataChunk(w, FourCCEXIF, m.exifData); err != nil {
-			return err
-		}
+		segs = appendDataChunk(segs, FourCCEXIF, m.exifData)
 	}
 
-	// Write XMP chunk.
+	// XMP chunk.
 	if m.xmpData != nil {
-		if err := writeDataChunk(w, FourCCXMP, m.xmpData); err != nil {
-			return err
-		}
+		segs = appendDataChunk(segs, FourCCXMP, m.xmpData)
 	}
 
-	return nil
+	return segs, nil
 }
 
 // splitAlphaAndBitstream separates frame data into optional ALPH chunk data
@@ -495,12 +498,12 @@ func splitAlphaAndBitstream(data []byte) (alphaData, bitstream []byte) {
 	return nil, data
 }
 
-// writeANMFChunk writes an ANMF wrapper around a frame's image data.
-// The ordering inside ANMF matches libwebp (muxinternal.c:396-409):
+// appendANMFChunk appends the segments of an ANMF wrapper around a frame's
+// image data. The ordering inside ANMF matches libwebp (muxinternal.c:396-409):
 //  1. ANMF chunk header
 //  2. ALPH sub-chunk (if present, encapsulated inside ANMF)
 //  3. VP8/VP8L sub-chunk
-func (m *Muxer) writeANMFChunk(w io.Writer, f muxFrame) error {
+func (m *Muxer) appendANMFChunk(segs net.Buffers, f muxFrame) net.Buffers {
 	alphaData, bitstream := splitAlphaAndBitstream(f.data)
 	subSize := frameSubChunksSize(alphaData, bitstream)
 	anmfPayload := uint32(container.ANMFChunkSize) + subSize
@@ -530,30 +533,22 @@ func (m *Muxer) writeANMFChunk(w io.Writer, f muxFrame) error {
 	}
 	hdr[23] = flagByte
 
-	if _, err := w.Write(hdr); err != nil {
-		return err
-	}
+	segs = append(segs, hdr)
 
-	// Write ALPH sub-chunk inside ANMF (if present).
+	// ALPH sub-chunk inside ANMF (if present).
 	if alphaData != nil {
-		if err := writeDataChunk(w, FourCCALPH, alphaData); err != nil {
-			return err
-		}
+		segs = appendDataChunk(segs, FourCCALPH, alphaData)
 	}
 
-	// Write VP8/VP8L sub-chunk.
+	// VP8/VP8L sub-chunk.
 	chunkID := detectBitstreamType(bitstream)
-	if err := writeDataChunk(w, chunkID, bitstream); err != nil {
-		return err
-	}
+	segs = appendDataChunk(segs, chunkID, bitstream)
 
 	// Padding for ANMF chunk as a whole.
 	if anmfPayload%2 != 0 {
-		if _, err := w.Write([]byte{0}); err != nil {
-			return err
-		}
+		segs = append(segs, chunkPadding)
 	}
-	return nil
+	return segs
 }
 
 // canvasSize determines the canvas dimensions.
@@ -655,22 +650,16 @@ func chunkTotalSize(payloadSize uint32) uint32 {
 	return total
 }
 
-// writeDataChunk writes a chunk header + data + optional padding.
-func writeDataChunk(w io.Writer, id ChunkID, data []byte) error {
+// appendDataChunk appends the segments for a chunk: a freshly built header,
+// the payload slice as-is, and the shared padding byte if the payload is odd.
+func appendDataChunk(segs net.Buffers, id ChunkID, data []byte) net.Buffers {
 	hdr := make([]byte, container.ChunkHeaderSize)
 	writeChunkHeader(hdr, id, uint32(len(data)))
-	if _, err := w.Write(hdr); err != nil {
-		return err
-	}
-	if _, err := w.Write(data); err != nil {
-		return err
-	}
+	segs = append(segs, hdr, data)
 	if len(data)%2 != 0 {
-		if _, err := w.Write([]byte{0}); err != nil {
-			return err
-		}
+		segs = append(segs, chunkPadding)
 	}
-	return nil
+	return segs
 }
 
 // putLE24 writes a 24-bit little-endian value into buf[0:3].
@@ -0,0 +1,215 @@
+// Package quality scores a degraded image against its original using
+// the codec's own distortion metrics: luma PSNR and the 7x7
+// hat-windowed SSIM from internal/dsp. The image-level functions accept
+// any image.Image but take the luma plane of *image.YCbCr and the pixel
+// buffer of *image.Gray directly, so decoder output (including
+// webp.DecodeYUV planes viewed through YCbCr) is scored without a
+// conversion pass. The plane-level functions can be pointed at any
+// single plane, e.g. to score chroma or alpha separately.
+//
+// All metrics fan out across row bands, one per available processor.
+package quality
+
+import (
+	"fmt"
+	"image"
+	"image/draw"
+	"runtime"
+	"sync"
+
+	"github.com/deepteams/webp/internal/dsp"
+)
+
+// ssimKernel mirrors dsp's window half-width: SSIM is evaluated on 7x7
+// windows, clipped at the image border.
+const ssimKernel = 3
+
+// PSNR returns the luma peak signal-to-noise ratio between a and b in
+// decibels (capped at 99 for identical planes). The images must have
+// equal dimensions.
+func PSNR(a, b image.Image) (float64, error) {
+	pa, sa, pb, sb, w, h, err := lumaPair(a, b)
+	if err != nil {
+		return 0, err
+	}
+	return PlanePSNR(pa, pb, w, h, sa, sb), nil
+}
+
+// SSIM returns the mean luma structural similarity between a and b, in
+// (0, 1] with 1 meaning identical. The images must have equal
+// dimensions.
+func SSIM(a, b image.Image) (float64, error) {
+	pa, sa, pb, sb, w, h, err := lumaPair(a, b)
+	if err != nil {
+		return 0, err
+	}
+	return PlaneSSIM(pa, pb, w, h, sa, sb), nil
+}
+
+// SSIMMap returns the per-pixel luma SSIM between a and b as a
+// row-major width x height map; 1 means locally identical, lower
+// values mark where the distortion sits. The images must have equal
+// dimensions.
+func SSIMMap(a, b image.Image) ([]float64, error) {
+	pa, sa, pb, sb, w, h, err := lumaPair(a, b)
+	if err != nil {
+		return nil, err
+	}
+	return PlaneSSIMMap(pa, pb, w, h, sa, sb), nil
+}
+
+// PlanePSNR computes the PSNR between two single planes of width x
+// height pixels with the given row strides.
+func PlanePSNR(a, b []byte, width, height, aStride, bStride int) float64 {
+	bounds := bandBounds(height)
+	sses := make([]uint64, len(bounds))
+	var wg sync.WaitGroup
+	for i, band := range bounds {
+		wg.Add(1)
+		go func(i, y0, y1 int) {
+			defer wg.Done()
+			sses[i] = dsp.SSE(a[y0*aStride:], b[y0*bStride:], width, y1-y0, aStride, bStride)
+		}(i, band[0], band[1])
+	}
+	wg.Wait()
+	var sse uint64
+	for _, s := range sses {
+		sse += s
+	}
+	return dsp.PSNRFromSSE(sse, width*height)
+}
+
+// PlaneSSIM computes the mean per-pixel SSIM between two single planes
+// of width x height pixels with the given row strides.
+func PlaneSSIM(a, b []byte, width, height, aStride, bStride int) float64 {
+	bounds := bandBounds(height)
+	sums := make([]float64, len(bounds))
+	var wg sync.WaitGroup
+	for i, band := range bounds {
+		wg.Add(1)
+		go func(i, y0, y1 int) {
+			defer wg.Done()
+			var sum float64
+			for y := y0; y < y1; y++ {
+				sum += ssimRow(a, b, width, height, aStride, bStride, y, nil)
+			}
+			sums[i] = sum
+		}(i, band[0], band[1])
+	}
+	wg.Wait()
+	var total float64
+	for _, s := range sums {
+		total += s
+	}
+	return total / float64(width*height)
+}
+
+// PlaneSSIMMap computes the per-pixel SSIM between two single planes,
+// returned as a row-major width x height map.
+func PlaneSSIMMap(a, b []byte, width, height, aStride, bStride int) []float64 {
+	out := make([]float64, width*height)
+	bounds := bandBounds(height)
+	var wg sync.WaitGroup
+	for _, band := range bounds {
+		wg.Add(1)
+		go func(y0, y1 int) {
+			defer wg.Done()
+			for y := y0; y < y1; y++ {
+				ssimRow(a, b, width, height, aStride, bStride, y, out[y*width:(y+1)*width])
+			}
+		}(band[0], band[1])
+	}
+	wg.Wait()
+	return out
+}
+
+// ssimRow evaluates one row of SSIM windows: the full hat-weighted
+// window in the interior, the clipped variant within ssimKernel pixels
+// of the border (the same split the encoder's distortion pass uses).
+// When out is non-nil the per-pixel values are stored there; the row
+// sum is returned either way.
+func ssimRow(a, b []byte, width, height, aStride, bStride, y int, out []float64) float64 {
+	interior := y >= ssimKernel && y < height-ssimKernel
+	var sum float64
+	for x := 0; x < width; x++ {
+		var v float64
+		if interior && x >= ssimKernel && x < width-ssimKernel {
+			offA := (y-ssimKernel)*aStride + x - ssimKernel
+			offB := (y-ssimKernel)*bStride + x - ssimKernel
+			v = dsp.SSIMGet(a[offA:], aStride, b[offB:], bStride)
+		} else {
+			v = dsp.SSIMGetClipped(a, aStride, b, bStride, x, y, width, height)
+		}
+		if out != nil {
+			out[x] = v
+		}
+		sum += v
+	}
+	return sum
+}
+
+// bandBounds splits [0, height) into one contiguous row band per
+// available processor, keeping bands at least ssimKernel*2+1 rows so
+// the per-band work dwarfs the goroutine overhead.
+func bandBounds(height int) [][2]int {
+	const minRows = 2*ssimKernel + 1
+	workers := runtime.GOMAXPROCS(0)
+	if max := height / minRows; workers > max {
+		workers = max
+	}
+	if workers <= 1 {
+		return [][2]int{{0, height}}
+	}
+	bounds := make([][2]int, 0, workers)
+	rows := (height + workers - 1) / workers
+	for y0 := 0; y0 < height; y0 += rows {
+		y1 := y0 + rows
+		if y1 > height {
+			y1 = height
+		}
+		bounds = append(bounds, [2]int{y0, y1})
+	}
+	return bounds
+}
+
+// lumaPair extracts matching luma planes from both images.
+func lumaPair(a, b image.Image) (pa []byte, sa int, pb []byte, sb int, w, h int, err error) {
+	ab, bb := a.Bounds(), b.Bounds()
+	if ab.Dx() != bb.Dx() || ab.Dy() != bb.Dy() {
+		return nil, 0, nil, 0, 0, 0, fmt.Errorf(
+			"quality: image dimensions differ: %dx%d vs %dx%d", ab.Dx(), ab.Dy(), bb.Dx(), bb.Dy())
+	}
+	w, h = ab.Dx(), ab.Dy()
+	pa, sa = lumaPlane(a)
+	pb, sb = lumaPlane(b)
+	return pa, sa, pb, sb, w, h, nil
+}
+
+// lumaPlane returns a luma view of img. YCbCr and Gray images are
+// referenced in place; everything else is converted to NRGBA and
+// reduced with the BT.601 weights the encoder's RGB->YUV step uses.
+func lumaPlane(img image.Image) ([]byte, int) {
+	bounds := img.Bounds()
+	w, h := bounds.Dx(), bounds.Dy()
+	switch src := img.(type) {
+	case *image.YCbCr:
+		return src.Y[src.YOffset(bounds.Min.X, bounds.Min.Y):], src.YStride
+	case *image.Gray:
+		return src.Pix[src.PixOffset(bounds.Min.X, bounds.Min.Y):], src.Stride
+	}
+	nrgba, ok := img.(*image.NRGBA)
+	if !ok || nrgba.Rect.Min != (image.Point{}) {
+		converted := image.NewNRGBA(image.Rect(0, 0, w, h))
+		draw.Draw(converted, converted.Bounds(), img, bounds.Min, draw.Src)
+		nrgba = converted
+	}
+	out := make([]byte, w*h)
+	for y := 0; y < h; y++ {
+		row := nrgba.Pix[y*nrgba.Stride:]
+		for x := 0; x < w; x++ {
+			r, g, b := uint32(row[x*4]), uint32(row[x*4+1]), uint32(row[x*4+2])
+			out[y*w+x] = byte((19595*r + 38470*g + 7471*b + 1<<15) >> 16)
+		}
+	}
+	return out, w
+}
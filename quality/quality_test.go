@@ -0,0 +1,165 @@
+package quality
+
+import (
+	"image"
+	"math"
+	"math/rand"
+	"runtime"
+	"testing"
+)
+
+func gradientNRGBA(w, h int) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			i := img.PixOffset(x, y)
+			img.Pix[i+0] = uint8(x * 255 / w)
+			img.Pix[i+1] = uint8(y * 255 / h)
+			img.Pix[i+2] = uint8((x * y) % 256)
+			img.Pix[i+3] = 255
+		}
+	}
+	return img
+}
+
+// addNoise returns a copy of img with uniform +-amp noise on the color
+// channels.
+func addNoise(img *image.NRGBA, amp int, seed int64) *image.NRGBA {
+	rng := rand.New(rand.NewSource(seed))
+	out := image.NewNRGBA(img.Rect)
+	copy(out.Pix, img.Pix)
+	for i := 0; i < len(out.Pix); i += 4 {
+		for c := 0; c < 3; c++ {
+			v := int(out.Pix[i+c]) + rng.Intn(2*amp+1) - amp
+			if v < 0 {
+				v = 0
+			} else if v > 255 {
+				v = 255
+			}
+			out.Pix[i+c] = uint8(v)
+		}
+	}
+	return out
+}
+
+func TestIdenticalImages(t *testing.T) {
+	img := gradientNRGBA(64, 48)
+	psnr, err := PSNR(img, img)
+	if err != nil {
+		t.Fatalf("PSNR: %v", err)
+	}
+	if psnr != 99 {
+		t.Errorf("PSNR = %v, want 99 (identical cap)", psnr)
+	}
+	ssim, err := SSIM(img, img)
+	if err != nil {
+		t.Fatalf("SSIM: %v", err)
+	}
+	if ssim < 0.999 || ssim > 1 {
+		t.Errorf("SSIM = %v, want ~1", ssim)
+	}
+}
+
+func TestNoiseLowersMetrics(t *testing.T) {
+	img := gradientNRGBA(96, 64)
+	light := addNoise(img, 4, 1)
+	heavy := addNoise(img, 40, 2)
+
+	psnrLight, _ := PSNR(img, light)
+	psnrHeavy, _ := PSNR(img, heavy)
+	if psnrLight >= 99 || psnrHeavy >= psnrLight {
+		t.Errorf("PSNR ordering wrong: light=%v heavy=%v", psnrLight, psnrHeavy)
+	}
+
+	ssimLight, _ := SSIM(img, light)
+	ssimHeavy, _ := SSIM(img, heavy)
+	if ssimLight >= 1 || ssimHeavy >= ssimLight {
+		t.Errorf("SSIM ordering wrong: light=%v heavy=%v", ssimLight, ssimHeavy)
+	}
+}
+
+func TestSSIMMapLocalizesDistortion(t *testing.T) {
+	const w, h = 80, 60
+	img := gradientNRGBA(w, h)
+	bad := image.NewNRGBA(img.Rect)
+	copy(bad.Pix, img.Pix)
+	// Trash a block in the top-left corner only.
+	for y := 0; y < 16; y++ {
+		for x := 0; x < 16; x++ {
+			i := bad.PixOffset(x, y)
+			bad.Pix[i+0] = ^bad.Pix[i+0]
+			bad.Pix[i+1] = ^bad.Pix[i+1]
+		}
+	}
+
+	m, err := SSIMMap(img, bad)
+	if err != nil {
+		t.Fatalf("SSIMMap: %v", err)
+	}
+	if len(m) != w*h {
+		t.Fatalf("map length %d, want %d", len(m), w*h)
+	}
+	if inside := m[8*w+8]; inside > 0.9 {
+		t.Errorf("corrupted region scored %v, want low", inside)
+	}
+	if outside := m[(h-8)*w+(w-8)]; outside < 0.999 {
+		t.Errorf("untouched region scored %v, want ~1", outside)
+	}
+}
+
+func TestYCbCrUsesLumaPlaneDirectly(t *testing.T) {
+	const w, h = 50, 34
+	a := image.NewYCbCr(image.Rect(0, 0, w, h), image.YCbCrSubsampleRatio420)
+	b := image.NewYCbCr(image.Rect(0, 0, w, h), image.YCbCrSubsampleRatio420)
+	rng := rand.New(rand.NewSource(3))
+	for i := range a.Y {
+		a.Y[i] = uint8(rng.Intn(256))
+		b.Y[i] = uint8(rng.Intn(256))
+	}
+
+	psnr, err := PSNR(a, b)
+	if err != nil {
+		t.Fatalf("PSNR: %v", err)
+	}
+	if want := PlanePSNR(a.Y, b.Y, w, h, a.YStride, b.YStride); psnr != want {
+		t.Errorf("PSNR(YCbCr) = %v, PlanePSNR on Y = %v", psnr, want)
+	}
+	ssim, err := SSIM(a, b)
+	if err != nil {
+		t.Fatalf("SSIM: %v", err)
+	}
+	if want := PlaneSSIM(a.Y, b.Y, w, h, a.YStride, b.YStride); ssim != want {
+		t.Errorf("SSIM(YCbCr) = %v, PlaneSSIM on Y = %v", ssim, want)
+	}
+}
+
+func TestDimensionMismatch(t *testing.T) {
+	if _, err := PSNR(gradientNRGBA(10, 10), gradientNRGBA(10, 12)); err == nil {
+		t.Error("PSNR accepted mismatched dimensions")
+	}
+	if _, err := SSIMMap(gradientNRGBA(10, 10), gradientNRGBA(12, 10)); err == nil {
+		t.Error("SSIMMap accepted mismatched dimensions")
+	}
+}
+
+func TestParallelMatchesSerial(t *testing.T) {
+	img := gradientNRGBA(120, 90)
+	noisy := addNoise(img, 10, 4)
+
+	prev := runtime.GOMAXPROCS(1)
+	psnr1, _ := PSNR(img, noisy)
+	ssim1, _ := SSIM(img, noisy)
+	runtime.GOMAXPROCS(4)
+	psnr4, _ := PSNR(img, noisy)
+	ssim4, _ := SSIM(img, noisy)
+	runtime.GOMAXPROCS(prev)
+
+	if psnr1 != psnr4 {
+		t.Errorf("PSNR differs across GOMAXPROCS: %v vs %v", psnr1, psnr4)
+	}
+	// The SSIM total is a float sum whose grouping follows the band
+	// layout, so allow rounding-level drift.
+	if math.Abs(ssim1-ssim4) > 1e-9 {
+		t.Errorf("SSIM differs across GOMAXPROCS: %v vs %v", ssim1, ssim4)
+	}
+}
@@ -0,0 +1,197 @@
+package webp
+
+import (
+	"fmt"
+	"image"
+	"io"
+
+	"github.com/deepteams/webp/internal/container"
+	"github.com/deepteams/webp/internal/lossy"
+)
+
+// RowEncoder is a push-style encoder for scan-line producers (RAW
+// converters, renderers) that generate rows top-to-bottom and cannot
+// afford to hold a full decoded frame. Rows are fed with [RowEncoder.WriteRows]
+// and the container is written on [RowEncoder.Close].
+//
+// In lossy mode each arriving row pair is converted straight into the
+// encoder's YUV 4:2:0 planes, so beyond the encoder's own working set the
+// only retained input state is one pending scanline and the alpha plane
+// (1 byte per pixel, dropped if the image turns out fully opaque). The
+// full 4-bytes-per-pixel RGBA frame is never materialized. In lossless
+// mode the VP8L encoder inherently needs the complete ARGB frame, so rows
+// are accumulated and encoded on Close.
+//
+// Options that require a full frame up front are not supported:
+// UseSharpYUV returns an error from NewRowEncoder, the transparent-area
+// cleanup normally applied when Exact is false is skipped, and Stats is
+// not filled.
+type RowEncoder struct {
+	w       io.Writer
+	opts    EncoderOptions
+	width   int
+	height  int
+	nextRow int // source row index expected next
+	closed  bool
+
+	// Lossy state.
+	enc      *lossy.VP8Encoder
+	alpha    []byte // accumulated alpha plane, width*height
+	alphaAcc uint8  // AND-reduction of all alpha bytes seen
+	pending  []byte // buffered even row awaiting its pair, width*4 bytes
+
+	// Lossless state: the accumulated full frame.
+	pix []byte
+}
+
+// NewRowEncoder creates a push-style encoder writing a WebP image of the
+// given dimensions to w. Rows must be supplied in top-to-bottom order as
+// packed 8-bit R,G,B,A (non-premultiplied) scanlines. A nil opts uses
+// [DefaultOptions]. The options are copied; later changes to opts do not
+// affect the encoder.
+func NewRowEncoder(w io.Writer, width, height int, opts *EncoderOptions) (*RowEncoder, error) {
+	if w == nil {
+		return nil, fmt.Errorf("webp: nil writer")
+	}
+	if opts == nil {
+		opts = DefaultOptions()
+	}
+	if err := validateConfig(opts); err != nil {
+		return nil, err
+	}
+	if width <= 0 || height <= 0 {
+		return nil, fmt.Errorf("webp: invalid image dimensions %dx%d", width, height)
+	}
+	if width > MaxDimension || height > MaxDimension {
+		return nil, fmt.Errorf("webp: image dimension %dx%d exceeds maximum %d", width, height, MaxDimension)
+	}
+	if opts.UseSharpYUV {
+		return nil, fmt.Errorf("webp: RowEncoder does not support UseSharpYUV (requires the full frame)")
+	}
+
+	re := &RowEncoder{
+		w:        w,
+		opts:     *opts,
+		width:    width,
+		height:   height,
+		alphaAcc: 0xff,
+	}
+	if opts.Lossless {
+		re.pix = make([]byte, width*height*4)
+	} else {
+		// The converter needs real alpha during chroma averaging, so the
+		// config's cached detection is left at "unknown" and the plane is
+		// dropped on Close if every row turned out opaque.
+		re.enc = lossy.NewEncoderForRows(width, height, lossyEncodeConfig(opts, false))
+		re.alpha = make([]byte, width*height)
+		re.pending = make([]byte, width*4)
+	}
+	return re, nil
+}
+
+// WriteRows feeds one or more complete scanlines, each width*4 bytes of
+// packed R,G,B,A. Rows may be split across calls in any multiple of a
+// row; supplying more than height rows in total is an error.
+func (re *RowEncoder) WriteRows(rgba []byte) error {
+	if re.closed {
+		return fmt.Errorf("webp: RowEncoder already closed")
+	}
+	rowBytes := re.width * 4
+	if len(rgba)%rowBytes != 0 {
+		return fmt.Errorf("webp: WriteRows length %d is not a multiple of the %d-byte row size", len(rgba), rowBytes)
+	}
+	numRows := len(rgba) / rowBytes
+	if re.nextRow+numRows > re.height {
+		return fmt.Errorf("webp: WriteRows exceeds image height %d", re.height)
+	}
+
+	if re.pix != nil {
+		// Lossless: accumulate the frame.
+		copy(re.pix[re.nextRow*rowBytes:], rgba)
+		re.nextRow += numRows
+		return nil
+	}
+
+	for i := 0; i < numRows; i++ {
+		row := rgba[i*rowBytes : (i+1)*rowBytes]
+
+		// Accumulate the alpha plane and its opacity AND-reduction.
+		aDst := re.alpha[re.nextRow*re.width:]
+		acc := re.alphaAcc
+		for x := 0; x < re.width; x++ {
+			a := row[x*4+3]
+			aDst[x] = a
+			acc &= a
+		}
+		re.alphaAcc = acc
+
+		if re.nextRow&1 == 0 {
+			// Even row: stash a copy until its pair arrives (the caller
+			// may reuse the slice between calls).
+			copy(re.pending, row)
+		} else {
+			re.enc.ImportRowPair(re.nextRow>>1, re.pending, row)
+		}
+		re.nextRow++
+	}
+	return nil
+}
+
+// Close encodes the accumulated frame and writes the RIFF/WEBP container
+// to the underlying writer. All height rows must have been supplied.
+// The RowEncoder must not be used after Close.
+func (re *RowEncoder) Close() error {
+	if re.closed {
+		return fmt.Errorf("webp: RowEncoder already closed")
+	}
+	re.closed = true
+	if re.nextRow != re.height {
+		return fmt.Errorf("webp: RowEncoder closed after %d of %d rows", re.nextRow, re.height)
+	}
+
+	if re.pix != nil {
+		img := &image.NRGBA{
+			Pix:    re.pix,
+			Stride: re.width * 4,
+			Rect:   image.Rect(0, 0, re.width, re.height),
+		}
+		return Encode(re.w, img, &re.opts)
+	}
+
+	if re.height&1 != 0 {
+		// Final odd row: import it with a replicated pair.
+		re.enc.ImportRowPair(re.height>>1, re.pending, nil)
+	}
+	re.enc.FinishImport()
+	defer func() {
+		lossy.ReleaseEncoder(re.enc)
+		re.enc = nil
+	}()
+
+	// Overlap the alpha-plane encode with the VP8 frame encode, as the
+	// one-shot lossy path does.
+	var (
+		alphaData []byte
+		alphaErr  error
+		alphaDone chan struct{}
+	)
+	if re.alphaAcc != 0xff {
+		alphaDone = make(chan struct{})
+		go func() {
+			defer close(alphaDone)
+			alphaData, alphaErr = lossy.EncodeAlpha(re.alpha, re.width, re.height, alphaEncodeConfig(&re.opts))
+		}()
+	}
+
+	bs, err := re.enc.EncodeFrame()
+	if alphaDone != nil {
+		<-alphaDone
+	}
+	if err != nil {
+		return fmt.Errorf("webp: lossy encode: %w", err)
+	}
+	if alphaErr != nil {
+		return fmt.Errorf("webp: alpha encode: %w", alphaErr)
+	}
+	return writeRIFF(re.w, container.FourCCVP8, bs, alphaData, re.width, re.height, &re.opts)
+}
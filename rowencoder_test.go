@@ -0,0 +1,137 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"testing"
+)
+
+// feedRows pushes img into re in uneven chunks to exercise row buffering
+// across WriteRows calls.
+func feedRows(t *testing.T, re *RowEncoder, img *image.NRGBA) {
+	t.Helper()
+	w := img.Rect.Dx()
+	h := img.Rect.Dy()
+	rowBytes := w * 4
+	for y := 0; y < h; {
+		n := 1 + y%3 // 1, 2 or 3 rows per call
+		if y+n > h {
+			n = h - y
+		}
+		chunk := make([]byte, n*rowBytes)
+		for i := 0; i < n; i++ {
+			copy(chunk[i*rowBytes:], img.Pix[(y+i)*img.Stride:(y+i)*img.Stride+rowBytes])
+		}
+		if err := re.WriteRows(chunk); err != nil {
+			t.Fatalf("WriteRows at row %d: %v", y, err)
+		}
+		y += n
+	}
+}
+
+func TestRowEncoderMatchesEncodeOpaque(t *testing.T) {
+	// For opaque input the row-by-row import performs the exact same
+	// conversion as the one-shot path, so the output must be identical.
+	for _, dims := range [][2]int{{120, 90}, {95, 61}, {64, 64}} {
+		img := sessionTestImage(dims[0], dims[1], 0)
+		opts := &EncoderOptions{Quality: 75, Method: 4}
+
+		var oneShot bytes.Buffer
+		if err := Encode(&oneShot, img, opts); err != nil {
+			t.Fatalf("%dx%d: Encode: %v", dims[0], dims[1], err)
+		}
+
+		var streamed bytes.Buffer
+		re, err := NewRowEncoder(&streamed, dims[0], dims[1], opts)
+		if err != nil {
+			t.Fatalf("%dx%d: NewRowEncoder: %v", dims[0], dims[1], err)
+		}
+		feedRows(t, re, img)
+		if err := re.Close(); err != nil {
+			t.Fatalf("%dx%d: Close: %v", dims[0], dims[1], err)
+		}
+		if !bytes.Equal(oneShot.Bytes(), streamed.Bytes()) {
+			t.Errorf("%dx%d: RowEncoder output differs from one-shot Encode", dims[0], dims[1])
+		}
+	}
+}
+
+func TestRowEncoderAlpha(t *testing.T) {
+	img := statsTestImage(80, 70) // gradient with a translucent band
+	var buf bytes.Buffer
+	re, err := NewRowEncoder(&buf, 80, 70, &EncoderOptions{Quality: 75})
+	if err != nil {
+		t.Fatalf("NewRowEncoder: %v", err)
+	}
+	feedRows(t, re, img)
+	if err := re.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	feat, err := GetFeatures(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("GetFeatures: %v", err)
+	}
+	if !feat.HasAlpha {
+		t.Error("translucent input produced no alpha channel")
+	}
+	dec, err := Decode(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	if b := dec.Bounds(); b.Dx() != 80 || b.Dy() != 70 {
+		t.Errorf("decoded dimensions %dx%d, want 80x70", b.Dx(), b.Dy())
+	}
+}
+
+func TestRowEncoderLossless(t *testing.T) {
+	img := sessionTestImage(48, 33, 1)
+	var buf bytes.Buffer
+	re, err := NewRowEncoder(&buf, 48, 33, &EncoderOptions{Lossless: true})
+	if err != nil {
+		t.Fatalf("NewRowEncoder: %v", err)
+	}
+	feedRows(t, re, img)
+	if err := re.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	dec, err := Decode(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	for y := 0; y < 33; y++ {
+		for x := 0; x < 48; x++ {
+			if dec.At(x, y) != img.At(x, y) {
+				t.Fatalf("lossless round trip mismatch at (%d, %d)", x, y)
+			}
+		}
+	}
+}
+
+func TestRowEncoderErrors(t *testing.T) {
+	var buf bytes.Buffer
+	if _, err := NewRowEncoder(&buf, 16, 16, &EncoderOptions{Quality: 75, UseSharpYUV: true}); err == nil {
+		t.Error("UseSharpYUV accepted")
+	}
+	if _, err := NewRowEncoder(&buf, 0, 16, nil); err == nil {
+		t.Error("zero width accepted")
+	}
+
+	re, err := NewRowEncoder(&buf, 16, 2, nil)
+	if err != nil {
+		t.Fatalf("NewRowEncoder: %v", err)
+	}
+	if err := re.WriteRows(make([]byte, 10)); err == nil {
+		t.Error("partial row accepted")
+	}
+	if err := re.WriteRows(make([]byte, 3*16*4)); err == nil {
+		t.Error("rows beyond height accepted")
+	}
+	if err := re.Close(); err == nil {
+		t.Error("Close with missing rows succeeded")
+	}
+	if err := re.WriteRows(make([]byte, 16*4)); err == nil {
+		t.Error("WriteRows after Close succeeded")
+	}
+}
@@ -93,33 +93,32 @@ func shiftVal(v, shift int) int {
 	return v >> uint(-shift)
 }
 
-func fixedPointInterpolation(v int, tab []uint32, tabPosShiftRight, tabValueShift int) uint32 {
-	tabPos := shiftVal(v, -tabPosShiftRight)
-	x := uint32(v - shiftVal(tabPos, tabPosShiftRight)) // fractional part
-	v0 := uint32(shiftVal(int(tab[tabPos]), tabValueShift))
-	v1 := uint32(shiftVal(int(tab[tabPos+1]), tabValueShift))
-	v2 := (v1 - v0) * x
-	half := 0
-	if tabPosShiftRight > 0 {
-		half = 1 << uint(tabPosShiftRight-1)
-	}
-	return v0 + (v2+uint32(half))>>uint(tabPosShiftRight)
-}
-
 func toLinearSrgb(v uint16, bitDepth int) uint32 {
 	shift := gammaToLinearTabBits - bitDepth
-	if shift > 0 {
+	if shift >= 0 {
+		// Table covers every input value directly (this is the common case:
+		// the sharp converter works at 10-bit precision, matching the table).
 		return gammaToLinearTab[int(v)<<uint(shift)]
 	}
-	return fixedPointInterpolation(int(v), gammaToLinearTab[:], -shift, 0)
+	// bitDepth > table bits: interpolate between adjacent table entries.
+	r := uint(-shift)
+	tabPos := int(v) >> r
+	x := uint32(v) & (1<<r - 1)
+	v0 := gammaToLinearTab[tabPos]
+	v1 := gammaToLinearTab[tabPos+1]
+	return v0 + ((v1-v0)*x+1<<(r-1))>>r
 }
 
 func fromLinearSrgb(value uint32, bitDepth int) uint16 {
-	return uint16(fixedPointInterpolation(
-		int(value), linearToGammaTab[:],
-		gammaToLinearBits-linearToGammaTabBits,
-		bitDepth-gammaToLinearBits,
-	))
+	// Table position uses the top linearToGammaTabBits of the 16-bit linear
+	// value; table entries are scaled down to bitDepth (always < 16 here).
+	const r = gammaToLinearBits - linearToGammaTabBits
+	s := uint(gammaToLinearBits - bitDepth)
+	tabPos := value >> r
+	x := value & (1<<r - 1)
+	v0 := linearToGammaTab[tabPos] >> s
+	v1 := linearToGammaTab[tabPos+1] >> s
+	return uint16(v0 + ((v1-v0)*x+1<<(r-1))>>r)
 }
 
 // --- Transfer function implementations ---
@@ -359,7 +358,12 @@ func fromLinearHLG(linear float32) float32 {
 // to a 16-bit linear value using the specified transfer function.
 func GammaToLinear(v uint16, bitDepth int, tf TransferFunc) uint32 {
 	initGammaTables()
+	return gammaToLinear(v, bitDepth, tf)
+}
 
+// gammaToLinear is GammaToLinear without the table-init check, for hot loops
+// that have already called initGammaTables.
+func gammaToLinear(v uint16, bitDepth int, tf TransferFunc) uint32 {
 	if tf == TransferSRGB {
 		return toLinearSrgb(v, bitDepth)
 	}
@@ -404,7 +408,12 @@ func GammaToLinear(v uint16, bitDepth int, tf TransferFunc) uint32 {
 // in the range of bitDepth bits using the specified transfer function.
 func LinearToGamma(v uint32, bitDepth int, tf TransferFunc) uint16 {
 	initGammaTables()
+	return linearToGamma(v, bitDepth, tf)
+}
 
+// linearToGamma is LinearToGamma without the table-init check, for hot loops
+// that have already called initGammaTables.
+func linearToGamma(v uint32, bitDepth int, tf TransferFunc) uint16 {
 	if tf == TransferSRGB {
 		return fromLinearSrgb(v, bitDepth)
 	}
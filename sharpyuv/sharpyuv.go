@@ -4,6 +4,8 @@ import (
 	"errors"
 	"fmt"
 	"image"
+	"runtime"
+	"sync"
 )
 
 const (
@@ -11,6 +13,11 @@ const (
 	yuvFix        = 16
 	yuvHalf       = 1 << (yuvFix - 1)
 	maxBitDepth   = 14
+
+	// minParallelPixels is the padded pixel count above which the sharp
+	// conversion phases are spread across goroutines. Below it, the
+	// fork/join overhead outweighs the per-row work.
+	minParallelPixels = 1 << 16
 )
 
 // Options controls the SharpYUV conversion.
@@ -149,11 +156,11 @@ func rgbToGray(r, g, b int64) int {
 // scaleDown averages a 2x2 block in the gamma domain, going through linear
 // space for gamma-aware blending.
 func scaleDown(a, b, c, d uint16, bitDepth int, tf TransferFunc) uint32 {
-	la := GammaToLinear(a, bitDepth, tf)
-	lb := GammaToLinear(b, bitDepth, tf)
-	lc := GammaToLinear(c, bitDepth, tf)
-	ld := GammaToLinear(d, bitDepth, tf)
-	return uint32(LinearToGamma((la+lb+lc+ld+2)>>2, bitDepth, tf))
+	la := gammaToLinear(a, bitDepth, tf)
+	lb := gammaToLinear(b, bitDepth, tf)
+	lc := gammaToLinear(c, bitDepth, tf)
+	ld := gammaToLinear(d, bitDepth, tf)
+	return uint32(linearToGamma((la+lb+lc+ld+2)>>2, bitDepth, tf))
 }
 
 func clipBitDepth(y, bitDepth int) uint16 {
@@ -183,24 +190,28 @@ func convertSharp(rgb []byte, width, height, rgbStride int, yuv *image.YCbCr, ma
 	sfix := getPrecisionShift(8) // 8-bit RGB input
 	yBitDepth := 8 + sfix
 
+	parallel := runtime.GOMAXPROCS(0) > 1 && w*h >= minParallelPixels
+
 	// Allocate working buffers.
-	tmpRow1 := make([]uint16, 3*w)   // one row of RGB (interleaved as R[w], G[w], B[w])
-	tmpRow2 := make([]uint16, 3*w)   // second row
-	bestY := make([]uint16, w*h)     // best Y (in working precision)
-	targetY := make([]uint16, w*h)   // target Y (gamma-corrected luminance)
+	tmpRow1 := make([]uint16, 3*w)     // one row of RGB (interleaved as R[w], G[w], B[w])
+	tmpRow2 := make([]uint16, 3*w)     // second row
+	bestY := make([]uint16, w*h)       // best Y (in working precision)
+	targetY := make([]uint16, w*h)     // target Y (gamma-corrected luminance)
 	bestUV := make([]int16, 3*uvW*uvH) // best UV residuals (R-W, G-W, B-W)
 	targetUV := make([]int16, 3*uvW*uvH)
 	bestRGBY := make([]uint16, w*2)
 	bestRGBUV := make([]int16, 3*uvW)
 
 	// Phase 1: Import RGB rows and compute initial Y and UV.
-	for j := 0; j < height; j += 2 {
+	// Row pairs are fully independent, so they are spread across workers
+	// for large images (each worker with its own pair of scratch rows).
+	importRowPair := func(j int, row1, row2 []uint16) {
 		isLastRow := (j == height-1)
-		importOneRow(rgb, j, rgbStride, width, w, sfix, tmpRow1)
+		importOneRow(rgb, j, rgbStride, width, w, sfix, row1)
 		if !isLastRow {
-			importOneRow(rgb, j+1, rgbStride, width, w, sfix, tmpRow2)
+			importOneRow(rgb, j+1, rgbStride, width, w, sfix, row2)
 		} else {
-			copy(tmpRow2, tmpRow1)
+			copy(row2, row1)
 		}
 
 		byOff := (j / 2) * 2 * w
@@ -208,22 +219,93 @@ func convertSharp(rgb []byte, width, height, rgbStride int, yuv *image.YCbCr, ma
 		buvOff := (j / 2) * 3 * uvW
 		tuvOff := buvOff
 
-		storeGray(tmpRow1, bestY[byOff:], w)
-		storeGray(tmpRow2, bestY[byOff+w:], w)
+		storeGray(row1, bestY[byOff:], w)
+		storeGray(row2, bestY[byOff+w:], w)
 
-		updateW(tmpRow1, targetY[tyOff:], w, yBitDepth, tf)
-		updateW(tmpRow2, targetY[tyOff+w:], w, yBitDepth, tf)
-		updateChroma(tmpRow1, tmpRow2, targetUV[tuvOff:], uvW, yBitDepth, tf)
+		updateW(row1, targetY[tyOff:], w, yBitDepth, tf)
+		updateW(row2, targetY[tyOff+w:], w, yBitDepth, tf)
+		updateChroma(row1, row2, targetUV[tuvOff:], uvW, yBitDepth, tf)
 		copy(bestUV[buvOff:buvOff+3*uvW], targetUV[tuvOff:tuvOff+3*uvW])
 	}
+	if parallel {
+		numPairs := (height + 1) / 2
+		numWorkers := runtime.GOMAXPROCS(0)
+		if numWorkers > numPairs {
+			numWorkers = numPairs
+		}
+		var wg sync.WaitGroup
+		pairsPerWorker := (numPairs + numWorkers - 1) / numWorkers
+		for wi := 0; wi < numWorkers; wi++ {
+			start := wi * pairsPerWorker
+			end := start + pairsPerWorker
+			if end > numPairs {
+				end = numPairs
+			}
+			if start >= end {
+				break
+			}
+			wg.Add(1)
+			go func(start, end int) {
+				defer wg.Done()
+				row1 := make([]uint16, 3*w)
+				row2 := make([]uint16, 3*w)
+				for p := start; p < end; p++ {
+					importRowPair(2*p, row1, row2)
+				}
+			}(start, end)
+		}
+		wg.Wait()
+	} else {
+		for j := 0; j < height; j += 2 {
+			importRowPair(j, tmpRow1, tmpRow2)
+		}
+	}
 
 	// Phase 2: Iterative refinement.
+	//
+	// Row pairs form a serial chain: interpolateTwoRows for pair j reads the
+	// already-updated UV residuals of pair j-1 (Gauss-Seidel style), so the
+	// chroma path cannot be fanned out without changing the result. What can
+	// run concurrently is the luma branch — updateW on both interpolated rows
+	// plus sharpYUVUpdateY — which only feeds the next iteration. In parallel
+	// mode it is handed to a second goroutine while this one continues the
+	// chroma chain, with double-buffered interpolated rows: the unbuffered
+	// channel guarantees job k is finished before job k+1 is accepted, which
+	// is exactly when buffer set k%2 is written again (at pair k+2).
 	diffYThreshold := uint64(3 * w * h)
 	prevDiffYSum := ^uint64(0)
 
+	var tmpRow3, tmpRow4 []uint16
+	if parallel {
+		tmpRow3 = make([]uint16, 3*w)
+		tmpRow4 = make([]uint16, 3*w)
+	}
+
+	type lumaJob struct {
+		row1, row2 []uint16 // interpolated RGB rows (read-only in the worker)
+		byOff      int
+	}
+
 	for iter := 0; iter < numIterations; iter++ {
 		var diffYSum uint64
 
+		var jobs chan lumaJob
+		var lumaDone chan uint64
+		if parallel {
+			jobs = make(chan lumaJob)
+			lumaDone = make(chan uint64, 1)
+			go func() {
+				var sum uint64
+				rgbY := make([]uint16, 2*w)
+				for jb := range jobs {
+					updateW(jb.row1, rgbY[:w], w, yBitDepth, tf)
+					updateW(jb.row2, rgbY[w:], w, yBitDepth, tf)
+					sum += sharpYUVUpdateY(targetY[jb.byOff:], rgbY, bestY[jb.byOff:], 2*w, yBitDepth)
+				}
+				lumaDone <- sum
+			}()
+		}
+
 		for j := 0; j < h; j += 2 {
 			jUV := j / 2
 			curUVOff := jUV * 3 * uvW
@@ -237,19 +319,32 @@ func convertSharp(rgb []byte, width, height, rgbStride int, yuv *image.YCbCr, ma
 			}
 
 			byOff := j * w
-			tyOff := j * w
+
+			row1, row2 := tmpRow1, tmpRow2
+			if parallel && jUV&1 == 1 {
+				row1, row2 = tmpRow3, tmpRow4
+			}
 
 			interpolateTwoRows(
 				bestY[byOff:], bestUV[prevUVOff:], bestUV[curUVOff:], bestUV[nextUVOff:],
-				w, tmpRow1, tmpRow2, yBitDepth,
+				w, row1, row2, yBitDepth,
 			)
 
-			updateW(tmpRow1, bestRGBY[:w], w, yBitDepth, tf)
-			updateW(tmpRow2, bestRGBY[w:], w, yBitDepth, tf)
-			updateChroma(tmpRow1, tmpRow2, bestRGBUV, uvW, yBitDepth, tf)
+			if parallel {
+				jobs <- lumaJob{row1: row1, row2: row2, byOff: byOff}
+			} else {
+				updateW(row1, bestRGBY[:w], w, yBitDepth, tf)
+				updateW(row2, bestRGBY[w:], w, yBitDepth, tf)
+				diffYSum += sharpYUVUpdateY(targetY[byOff:], bestRGBY[:], bestY[byOff:], 2*w, yBitDepth)
+			}
+
+			updateChroma(row1, row2, bestRGBUV, uvW, yBitDepth, tf)
+			sharpYUVUpdateRGB(targetUV[curUVOff:], bestRGBUV, bestUV[curUVOff:], 3*uvW)
+		}
 
-			diffYSum += sharpYUVUpdateY(targetY[tyOff:], bestRGBY[:], bestY[byOff:], 2*w, yBitDepth)
-			sharpYUVUpdateRGB(targetUV[jUV*3*uvW:], bestRGBUV, bestUV[curUVOff:], 3*uvW)
+		if parallel {
+			close(jobs)
+			diffYSum += <-lumaDone
 		}
 
 		if iter > 0 {
@@ -264,7 +359,7 @@ func convertSharp(rgb []byte, width, height, rgbStride int, yuv *image.YCbCr, ma
 	}
 
 	// Phase 3: Final conversion from internal W/RGB representation to YUV.
-	convertWRGBToYUV(bestY, bestUV, yuv, width, height, w, uvW, uvH, sfix, matrix)
+	convertWRGBToYUV(bestY, bestUV, yuv, width, height, w, uvW, uvH, sfix, matrix, parallel)
 	return nil
 }
 
@@ -292,11 +387,11 @@ func storeGray(src []uint16, y []uint16, w int) {
 
 func updateW(src []uint16, dst []uint16, w, bitDepth int, tf TransferFunc) {
 	for i := 0; i < w; i++ {
-		r := GammaToLinear(src[i], bitDepth, tf)
-		g := GammaToLinear(src[i+w], bitDepth, tf)
-		b := GammaToLinear(src[i+2*w], bitDepth, tf)
+		r := gammaToLinear(src[i], bitDepth, tf)
+		g := gammaToLinear(src[i+w], bitDepth, tf)
+		b := gammaToLinear(src[i+2*w], bitDepth, tf)
 		y := rgbToGray(int64(r), int64(g), int64(b))
-		dst[i] = LinearToGamma(uint32(y), bitDepth, tf)
+		dst[i] = linearToGamma(uint32(y), bitDepth, tf)
 	}
 }
 
@@ -387,7 +482,7 @@ func sharpYUVUpdateRGB(target, src, dst []int16, length int) {
 	}
 }
 
-func convertWRGBToYUV(bestY []uint16, bestUV []int16, yuv *image.YCbCr, width, height, w, uvW, uvH, sfix int, matrix *ConversionMatrix) {
+func convertWRGBToYUV(bestY []uint16, bestUV []int16, yuv *image.YCbCr, width, height, w, uvW, uvH, sfix int, matrix *ConversionMatrix, parallel bool) {
 	srounder := int64(1) << uint(yuvFix+sfix-1)
 
 	// Scale the matrix offsets by the precision shift factor.
@@ -401,32 +496,79 @@ func convertWRGBToYUV(bestY []uint16, bestUV []int16, yuv *image.YCbCr, width, h
 	vOff := int64(shiftVal(int(matrix.RGBToV[3]), sfix))
 
 	// Y plane
-	for j := 0; j < height; j++ {
-		for i := 0; i < width; i++ {
-			yIdx := j*w + i
-			uvIdx := (j/2)*3*uvW + (i >> 1)
-			wVal := int64(bestY[yIdx])
-			r := int64(bestUV[uvIdx]) + wVal
-			g := int64(bestUV[uvIdx+uvW]) + wVal
-			b := int64(bestUV[uvIdx+2*uvW]) + wVal
-			yVal := int64(matrix.RGBToY[0])*r + int64(matrix.RGBToY[1])*g + int64(matrix.RGBToY[2])*b + yOff + srounder
-			yuv.Y[j*yuv.YStride+i] = clipU8(int32(yVal >> uint(yuvFix+sfix)))
+	yRows := func(j0, j1 int) {
+		for j := j0; j < j1; j++ {
+			for i := 0; i < width; i++ {
+				yIdx := j*w + i
+				uvIdx := (j/2)*3*uvW + (i >> 1)
+				wVal := int64(bestY[yIdx])
+				r := int64(bestUV[uvIdx]) + wVal
+				g := int64(bestUV[uvIdx+uvW]) + wVal
+				b := int64(bestUV[uvIdx+2*uvW]) + wVal
+				yVal := int64(matrix.RGBToY[0])*r + int64(matrix.RGBToY[1])*g + int64(matrix.RGBToY[2])*b + yOff + srounder
+				yuv.Y[j*yuv.YStride+i] = clipU8(int32(yVal >> uint(yuvFix+sfix)))
+			}
 		}
 	}
 
 	// U/V planes
-	for j := 0; j < uvH; j++ {
-		for i := 0; i < uvW; i++ {
-			uvIdx := j*3*uvW + i
-			r := int64(bestUV[uvIdx])
-			g := int64(bestUV[uvIdx+uvW])
-			b := int64(bestUV[uvIdx+2*uvW])
-			uVal := int64(matrix.RGBToU[0])*r + int64(matrix.RGBToU[1])*g + int64(matrix.RGBToU[2])*b + uOff + srounder
-			vVal := int64(matrix.RGBToV[0])*r + int64(matrix.RGBToV[1])*g + int64(matrix.RGBToV[2])*b + vOff + srounder
-			if j < len(yuv.Cb)/yuv.CStride && i < yuv.CStride {
-				yuv.Cb[j*yuv.CStride+i] = clipU8(int32(uVal >> uint(yuvFix+sfix)))
-				yuv.Cr[j*yuv.CStride+i] = clipU8(int32(vVal >> uint(yuvFix+sfix)))
+	uvRows := func(j0, j1 int) {
+		for j := j0; j < j1; j++ {
+			for i := 0; i < uvW; i++ {
+				uvIdx := j*3*uvW + i
+				r := int64(bestUV[uvIdx])
+				g := int64(bestUV[uvIdx+uvW])
+				b := int64(bestUV[uvIdx+2*uvW])
+				uVal := int64(matrix.RGBToU[0])*r + int64(matrix.RGBToU[1])*g + int64(matrix.RGBToU[2])*b + uOff + srounder
+				vVal := int64(matrix.RGBToV[0])*r + int64(matrix.RGBToV[1])*g + int64(matrix.RGBToV[2])*b + vOff + srounder
+				if j < len(yuv.Cb)/yuv.CStride && i < yuv.CStride {
+					yuv.Cb[j*yuv.CStride+i] = clipU8(int32(uVal >> uint(yuvFix+sfix)))
+					yuv.Cr[j*yuv.CStride+i] = clipU8(int32(vVal >> uint(yuvFix+sfix)))
+				}
 			}
 		}
 	}
+
+	if !parallel {
+		yRows(0, height)
+		uvRows(0, uvH)
+		return
+	}
+
+	// Rows are independent; split them statically (the per-row cost is
+	// uniform). Each worker handles a band of Y rows and the matching share
+	// of chroma rows.
+	numWorkers := runtime.GOMAXPROCS(0)
+	if numWorkers > height {
+		numWorkers = height
+	}
+	var wg sync.WaitGroup
+	rowsPerWorker := (height + numWorkers - 1) / numWorkers
+	uvPerWorker := (uvH + numWorkers - 1) / numWorkers
+	for wi := 0; wi < numWorkers; wi++ {
+		y0 := wi * rowsPerWorker
+		y1 := y0 + rowsPerWorker
+		if y1 > height {
+			y1 = height
+		}
+		c0 := wi * uvPerWorker
+		c1 := c0 + uvPerWorker
+		if c1 > uvH {
+			c1 = uvH
+		}
+		if y0 >= y1 && c0 >= c1 {
+			break
+		}
+		wg.Add(1)
+		go func(y0, y1, c0, c1 int) {
+			defer wg.Done()
+			if y0 < y1 {
+				yRows(y0, y1)
+			}
+			if c0 < c1 {
+				uvRows(c0, c1)
+			}
+		}(y0, y1, c0, c1)
+	}
+	wg.Wait()
 }
@@ -1,8 +1,10 @@
 package sharpyuv
 
 import (
+	"bytes"
 	"image"
 	"math"
+	"runtime"
 	"testing"
 )
 
@@ -427,3 +429,52 @@ func abs32(v int32) int32 {
 	}
 	return v
 }
+
+// TestConvertSharpParallelMatchesSerial verifies the parallel conversion path
+// (taken for images above minParallelPixels) is bit-exact with the serial one.
+func TestConvertSharpParallelMatchesSerial(t *testing.T) {
+	width, height := 320, 241 // odd height, above the parallel threshold
+	rgb := make([]byte, width*height*3)
+	for i := range rgb {
+		rgb[i] = uint8((i*7 + i/3) % 256)
+	}
+	opts := DefaultOptions()
+
+	yuvPar := image.NewYCbCr(image.Rect(0, 0, width, height), image.YCbCrSubsampleRatio420)
+	if err := Convert(rgb, width, height, width*3, yuvPar, opts); err != nil {
+		t.Fatalf("parallel Convert: %v", err)
+	}
+
+	prev := runtime.GOMAXPROCS(1)
+	yuvSer := image.NewYCbCr(image.Rect(0, 0, width, height), image.YCbCrSubsampleRatio420)
+	err := Convert(rgb, width, height, width*3, yuvSer, opts)
+	runtime.GOMAXPROCS(prev)
+	if err != nil {
+		t.Fatalf("serial Convert: %v", err)
+	}
+
+	if !bytes.Equal(yuvPar.Y, yuvSer.Y) {
+		t.Fatal("Y planes differ between parallel and serial conversion")
+	}
+	if !bytes.Equal(yuvPar.Cb, yuvSer.Cb) {
+		t.Fatal("Cb planes differ between parallel and serial conversion")
+	}
+	if !bytes.Equal(yuvPar.Cr, yuvSer.Cr) {
+		t.Fatal("Cr planes differ between parallel and serial conversion")
+	}
+}
+
+func BenchmarkConvertSharp1080p(b *testing.B) {
+	width, height := 1920, 1080
+	rgb := make([]byte, width*height*3)
+	for i := range rgb {
+		rgb[i] = uint8(i % 256)
+	}
+	yuv := image.NewYCbCr(image.Rect(0, 0, width, height), image.YCbCrSubsampleRatio420)
+	opts := DefaultOptions()
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		_ = Convert(rgb, width, height, width*3, yuv, opts)
+	}
+}
@@ -0,0 +1,234 @@
+package webp
+
+import (
+	"bytes"
+	"errors"
+	"fmt"
+	"image"
+	"io"
+	"time"
+
+	"github.com/deepteams/webp/internal/container"
+	"github.com/deepteams/webp/internal/dsp"
+	"github.com/deepteams/webp/internal/lossless"
+)
+
+// EncoderStats collects statistics about a single [Encode] call. Assign an
+// instance to [EncoderOptions].Stats before encoding; every call overwrites
+// the output fields.
+//
+// Stage times and segment quantizers are reported for the lossy (VP8)
+// encoder; the lossless encoder fills only the byte counts and TotalTime.
+type EncoderStats struct {
+	// ComputeQuality requests PSNR and SSIM of the encoded result against
+	// the source image. This costs an extra decode of the output plus a
+	// luma-plane comparison, so it is off by default.
+	ComputeQuality bool
+
+	// Per-stage wall times of the lossy encoder.
+	AnalysisTime time.Duration // segment analysis + probability seeding
+	QuantizeTime time.Duration // mode decision, quantization, token recording
+	EntropyTime  time.Duration // probability optimization + bitstream emission
+	AlphaTime    time.Duration // alpha-plane compression (overlaps QuantizeTime)
+	TotalTime    time.Duration // the whole Encode call
+
+	// Output bytes per section of the container.
+	BitstreamBytes int // VP8/VP8L payload
+	AlphaBytes     int // ALPH chunk payload (lossy with alpha)
+	HeaderBytes    int // everything else: RIFF/VP8X framing, chunk headers, metadata, padding
+
+	// SegmentQuants holds the base quantizer chosen for each of the four
+	// segments (lossy only).
+	SegmentQuants [4]int
+
+	// PSNR and SSIM of the luma plane, filled only when ComputeQuality is
+	// set. PSNR is capped at 99 dB for a bit-exact result.
+	PSNR float64
+	SSIM float64
+}
+
+// DecodeStats reports where one decode call spent its time, so latency
+// regressions can be attributed to a stage instead of guessed at. All
+// durations are nanoseconds. The lossy stage breakdown (entropy,
+// reconstruction, loop filter) is accumulated inside the decoder with a
+// handful of clock reads per macroblock row, cheap enough to leave
+// enabled in production. On the parallel decode path those three stages
+// overlap in wall time; their values are summed per-goroutine durations
+// and can jointly exceed FrameDecodeNS.
+type DecodeStats struct {
+	ContainerParseNS int64 // RIFF/chunk parsing up to the first frame
+	FrameDecodeNS    int64 // VP8 or VP8L bitstream decode, end to end
+	EntropyNS        int64 // lossy only: boolean-coder token parsing
+	ReconstructNS    int64 // lossy only: prediction + inverse transform
+	FilterNS         int64 // lossy only: loop filter
+	AlphaNS          int64 // ALPH chunk decode (runs concurrently with the frame)
+	ConvertNS        int64 // plane copy / chroma upsample + alpha merge
+	TotalNS          int64 // the whole DecodeWithStats call, including I/O
+
+	BytesConsumed int64 // compressed input size
+	Width, Height int
+	Lossless      bool
+	HasAlpha      bool
+
+	// SIMDTier names the instruction-set tier the dsp dispatch selected
+	// at startup: "avx512", "avx2", "sse2", "neon", or "go".
+	SIMDTier string
+}
+
+// DecodeWithStats is [Decode] with an instrumentation out-parameter: the
+// first frame is decoded exactly as Decode would decode it, and the
+// per-stage timings, sizes, and format flags are recorded into stats.
+// A nil stats falls back to plain Decode. Unlike Decode, the input is
+// always buffered in full, so BytesConsumed reflects the whole file.
+func DecodeWithStats(r io.Reader, stats *DecodeStats) (image.Image, error) {
+	if stats == nil {
+		return Decode(r)
+	}
+	if r == nil {
+		return nil, errors.New("webp: nil reader")
+	}
+	start := time.Now()
+	*stats = DecodeStats{SIMDTier: dsp.SIMDTier()}
+
+	data, err := readAll(r)
+	if err != nil {
+		return nil, fmt.Errorf("webp: reading data: %w", err)
+	}
+	stats.BytesConsumed = int64(len(data))
+
+	parseStart := time.Now()
+	p, err := container.NewParser(data)
+	if err != nil {
+		return nil, fmt.Errorf("webp: parsing container: %w", err)
+	}
+	frames := p.Frames()
+	stats.ContainerParseNS = time.Since(parseStart).Nanoseconds()
+	if len(frames) == 0 {
+		return nil, ErrNoFrames
+	}
+	frame := frames[0]
+	stats.Lossless = frame.IsLossless
+	stats.HasAlpha = len(frame.AlphaData) > 0
+
+	var img image.Image
+	if frame.IsLossless {
+		frameStart := time.Now()
+		img, err = lossless.DecodeVP8L(frame.Payload)
+		if err != nil {
+			return nil, fmt.Errorf("webp: lossless decode: %w", err)
+		}
+		stats.FrameDecodeNS = time.Since(frameStart).Nanoseconds()
+	} else {
+		img, err = decodeLossy(frame.Payload, frame.AlphaData, stats)
+		if err != nil {
+			return nil, err
+		}
+	}
+
+	bounds := img.Bounds()
+	stats.Width = bounds.Dx()
+	stats.Height = bounds.Dy()
+	stats.TotalNS = time.Since(start).Nanoseconds()
+	return img, nil
+}
+
+// encodeWithStats is the Encode path taken when opts.Stats is set. It uses
+// the buffered encoders so section sizes are known, and wraps the writer to
+// count container overhead.
+func encodeWithStats(w io.Writer, img image.Image, opts *EncoderOptions, imgW, imgH int) error {
+	st := opts.Stats
+	*st = EncoderStats{ComputeQuality: st.ComputeQuality}
+	start := time.Now()
+
+	var (
+		bitstream []byte
+		alphaData []byte
+		fourcc    uint32
+		err       error
+	)
+	if opts.Lossless {
+		bitstream, fourcc, err = encodeLossless(img, opts)
+	} else {
+		bitstream, alphaData, fourcc, err = encodeLossyWithAlpha(img, opts)
+	}
+	if err != nil {
+		return err
+	}
+	st.BitstreamBytes = len(bitstream)
+	st.AlphaBytes = len(alphaData)
+
+	// Tee the container into a buffer when the quality metrics need to
+	// decode the result afterwards.
+	out := w
+	var encoded *bytes.Buffer
+	if st.ComputeQuality {
+		encoded = new(bytes.Buffer)
+		out = io.MultiWriter(w, encoded)
+	}
+	cw := &countingWriter{w: out}
+	if err := writeRIFF(cw, fourcc, bitstream, alphaData, imgW, imgH, opts); err != nil {
+		return err
+	}
+	st.HeaderBytes = cw.n - st.BitstreamBytes - st.AlphaBytes
+
+	if st.ComputeQuality {
+		if err := computeQualityMetrics(img, encoded.Bytes(), st); err != nil {
+			return err
+		}
+	}
+	st.TotalTime = time.Since(start)
+	return nil
+}
+
+// countingWriter counts bytes passed through to the underlying writer.
+type countingWriter struct {
+	w io.Writer
+	n int
+}
+
+func (cw *countingWriter) Write(p []byte) (int, error) {
+	n, err := cw.w.Write(p)
+	cw.n += n
+	return n, err
+}
+
+// computeQualityMetrics decodes the encoded output and fills PSNR/SSIM of
+// the luma plane against the source image, using the dsp SSIM kernels.
+func computeQualityMetrics(src image.Image, encoded []byte, st *EncoderStats) error {
+	dec, err := Decode(bytes.NewReader(encoded))
+	if err != nil {
+		return fmt.Errorf("webp: stats: decoding output: %w", err)
+	}
+	b := src.Bounds()
+	w, h := b.Dx(), b.Dy()
+	ref := lumaPlane(src)
+	pix := lumaPlane(dec)
+
+	st.PSNR = dsp.PSNRFromSSE(dsp.SSE(pix, ref, w, h, w, w), w*h)
+
+	// Per-pixel clipped-window SSIM, averaged over the plane (matching
+	// libwebp's AccumulateSSIM).
+	var sum float64
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			sum += dsp.SSIMGetClipped(pix, w, ref, w, x, y, w, h)
+		}
+	}
+	st.SSIM = sum / float64(w*h)
+	return nil
+}
+
+// lumaPlane converts an image to a tightly-packed BT.601 luma plane.
+func lumaPlane(img image.Image) []byte {
+	b := img.Bounds()
+	w, h := b.Dx(), b.Dy()
+	plane := make([]byte, w*h)
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			r, g, bl, _ := img.At(b.Min.X+x, b.Min.Y+y).RGBA()
+			// 16-bit RGBA components; same coefficients as image/color.Gray.
+			plane[y*w+x] = uint8((19595*r + 38470*g + 7471*bl + 1<<15) >> 24)
+		}
+	}
+	return plane
+}
@@ -0,0 +1,217 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"image/color"
+	"testing"
+)
+
+// statsTestImage returns an image with a gradient and a translucent band,
+// so the lossy path also exercises the alpha encoder.
+func statsTestImage(w, h int) *image.NRGBA {
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			a := uint8(255)
+			if y < h/4 {
+				a = 128
+			}
+			img.SetNRGBA(x, y, color.NRGBA{
+				R: uint8(x * 3), G: uint8(y * 5), B: uint8(x + y), A: a,
+			})
+		}
+	}
+	return img
+}
+
+func TestEncoderStatsLossy(t *testing.T) {
+	img := statsTestImage(160, 128)
+	st := &EncoderStats{}
+	opts := &EncoderOptions{Quality: 75, Method: 4, Stats: st}
+
+	var withStats bytes.Buffer
+	if err := Encode(&withStats, img, opts); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	// Stats collection must not change the output.
+	var plain bytes.Buffer
+	if err := Encode(&plain, img, &EncoderOptions{Quality: 75, Method: 4}); err != nil {
+		t.Fatalf("Encode (no stats): %v", err)
+	}
+	if !bytes.Equal(withStats.Bytes(), plain.Bytes()) {
+		t.Error("output with Stats differs from output without")
+	}
+
+	if st.BitstreamBytes <= 0 || st.AlphaBytes <= 0 || st.HeaderBytes <= 0 {
+		t.Errorf("section bytes not filled: bitstream=%d alpha=%d header=%d",
+			st.BitstreamBytes, st.AlphaBytes, st.HeaderBytes)
+	}
+	if total := st.BitstreamBytes + st.AlphaBytes + st.HeaderBytes; total != withStats.Len() {
+		t.Errorf("section bytes sum to %d, file is %d", total, withStats.Len())
+	}
+	if st.TotalTime <= 0 || st.QuantizeTime <= 0 {
+		t.Errorf("stage times not filled: total=%v quantize=%v", st.TotalTime, st.QuantizeTime)
+	}
+	if st.AnalysisTime < 0 || st.EntropyTime < 0 || st.AlphaTime <= 0 {
+		t.Errorf("stage times not filled: analysis=%v entropy=%v alpha=%v",
+			st.AnalysisTime, st.EntropyTime, st.AlphaTime)
+	}
+	for i, q := range st.SegmentQuants {
+		if q < 0 || q > 127 {
+			t.Errorf("SegmentQuants[%d] = %d, out of VP8 range", i, q)
+		}
+	}
+	if st.PSNR != 0 || st.SSIM != 0 {
+		t.Errorf("quality metrics filled without ComputeQuality: psnr=%v ssim=%v", st.PSNR, st.SSIM)
+	}
+}
+
+func TestEncoderStatsQuality(t *testing.T) {
+	img := statsTestImage(96, 96)
+
+	st := &EncoderStats{ComputeQuality: true}
+	var buf bytes.Buffer
+	if err := Encode(&buf, img, &EncoderOptions{Quality: 75, Stats: st}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	if st.PSNR < 20 || st.PSNR > 99 {
+		t.Errorf("lossy PSNR = %.2f, expected a plausible value in [20, 99]", st.PSNR)
+	}
+	if st.SSIM <= 0 || st.SSIM > 1 {
+		t.Errorf("lossy SSIM = %.4f, expected (0, 1]", st.SSIM)
+	}
+
+	// Lossless must report a bit-exact result.
+	st2 := &EncoderStats{ComputeQuality: true}
+	buf.Reset()
+	if err := Encode(&buf, img, &EncoderOptions{Lossless: true, Stats: st2}); err != nil {
+		t.Fatalf("Encode lossless: %v", err)
+	}
+	if st2.PSNR != 99 {
+		t.Errorf("lossless PSNR = %.2f, want 99 (exact)", st2.PSNR)
+	}
+	if st2.SSIM <= 0.999 {
+		t.Errorf("lossless SSIM = %.6f, want ~1", st2.SSIM)
+	}
+}
+
+func TestEncoderStatsLossless(t *testing.T) {
+	img := statsTestImage(64, 64)
+	st := &EncoderStats{}
+	var buf bytes.Buffer
+	if err := Encode(&buf, img, &EncoderOptions{Lossless: true, Stats: st}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	if st.BitstreamBytes <= 0 || st.HeaderBytes <= 0 {
+		t.Errorf("section bytes not filled: bitstream=%d header=%d", st.BitstreamBytes, st.HeaderBytes)
+	}
+	if st.AlphaBytes != 0 {
+		t.Errorf("lossless reported %d alpha bytes, want 0", st.AlphaBytes)
+	}
+	if total := st.BitstreamBytes + st.HeaderBytes; total != buf.Len() {
+		t.Errorf("section bytes sum to %d, file is %d", total, buf.Len())
+	}
+	if st.TotalTime <= 0 {
+		t.Errorf("TotalTime = %v, want > 0", st.TotalTime)
+	}
+}
+
+func TestDecodeStatsLossy(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, sessionTestImage(160, 128, 7), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	var st DecodeStats
+	img, err := DecodeWithStats(bytes.NewReader(buf.Bytes()), &st)
+	if err != nil {
+		t.Fatalf("DecodeWithStats: %v", err)
+	}
+	if _, ok := img.(*image.YCbCr); !ok {
+		t.Errorf("decoded type %T, want *image.YCbCr", img)
+	}
+	if st.Width != 160 || st.Height != 128 {
+		t.Errorf("dimensions %dx%d, want 160x128", st.Width, st.Height)
+	}
+	if st.Lossless || st.HasAlpha {
+		t.Errorf("flags lossless=%v alpha=%v, want false/false", st.Lossless, st.HasAlpha)
+	}
+	if st.BytesConsumed != int64(buf.Len()) {
+		t.Errorf("BytesConsumed = %d, want %d", st.BytesConsumed, buf.Len())
+	}
+	if st.SIMDTier == "" {
+		t.Error("SIMDTier is empty")
+	}
+	if st.TotalNS <= 0 || st.FrameDecodeNS <= 0 || st.FrameDecodeNS > st.TotalNS {
+		t.Errorf("timings total=%d frame=%d inconsistent", st.TotalNS, st.FrameDecodeNS)
+	}
+	if st.EntropyNS <= 0 || st.ReconstructNS <= 0 {
+		t.Errorf("stage breakdown entropy=%d recon=%d, want both > 0", st.EntropyNS, st.ReconstructNS)
+	}
+	if st.AlphaNS != 0 {
+		t.Errorf("AlphaNS = %d for an opaque image, want 0", st.AlphaNS)
+	}
+}
+
+func TestDecodeStatsAlpha(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, statsTestImage(120, 96), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	var st DecodeStats
+	img, err := DecodeWithStats(bytes.NewReader(buf.Bytes()), &st)
+	if err != nil {
+		t.Fatalf("DecodeWithStats: %v", err)
+	}
+	if _, ok := img.(*image.NRGBA); !ok {
+		t.Errorf("decoded type %T, want *image.NRGBA", img)
+	}
+	if !st.HasAlpha {
+		t.Error("HasAlpha = false, want true")
+	}
+	if st.AlphaNS <= 0 {
+		t.Errorf("AlphaNS = %d, want > 0", st.AlphaNS)
+	}
+	if st.ConvertNS <= 0 {
+		t.Errorf("ConvertNS = %d, want > 0 (upsample + alpha merge)", st.ConvertNS)
+	}
+}
+
+func TestDecodeStatsLossless(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, statsTestImage(64, 48), &EncoderOptions{Lossless: true}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	var st DecodeStats
+	if _, err := DecodeWithStats(bytes.NewReader(buf.Bytes()), &st); err != nil {
+		t.Fatalf("DecodeWithStats: %v", err)
+	}
+	if !st.Lossless {
+		t.Error("Lossless = false, want true")
+	}
+	if st.FrameDecodeNS <= 0 {
+		t.Errorf("FrameDecodeNS = %d, want > 0", st.FrameDecodeNS)
+	}
+	if st.EntropyNS != 0 || st.ReconstructNS != 0 || st.FilterNS != 0 {
+		t.Errorf("lossy stage fields set for lossless: %d/%d/%d",
+			st.EntropyNS, st.ReconstructNS, st.FilterNS)
+	}
+}
+
+func TestDecodeStatsNil(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, sessionTestImage(48, 32, 1), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	img, err := DecodeWithStats(bytes.NewReader(buf.Bytes()), nil)
+	if err != nil {
+		t.Fatalf("DecodeWithStats(nil): %v", err)
+	}
+	if b := img.Bounds(); b.Dx() != 48 || b.Dy() != 32 {
+		t.Errorf("dimensions %dx%d, want 48x32", b.Dx(), b.Dy())
+	}
+}
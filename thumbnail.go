@@ -0,0 +1,198 @@
+package webp
+
+import (
+	"fmt"
+	"image"
+	"io"
+
+	"github.com/deepteams/webp/internal/container"
+	"github.com/deepteams/webp/internal/dsp"
+	"github.com/deepteams/webp/internal/lossless"
+	"github.com/deepteams/webp/internal/lossy"
+	"github.com/deepteams/webp/internal/pool"
+)
+
+// Thumbnail decodes the first frame of the WebP image in r, downscales it
+// to fit within maxW x maxH preserving aspect ratio, and writes the
+// re-encoded WebP to w as one fused operation. Images that already fit
+// are re-encoded at their original size; thumbnails never upscale.
+//
+// Lossy sources are rescaled at the YCbCr plane level: no full-size RGBA
+// frame is materialized and no color conversion runs at the source size.
+// Lossless sources are downscaled during ARGB conversion inside the
+// decoder. Scratch planes come from the shared buffer pool.
+//
+// Metadata chunks (ICC, EXIF, XMP) are not carried over from the source;
+// set them on opts to embed them in the thumbnail. A nil opts uses
+// [DefaultOptions].
+func Thumbnail(w io.Writer, r io.Reader, maxW, maxH int, opts *EncoderOptions) error {
+	if w == nil {
+		return fmt.Errorf("webp: nil writer")
+	}
+	if r == nil {
+		return fmt.Errorf("webp: nil reader")
+	}
+	if maxW <= 0 || maxH <= 0 {
+		return fmt.Errorf("webp: invalid thumbnail bounds %dx%d", maxW, maxH)
+	}
+	if opts == nil {
+		opts = DefaultOptions()
+	}
+	if err := validateConfig(opts); err != nil {
+		return err
+	}
+
+	data, err := readAll(r)
+	if err != nil {
+		return fmt.Errorf("webp: reading data: %w", err)
+	}
+	p, err := container.NewParser(data)
+	if err != nil {
+		return fmt.Errorf("webp: parsing container: %w", err)
+	}
+	frames := p.Frames()
+	if len(frames) == 0 {
+		return ErrNoFrames
+	}
+	frame := frames[0]
+
+	if frame.IsLossless {
+		return thumbnailFromLossless(w, frame, maxW, maxH, opts)
+	}
+	return thumbnailFromLossy(w, frame, maxW, maxH, opts)
+}
+
+// thumbnailDims fits srcW x srcH within maxW x maxH preserving aspect
+// ratio, never scaling up.
+func thumbnailDims(srcW, srcH, maxW, maxH int) (dstW, dstH int) {
+	if srcW <= maxW && srcH <= maxH {
+		return srcW, srcH
+	}
+	dstW = maxW
+	dstH = (srcH*maxW + srcW/2) / srcW
+	if dstH > maxH {
+		dstH = maxH
+		dstW = (srcW*maxH + srcH/2) / srcH
+	}
+	if dstW < 1 {
+		dstW = 1
+	}
+	if dstH < 1 {
+		dstH = 1
+	}
+	return dstW, dstH
+}
+
+// thumbnailFromLossless downscales a VP8L frame during the decoder's ARGB
+// conversion and re-encodes it with the regular Encode path at thumbnail
+// size.
+func thumbnailFromLossless(w io.Writer, frame container.FrameInfo, maxW, maxH int, opts *EncoderOptions) error {
+	dstW, dstH := thumbnailDims(frame.Width, frame.Height, maxW, maxH)
+	img, err := lossless.DecodeVP8LScaled(frame.Payload, dstW, dstH)
+	if err != nil {
+		return fmt.Errorf("webp: lossless decode: %w", err)
+	}
+	return Encode(w, img, opts)
+}
+
+// thumbnailFromLossy rescales the decoder's Y/U/V (and alpha) planes
+// directly to thumbnail size and feeds them to the encoder without an
+// intermediate RGBA frame. Only a lossless re-encode converts to RGBA,
+// and then at thumbnail size.
+func thumbnailFromLossy(w io.Writer, frame container.FrameInfo, maxW, maxH int, opts *EncoderOptions) error {
+	dec, width, height, yPlane, yStride, uPlane, vPlane, uvStride, err := lossy.DecodeFrame(frame.Payload)
+	if err != nil {
+		return fmt.Errorf("webp: lossy decode: %w", err)
+	}
+	defer lossy.ReleaseDecoder(dec)
+
+	var alphaPlane []byte
+	if len(frame.AlphaData) > 0 {
+		alphaPlane, err = lossy.DecodeAlpha(frame.AlphaData, width, height)
+		if err != nil {
+			return fmt.Errorf("webp: alpha decode: %w", err)
+		}
+	}
+
+	dstW, dstH := thumbnailDims(width, height, maxW, maxH)
+	srcCW, srcCH := (width+1)/2, (height+1)/2
+	dstCW, dstCH := (dstW+1)/2, (dstH+1)/2
+
+	var yuv *image.YCbCr
+	var alpha []byte
+	if dstW == width && dstH == height {
+		// Already fits: feed the decoder planes straight through.
+		yuv = &image.YCbCr{
+			Y:              yPlane,
+			Cb:             uPlane,
+			Cr:             vPlane,
+			YStride:        yStride,
+			CStride:        uvStride,
+			SubsampleRatio: image.YCbCrSubsampleRatio420,
+			Rect:           image.Rect(0, 0, width, height),
+		}
+		alpha = alphaPlane
+	} else {
+		yLen := dstW * dstH
+		cLen := dstCW * dstCH
+		buf := pool.Get(yLen + 2*cLen)
+		defer pool.Put(buf)
+		scaledY := buf[:yLen]
+		scaledU := buf[yLen : yLen+cLen]
+		scaledV := buf[yLen+cLen : yLen+2*cLen]
+		dsp.RescalePlane(yPlane, yStride, width, height, scaledY, dstW, dstW, dstH)
+		dsp.RescalePlane(uPlane, uvStride, srcCW, srcCH, scaledU, dstCW, dstCW, dstCH)
+		dsp.RescalePlane(vPlane, uvStride, srcCW, srcCH, scaledV, dstCW, dstCW, dstCH)
+		yuv = &image.YCbCr{
+			Y:              scaledY,
+			Cb:             scaledU,
+			Cr:             scaledV,
+			YStride:        dstW,
+			CStride:        dstCW,
+			SubsampleRatio: image.YCbCrSubsampleRatio420,
+			Rect:           image.Rect(0, 0, dstW, dstH),
+		}
+		if alphaPlane != nil {
+			alphaBuf := pool.Get(dstW * dstH)
+			defer pool.Put(alphaBuf)
+			dsp.RescalePlane(alphaPlane, width, width, height, alphaBuf, dstW, dstW, dstH)
+			alpha = alphaBuf[:dstW*dstH]
+		}
+	}
+
+	if opts.Lossless {
+		// Lossless re-encode needs RGBA; convert once, at thumbnail size.
+		img := buildNRGBA(dstW, dstH, yuv.Y, yuv.YStride, yuv.Cb, yuv.Cr, yuv.CStride, alpha)
+		return Encode(w, img, opts)
+	}
+
+	enc := lossy.NewEncoderFromYUV(yuv, dstW, dstH, lossyEncodeConfig(opts, alpha != nil))
+	defer lossy.ReleaseEncoder(enc)
+
+	// Overlap the alpha-plane encode with the VP8 frame encode, as the
+	// one-shot lossy path does.
+	var (
+		alphaData []byte
+		alphaErr  error
+		alphaDone chan struct{}
+	)
+	if alpha != nil {
+		alphaDone = make(chan struct{})
+		go func() {
+			defer close(alphaDone)
+			alphaData, alphaErr = lossy.EncodeAlpha(alpha, dstW, dstH, alphaEncodeConfig(opts))
+		}()
+	}
+
+	bs, err := enc.EncodeFrame()
+	if alphaDone != nil {
+		<-alphaDone
+	}
+	if err != nil {
+		return fmt.Errorf("webp: lossy encode: %w", err)
+	}
+	if alphaErr != nil {
+		return fmt.Errorf("webp: alpha encode: %w", alphaErr)
+	}
+	return writeRIFF(w, container.FourCCVP8, bs, alphaData, dstW, dstH, opts)
+}
@@ -0,0 +1,134 @@
+package webp
+
+import (
+	"bytes"
+	"testing"
+)
+
+func TestThumbnailDims(t *testing.T) {
+	cases := []struct {
+		srcW, srcH, maxW, maxH int
+		wantW, wantH           int
+	}{
+		{300, 200, 100, 100, 100, 67},
+		{200, 300, 100, 100, 67, 100},
+		{50, 40, 100, 100, 50, 40}, // already fits: keep size
+		{1000, 10, 100, 100, 100, 1},
+		{10, 1000, 100, 100, 1, 100},
+		{256, 256, 64, 64, 64, 64},
+	}
+	for _, tc := range cases {
+		gotW, gotH := thumbnailDims(tc.srcW, tc.srcH, tc.maxW, tc.maxH)
+		if gotW != tc.wantW || gotH != tc.wantH {
+			t.Errorf("thumbnailDims(%d, %d, %d, %d) = %dx%d, want %dx%d",
+				tc.srcW, tc.srcH, tc.maxW, tc.maxH, gotW, gotH, tc.wantW, tc.wantH)
+		}
+	}
+}
+
+func TestThumbnailLossySource(t *testing.T) {
+	var src bytes.Buffer
+	if err := Encode(&src, sessionTestImage(300, 200, 0), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	var thumb bytes.Buffer
+	if err := Thumbnail(&thumb, bytes.NewReader(src.Bytes()), 100, 100, nil); err != nil {
+		t.Fatalf("Thumbnail: %v", err)
+	}
+	cfg, err := DecodeConfig(bytes.NewReader(thumb.Bytes()))
+	if err != nil {
+		t.Fatalf("DecodeConfig: %v", err)
+	}
+	if cfg.Width != 100 || cfg.Height != 67 {
+		t.Errorf("thumbnail is %dx%d, want 100x67", cfg.Width, cfg.Height)
+	}
+	if _, err := Decode(bytes.NewReader(thumb.Bytes())); err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+}
+
+func TestThumbnailLosslessSource(t *testing.T) {
+	var src bytes.Buffer
+	if err := Encode(&src, sessionTestImage(160, 120, 1), &EncoderOptions{Lossless: true}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	for _, lossless := range []bool{false, true} {
+		var thumb bytes.Buffer
+		opts := &EncoderOptions{Lossless: lossless, Quality: 75, Method: 4}
+		if err := Thumbnail(&thumb, bytes.NewReader(src.Bytes()), 80, 80, opts); err != nil {
+			t.Fatalf("Thumbnail(lossless=%v): %v", lossless, err)
+		}
+		cfg, err := DecodeConfig(bytes.NewReader(thumb.Bytes()))
+		if err != nil {
+			t.Fatalf("DecodeConfig: %v", err)
+		}
+		if cfg.Width != 80 || cfg.Height != 60 {
+			t.Errorf("lossless=%v: thumbnail is %dx%d, want 80x60", lossless, cfg.Width, cfg.Height)
+		}
+	}
+}
+
+func TestThumbnailAlpha(t *testing.T) {
+	var src bytes.Buffer
+	if err := Encode(&src, statsTestImage(120, 90), &EncoderOptions{Quality: 75}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	feat, err := GetFeatures(bytes.NewReader(src.Bytes()))
+	if err != nil {
+		t.Fatalf("GetFeatures(src): %v", err)
+	}
+	if !feat.HasAlpha {
+		t.Fatal("source image has no alpha; test image changed?")
+	}
+
+	var thumb bytes.Buffer
+	if err := Thumbnail(&thumb, bytes.NewReader(src.Bytes()), 60, 60, nil); err != nil {
+		t.Fatalf("Thumbnail: %v", err)
+	}
+	feat, err = GetFeatures(bytes.NewReader(thumb.Bytes()))
+	if err != nil {
+		t.Fatalf("GetFeatures(thumb): %v", err)
+	}
+	if !feat.HasAlpha {
+		t.Error("alpha channel lost in thumbnail")
+	}
+	if feat.Width != 60 || feat.Height != 45 {
+		t.Errorf("thumbnail is %dx%d, want 60x45", feat.Width, feat.Height)
+	}
+}
+
+func TestThumbnailSameSizePassThrough(t *testing.T) {
+	var src bytes.Buffer
+	if err := Encode(&src, sessionTestImage(64, 48, 2), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	var thumb bytes.Buffer
+	if err := Thumbnail(&thumb, bytes.NewReader(src.Bytes()), 128, 128, nil); err != nil {
+		t.Fatalf("Thumbnail: %v", err)
+	}
+	cfg, err := DecodeConfig(bytes.NewReader(thumb.Bytes()))
+	if err != nil {
+		t.Fatalf("DecodeConfig: %v", err)
+	}
+	if cfg.Width != 64 || cfg.Height != 48 {
+		t.Errorf("thumbnail is %dx%d, want 64x48 (no upscale)", cfg.Width, cfg.Height)
+	}
+}
+
+func TestThumbnailErrors(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Thumbnail(nil, bytes.NewReader(nil), 10, 10, nil); err == nil {
+		t.Error("nil writer accepted")
+	}
+	if err := Thumbnail(&buf, nil, 10, 10, nil); err == nil {
+		t.Error("nil reader accepted")
+	}
+	if err := Thumbnail(&buf, bytes.NewReader(nil), 0, 10, nil); err == nil {
+		t.Error("zero bounds accepted")
+	}
+	if err := Thumbnail(&buf, bytes.NewReader([]byte("not webp")), 10, 10, nil); err == nil {
+		t.Error("garbage input accepted")
+	}
+}
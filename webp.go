@@ -12,6 +12,7 @@ import (
 	"image"
 	"image/color"
 	"io"
+	"time"
 
 	"github.com/deepteams/webp/animation"
 	"github.com/deepteams/webp/internal/container"
@@ -26,6 +27,11 @@ func init() {
 	// Wire the animation package's frame decoder to our VP8/VP8L decoders.
 	animation.FrameDecoderFunc = decodeFrameForAnimation
 
+	// Wire the raw-format decoder and the SIMD YCbCr conversion used by the
+	// animation package's zero-conversion frame path.
+	animation.FrameDecoderRawFunc = decodeRawFrameForAnimation
+	animation.YCbCrToNRGBAFunc = ycbcrToNRGBAFancy
+
 	// Wire the animation package's frame encoder to our VP8/VP8L encoders.
 	animation.FrameEncoderFunc = encodeFrameForAnimation
 
@@ -85,23 +91,59 @@ func readAll(r io.Reader) ([]byte, error) {
 // Decode reads a WebP image from r and returns it as an image.Image.
 // For lossless images the returned type is *image.NRGBA.
 // For lossy images the returned type is *image.YCbCr (when available) or *image.NRGBA.
+//
+// Inputs that are already in memory (anything with a Len() method, such as
+// *bytes.Reader) are decoded in place. Other readers are consumed
+// incrementally, chunk by chunk, so decoding the first frame of a large
+// animated file does not require buffering the whole file.
 func Decode(r io.Reader) (image.Image, error) {
 	if r == nil {
 		return nil, errors.New("webp: nil reader")
 	}
-	data, err := readAll(r)
+	// In-memory readers: keep the single-allocation, zero-copy slice path.
+	if _, ok := r.(interface{ Len() int }); ok {
+		data, err := readAll(r)
+		if err != nil {
+			return nil, fmt.Errorf("webp: reading data: %w", err)
+		}
+		return decodeBytes(data)
+	}
+	return decodeStream(r)
+}
+
+// decodeStream decodes the first frame from a streaming reader without
+// buffering the complete file. Only the chunks up to and including the
+// first image frame are read.
+func decodeStream(r io.Reader) (image.Image, error) {
+	p, err := container.NewStreamParser(r)
 	if err != nil {
-		return nil, fmt.Errorf("webp: reading data: %w", err)
+		return nil, fmt.Errorf("webp: parsing container: %w", err)
+	}
+	frame, err := p.NextFrame()
+	if err == io.EOF {
+		return nil, ErrNoFrames
 	}
-	return decodeBytes(data)
+	if err != nil {
+		return nil, fmt.Errorf("webp: parsing container: %w", err)
+	}
+	return decodeFrame(frame)
 }
 
 // DecodeConfig returns the color model and dimensions of a WebP image
 // without decoding the entire image.
+//
+// For readers that are not already in memory, only the container prefix up
+// to the first frame header is read, so probing a large file costs a
+// bounded amount of I/O and allocation.
 func DecodeConfig(r io.Reader) (image.Config, error) {
 	if r == nil {
 		return image.Config{}, errors.New("webp: nil reader")
 	}
+
+	if _, ok := r.(interface{ Len() int }); !ok {
+		return decodeConfigStream(r)
+	}
+
 	data, err := readAll(r)
 	if err != nil {
 		return image.Config{}, fmt.Errorf("webp: reading data: %w", err)
@@ -134,13 +176,54 @@ func DecodeConfig(r io.Reader) (image.Config, error) {
 	}, nil
 }
 
+// decodeConfigStream probes config from a streaming reader, reading only
+// chunk headers and the first frame's bitstream header.
+func decodeConfigStream(r io.Reader) (image.Config, error) {
+	p, err := container.NewStreamParser(r)
+	if err != nil {
+		return image.Config{}, fmt.Errorf("webp: parsing container: %w", err)
+	}
+
+	frame, err := p.NextFrameHeader()
+	feat := p.Features()
+
+	cm := color.NRGBAModel
+	switch {
+	case err == nil:
+		if !frame.IsLossless && !frame.HasAlpha {
+			cm = color.YCbCrModel
+		}
+	case err == io.EOF:
+		if !feat.HasAlpha {
+			cm = color.YCbCrModel
+		}
+	default:
+		return image.Config{}, fmt.Errorf("webp: parsing container: %w", err)
+	}
+
+	return image.Config{
+		ColorModel: cm,
+		Width:      feat.Width,
+		Height:     feat.Height,
+	}, nil
+}
+
 // GetFeatures reads WebP features (dimensions, format, alpha, animation)
 // without decoding pixel data. It parses just the RIFF container and chunk
 // headers, making it much cheaper than a full [Decode].
+//
+// For readers that are not already in memory, pixel payloads are skipped
+// rather than buffered (seeking past them when the reader is an io.Seeker),
+// so probing a large file allocates only a few hundred bytes.
 func GetFeatures(r io.Reader) (*Features, error) {
 	if r == nil {
 		return nil, errors.New("webp: nil reader")
 	}
+
+	if _, ok := r.(interface{ Len() int }); !ok {
+		return getFeaturesStream(r)
+	}
+
 	data, err := readAll(r)
 	if err != nil {
 		return nil, fmt.Errorf("webp: reading data: %w", err)
@@ -151,14 +234,42 @@ func GetFeatures(r io.Reader) (*Features, error) {
 		return nil, fmt.Errorf("webp: parsing container: %w", err)
 	}
 
-	feat := p.Features()
+	return featuresFromContainer(p.Features(), len(p.Frames())), nil
+}
+
+// getFeaturesStream probes features from a streaming reader, walking chunk
+// headers and skipping pixel payloads.
+func getFeaturesStream(r io.Reader) (*Features, error) {
+	p, err := container.NewStreamParser(r)
+	if err != nil {
+		return nil, fmt.Errorf("webp: parsing container: %w", err)
+	}
+
+	frames := 0
+	for {
+		_, err := p.NextFrameHeader()
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			return nil, fmt.Errorf("webp: parsing container: %w", err)
+		}
+		frames++
+	}
+
+	return featuresFromContainer(p.Features(), frames), nil
+}
+
+// featuresFromContainer converts container-level features to the public
+// Features struct.
+func featuresFromContainer(feat container.Features, frameCount int) *Features {
 	f := &Features{
-		Width:      feat.Width,
-		Height:     feat.Height,
-		HasAlpha:   feat.HasAlpha,
+		Width:        feat.Width,
+		Height:       feat.Height,
+		HasAlpha:     feat.HasAlpha,
 		HasAnimation: feat.HasAnim,
-		FrameCount: len(p.Frames()),
-		LoopCount:  feat.LoopCount,
+		FrameCount:   frameCount,
+		LoopCount:    feat.LoopCount,
 	}
 
 	switch feat.Format {
@@ -172,7 +283,7 @@ func GetFeatures(r io.Reader) (*Features, error) {
 		f.Format = "unknown"
 	}
 
-	return f, nil
+	return f
 }
 
 // decodeBytes decodes a complete WebP file from a byte slice.
@@ -197,7 +308,7 @@ func decodeFrame(frame container.FrameInfo) (image.Image, error) {
 	if frame.IsLossless {
 		return decodeLossless(frame.Payload)
 	}
-	return decodeLossy(frame.Payload, frame.AlphaData)
+	return decodeLossy(frame.Payload, frame.AlphaData, nil)
 }
 
 // decodeLossless decodes a VP8L lossless bitstream.
@@ -250,7 +361,7 @@ func decodeFrameForAnimation(bitstreamData, alphaData []byte) (*image.NRGBA, err
 	if isLossless {
 		img, err = decodeLossless(bitstreamData)
 	} else {
-		img, err = decodeLossy(bitstreamData, alphaData)
+		img, err = decodeLossy(bitstreamData, alphaData, nil)
 	}
 	if err != nil {
 		return nil, err
@@ -273,6 +384,29 @@ func decodeFrameForAnimation(bitstreamData, alphaData []byte) (*image.NRGBA, err
 	return nrgba, nil
 }
 
+// decodeRawFrameForAnimation decodes a VP8/VP8L bitstream in the codec's
+// native output format for the animation package's FrameDecoderRawFunc:
+// *image.YCbCr (4:2:0) for opaque lossy frames, *image.NRGBA otherwise.
+// No colour-space conversion is performed.
+func decodeRawFrameForAnimation(bitstreamData, alphaData []byte) (image.Image, error) {
+	isLossless := len(bitstreamData) > 0 && bitstreamData[0] == 0x2f
+	if isLossless {
+		return decodeLossless(bitstreamData)
+	}
+	return decodeLossy(bitstreamData, alphaData, nil)
+}
+
+// ycbcrToNRGBAFancy converts a 4:2:0 YCbCr image to NRGBA with the fancy
+// SIMD chroma upsampler. It backs the animation package's YCbCrToNRGBAFunc,
+// used when a frame handed out raw must be materialized as RGBA after all.
+func ycbcrToNRGBAFancy(ycbcr *image.YCbCr) *image.NRGBA {
+	w := ycbcr.Rect.Dx()
+	h := ycbcr.Rect.Dy()
+	img := image.NewNRGBA(image.Rect(0, 0, w, h))
+	renderNRGBA(img, w, h, ycbcr.Y, ycbcr.YStride, ycbcr.Cb, ycbcr.Cr, ycbcr.CStride, nil)
+	return img
+}
+
 // ycbcrToNRGBA converts a 4:2:0 YCbCr image to NRGBA using direct
 // YCbCr→RGB conversion (no fancy upsampling, as animation compositing
 // doesn't require it).
@@ -320,29 +454,65 @@ func ycbcrToNRGBA(ycbcr *image.YCbCr) *image.NRGBA {
 // Without alpha data it returns *image.YCbCr (4:2:0) — no colour-space
 // conversion needed, just a plane copy.  With alpha it falls back to
 // *image.NRGBA using fancy chroma upsampling.
-func decodeLossy(data []byte, alphaData []byte) (image.Image, error) {
+// When stats is non-nil the frame/alpha/conversion timings and the
+// decoder's stage breakdown are recorded into it.
+func decodeLossy(data []byte, alphaData []byte, stats *DecodeStats) (image.Image, error) {
+	// The ALPH chunk (a VP8L sub-decode) and the VP8 bitstream share
+	// nothing until the merge, so decode the alpha plane concurrently
+	// with the frame. Alpha only needs the dimensions, which the VP8
+	// frame header provides up front.
+	var (
+		alphaPlane []byte
+		alphaErr   error
+		alphaNS    int64
+		alphaDone  chan struct{}
+	)
+	frameStart := time.Now()
+	if len(alphaData) > 0 {
+		width, height, err := container.ParseVP8Header(data)
+		if err != nil {
+			return nil, fmt.Errorf("webp: lossy decode: %w", err)
+		}
+		alphaDone = make(chan struct{})
+		go func() {
+			defer close(alphaDone)
+			start := time.Now()
+			alphaPlane, alphaErr = lossy.DecodeAlpha(alphaData, width, height)
+			alphaNS = time.Since(start).Nanoseconds()
+		}()
+	}
+
 	dec, width, height, yPlane, yStride, uPlane, vPlane, uvStride, err := lossy.DecodeFrame(data)
+	if alphaDone != nil {
+		<-alphaDone
+	}
 	if err != nil {
 		return nil, fmt.Errorf("webp: lossy decode: %w", err)
 	}
 	defer lossy.ReleaseDecoder(dec)
+	if alphaErr != nil {
+		return nil, fmt.Errorf("webp: alpha decode: %w", alphaErr)
+	}
 
-	// Decode alpha plane if present.
-	var alphaPlane []byte
-	if len(alphaData) > 0 {
-		alphaPlane, err = lossy.DecodeAlpha(alphaData, width, height)
-		if err != nil {
-			return nil, fmt.Errorf("webp: alpha decode: %w", err)
-		}
+	convertStart := time.Now()
+	if stats != nil {
+		stats.FrameDecodeNS = convertStart.Sub(frameStart).Nanoseconds()
+		stats.EntropyNS, stats.ReconstructNS, stats.FilterNS = dec.StageTimings()
+		stats.AlphaNS = alphaNS
 	}
 
 	// Fast path: no alpha → return *image.YCbCr directly.
+	var img image.Image
 	if alphaPlane == nil {
-		return buildYCbCr(width, height, yPlane, yStride, uPlane, vPlane, uvStride), nil
+		img = buildYCbCr(width, height, yPlane, yStride, uPlane, vPlane, uvStride)
+	} else {
+		// Slow path: alpha present → NRGBA with fancy chroma upsampling.
+		img = buildNRGBA(width, height, yPlane, yStride, uPlane, vPlane, uvStride, alphaPlane)
 	}
-
-	// Slow path: alpha present → NRGBA with fancy chroma upsampling.
-	return buildNRGBA(width, height, yPlane, yStride, uPlane, vPlane, uvStride, alphaPlane), nil
+	if stats != nil {
+		stats.ConvertNS = time.Since(convertStart).Nanoseconds()
+	}
+	return img, nil
 }
 
 // buildYCbCr copies the decoder's Y/U/V cache planes into an image.YCbCr.
@@ -378,6 +548,14 @@ func buildYCbCr(width, height int, yPlane []byte, yStride int, uPlane, vPlane []
 // the diamond-shaped 4-tap fancy upsampler (FANCY_UPSAMPLING from libwebp).
 func buildNRGBA(width, height int, yPlane []byte, yStride int, uPlane, vPlane []byte, uvStride int, alphaPlane []byte) *image.NRGBA {
 	img := image.NewNRGBA(image.Rect(0, 0, width, height))
+	renderNRGBA(img, width, height, yPlane, yStride, uPlane, vPlane, uvStride, alphaPlane)
+	return img
+}
+
+// renderNRGBA performs the fancy-upsampled YUV(+alpha) to NRGBA conversion
+// into an existing image whose bounds are width x height.
+func renderNRGBA(img *image.NRGBA, width, height int, yPlane []byte, yStride int, uPlane, vPlane []byte, uvStride int, alphaPlane []byte) {
+	base := img.PixOffset(img.Rect.Min.X, img.Rect.Min.Y)
 
 	yRow := func(row int) []byte {
 		off := row * yStride
@@ -399,7 +577,7 @@ func buildNRGBA(width, height int, yPlane []byte, yStride int, uPlane, vPlane []
 		return alphaPlane[off : off+width]
 	}
 	dstRow := func(row int) []byte {
-		off := row * img.Stride
+		off := base + row*img.Stride
 		return img.Pix[off : off+width*4]
 	}
 
@@ -408,7 +586,7 @@ func buildNRGBA(width, height int, yPlane []byte, yStride int, uPlane, vPlane []
 			yRow(0), nil, uRow(0), vRow(0), uRow(0), vRow(0),
 			dstRow(0), nil, aRow(0), nil, width,
 		)
-		return img
+		return
 	}
 
 	// Row 0: mirror chroma.
@@ -445,6 +623,4 @@ func buildNRGBA(width, height int, yPlane []byte, yStride int, uPlane, vPlane []
 			width,
 		)
 	}
-
-	return img
 }
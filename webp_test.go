@@ -4,6 +4,7 @@ import (
 	"bytes"
 	"image"
 	"image/color"
+	"io"
 	"os"
 	"path/filepath"
 	"testing"
@@ -461,6 +462,106 @@ func TestDecodeAnimatedReturnsFirstFrame(t *testing.T) {
 	}
 }
 
+func TestDecodeRawFrameForAnimation(t *testing.T) {
+	// An opaque lossy frame must come back in the codec's native YCbCr
+	// format, with no colour-space conversion.
+	const W, H = 32, 24
+	img := image.NewNRGBA(image.Rect(0, 0, W, H))
+	for y := 0; y < H; y++ {
+		for x := 0; x < W; x++ {
+			img.SetNRGBA(x, y, color.NRGBA{R: uint8(x * 8), G: uint8(y * 10), B: 100, A: 255})
+		}
+	}
+	bs, err := encodeFrameForAnimation(img, false, 75)
+	if err != nil {
+		t.Fatalf("encodeFrameForAnimation: %v", err)
+	}
+
+	raw, err := decodeRawFrameForAnimation(bs, nil)
+	if err != nil {
+		t.Fatalf("decodeRawFrameForAnimation: %v", err)
+	}
+	ycbcr, ok := raw.(*image.YCbCr)
+	if !ok {
+		t.Fatalf("raw frame = %T, want *image.YCbCr", raw)
+	}
+	if ycbcr.Rect.Dx() != W || ycbcr.Rect.Dy() != H {
+		t.Errorf("raw frame size = %dx%d, want %dx%d", ycbcr.Rect.Dx(), ycbcr.Rect.Dy(), W, H)
+	}
+
+	// The fancy-upsampling fallback must produce a full-size opaque NRGBA
+	// close to the original (lossy tolerance).
+	nrgba := ycbcrToNRGBAFancy(ycbcr)
+	if nrgba.Bounds().Dx() != W || nrgba.Bounds().Dy() != H {
+		t.Fatalf("converted size = %dx%d, want %dx%d", nrgba.Bounds().Dx(), nrgba.Bounds().Dy(), W, H)
+	}
+	for y := 0; y < H; y++ {
+		for x := 0; x < W; x++ {
+			got := nrgba.NRGBAAt(x, y)
+			want := img.NRGBAAt(x, y)
+			if got.A != 255 {
+				t.Fatalf("alpha at (%d,%d) = %d, want 255", x, y, got.A)
+			}
+			if absDiffU8(got.R, want.R) > 32 || absDiffU8(got.G, want.G) > 32 || absDiffU8(got.B, want.B) > 32 {
+				t.Fatalf("pixel (%d,%d) = %v, want ~%v", x, y, got, want)
+			}
+		}
+	}
+}
+
+func TestStreamDecoderRawLossyFrames(t *testing.T) {
+	// End-to-end: full-canvas opaque lossy frames flow through
+	// StreamDecoder.NextFrameRaw as YCbCr without any RGB conversion.
+	const W, H = 16, 16
+	anim := &animation.Animation{CanvasWidth: W, CanvasHeight: H}
+	for i := 0; i < 3; i++ {
+		img := image.NewNRGBA(image.Rect(0, 0, W, H))
+		c := color.NRGBA{R: uint8(i * 80), G: 128, B: 0, A: 255}
+		for y := 0; y < H; y++ {
+			for x := 0; x < W; x++ {
+				img.SetNRGBA(x, y, c)
+			}
+		}
+		bs, err := encodeFrameForAnimation(img, false, 75)
+		if err != nil {
+			t.Fatalf("encodeFrameForAnimation %d: %v", i, err)
+		}
+		anim.Frames = append(anim.Frames, animation.Frame{
+			BitstreamData: bs,
+			Width:         W,
+			Height:        H,
+			Duration:      100 * time.Millisecond,
+			Blend:         animation.BlendNone,
+		})
+	}
+
+	sd, err := animation.NewStreamDecoder(anim, nil)
+	if err != nil {
+		t.Fatalf("NewStreamDecoder: %v", err)
+	}
+	for i := 0; sd.HasNext(); i++ {
+		frame, _, err := sd.NextFrameRaw()
+		if err != nil {
+			t.Fatalf("NextFrameRaw %d: %v", i, err)
+		}
+		ycbcr, ok := frame.(*image.YCbCr)
+		if !ok {
+			t.Fatalf("frame %d = %T, want *image.YCbCr", i, frame)
+		}
+		if ycbcr.Rect.Dx() != W || ycbcr.Rect.Dy() != H {
+			t.Errorf("frame %d size = %dx%d, want %dx%d", i, ycbcr.Rect.Dx(), ycbcr.Rect.Dy(), W, H)
+		}
+	}
+}
+
+func absDiffU8(a, b uint8) int {
+	d := int(a) - int(b)
+	if d < 0 {
+		return -d
+	}
+	return d
+}
+
 func TestDecodeConfigEdgeCases(t *testing.T) {
 	t.Run("1x1_lossless", func(t *testing.T) {
 		img := image.NewNRGBA(image.Rect(0, 0, 1, 1))
@@ -1019,3 +1120,97 @@ func TestEncodeWithMetadata_AllLargeBlobs(t *testing.T) {
 		})
 	}
 }
+
+// --- Streaming reader tests ---
+
+// streamOnly hides Len() and Seek so the package must treat the input as a
+// plain forward-only stream.
+type streamOnly struct {
+	r io.Reader
+}
+
+func (s *streamOnly) Read(p []byte) (int, error) { return s.r.Read(p) }
+
+// makeTestAnimation encodes a small 3-frame animation and returns its bytes.
+func makeTestAnimation(t *testing.T) []byte {
+	t.Helper()
+	const W, H = 16, 16
+	var buf bytes.Buffer
+	enc := animation.NewEncoder(&buf, W, H, nil)
+	for i := 0; i < 3; i++ {
+		img := image.NewNRGBA(image.Rect(0, 0, W, H))
+		c := color.NRGBA{R: uint8(i * 80), G: 128, B: 0, A: 255}
+		for y := 0; y < H; y++ {
+			for x := 0; x < W; x++ {
+				img.SetNRGBA(x, y, c)
+			}
+		}
+		if err := enc.AddFrame(img, 100*time.Millisecond); err != nil {
+			t.Fatalf("AddFrame %d: %v", i, err)
+		}
+	}
+	if err := enc.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	return buf.Bytes()
+}
+
+// TestStreamingMatchesInMemory verifies that Decode, DecodeConfig and
+// GetFeatures produce identical results whether the input is an in-memory
+// reader or a plain forward-only stream.
+func TestStreamingMatchesInMemory(t *testing.T) {
+	inputs := map[string][]byte{
+		"red_4x4_lossy.webp":         readTestFile(t, "red_4x4_lossy.webp"),
+		"red_4x4_lossless.webp":      readTestFile(t, "red_4x4_lossless.webp"),
+		"blue_16x16_lossy.webp":      readTestFile(t, "blue_16x16_lossy.webp"),
+		"gradient_8x8_lossless.webp": readTestFile(t, "gradient_8x8_lossless.webp"),
+		"animated":                   makeTestAnimation(t),
+	}
+
+	for name, data := range inputs {
+		t.Run(name, func(t *testing.T) {
+			wantCfg, err := DecodeConfig(bytes.NewReader(data))
+			if err != nil {
+				t.Fatalf("DecodeConfig (memory): %v", err)
+			}
+			gotCfg, err := DecodeConfig(&streamOnly{r: bytes.NewReader(data)})
+			if err != nil {
+				t.Fatalf("DecodeConfig (stream): %v", err)
+			}
+			if gotCfg != wantCfg {
+				t.Errorf("DecodeConfig = %+v, want %+v", gotCfg, wantCfg)
+			}
+
+			wantFeat, err := GetFeatures(bytes.NewReader(data))
+			if err != nil {
+				t.Fatalf("GetFeatures (memory): %v", err)
+			}
+			gotFeat, err := GetFeatures(&streamOnly{r: bytes.NewReader(data)})
+			if err != nil {
+				t.Fatalf("GetFeatures (stream): %v", err)
+			}
+			if *gotFeat != *wantFeat {
+				t.Errorf("GetFeatures = %+v, want %+v", *gotFeat, *wantFeat)
+			}
+
+			wantImg, err := Decode(bytes.NewReader(data))
+			if err != nil {
+				t.Fatalf("Decode (memory): %v", err)
+			}
+			gotImg, err := Decode(&streamOnly{r: bytes.NewReader(data)})
+			if err != nil {
+				t.Fatalf("Decode (stream): %v", err)
+			}
+			if gotImg.Bounds() != wantImg.Bounds() {
+				t.Fatalf("Decode bounds = %v, want %v", gotImg.Bounds(), wantImg.Bounds())
+			}
+			for y := 0; y < wantImg.Bounds().Dy(); y++ {
+				for x := 0; x < wantImg.Bounds().Dx(); x++ {
+					if gotImg.At(x, y) != wantImg.At(x, y) {
+						t.Fatalf("pixel (%d,%d) = %v, want %v", x, y, gotImg.At(x, y), wantImg.At(x, y))
+					}
+				}
+			}
+		})
+	}
+}
@@ -0,0 +1,126 @@
+package webp
+
+import (
+	"errors"
+	"fmt"
+	"image"
+	"io"
+
+	"github.com/deepteams/webp/internal/container"
+	"github.com/deepteams/webp/internal/lossy"
+)
+
+// YUVImage exposes a decoded lossy frame's native YCbCr 4:2:0 planes,
+// plus the alpha plane when the file has one. The planes are the
+// decoder's own output buffers — no copy and no RGB conversion is
+// performed — so consumers that work in YUV natively (video pipelines,
+// re-encoders) skip the round trip entirely.
+type YUVImage struct {
+	// Y, Cb, Cr are the luma and chroma planes. Chroma is subsampled
+	// 4:2:0: each plane is ceil(Width/2) x ceil(Height/2).
+	Y, Cb, Cr []byte
+	// A is the alpha plane (one byte per pixel, stride == Width),
+	// or nil when the image is opaque.
+	A []byte
+
+	YStride int // bytes per luma row
+	CStride int // bytes per chroma row
+
+	Width, Height int
+}
+
+// DecodeYUV decodes the first frame of a lossy WebP image and returns its
+// YCbCr (and alpha) planes directly, skipping RGB conversion. The alpha
+// plane decodes concurrently with the frame as in Decode. VP8L (lossless)
+// bitstreams decode to RGBA and have no YUV planes; DecodeYUV returns an
+// error for them — use Decode instead.
+func DecodeYUV(r io.Reader) (*YUVImage, error) {
+	if r == nil {
+		return nil, errors.New("webp: nil reader")
+	}
+	data, err := readAll(r)
+	if err != nil {
+		return nil, fmt.Errorf("webp: reading data: %w", err)
+	}
+	p, err := container.NewParser(data)
+	if err != nil {
+		return nil, fmt.Errorf("webp: parsing container: %w", err)
+	}
+	frames := p.Frames()
+	if len(frames) == 0 {
+		return nil, ErrNoFrames
+	}
+	frame := frames[0]
+	if frame.IsLossless {
+		return nil, errors.New("webp: DecodeYUV: lossless bitstreams have no YUV planes; use Decode")
+	}
+
+	var (
+		alphaPlane []byte
+		alphaErr   error
+		alphaDone  chan struct{}
+	)
+	if len(frame.AlphaData) > 0 {
+		width, height, err := container.ParseVP8Header(frame.Payload)
+		if err != nil {
+			return nil, fmt.Errorf("webp: lossy decode: %w", err)
+		}
+		alphaDone = make(chan struct{})
+		go func() {
+			defer close(alphaDone)
+			alphaPlane, alphaErr = lossy.DecodeAlpha(frame.AlphaData, width, height)
+		}()
+	}
+
+	dec, width, height, yPlane, yStride, uPlane, vPlane, uvStride, err := lossy.DecodeFrame(frame.Payload)
+	if alphaDone != nil {
+		<-alphaDone
+	}
+	if err != nil {
+		return nil, fmt.Errorf("webp: lossy decode: %w", err)
+	}
+	if alphaErr != nil {
+		lossy.ReleaseDecoder(dec)
+		return nil, fmt.Errorf("webp: alpha decode: %w", alphaErr)
+	}
+
+	// The returned planes alias the decoder's buffers, so the decoder is
+	// deliberately not returned to the pool; the planes stay valid for
+	// the life of the YUVImage and the GC reclaims them with it.
+	_ = dec
+
+	chromaH := (height + 1) / 2
+	return &YUVImage{
+		Y:       yPlane[:height*yStride],
+		Cb:      uPlane[:chromaH*uvStride],
+		Cr:      vPlane[:chromaH*uvStride],
+		A:       alphaPlane,
+		YStride: yStride,
+		CStride: uvStride,
+		Width:   width,
+		Height:  height,
+	}, nil
+}
+
+// YCbCr returns a zero-copy *image.YCbCr view of the planes. The alpha
+// plane, if any, is not represented; use ToNRGBA for composited output.
+func (img *YUVImage) YCbCr() *image.YCbCr {
+	return &image.YCbCr{
+		Y:              img.Y,
+		Cb:             img.Cb,
+		Cr:             img.Cr,
+		YStride:        img.YStride,
+		CStride:        img.CStride,
+		SubsampleRatio: image.YCbCrSubsampleRatio420,
+		Rect:           image.Rect(0, 0, img.Width, img.Height),
+	}
+}
+
+// ToNRGBA converts the planes to NRGBA with the fancy 4-tap chroma
+// upsampler, merging the alpha plane when present. For images with alpha
+// this is the same conversion Decode performs.
+func (img *YUVImage) ToNRGBA() *image.NRGBA {
+	out := image.NewNRGBA(image.Rect(0, 0, img.Width, img.Height))
+	renderNRGBA(out, img.Width, img.Height, img.Y, img.YStride, img.Cb, img.Cr, img.CStride, img.A)
+	return out
+}
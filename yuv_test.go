@@ -0,0 +1,81 @@
+package webp
+
+import (
+	"bytes"
+	"image"
+	"testing"
+)
+
+func TestDecodeYUVOpaque(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, sessionTestImage(120, 90, 0), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	yuv, err := DecodeYUV(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("DecodeYUV: %v", err)
+	}
+	if yuv.Width != 120 || yuv.Height != 90 {
+		t.Fatalf("dimensions %dx%d, want 120x90", yuv.Width, yuv.Height)
+	}
+	if yuv.A != nil {
+		t.Error("opaque image has non-nil alpha plane")
+	}
+
+	// The planes must match what Decode copies into its YCbCr output.
+	dec, err := Decode(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	want, ok := dec.(*image.YCbCr)
+	if !ok {
+		t.Fatalf("Decode returned %T, want *image.YCbCr", dec)
+	}
+	if !bytes.Equal(yuv.Y, want.Y) || !bytes.Equal(yuv.Cb, want.Cb) || !bytes.Equal(yuv.Cr, want.Cr) {
+		t.Error("DecodeYUV planes differ from Decode's YCbCr output")
+	}
+	if got := yuv.YCbCr(); got.YStride != want.YStride || got.CStride != want.CStride {
+		t.Errorf("YCbCr strides (%d, %d), want (%d, %d)",
+			got.YStride, got.CStride, want.YStride, want.CStride)
+	}
+}
+
+func TestDecodeYUVAlphaToNRGBA(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, statsTestImage(80, 70), nil); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+
+	yuv, err := DecodeYUV(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("DecodeYUV: %v", err)
+	}
+	if yuv.A == nil {
+		t.Fatal("translucent image decoded with nil alpha plane")
+	}
+
+	// ToNRGBA must reproduce Decode's fused YUV+alpha conversion exactly.
+	dec, err := Decode(bytes.NewReader(buf.Bytes()))
+	if err != nil {
+		t.Fatalf("Decode: %v", err)
+	}
+	want, ok := dec.(*image.NRGBA)
+	if !ok {
+		t.Fatalf("Decode returned %T, want *image.NRGBA", dec)
+	}
+	got := yuv.ToNRGBA()
+	if !bytes.Equal(got.Pix, want.Pix) {
+		t.Error("ToNRGBA output differs from Decode")
+	}
+}
+
+func TestDecodeYUVLossless(t *testing.T) {
+	var buf bytes.Buffer
+	if err := Encode(&buf, sessionTestImage(32, 32, 1), &EncoderOptions{Lossless: true}); err != nil {
+		t.Fatalf("Encode: %v", err)
+	}
+	if _, err := DecodeYUV(bytes.NewReader(buf.Bytes())); err == nil {
+		t.Error("DecodeYUV accepted a lossless bitstream")
+	}
+}